@@ -0,0 +1,163 @@
+#include "adc_source.h"
+
+// The ESP32 and ESP32-S2 only support the first output format for a single unit (`ADC_CONV_SINGLE_UNIT_1`), the later targets only the second one:
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_SOURCE_OUTPUT_FORMAT (ADC_DIGI_OUTPUT_FORMAT_TYPE1)
+#define ADC_SOURCE_GET_DATA(output) ((output)->type1.data)
+#define ADC_SOURCE_GET_CHANNEL(output) ((output)->type1.channel)
+#else
+#define ADC_SOURCE_OUTPUT_FORMAT (ADC_DIGI_OUTPUT_FORMAT_TYPE2)
+#define ADC_SOURCE_GET_DATA(output) ((output)->type2.data)
+#define ADC_SOURCE_GET_CHANNEL(output) ((output)->type2.channel)
+#endif
+
+/// @brief Defining a struct called `adc_context`, that contains the private data of the ADC source.
+typedef struct adc_context {
+    adc_continuous_handle_t handle; // This field contains the `adc_continuous_handle_t` of the running capture.
+    adc_channel_t channel;          // This field contains the `adc_channel_t` that is sampled.
+
+    uint8_t frame[ADC_SOURCE_FRAME_LENGTH]; // This field contains a buffer for a single conversion frame of the DMA.
+} adc_context_t;
+
+static esp_err_t read_adc_source(void* context, float* samples, size_t sample_length) {
+    adc_context_t* adc_context = context;
+
+    float voltage_per_step = ADC_SOURCE_VOLTAGE_RANGE / ((1 << SOC_ADC_DIGI_MAX_BITWIDTH) - 1);
+
+    // Drain the frames that were stored in the pool since the previous capture, so the samples start now instead of up to a full pool earlier (the drain is limited, in case the ADC delivers frames as fast as they are read):
+    for (size_t i = 0; i <= ADC_SOURCE_BUFFER_LENGTH / ADC_SOURCE_FRAME_LENGTH; i++) {
+        uint32_t frame_length = 0;
+
+        if (adc_continuous_read(adc_context->handle, adc_context->frame, sizeof(adc_context->frame), &frame_length, 0) != ESP_OK)
+            break; // The pool is empty (`ESP_ERR_TIMEOUT`).
+    }
+
+    size_t sample_index = 0;
+
+    // Read conversion frames from the DMA, until the requested number of samples is captured:
+    while (sample_index < sample_length) {
+        uint32_t frame_length = 0;
+
+        esp_err_t succeeded_read = adc_continuous_read(adc_context->handle, adc_context->frame, sizeof(adc_context->frame), &frame_length, ADC_SOURCE_READ_TIMEOUT_MS);
+
+        // Check if the frame could be read in time:
+        if (succeeded_read != ESP_OK) {
+            ESP_LOGE(ADC_SOURCE_TAG, "The ADC did not deliver a frame, with error '%s'!", esp_err_to_name(succeeded_read));
+
+            return ESP_FAIL;
+        }
+
+        // Convert every result of the requested channel in the frame into a voltage:
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= frame_length && sample_index < sample_length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            adc_digi_output_data_t* output = (adc_digi_output_data_t*)&adc_context->frame[i];
+
+            if (ADC_SOURCE_GET_CHANNEL(output) == adc_context->channel)
+                samples[sample_index++] = ADC_SOURCE_GET_DATA(output) * voltage_per_step;
+        }
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t close_adc_source(void* context) {
+    adc_context_t* adc_context = context;
+
+    // Stop the capture and release the ADC:
+    ESP_ERROR_CHECK(adc_continuous_stop(adc_context->handle));
+    ESP_ERROR_CHECK(adc_continuous_deinit(adc_context->handle));
+
+    free(adc_context); // Free the memory allocated for the context of the ADC.
+
+    return ESP_OK;
+}
+
+esp_err_t check_adc_source_config(int adc_channel, size_t sample_frequency) {
+    // Check if the channel exists on the first ADC unit:
+    if (adc_channel < 0 || adc_channel >= SOC_ADC_CHANNEL_NUM(ADC_UNIT_1)) {
+        ESP_LOGE(ADC_SOURCE_TAG, "The ADC channel '%d' does not exist (the first unit has '%d' channels)!", adc_channel, (int)SOC_ADC_CHANNEL_NUM(ADC_UNIT_1));
+
+        return ESP_FAIL;
+    }
+
+    // Check if the sample frequency is supported by the ADC:
+    if (sample_frequency < SOC_ADC_SAMPLE_FREQ_THRES_LOW || sample_frequency > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) {
+        ESP_LOGE(ADC_SOURCE_TAG, "The sample frequency of '%d' Hz is not supported by the ADC!", (int)sample_frequency);
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t open_adc_source(sample_source_t* source, adc_channel_t adc_channel, size_t sample_frequency) {
+    // Check if `source` has a valid value:
+    if (source == NULL) {
+        ESP_LOGE(ADC_SOURCE_TAG, "The value of '%s' could not be 'NULL'!", "source");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the channel and the sample frequency are supported by the ADC, before the driver is touched:
+    if (check_adc_source_config(adc_channel, sample_frequency) != ESP_OK)
+        return ESP_FAIL;
+
+    adc_context_t* adc_context = calloc(1, sizeof(adc_context_t)); // Allocate memory for the context of the ADC.
+
+    // Check if the memory allocation was successful:
+    if (adc_context == NULL) {
+        ESP_LOGE(ADC_SOURCE_TAG, "The value of '%s' could not be 'NULL'!", "adc_context");
+
+        return ESP_FAIL;
+    }
+
+    adc_context->channel = adc_channel;
+
+    // Create the handle for the continuous (DMA) conversion:
+    adc_continuous_handle_cfg_t handle_configuration = {
+        .max_store_buf_size = ADC_SOURCE_BUFFER_LENGTH,
+        .conv_frame_size = ADC_SOURCE_FRAME_LENGTH
+    };
+
+    // Sample a single channel of the first ADC unit, with the full input range:
+    adc_digi_pattern_config_t pattern_configuration = {
+        .atten = ADC_ATTEN_DB_11,
+        .channel = adc_channel,
+        .unit = ADC_UNIT_1,
+        .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH
+    };
+
+    adc_continuous_config_t continuous_configuration = {
+        .pattern_num = 1,
+        .adc_pattern = &pattern_configuration,
+        .sample_freq_hz = sample_frequency,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_SOURCE_OUTPUT_FORMAT
+    };
+
+    // Create, configure and start the capture:
+    if (adc_continuous_new_handle(&handle_configuration, &adc_context->handle) != ESP_OK) {
+        ESP_LOGE(ADC_SOURCE_TAG, "The handle for the continuous ADC conversion could not be created!");
+
+        free(adc_context);
+
+        return ESP_FAIL;
+    }
+
+    if (adc_continuous_config(adc_context->handle, &continuous_configuration) != ESP_OK || adc_continuous_start(adc_context->handle) != ESP_OK) {
+        ESP_LOGE(ADC_SOURCE_TAG, "The continuous ADC conversion could not be started!");
+
+        adc_continuous_deinit(adc_context->handle);
+        free(adc_context);
+
+        return ESP_FAIL;
+    }
+
+    // Fill the interface of the source:
+    source->type = ADC_SOURCE;
+    source->sample_frequency = sample_frequency;
+    source->read = read_adc_source;
+    source->close = close_adc_source;
+    source->context = adc_context;
+
+    return ESP_OK;
+}
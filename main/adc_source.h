@@ -0,0 +1,29 @@
+#ifndef ADC_SOURCE_H_
+#define ADC_SOURCE_H_
+
+#include "esp_adc/adc_continuous.h"
+
+#include "sample_source.h"
+
+#define ADC_SOURCE_TAG ("ADC_SOURCE_H_")
+
+#define ADC_SOURCE_FRAME_LENGTH (256)
+#define ADC_SOURCE_BUFFER_LENGTH (4 * ADC_SOURCE_FRAME_LENGTH)
+#define ADC_SOURCE_READ_TIMEOUT_MS (1000)
+
+#define ADC_SOURCE_VOLTAGE_RANGE (3.3f)
+
+/// @brief This function checks if a channel and a sample frequency are supported by the ADC, so a request can be rejected before the current source is closed.
+/// @param adc_channel The channel of `ADC_UNIT_1` (as an `int`, so a negative value from a request is rejected as well).
+/// @param sample_frequency The frequency at which the channel is sampled, measured in Hz (Hertz).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if both are supported or `ESP_FAIL` if there is an error.
+extern esp_err_t check_adc_source_config(int adc_channel, size_t sample_frequency);
+
+/// @brief This function opens a source that continuously captures samples from an ADC channel over DMA.
+/// @param source A pointer to the `sample_source_t` structure that will be initialized.
+/// @param adc_channel The channel of `ADC_UNIT_1` that is sampled.
+/// @param sample_frequency The frequency at which the channel is sampled, measured in Hz (Hertz). It must be within the range supported by the ADC (`SOC_ADC_SAMPLE_FREQ_THRES_LOW` to `SOC_ADC_SAMPLE_FREQ_THRES_HIGH`).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t open_adc_source(sample_source_t* source, adc_channel_t adc_channel, size_t sample_frequency);
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef BINARY_PROTOCOL_H_
+#define BINARY_PROTOCOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// This header only depends on the C standard library, so that it can be shared with the host-side encoder (see 'tools/binary_encoder').
+
+#define BINARY_PROTOCOL_CONTENT_TYPE ("application/octet-stream")
+
+#define BINARY_PROTOCOL_MAGIC (0x4246) // The characters 'FB' (in little-endian byte order).
+#define BINARY_PROTOCOL_VERSION (1)
+
+#define BINARY_HEADER_LENGTH (8)
+#define BINARY_WAVE_PAYLOAD_HEADER_LENGTH (8)
+#define BINARY_WAVE_RECORD_LENGTH (16)
+#define BINARY_FFT_PAYLOAD_LENGTH (8)
+#define BINARY_DAC_PAYLOAD_LENGTH (4)
+#define BINARY_PEAK_PAYLOAD_HEADER_LENGTH (4)
+#define BINARY_PEAK_RECORD_LENGTH (8)
+
+#define BINARY_FFT_FLAG_PEAK_CONFIG (0x01)
+#define BINARY_DAC_FLAG_PREVENT_OVERFLOW (0x01)
+#define BINARY_DAC_FLAG_KEEP_PHASE (0x02)
+#define BINARY_DAC_FLAG_SWAP_AT_PERIOD (0x04)
+
+/// @brief This is an enumeration called `binary_message_type_t` with the types of binary messages. The layout of every message is a header followed by a fixed-layout payload, where all fields are little-endian:
+///
+/// Header (`BINARY_HEADER_LENGTH` bytes): `uint16_t` magic, `uint8_t` version, `uint8_t` message type, `uint16_t` reserved, `uint16_t` payload length.
+/// Wave payload: `uint32_t` sample frequency, `uint8_t` number of waves, three reserved bytes, followed by a record per wave of `float` amplitude, `float` frequency (in Hz), `float` phase and `float` offset.
+/// FFT payload: `uint8_t` window ID (a `window_config_t`), `uint8_t` flags, `uint8_t` maximum peaks, a reserved byte and a `float` peak threshold (the peak fields are only used with `BINARY_FFT_FLAG_PEAK_CONFIG`).
+/// DAC payload: `uint8_t` flags (`BINARY_DAC_FLAG_*`) followed by three reserved bytes.
+/// Peak payload (the response to a binary FFT message): `uint8_t` number of peaks, three reserved bytes, followed by a record per peak of `float` frequency (in Hz) and `float` amplitude.
+typedef enum binary_message_type {
+    BINARY_WAVE_MESSAGE = 1,
+    BINARY_FFT_MESSAGE = 2,
+    BINARY_DAC_MESSAGE = 3,
+    BINARY_PEAK_MESSAGE = 4
+} binary_message_type_t;
+
+/// @brief This is an enumeration called `binary_window_id_t` with the window IDs of a binary FFT message, in the same order as the `window_config_t` enum.
+typedef enum binary_window_id {
+    BINARY_HANN_WINDOW = 0,
+    BINARY_BLACKMAN_WINDOW = 1,
+    BINARY_BLACKMAN_HARRIS_WINDOW = 2,
+    BINARY_BLACKMAN_NUTTALL_WINDOW = 3,
+    BINARY_NUTTALL_WINDOW = 4,
+    BINARY_FLAT_TOP_WINDOW = 5
+} binary_window_id_t;
+
+/// @brief This function writes an `uint16_t` in little-endian byte order.
+/// @param data A pointer to the two bytes that will be written.
+/// @param value The value to write.
+static inline void binary_write_u16(uint8_t* data, uint16_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+}
+
+/// @brief This function writes an `uint32_t` in little-endian byte order.
+/// @param data A pointer to the four bytes that will be written.
+/// @param value The value to write.
+static inline void binary_write_u32(uint8_t* data, uint32_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = (value >> 24) & 0xFF;
+}
+
+/// @brief This function writes a `float` in little-endian byte order.
+/// @param data A pointer to the four bytes that will be written.
+/// @param value The value to write.
+static inline void binary_write_f32(uint8_t* data, float value) {
+    union {
+        float value;
+        uint32_t bits;
+    } converted_value = { .value = value };
+
+    binary_write_u32(data, converted_value.bits);
+}
+
+/// @brief This function reads an `uint16_t` in little-endian byte order.
+/// @param data A pointer to the two bytes that will be read.
+/// @return The read value.
+static inline uint16_t binary_read_u16(const uint8_t* data) {
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+/// @brief This function reads an `uint32_t` in little-endian byte order.
+/// @param data A pointer to the four bytes that will be read.
+/// @return The read value.
+static inline uint32_t binary_read_u32(const uint8_t* data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/// @brief This function reads a `float` in little-endian byte order.
+/// @param data A pointer to the four bytes that will be read.
+/// @return The read value.
+static inline float binary_read_f32(const uint8_t* data) {
+    union {
+        uint32_t bits;
+        float value;
+    } converted_value = { .bits = binary_read_u32(data) };
+
+    return converted_value.value;
+}
+
+/// @brief This function writes the header of a binary message.
+/// @param data A pointer to the `BINARY_HEADER_LENGTH` bytes that will be written.
+/// @param message_type The `binary_message_type_t` of the message.
+/// @param payload_length The length of the payload that follows the header (in bytes).
+static inline void binary_write_header(uint8_t* data, binary_message_type_t message_type, uint16_t payload_length) {
+    binary_write_u16(&data[0], BINARY_PROTOCOL_MAGIC);
+    data[2] = BINARY_PROTOCOL_VERSION;
+    data[3] = (uint8_t)message_type;
+    binary_write_u16(&data[4], 0);
+    binary_write_u16(&data[6], payload_length);
+}
+
+/// @brief This function validates the header of a binary message, and checks if the complete payload is present.
+/// @param data A pointer to the message.
+/// @param data_length The length of the message (in bytes).
+/// @param message_type The expected `binary_message_type_t` of the message.
+/// @param payload A pointer where a pointer to the payload will be stored.
+/// @param payload_length A pointer where the length of the payload will be stored.
+/// @return Zero if the header is valid, or a negative value if it is not.
+static inline int binary_read_header(const uint8_t* data, size_t data_length, binary_message_type_t message_type, const uint8_t** payload, size_t* payload_length) {
+    // Check if the message contains a complete header, with the expected magic, version and type:
+    if (data == NULL || data_length < BINARY_HEADER_LENGTH || binary_read_u16(&data[0]) != BINARY_PROTOCOL_MAGIC || data[2] != BINARY_PROTOCOL_VERSION || data[3] != message_type)
+        return -1;
+
+    size_t announced_length = binary_read_u16(&data[6]);
+
+    // Check if the message contains the complete payload:
+    if (announced_length > data_length - BINARY_HEADER_LENGTH)
+        return -1;
+
+    *payload = &data[BINARY_HEADER_LENGTH];
+    *payload_length = announced_length;
+
+    return 0;
+}
+
+#endif
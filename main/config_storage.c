@@ -0,0 +1,175 @@
+#include "config_storage.h"
+
+/// @brief Defining a struct called `config_storage_cache`, that mirrors what is stored in NVS, so a configuration that did not change is not written again.
+typedef struct config_storage_cache {
+    bool is_valid;                 // This field contains a `bool`, indicating if the cache mirrors the stored configuration.
+    stored_config_t stored_config; // This field contains the `stored_config_t` that is stored.
+    uint32_t dac_values_checksum;  // This field contains a `uint32_t` with the checksum of the stored DAC values.
+} config_storage_cache_t;
+
+static config_storage_cache_t storage_cache = {};
+
+static uint32_t calculate_storage_checksum(const void* data, size_t length) {
+    const uint8_t* bytes = data;
+    uint32_t checksum = 2166136261u; // The offset basis of the 32-bit FNV-1a hash.
+
+    for (size_t i = 0; i < length; i++) {
+        checksum ^= bytes[i];
+        checksum *= 16777619u; // The prime of the 32-bit FNV-1a hash.
+    }
+
+    return checksum;
+}
+
+static bool has_same_settings(const stored_config_t* first_config, const stored_config_t* second_config) {
+    size_t settings_offset = offsetof(stored_config_t, sample_frequency);
+    size_t settings_length = offsetof(stored_config_t, dac_values_length) - settings_offset;
+
+    // Compare everything between the version and the length of the DAC values (the DAC values themselves are compared by their checksum):
+    return memcmp((const uint8_t*)first_config + settings_offset, (const uint8_t*)second_config + settings_offset, settings_length) == 0;
+}
+
+static bool has_stored_table(uint32_t table_length, uint32_t checksum, uint32_t stored_table_length, uint32_t stored_checksum) {
+    // A table without a length keeps the stored one, so it never needs a write:
+    return table_length == 0 || (table_length == stored_table_length && checksum == stored_checksum);
+}
+
+static esp_err_t load_stored_table(nvs_handle_t storage_handle, const char* key, void* table, size_t expected_length) {
+    size_t stored_length = 0;
+
+    // Check if the table is stored with the expected length, before reading it:
+    if (table == NULL || expected_length == 0 || nvs_get_blob(storage_handle, key, NULL, &stored_length) != ESP_OK || stored_length != expected_length)
+        return ESP_FAIL;
+
+    return nvs_get_blob(storage_handle, key, table, &stored_length) == ESP_OK ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t save_stored_config(const stored_config_t* stored_config, const uint8_t* dac_values) {
+    // Check if `stored_config` has a valid value, and if the DAC values are provided when their length is set:
+    if (stored_config == NULL || (dac_values == NULL && stored_config->dac_values_length > 0)) {
+        ESP_LOGE(CONFIG_STORAGE_TAG, "The value of '%s' and the DAC values with a length could not be 'NULL'!", "stored_config");
+
+        return ESP_FAIL;
+    }
+
+    uint32_t dac_values_checksum = calculate_storage_checksum(dac_values, stored_config->dac_values_length * sizeof(uint8_t));
+
+    // Skip the write when NVS already holds this configuration and these DAC values (every write wears the flash, and blocks the request for milliseconds):
+    if (storage_cache.is_valid && has_same_settings(stored_config, &storage_cache.stored_config)
+        && has_stored_table(stored_config->dac_values_length, dac_values_checksum, storage_cache.stored_config.dac_values_length, storage_cache.dac_values_checksum)) {
+        ESP_LOGD(CONFIG_STORAGE_TAG, "The configuration did not change, so it is not stored again.");
+
+        return ESP_OK;
+    }
+
+    nvs_handle_t storage_handle;
+
+    // Open the namespace of the program in NVS:
+    if (nvs_open(CONFIG_STORAGE_NAMESPACE, NVS_READWRITE, &storage_handle) != ESP_OK) {
+        ESP_LOGE(CONFIG_STORAGE_TAG, "The namespace '%s' could not be opened!", CONFIG_STORAGE_NAMESPACE);
+
+        return ESP_FAIL;
+    }
+
+    stored_config_t config_to_store = *stored_config;
+    config_to_store.version = CONFIG_STORAGE_VERSION;
+
+    esp_err_t succeeded_storing = ESP_OK;
+
+    // Store the DAC values first, so that the stored configuration never refers to DAC values that are not (completely) written:
+    if (config_to_store.dac_values_length > 0)
+        succeeded_storing = nvs_set_blob(storage_handle, CONFIG_STORAGE_DAC_VALUES_KEY, dac_values, config_to_store.dac_values_length * sizeof(uint8_t));
+
+    // Keep the length of the DAC values that were stored before, when no new DAC values are provided:
+    stored_config_t previous_config = {};
+    size_t previous_config_length = sizeof(previous_config);
+
+    if (config_to_store.dac_values_length == 0 && nvs_get_blob(storage_handle, CONFIG_STORAGE_CONFIG_KEY, &previous_config, &previous_config_length) == ESP_OK && previous_config_length == sizeof(previous_config) && previous_config.version == CONFIG_STORAGE_VERSION)
+        config_to_store.dac_values_length = previous_config.dac_values_length;
+
+    if (succeeded_storing == ESP_OK)
+        succeeded_storing = nvs_set_blob(storage_handle, CONFIG_STORAGE_CONFIG_KEY, &config_to_store, sizeof(config_to_store));
+
+    if (succeeded_storing == ESP_OK)
+        succeeded_storing = nvs_commit(storage_handle);
+
+    nvs_close(storage_handle);
+
+    // Check if the configuration and the DAC values are stored (what is stored after a failed write is unknown, so the next save writes again):
+    if (succeeded_storing != ESP_OK) {
+        ESP_LOGE(CONFIG_STORAGE_TAG, "The configuration could not be stored, with error '%s'!", esp_err_to_name(succeeded_storing));
+
+        storage_cache.is_valid = false;
+
+        return ESP_FAIL;
+    }
+
+    // Remember what is stored now (DAC values that were kept keep their checksum, when the cache knows it):
+    bool kept_dac_values = stored_config->dac_values_length == 0 && config_to_store.dac_values_length > 0;
+
+    storage_cache.is_valid = !kept_dac_values || storage_cache.is_valid;
+    storage_cache.dac_values_checksum = kept_dac_values ? storage_cache.dac_values_checksum : dac_values_checksum;
+    storage_cache.stored_config = config_to_store;
+
+    return ESP_OK;
+}
+
+static bool has_valid_settings(const stored_config_t* stored_config) {
+    return stored_config->number_of_waves <= MAXIMUM_STORED_WAVES &&
+           stored_config->number_of_second_channel_waves <= MAXIMUM_STORED_WAVES &&
+           stored_config->window >= 0 && stored_config->window < WINDOW_CONFIGS_LENGTH &&
+           (stored_config->dac_swap_mode == DAC_SWAP_AT_CROSSING || stored_config->dac_swap_mode == DAC_SWAP_AT_PERIOD) &&
+           stored_config->dac_interpolation_factor >= 1 && stored_config->dac_interpolation_factor <= DAC_MAXIMUM_INTERPOLATION_FACTOR &&
+           stored_config->dac_channels != 0 && (stored_config->dac_channels & ~DAC_OUTPUT_BOTH_CHANNELS) == 0;
+}
+
+esp_err_t load_stored_config(stored_config_t* stored_config, uint8_t* dac_values, size_t maximum_dac_values_length) {
+    // Check if `stored_config` has a valid value:
+    if (stored_config == NULL) {
+        ESP_LOGE(CONFIG_STORAGE_TAG, "The value of '%s' could not be 'NULL'!", "stored_config");
+
+        return ESP_FAIL;
+    }
+
+    nvs_handle_t storage_handle;
+
+    // Open the namespace of the program in NVS (it does not exist before the first configuration is stored):
+    if (nvs_open(CONFIG_STORAGE_NAMESPACE, NVS_READONLY, &storage_handle) != ESP_OK)
+        return ESP_ERR_NOT_FOUND;
+
+    size_t config_length = sizeof(stored_config_t);
+
+    esp_err_t succeeded_loading = nvs_get_blob(storage_handle, CONFIG_STORAGE_CONFIG_KEY, stored_config, &config_length);
+
+    // Check if a configuration of the current version is stored:
+    if (succeeded_loading != ESP_OK || config_length != sizeof(stored_config_t) || stored_config->version != CONFIG_STORAGE_VERSION) {
+        if (succeeded_loading == ESP_OK)
+            ESP_LOGE(CONFIG_STORAGE_TAG, "The stored configuration has an unsupported version, so it is ignored!");
+
+        nvs_close(storage_handle);
+
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Check if the stored counts and enums are within the valid range (a corrupt or foreign blob would otherwise overflow the waves, or stop the DAC from starting):
+    if (!has_valid_settings(stored_config)) {
+        ESP_LOGE(CONFIG_STORAGE_TAG, "The stored configuration is invalid, so it is ignored!");
+
+        nvs_close(storage_handle);
+
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Load the DAC values, if they fit in the provided buffer (otherwise they are reported as not stored):
+    if (stored_config->dac_values_length > maximum_dac_values_length || load_stored_table(storage_handle, CONFIG_STORAGE_DAC_VALUES_KEY, dac_values, stored_config->dac_values_length * sizeof(uint8_t)) != ESP_OK)
+        stored_config->dac_values_length = 0;
+
+    nvs_close(storage_handle);
+
+    // Remember what is stored, so saving the restored configuration again does not write it:
+    storage_cache.is_valid = true;
+    storage_cache.stored_config = *stored_config;
+    storage_cache.dac_values_checksum = calculate_storage_checksum(dac_values, stored_config->dac_values_length * sizeof(uint8_t));
+
+    return ESP_OK;
+}
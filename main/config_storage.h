@@ -0,0 +1,66 @@
+#ifndef CONFIG_STORAGE_H_
+#define CONFIG_STORAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "nvs.h"
+
+#include "dac_communicator.h"
+#include "filter_transform.h"
+#include "wave_transform.h"
+#include "window_transform.h"
+
+#define CONFIG_STORAGE_TAG ("CONFIG_STORAGE_H_")
+
+#define CONFIG_STORAGE_NAMESPACE ("fft_creator")
+#define CONFIG_STORAGE_VERSION (7)
+
+#define CONFIG_STORAGE_CONFIG_KEY ("config")
+#define CONFIG_STORAGE_DAC_VALUES_KEY ("dac_values")
+
+#define MAXIMUM_STORED_WAVES (10)
+
+/// @brief Defining a struct called `stored_config`, that contains the last applied configuration of the program, as it is stored in NVS.
+typedef struct stored_config {
+    uint32_t version; // This field contains a `uint32_t` that must be equal to `CONFIG_STORAGE_VERSION` (otherwise the stored configuration is ignored).
+
+    uint32_t sample_frequency;                  // This field contains a `uint32_t` with the sample frequency (in Hz).
+    uint32_t number_of_waves;                   // This field contains a `uint32_t` with the number of waves.
+    wave_config_t waves[MAXIMUM_STORED_WAVES];  // This field contains an array of `wave_config_t` waves.
+    window_config_t window;                     // This field contains the `window_config_t` window.
+
+    bool dac_is_enabled;       // This field contains a `bool`, indicating if the DAC was outputting the samples.
+    bool prevent_dac_overflow; // This field contains a `bool`, indicating if the DAC values are clamped to the range of the DAC.
+    bool keep_dac_phase;       // This field contains a `bool`, indicating if new DAC values continue at the same position in their period.
+
+    dac_swap_mode_t dac_swap_mode;      // This field contains the `dac_swap_mode_t` with the moment at which new DAC values are swapped in.
+    uint32_t dac_interpolation_factor;  // This field contains a `uint32_t` with the number of values that the DAC outputs per sample.
+    dac_output_channels_t dac_channels; // This field contains the `dac_output_channels_t` with the DAC channels that are output.
+
+    uint32_t number_of_second_channel_waves;                  // This field contains a `uint32_t` with the number of waves of the second DAC channel.
+    uint32_t second_channel_sample_frequency;                 // This field contains a `uint32_t` with the sample frequency to which the waves of the second channel are relative (in Hz).
+    wave_config_t second_channel_waves[MAXIMUM_STORED_WAVES]; // This field contains an array of `wave_config_t` waves of the second DAC channel.
+
+    filter_config_t filter; // This field contains the `filter_config_t` settings of the filter stage.
+
+    // The length of the DAC values must stay the last field, because the settings before it are compared at once to skip unchanged writes.
+    uint32_t dac_values_length; // This field contains a `uint32_t` with the number of stored (pre-quantized and interleaved) DAC values of both channels, or zero if none are stored.
+} stored_config_t;
+
+/// @brief This function stores the configuration in NVS, together with the pre-quantized DAC values (so they do not have to be computed again after a reboot). Nothing is written when NVS already holds the same configuration and DAC values (as far as this function stored or loaded them since the boot).
+/// @param stored_config A pointer to the configuration. Its `dac_values_length` field tells if the DAC values are stored (the previously stored DAC values are kept when it is zero).
+/// @param dac_values A pointer to the pre-quantized DAC values (it may be `NULL` when `dac_values_length` is zero).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t save_stored_config(const stored_config_t* stored_config, const uint8_t* dac_values);
+
+/// @brief This function loads the configuration from NVS, together with the stored DAC values. DAC values that are missing, or do not fit in the provided buffer, are reported with a length of zero.
+/// @param stored_config A pointer to a `stored_config_t` structure where the configuration will be stored.
+/// @param dac_values A pointer to a buffer where the pre-quantized DAC values will be stored.
+/// @param maximum_dac_values_length The length of the `dac_values` buffer.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully, `ESP_ERR_NOT_FOUND` if no (valid) configuration is stored (also when a count of waves or one of the enums is out of range), or `ESP_FAIL` if there is an error.
+extern esp_err_t load_stored_config(stored_config_t* stored_config, uint8_t* dac_values, size_t maximum_dac_values_length);
+
+#endif
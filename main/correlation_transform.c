@@ -0,0 +1,353 @@
+#include "correlation_transform.h"
+
+static bool is_power_of_two(size_t value) {
+    return value >= 2 && (value & (value - 1)) == 0;
+}
+
+static esp_err_t convolve_block_f32(correlation_kernel_t* kernel, const float* head, size_t head_length, const float* block, size_t block_length) {
+    float* block_spectrum = kernel->block_spectrum;
+    size_t fft_length = kernel->fft_length;
+
+    // Put the samples in the complex buffer (the head and the block follow each other), and pad the rest with zeros:
+    memset(block_spectrum, 0, fft_length * 2 * sizeof(float));
+
+    for (size_t i = 0; i < head_length; i++)
+        block_spectrum[i * 2] = head[i];
+
+    for (size_t i = 0; i < block_length; i++)
+        block_spectrum[(head_length + i) * 2] = block[i];
+
+    if (apply_complex_fft_fc32(block_spectrum, fft_length) != ESP_OK)
+        return ESP_FAIL;
+
+    // Multiply the conjugated spectrum with the kernel, which is the conjugated (and scaled) product of the two spectra:
+    for (size_t i = 0; i < fft_length; i++) {
+        float signal_real = block_spectrum[i * 2 + 0];
+        float signal_imaginary = -block_spectrum[i * 2 + 1];
+        float kernel_real = kernel->kernel_spectrum[i * 2 + 0];
+        float kernel_imaginary = kernel->kernel_spectrum[i * 2 + 1];
+
+        block_spectrum[i * 2 + 0] = signal_real * kernel_real - signal_imaginary * kernel_imaginary;
+        block_spectrum[i * 2 + 1] = signal_real * kernel_imaginary + signal_imaginary * kernel_real;
+    }
+
+    // The forward FFT of the conjugated product is the conjugated inverse FFT, of which the (real) result is in the real parts:
+    return apply_complex_fft_fc32(block_spectrum, fft_length);
+}
+
+size_t get_correlation_fft_length(size_t output_length) {
+    size_t fft_length = 2;
+
+    while (fft_length < output_length && fft_length <= MAXIMUM_CORRELATION_FFT_LENGTH)
+        fft_length *= 2;
+
+    return (fft_length <= MAXIMUM_CORRELATION_FFT_LENGTH) ? fft_length : 0;
+}
+
+size_t get_streaming_fft_length(size_t reference_length) {
+    size_t fft_length = get_correlation_fft_length(reference_length * CORRELATION_BLOCK_RATIO);
+
+    // A long reference gets the longest FFT, and so fewer new samples per block:
+    return (fft_length != 0) ? fft_length : MAXIMUM_CORRELATION_FFT_LENGTH;
+}
+
+const char* get_correlation_mode_name(correlation_mode_t mode) {
+    switch (mode) {
+        case CROSS_CORRELATION:
+            return "CROSS_CORRELATION";
+
+        case CONVOLUTION:
+            return "CONVOLUTION";
+
+        default:
+            return "UNKNOWN";
+    }
+}
+
+const char* get_correlation_method_name(correlation_method_t method) {
+    switch (method) {
+        case SINGLE_BLOCK_CORRELATION:
+            return "SINGLE_BLOCK";
+
+        case OVERLAP_ADD_CORRELATION:
+            return "OVERLAP_ADD";
+
+        case OVERLAP_SAVE_CORRELATION:
+            return "OVERLAP_SAVE";
+
+        default:
+            return "UNKNOWN";
+    }
+}
+
+esp_err_t prepare_correlation_kernel(correlation_kernel_t* kernel, const float* reference, size_t reference_length, correlation_mode_t mode, size_t fft_length) {
+    // Check if `kernel` and `reference` have a valid value:
+    if (kernel == NULL || reference == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "kernel", "reference");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the reference has a valid length:
+    if (reference_length == 0 || reference_length > MAXIMUM_REFERENCE_LENGTH) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The length '%d' of the reference must be between '1' and '%d'!", (int)reference_length, MAXIMUM_REFERENCE_LENGTH);
+
+        return ESP_FAIL;
+    }
+
+    // Select the FFT length for streaming, if it is not given:
+    if (fft_length == 0)
+        fft_length = get_streaming_fft_length(reference_length);
+
+    // Check if the FFT length is a power of two, that holds the reference and at least as many new samples:
+    if (!is_power_of_two(fft_length) || fft_length < reference_length * 2 || fft_length > MAXIMUM_CORRELATION_FFT_LENGTH) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The FFT length '%d' must be a power of two between '%d' and '%d'!", (int)fft_length, (int)reference_length * 2, MAXIMUM_CORRELATION_FFT_LENGTH);
+
+        return ESP_FAIL;
+    }
+
+    // Release the buffers of a previous reference:
+    ESP_ERROR_CHECK(free_correlation_kernel(kernel));
+
+    kernel->kernel_spectrum = calloc(fft_length * 2, sizeof(float));
+    kernel->block_spectrum = calloc(fft_length * 2, sizeof(float));
+    kernel->overlap = calloc(reference_length, sizeof(float)); // One more than the `reference_length - 1` samples that are kept, so a reference of one sample still gets a buffer.
+
+    // Check if the memory allocation was successful:
+    if (kernel->kernel_spectrum == NULL || kernel->block_spectrum == NULL || kernel->overlap == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "kernel_spectrum", "block_spectrum", "overlap");
+
+        free_correlation_kernel(kernel);
+
+        return ESP_FAIL;
+    }
+
+    ESP_ERROR_CHECK(initialize_fft_f32(&kernel->fft_data));
+
+    kernel->mode = mode;
+    kernel->reference_length = reference_length;
+    kernel->fft_length = fft_length;
+    kernel->block_length = fft_length - reference_length + 1;
+
+    // A cross-correlation is a convolution with the time-reversed reference:
+    for (size_t i = 0; i < reference_length; i++)
+        kernel->kernel_spectrum[i * 2] = (mode == CROSS_CORRELATION) ? reference[reference_length - 1 - i] : reference[i];
+
+    if (apply_complex_fft_fc32(kernel->kernel_spectrum, fft_length) != ESP_OK) {
+        free_correlation_kernel(kernel);
+
+        return ESP_FAIL;
+    }
+
+    // Conjugate and scale the spectrum once, so every block only needs a single FFT for its inverse:
+    for (size_t i = 0; i < fft_length; i++) {
+        kernel->kernel_spectrum[i * 2 + 0] /= fft_length;
+        kernel->kernel_spectrum[i * 2 + 1] /= -(float)fft_length;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t free_correlation_kernel(correlation_kernel_t* kernel) {
+    // Check if `kernel` has a valid value:
+    if (kernel == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "kernel");
+
+        return ESP_FAIL;
+    }
+
+    free(kernel->kernel_spectrum);
+    free(kernel->block_spectrum);
+    free(kernel->overlap);
+
+    kernel->kernel_spectrum = NULL;
+    kernel->block_spectrum = NULL;
+    kernel->overlap = NULL;
+    kernel->reference_length = 0;
+    kernel->fft_length = 0;
+    kernel->block_length = 0;
+
+    return de_initialize_fft_f32(&kernel->fft_data);
+}
+
+esp_err_t apply_correlation_f32(correlation_kernel_t* kernel, const float* signal, size_t signal_length, float* output) {
+    // Check if `kernel`, `signal` and `output` have a valid value:
+    if (kernel == NULL || signal == NULL || output == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "kernel", "signal", "output");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the kernel is prepared:
+    if (kernel->kernel_spectrum == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The kernel is not prepared yet, call 'prepare_correlation_kernel' first!");
+
+        return ESP_FAIL;
+    }
+
+    size_t output_length = signal_length + kernel->reference_length - 1;
+
+    // Check if the full result fits in the FFT (otherwise its end would wrap around onto its start):
+    if (signal_length == 0 || output_length > kernel->fft_length) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The '%d' outputs of the signal do not fit in the FFT length '%d', stream the signal instead!", (int)output_length, (int)kernel->fft_length);
+
+        return ESP_FAIL;
+    }
+
+    if (convolve_block_f32(kernel, NULL, 0, signal, signal_length) != ESP_OK)
+        return ESP_FAIL;
+
+    for (size_t i = 0; i < output_length; i++)
+        output[i] = kernel->block_spectrum[i * 2];
+
+    return ESP_OK;
+}
+
+esp_err_t stream_correlation_f32(correlation_kernel_t* kernel, correlation_method_t method, const float* input, size_t input_length, float* output) {
+    // Check if `kernel`, `input` and `output` have a valid value:
+    if (kernel == NULL || input == NULL || output == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "kernel", "input", "output");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the kernel is prepared:
+    if (kernel->kernel_spectrum == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The kernel is not prepared yet, call 'prepare_correlation_kernel' first!");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the method combines blocks:
+    if (method != OVERLAP_ADD_CORRELATION && method != OVERLAP_SAVE_CORRELATION) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "Unknown configuration for the provided method in '%s'!", "method");
+
+        return ESP_FAIL;
+    }
+
+    size_t overlap_length = kernel->reference_length - 1;
+    float* overlap = kernel->overlap;
+    const float* block_outputs = kernel->block_spectrum; // The real parts of the outputs of a block.
+
+    for (size_t offset = 0; offset < input_length; ) {
+        size_t block_length = input_length - offset;
+
+        if (block_length > kernel->block_length)
+            block_length = kernel->block_length;
+
+        const float* block = input + offset;
+
+        if (method == OVERLAP_ADD_CORRELATION) {
+            // Transform the block alone, so its outputs run `overlap_length` samples past its end:
+            if (convolve_block_f32(kernel, NULL, 0, block, block_length) != ESP_OK)
+                return ESP_FAIL;
+
+            // Add the tail of the previous blocks to the first outputs:
+            for (size_t i = 0; i < block_length; i++)
+                output[offset + i] = block_outputs[i * 2] + ((i < overlap_length) ? overlap[i] : 0.0f);
+
+            // Keep the tail that runs past the block, together with the part of the previous tail that is not used yet (for a block that is shorter than the tail):
+            for (size_t i = 0; i < overlap_length; i++)
+                overlap[i] = ((i + block_length < overlap_length) ? overlap[i + block_length] : 0.0f) + block_outputs[(block_length + i) * 2];
+        }
+        else {
+            // Transform the block after the end of the previous input, so the first `overlap_length` outputs are the only ones that wrap around:
+            if (convolve_block_f32(kernel, overlap, overlap_length, block, block_length) != ESP_OK)
+                return ESP_FAIL;
+
+            for (size_t i = 0; i < block_length; i++)
+                output[offset + i] = block_outputs[(overlap_length + i) * 2];
+
+            // Keep the end of the input (which may still include a part of the previous end, for a block that is shorter than it):
+            if (block_length < overlap_length) {
+                memmove(overlap, overlap + block_length, (overlap_length - block_length) * sizeof(float));
+                memcpy(overlap + overlap_length - block_length, block, block_length * sizeof(float));
+            }
+            else {
+                memcpy(overlap, block + block_length - overlap_length, overlap_length * sizeof(float));
+            }
+        }
+
+        offset += block_length;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t reset_correlation_stream(correlation_kernel_t* kernel) {
+    // Check if `kernel` has a valid value:
+    if (kernel == NULL || kernel->overlap == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "kernel", "overlap");
+
+        return ESP_FAIL;
+    }
+
+    memset(kernel->overlap, 0, kernel->reference_length * sizeof(float));
+
+    return ESP_OK;
+}
+
+esp_err_t find_correlation_peak_f32(const float* output, size_t output_length, int first_lag, correlation_peak_t* peak) {
+    // Check if `output` and `peak` have a valid value:
+    if (output == NULL || peak == NULL || output_length == 0) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL' or empty!", "output", "peak");
+
+        return ESP_FAIL;
+    }
+
+    size_t peak_index = 0;
+
+    for (size_t i = 1; i < output_length; i++) {
+        if (fabsf(output[i]) > fabsf(output[peak_index]))
+            peak_index = i;
+    }
+
+    float offset = 0.0f; // The offset of the top of the parabola from the peak index (between -0.5 and 0.5).
+
+    // Fit a parabola through the magnitudes around the peak, if it has neighbours on both sides:
+    if (peak_index > 0 && peak_index + 1 < output_length) {
+        float previous = fabsf(output[peak_index - 1]);
+        float current = fabsf(output[peak_index]);
+        float next = fabsf(output[peak_index + 1]);
+        float denominator = previous - 2.0f * current + next;
+
+        if (denominator < 0.0f)
+            offset = 0.5f * (previous - next) / denominator;
+    }
+
+    peak->index = peak_index;
+    peak->lag = first_lag + (int)peak_index + offset;
+    peak->value = output[peak_index];
+    peak->normalized_value = 0.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t normalize_correlation_peak_f32(correlation_peak_t* peak, const float* signal, size_t signal_length, const float* reference, size_t reference_length) {
+    // Check if `peak`, `signal` and `reference` have a valid value:
+    if (peak == NULL || signal == NULL || reference == NULL) {
+        ESP_LOGE(CORRELATION_TRANSFORM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "peak", "signal", "reference");
+
+        return ESP_FAIL;
+    }
+
+    int lag = (int)lroundf(peak->lag); // The lag of the output at the peak index (the interpolation moves it at most half a sample).
+    float reference_energy = 0.0f;
+    float signal_energy = 0.0f;
+
+    // Sum the energy of the reference, and of the signal samples that it overlaps at the lag (`x[n + lag]` with `r[n]`):
+    for (size_t n = 0; n < reference_length; n++) {
+        int signal_index = lag + (int)n;
+
+        reference_energy += reference[n] * reference[n];
+
+        if (signal_index >= 0 && signal_index < (int)signal_length)
+            signal_energy += signal[signal_index] * signal[signal_index];
+    }
+
+    float energy = sqrtf(reference_energy * signal_energy);
+
+    peak->normalized_value = (energy > 0.0f) ? peak->value / energy : 0.0f;
+
+    return ESP_OK;
+}
@@ -0,0 +1,131 @@
+#ifndef CORRELATION_TRANSFORM_H_
+#define CORRELATION_TRANSFORM_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_log.h"
+
+#include "fft_transform.h"
+
+#define CORRELATION_TRANSFORM_TAG ("CORRELATION_TRANSFORM_H_")
+
+#ifdef FFT_STATIC_LENGTH
+#define MAXIMUM_CORRELATION_FFT_LENGTH (FFT_STATIC_LENGTH) // The longest FFT of a block (the generated tables cover this length).
+#else
+#define MAXIMUM_CORRELATION_FFT_LENGTH (CONFIG_DSP_MAX_FFT_SIZE) // The longest FFT of a block (the tables of `esp_dsp` cover this length).
+#endif
+
+#define MAXIMUM_REFERENCE_LENGTH (MAXIMUM_CORRELATION_FFT_LENGTH / 2) // The longest reference, so a streaming block still has room for new samples.
+#define CORRELATION_BLOCK_RATIO (4)                                   // The FFT of a streaming block is at least this many times the length of the reference (so most of a block is new samples).
+
+/// @brief This is an enumeration called `correlation_mode_t` with the operations that are applied with a reference.
+typedef enum correlation_mode {
+    CROSS_CORRELATION, // The cross-correlation `c[l] = sum(x[n + l] * r[n])`, which peaks at the delay of the reference in the signal (a matched filter).
+    CONVOLUTION        // The convolution `y[n] = sum(x[n - k] * r[k])`, which filters the signal with the reference as impulse response.
+} correlation_mode_t;
+
+/// @brief This is an enumeration called `correlation_method_t` with the ways in which the blocks of a signal are combined.
+typedef enum correlation_method {
+    SINGLE_BLOCK_CORRELATION, // The complete signal is transformed in a single FFT, which must hold the signal and the reference.
+    OVERLAP_ADD_CORRELATION,  // The signal is split into blocks, of which the tails of the outputs are added to the next outputs.
+    OVERLAP_SAVE_CORRELATION  // The signal is split into blocks, that start with the end of the previous block (of which the aliased outputs are discarded).
+} correlation_method_t;
+
+/// @brief Defining a struct called `correlation_kernel`, that contains the cached spectrum of a reference for a single FFT length, together with the state of a streaming signal.
+typedef struct correlation_kernel {
+    correlation_mode_t mode; // This field contains the `correlation_mode_t` for which the spectrum is prepared.
+    size_t reference_length; // This field contains a `size_t` with the number of samples of the reference.
+    size_t fft_length;       // This field contains a `size_t` with the length of the FFT of a block (a power of two).
+    size_t block_length;     // This field contains a `size_t` with the largest number of new samples of a streaming block (`fft_length - reference_length + 1`).
+
+    float* kernel_spectrum; // This field is a pointer to the conjugated spectrum of the (time-reversed, for a cross-correlation) reference, scaled by `1 / fft_length` for the inverse FFT.
+    float* block_spectrum;  // This field is a pointer to the complex buffer, in which a block is transformed.
+    float* overlap;         // This field is a pointer to the `reference_length - 1` samples of the stream: the tail of the previous output (overlap-add) or the end of the previous input (overlap-save).
+
+    fft_data_t fft_data; // This field contains the `fft_data_t` that keeps the FFT initialized for as long as the kernel exists.
+} correlation_kernel_t;
+
+/// @brief Defining a struct called `correlation_peak`, that contains the strongest value of a correlation.
+typedef struct correlation_peak {
+    size_t index;           // This field contains a `size_t` with the index of the strongest output.
+    float lag;              // This field contains a `float` with the lag of the peak (in samples, interpolated between the outputs around it).
+    float value;            // This field contains a `float` with the output at the peak.
+    float normalized_value; // This field contains a `float` with the value relative to the energy of the reference and the signal under it (between -1 and 1).
+} correlation_peak_t;
+
+/// @brief This function transforms a reference into the cached spectrum of a kernel, which is reused for every signal and block. A previous spectrum of the kernel is replaced, and the stream starts over.
+/// @param kernel A pointer to the `correlation_kernel_t` structure.
+/// @param reference A pointer to the samples of the reference.
+/// @param reference_length The number of samples of the reference (at most `MAXIMUM_REFERENCE_LENGTH`).
+/// @param mode The `correlation_mode_t` that is applied with the reference.
+/// @param fft_length The length of the FFT of a block (a power of two, of at least `2 * reference_length`), or zero to select one for streaming (at least `CORRELATION_BLOCK_RATIO` times the reference).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t prepare_correlation_kernel(correlation_kernel_t* kernel, const float* reference, size_t reference_length, correlation_mode_t mode, size_t fft_length);
+
+/// @brief This function releases the buffers of a kernel, and de-initializes its FFT.
+/// @param kernel A pointer to the `correlation_kernel_t` structure.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t free_correlation_kernel(correlation_kernel_t* kernel);
+
+/// @brief This function applies the kernel to a complete signal in a single FFT. The output is the full linear result, where output `i` is the lag `i - (reference_length - 1)` of a cross-correlation (or the sample `i` of a convolution).
+/// @param kernel A pointer to the prepared `correlation_kernel_t` structure.
+/// @param signal A pointer to the samples of the signal.
+/// @param signal_length The number of samples of the signal (`signal_length + reference_length - 1` must fit in the FFT).
+/// @param output A pointer to an array of `signal_length + reference_length - 1` floats, where the result will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t apply_correlation_f32(correlation_kernel_t* kernel, const float* signal, size_t signal_length, float* output);
+
+/// @brief This function applies the kernel to the next samples of a stream, which are split into blocks of at most `block_length` samples. Output `i` belongs to input `i`, and continues from the previous call: it is the lag `n - (reference_length - 1)` of a cross-correlation, where `n` counts the samples since the start of the stream. Feeding `reference_length - 1` zeros flushes the last lags.
+/// @param kernel A pointer to the prepared `correlation_kernel_t` structure.
+/// @param method The `correlation_method_t` (`OVERLAP_ADD_CORRELATION` or `OVERLAP_SAVE_CORRELATION`), which must stay the same for the whole stream.
+/// @param input A pointer to the next samples.
+/// @param input_length The number of samples.
+/// @param output A pointer to an array of `input_length` floats, where the result will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t stream_correlation_f32(correlation_kernel_t* kernel, correlation_method_t method, const float* input, size_t input_length, float* output);
+
+/// @brief This function starts the stream of a kernel over, as if no samples were fed yet.
+/// @param kernel A pointer to the prepared `correlation_kernel_t` structure.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t reset_correlation_stream(correlation_kernel_t* kernel);
+
+/// @brief This function finds the output with the largest magnitude, and interpolates its lag with a parabola through the magnitudes around it.
+/// @param output A pointer to the result of the kernel.
+/// @param output_length The number of outputs.
+/// @param first_lag The lag of the first output (`-(reference_length - 1)` for the full result of a cross-correlation, or zero for a convolution).
+/// @param peak A pointer to a `correlation_peak_t` structure where the peak will be stored (its `normalized_value` is set to zero).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t find_correlation_peak_f32(const float* output, size_t output_length, int first_lag, correlation_peak_t* peak);
+
+/// @brief This function normalizes the value of a cross-correlation peak by the energy of the reference and the part of the signal under it, so a perfect match of any amplitude is one.
+/// @param peak A pointer to the `correlation_peak_t` structure, whose `normalized_value` is set.
+/// @param signal A pointer to the samples of the signal.
+/// @param signal_length The number of samples of the signal.
+/// @param reference A pointer to the samples of the reference.
+/// @param reference_length The number of samples of the reference.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t normalize_correlation_peak_f32(correlation_peak_t* peak, const float* signal, size_t signal_length, const float* reference, size_t reference_length);
+
+/// @brief This function selects the shortest FFT length (a power of two) that holds a given number of linear outputs.
+/// @param output_length The number of outputs.
+/// @return The FFT length, or zero if it is longer than `MAXIMUM_CORRELATION_FFT_LENGTH`.
+extern size_t get_correlation_fft_length(size_t output_length);
+
+/// @brief This function selects the FFT length with which a reference is streamed (at least `CORRELATION_BLOCK_RATIO` times the reference, capped at `MAXIMUM_CORRELATION_FFT_LENGTH`).
+/// @param reference_length The number of samples of the reference.
+/// @return The FFT length that `prepare_correlation_kernel` selects for a `fft_length` of zero.
+extern size_t get_streaming_fft_length(size_t reference_length);
+
+/// @brief This function converts a correlation mode into its name (for example `"CROSS_CORRELATION"`).
+/// @param mode The `correlation_mode_t` value.
+/// @return A string with the name of the mode.
+extern const char* get_correlation_mode_name(correlation_mode_t mode);
+
+/// @brief This function converts a correlation method into its name (for example `"OVERLAP_SAVE"`).
+/// @param method The `correlation_method_t` value.
+/// @return A string with the name of the method.
+extern const char* get_correlation_method_name(correlation_method_t method);
+
+#endif
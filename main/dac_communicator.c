@@ -1,6 +1,90 @@
 #include "dac_communicator.h"
 
-esp_err_t dac_output_values(size_t sample_frequency) {
+static const dac_channel_t dac_channels[DAC_NUMBER_OF_CHANNELS] = {DAC_CHANNEL_1, DAC_CHANNEL_2}; // The DAC channel of every index in the interleaved values.
+
+static bool find_dac_swap_index(size_t* staged_index) {
+    const uint8_t* active_values = dac_data.dac_values;
+    const uint8_t* staged_values = dac_data.dac_buffers[dac_data.active_buffer ^ 1];
+
+    size_t current_index = dac_data.current_index;
+    size_t staged_number_of_samples = dac_data.staged_number_of_samples;
+
+    // The staged values continue at the same position in their period, or start at their first value:
+    size_t staged_current_index = dac_data.keep_phase ? current_index * staged_number_of_samples / dac_data.number_of_samples : 0;
+
+    *staged_index = staged_current_index;
+
+    // Always swap at the end of the period (where the active values wrap around):
+    if (current_index == 0)
+        return true;
+
+    // A crossing is only found on a channel that is output before and after the swap (the first one, if both are):
+    dac_output_channels_t shared_channels = dac_data.output_channels & dac_data.staged_output_channels;
+
+    if (dac_data.swap_mode == DAC_SWAP_AT_PERIOD || shared_channels == 0)
+        return false;
+
+    size_t channel = (shared_channels & DAC_OUTPUT_CHANNEL_1) ? 0 : 1;
+    size_t previous_index = current_index - 1;
+    size_t staged_previous_index = dac_data.keep_phase ? previous_index * staged_number_of_samples / dac_data.number_of_samples : 0;
+
+    int previous_difference = (int)active_values[previous_index * DAC_NUMBER_OF_CHANNELS + channel] - (int)staged_values[staged_previous_index * DAC_NUMBER_OF_CHANNELS + channel];
+    int current_difference = (int)active_values[current_index * DAC_NUMBER_OF_CHANNELS + channel] - (int)staged_values[staged_current_index * DAC_NUMBER_OF_CHANNELS + channel];
+
+    // Swap where the active output crosses the staged output, so the output does not jump:
+    return current_difference == 0 || (previous_difference < 0) != (current_difference < 0);
+}
+
+esp_err_t design_dac_interpolator(void) {
+    if (dac_data.has_interpolation_taps)
+        return ESP_OK;
+
+    float prototype_taps[DAC_MAXIMUM_INTERPOLATION_FACTOR * DAC_TAPS_PER_PHASE]; // The taps of the prototype low-pass (the last one stays zero, because the number of taps must be odd).
+
+    for (size_t interpolation_factor = 1; interpolation_factor <= DAC_MAXIMUM_INTERPOLATION_FACTOR; interpolation_factor++) {
+        size_t number_of_taps = interpolation_factor * DAC_TAPS_PER_PHASE - 1;
+
+        memset(prototype_taps, 0, sizeof(prototype_taps));
+
+        // Design a low-pass at the Nyquist frequency of the samples, relative to the output frequency (which removes the images of the spectrum):
+        if (design_fir_filter_f32(prototype_taps, number_of_taps, LOW_PASS_FILTER, 0.0f, 0.5f / interpolation_factor) != ESP_OK)
+            return ESP_FAIL;
+
+        // Split the prototype into its phases, and scale them with the factor (only one in every `interpolation_factor` inputs is a sample, the others are zero):
+        for (size_t phase = 0; phase < interpolation_factor; phase++) {
+            for (size_t tap = 0; tap < DAC_TAPS_PER_PHASE; tap++) {
+                float scaled_tap = prototype_taps[tap * interpolation_factor + phase] * interpolation_factor * (1 << DAC_COEFFICIENT_SHIFT);
+
+                dac_data.interpolation_taps[interpolation_factor - 1][phase][tap] = (int16_t)lroundf(scaled_tap);
+            }
+        }
+    }
+
+    dac_data.has_interpolation_taps = true;
+
+    return ESP_OK;
+}
+
+uint8_t interpolate_dac_value(const uint8_t* dac_values, size_t number_of_samples, size_t current_index, size_t current_phase, size_t interpolation_factor, size_t channel) {
+    const int16_t* taps = dac_data.interpolation_taps[interpolation_factor - 1][current_phase];
+
+    int32_t accumulator = 1 << (DAC_COEFFICIENT_SHIFT - 1); // Round to the nearest value.
+    size_t index = current_index;
+
+    // Convolve the taps of the phase with the current sample and the samples before it:
+    for (size_t tap = 0; tap < DAC_TAPS_PER_PHASE; tap++) {
+        accumulator += taps[tap] * (int32_t)dac_values[index * DAC_NUMBER_OF_CHANNELS + channel];
+
+        index = (index == 0) ? number_of_samples - 1 : index - 1;
+    }
+
+    int32_t digital_value = accumulator >> DAC_COEFFICIENT_SHIFT;
+
+    // Clamp the overshoot of the low-pass to the range of the DAC:
+    return (uint8_t)((digital_value < 0) ? 0 : (digital_value > UINT8_MAX) ? UINT8_MAX : digital_value);
+}
+
+esp_err_t check_dac_output_config(size_t sample_frequency, size_t interpolation_factor) {
     // Check if the sample frequency is valid:
     if (sample_frequency == 0) {
         ESP_LOGE(DAC_COMMUNICATOR_TAG, "The sample frequency cannot be equal to zero, because then no signal can be output over the DAC!");
@@ -8,16 +92,101 @@ esp_err_t dac_output_values(size_t sample_frequency) {
         return ESP_FAIL;
     }
 
-    ESP_ERROR_CHECK(dac_output_enable(DAC_CHANNEL_1)); // Enable the output for the DAC.
+    // Check if the interpolation factor is supported:
+    if (interpolation_factor == 0 || interpolation_factor > DAC_MAXIMUM_INTERPOLATION_FACTOR) {
+        ESP_LOGE(DAC_COMMUNICATOR_TAG, "The interpolation factor must be between 1 and '%d'!", DAC_MAXIMUM_INTERPOLATION_FACTOR);
+
+        return ESP_FAIL;
+    }
+
+    // Check if the timer can run at the output frequency:
+    if (1000000 / (sample_frequency * interpolation_factor) < DAC_MINIMUM_PERIOD_US) {
+        ESP_LOGE(DAC_COMMUNICATOR_TAG, "The sample frequency of '%d' Hz with an interpolation factor of '%d' is too high for the timer of the DAC!", (int)sample_frequency, (int)interpolation_factor);
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dac_output_values(const uint8_t* dac_values, size_t number_of_samples, size_t sample_frequency, size_t interpolation_factor, dac_output_channels_t output_channels) {
+    // Check if the sample frequency and the interpolation factor are supported:
+    if (check_dac_output_config(sample_frequency, interpolation_factor) != ESP_OK)
+        return ESP_FAIL;
+
+    // Check if the values are valid, and fit in a buffer:
+    if (dac_values == NULL || number_of_samples == 0 || number_of_samples > DAC_MAXIMUM_SAMPLES) {
+        ESP_LOGE(DAC_COMMUNICATOR_TAG, "The value of '%s' could not be 'NULL', and must contain between 1 and '%d' values!", "dac_values", DAC_MAXIMUM_SAMPLES);
+
+        return ESP_FAIL;
+    }
+
+    // Check if at least one known channel is output:
+    if (output_channels == 0 || (output_channels & ~DAC_OUTPUT_BOTH_CHANNELS) != 0) {
+        ESP_LOGE(DAC_COMMUNICATOR_TAG, "The value of '%s' must select one or both DAC channels!", "output_channels");
+
+        return ESP_FAIL;
+    }
+
+    uint64_t period_us = 1000000 / (sample_frequency * interpolation_factor); // The period of the timer, in microseconds.
+
+    // Design the taps of the interpolator, before the timer can use them:
+    if (design_dac_interpolator() != ESP_OK)
+        return ESP_FAIL;
 
-    // Stop and reinitialize the current DAC timer if it exists:
+    // Stage the values for a swap by the timer, if it is already running:
     if (dac_data.timer != NULL) {
-        ESP_LOGI(DAC_COMMUNICATOR_TAG, "The current timer for sending the signal over the DAC will be stopped, and reinitialized!");
+        // Withdraw a previous swap that did not happen yet, so the inactive buffer can be overwritten:
+        portENTER_CRITICAL(&dac_data.lock);
+        dac_data.has_staged_values = false;
+        portEXIT_CRITICAL(&dac_data.lock);
+
+        memcpy(dac_data.dac_buffers[dac_data.active_buffer ^ 1], dac_values, number_of_samples * DAC_NUMBER_OF_CHANNELS * sizeof(uint8_t));
+
+        dac_output_channels_t added_channels = output_channels & ~dac_data.output_channels;                                        // The channels that are enabled before the swap (the timer only writes them after it).
+        dac_output_channels_t withdrawn_channels = dac_data.staged_output_channels & ~dac_data.output_channels & ~output_channels; // The channels that were added for the withdrawn swap, but are not output anymore.
+
+        // Enable the added channels, and disable the channels of the withdrawn swap (the timer disables a removed channel at the swap):
+        for (size_t channel = 0; channel < DAC_NUMBER_OF_CHANNELS; channel++) {
+            if (added_channels & (1 << channel))
+                ESP_ERROR_CHECK(dac_output_enable(dac_channels[channel]));
+            else if (withdrawn_channels & (1 << channel))
+                ESP_ERROR_CHECK(dac_output_disable(dac_channels[channel]));
+        }
 
-        ESP_ERROR_CHECK(esp_timer_stop(dac_data.timer));
-        ESP_ERROR_CHECK(esp_timer_delete(dac_data.timer));
+        portENTER_CRITICAL(&dac_data.lock);
+        dac_data.staged_number_of_samples = number_of_samples;
+        dac_data.staged_period_us = period_us;
+        dac_data.staged_interpolation_factor = interpolation_factor;
+        dac_data.staged_output_channels = output_channels;
+        dac_data.has_staged_values = true;
+        portEXIT_CRITICAL(&dac_data.lock);
+
+        record_trace_event(&trace_buffer, DAC_STAGE_TRACE, TRACE_LEVEL_INFO, (const int32_t[TRACE_EVENT_VALUES]){number_of_samples, period_us, output_channels}, NULL); // The values are swapped in by the running timer.
+
+        return ESP_OK;
+    }
+
+    // Fill the first buffer, and output it from the start:
+    memcpy(dac_data.dac_buffers[0], dac_values, number_of_samples * DAC_NUMBER_OF_CHANNELS * sizeof(uint8_t));
+
+    dac_data.active_buffer = 0;
+    dac_data.dac_values = dac_data.dac_buffers[0];
+    dac_data.number_of_samples = number_of_samples;
+    dac_data.current_index = 0;
+    dac_data.period_us = period_us;
+    dac_data.interpolation_factor = interpolation_factor;
+    dac_data.output_channels = output_channels;
+    dac_data.staged_output_channels = output_channels;
+    dac_data.current_phase = 0;
+    dac_data.has_staged_values = false;
+
+    // Enable the output of every selected channel:
+    for (size_t channel = 0; channel < DAC_NUMBER_OF_CHANNELS; channel++) {
+        if (output_channels & (1 << channel))
+            ESP_ERROR_CHECK(dac_output_enable(dac_channels[channel]));
     }
-    
+
     // Create the timer for DAC output:
     esp_timer_create_args_t timer_arguments = {
         .callback = &dac_timer_handler,
@@ -25,23 +194,96 @@ esp_err_t dac_output_values(size_t sample_frequency) {
     };
 
     ESP_ERROR_CHECK(esp_timer_create(&timer_arguments, &dac_data.timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(dac_data.timer, (1000 / sample_frequency) * 1000));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(dac_data.timer, period_us));
 
     return ESP_OK;
 }
 
-void dac_timer_handler(void*) {
-    static size_t current_index = 0;
+esp_err_t quantize_dac_values(const float* samples, uint8_t* dac_values, size_t number_of_samples, size_t channel, bool prevent_dac_overflow) {
+    // Check if `samples` and `dac_values` have a valid value:
+    if (samples == NULL || dac_values == NULL) {
+        ESP_LOGE(DAC_COMMUNICATOR_TAG, "The value of '%s' and '%s' could not be 'NULL'!", "samples", "dac_values");
+
+        return ESP_FAIL;
+    }
 
-    float analog_value = dac_data.digital_samples[current_index]; // Retrieve the current value of a digital sample.
+    // Check if the channel is one of the interleaved channels:
+    if (channel >= DAC_NUMBER_OF_CHANNELS) {
+        ESP_LOGE(DAC_COMMUNICATOR_TAG, "The channel '%d' is not a channel of the DAC!", (int)channel);
 
-    // Apply DAC overflow prevention (if it is enabled):
-    if (dac_data.prevent_dac_overflow_conversion) 
-        analog_value = fmaxf(ESP_VCC_MIN, fminf(analog_value, ESP_VCC_MAX)); 
+        return ESP_FAIL;
+    }
+
+    for (size_t i = 0; i < number_of_samples; i++) {
+        float analog_value = samples[i];
 
-    uint8_t digital_value = (analog_value * 255) / ESP_VCC_MAX;        // Convert the analog value to a digital value.
+        // Apply DAC overflow prevention (if it is enabled):
+        if (prevent_dac_overflow)
+            analog_value = fmaxf(ESP_VCC_MIN, fminf(analog_value, ESP_VCC_MAX));
 
-    ESP_ERROR_CHECK(dac_output_voltage(DAC_CHANNEL_1, digital_value)); // Output the digital value to the DAC.
+        dac_values[i * DAC_NUMBER_OF_CHANNELS + channel] = (uint8_t)(int32_t)((analog_value * 255) / ESP_VCC_MAX); // Convert the analog value to a digital value (out-of-range values wrap around).
+    }
 
-    current_index = (current_index + 1) % dac_data.number_of_samples;  // Update the current index to the next sample.
+    return ESP_OK;
 }
+
+void dac_timer_handler(void*) {
+    uint64_t new_period_us = 0;                 // The period of the timer after a swap, or zero if it does not change.
+    dac_output_channels_t removed_channels = 0; // The channels that are no longer output after a swap.
+
+    portENTER_CRITICAL(&dac_data.lock);
+
+    size_t staged_index = 0;
+
+    // Swap in the staged values of both channels together, at a crossing or at the end of the period (but never between two samples):
+    if (dac_data.has_staged_values && dac_data.current_phase == 0 && find_dac_swap_index(&staged_index)) {
+        removed_channels = dac_data.output_channels & ~dac_data.staged_output_channels;
+
+        dac_data.active_buffer ^= 1;
+        dac_data.dac_values = dac_data.dac_buffers[dac_data.active_buffer];
+        dac_data.number_of_samples = dac_data.staged_number_of_samples;
+        dac_data.current_index = staged_index;
+        dac_data.interpolation_factor = dac_data.staged_interpolation_factor;
+        dac_data.output_channels = dac_data.staged_output_channels;
+        dac_data.has_staged_values = false;
+
+        if (dac_data.staged_period_us != dac_data.period_us) {
+            dac_data.period_us = dac_data.staged_period_us;
+            new_period_us = dac_data.staged_period_us;
+        }
+    }
+
+    dac_output_channels_t output_channels = dac_data.output_channels;
+    uint8_t digital_values[DAC_NUMBER_OF_CHANNELS] = {};
+
+    // Retrieve the value of every channel at the same index (and phase), so the channels stay aligned:
+    for (size_t channel = 0; channel < DAC_NUMBER_OF_CHANNELS; channel++) {
+        if (!(output_channels & (1 << channel)))
+            continue;
+
+        if (dac_data.interpolation_factor > 1)
+            digital_values[channel] = interpolate_dac_value(dac_data.dac_values, dac_data.number_of_samples, dac_data.current_index, dac_data.current_phase, dac_data.interpolation_factor, channel); // Calculate the value between the current sample and the next one.
+        else
+            digital_values[channel] = dac_data.dac_values[dac_data.current_index * DAC_NUMBER_OF_CHANNELS + channel]; // Retrieve the current pre-quantized value.
+    }
+
+    // Move to the next sample, after the last phase (without the interpolator, every value is a sample):
+    if (++dac_data.current_phase >= dac_data.interpolation_factor) {
+        dac_data.current_phase = 0;
+        dac_data.current_index = (dac_data.current_index + 1) % dac_data.number_of_samples; // Update the current index to the next sample.
+    }
+
+    portEXIT_CRITICAL(&dac_data.lock);
+
+    // Output the digital values to the DAC, one channel directly after the other:
+    for (size_t channel = 0; channel < DAC_NUMBER_OF_CHANNELS; channel++) {
+        if (output_channels & (1 << channel))
+            ESP_ERROR_CHECK(dac_output_voltage(dac_channels[channel], digital_values[channel]));
+        else if (removed_channels & (1 << channel))
+            ESP_ERROR_CHECK(dac_output_disable(dac_channels[channel]));
+    }
+
+    // Change the period of the running timer, if the swapped values have another sample frequency:
+    if (new_period_us > 0)
+        ESP_ERROR_CHECK(esp_timer_restart(dac_data.timer, new_period_us));
+}
\ No newline at end of file
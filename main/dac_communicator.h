@@ -2,35 +2,117 @@
 #define DAC_COMMUNICATOR_H_
 
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
 
 #include "esp_timer.h"
 #include "esp_log.h"
 #include "driver/dac.h"
 
+#include "filter_transform.h"
+#include "trace_buffer.h"
+
 #define DAC_COMMUNICATOR_TAG ("DAC_COMMUNICATOR_H_")
 
 #define ESP_VCC_MIN (0.0f)
 #define ESP_VCC_MAX (3.3f)
 
+#define DAC_MAXIMUM_SAMPLES (2048)
+#define DAC_MINIMUM_PERIOD_US (50) // The shortest period of a periodic `esp_timer`.
+#define DAC_NUMBER_OF_CHANNELS (2) // The number of DAC channels, whose values are interleaved (so one tick of the timer updates them together).
+
+#define DAC_MAXIMUM_INTERPOLATION_FACTOR (8) // The highest number of output values per sample.
+#define DAC_TAPS_PER_PHASE (8)               // The number of taps of every phase of the polyphase interpolator (so the prototype low-pass has `factor * 8 - 1` taps).
+#define DAC_COEFFICIENT_SHIFT (14)           // The number of fractional bits of the fixed-point taps (the timer does not use floats, because the ESP32-S2 has no FPU).
+
+/// @brief This is an enumeration called `dac_swap_mode_t` with the moments at which staged DAC values replace the values that are being output.
+typedef enum dac_swap_mode {
+    DAC_SWAP_AT_CROSSING, // Swap as soon as the output crosses the level at which the staged values start (or at the end of the period, whichever comes first).
+    DAC_SWAP_AT_PERIOD    // Swap at the end of the period of the values that are being output.
+} dac_swap_mode_t;
+
+/// @brief This is an enumeration called `dac_output_channels_t` with the DAC channels that are output (a mask, with a bit per channel).
+typedef enum dac_output_channels {
+    DAC_OUTPUT_CHANNEL_1 = 0x01,    // Only output `DAC_CHANNEL_1`.
+    DAC_OUTPUT_CHANNEL_2 = 0x02,    // Only output `DAC_CHANNEL_2`.
+    DAC_OUTPUT_BOTH_CHANNELS = 0x03 // Output both channels, with their values updated on the same tick of the timer.
+} dac_output_channels_t;
+
 /// @brief Defining a struct called `dac_data`, that contains all the needed data for converting digital samples to analog values over de DAC.
 typedef struct dac_data {
-    float* digital_samples;   // This field is a pointer to an array of `float` values called `digital_samples`.
-    size_t number_of_samples; // This field is a `size_t` variable called `number_of_samples`.
+    uint8_t dac_buffers[2][DAC_MAXIMUM_SAMPLES * DAC_NUMBER_OF_CHANNELS]; // This field contains two buffers with interleaved pre-quantized values: the one that is being output, and the one that receives the staged values.
+    size_t active_buffer;                                                 // This field contains a `size_t` with the index of the buffer that is being output.
+
+    const uint8_t* dac_values;             // This field is a pointer to the interleaved pre-quantized `uint8_t` values that are being output as-is by the timer (see `quantize_dac_values`).
+    size_t number_of_samples;              // This field contains a `size_t` with the number of samples per channel.
+    size_t current_index;                  // This field contains a `size_t` with the index of the next sample that is output.
+    uint64_t period_us;                    // This field contains an `uint64_t` with the period of the timer (in microseconds).
+    dac_output_channels_t output_channels; // This field contains the `dac_output_channels_t` with the channels that are being output.
+
+    size_t interpolation_factor; // This field contains a `size_t` with the number of values that are output per sample (one disables the interpolator).
+    size_t current_phase;        // This field contains a `size_t` with the phase of the interpolator, that is the position of the next value between two samples.
+
+    bool has_staged_values;             // This field contains a `bool`, indicating if the inactive buffer holds values that wait for a swap.
+    size_t staged_number_of_samples;    // This field contains a `size_t` with the number of staged values.
+    uint64_t staged_period_us;          // This field contains an `uint64_t` with the period of the timer for the staged values (in microseconds).
+    size_t staged_interpolation_factor; // This field contains a `size_t` with the interpolation factor for the staged values.
 
-    bool prevent_dac_overflow_conversion; // This field contains a `bool` variable for preventing overflows when converting digital samples to analog values for output over the DAC.
+    dac_output_channels_t staged_output_channels; // This field contains the `dac_output_channels_t` with the channels that are output after the swap.
+
+    dac_swap_mode_t swap_mode; // This field contains the `dac_swap_mode_t` that is used for the next swap.
+    bool keep_phase;           // This field contains a `bool`, indicating if the staged values continue at the same position in their period (instead of at their start).
+
+    int16_t interpolation_taps[DAC_MAXIMUM_INTERPOLATION_FACTOR][DAC_MAXIMUM_INTERPOLATION_FACTOR][DAC_TAPS_PER_PHASE]; // This field contains the fixed-point taps of every phase, for every interpolation factor (index `factor - 1`).
+    bool has_interpolation_taps;                                                                                         // This field contains a `bool`, indicating if the taps above are designed.
 
     esp_timer_handle_t timer; // This field is an `esp_timer_handle_t` variable called `timer`.
+    portMUX_TYPE lock;        // This field contains a `portMUX_TYPE` spinlock, that guards the swap between the request handlers and the timer.
 } dac_data_t;
 
 /// @brief The declaration of an external variable `dac_data`, which means that this variable is defined in another source file (in this case 'main.c').
 extern dac_data_t dac_data;
 
-/// @brief This function enables the DAC output and sets up a timer to send a signal over the DAC at a specified sample frequency.
+/// @brief This function checks if the DAC can output samples at a sample frequency, with an interpolation factor (without changing the output).
+/// @param sample_frequency The frequency at which the signal would be output over the DAC (in Hz).
+/// @param interpolation_factor The number of values that would be output per sample.
+/// @return An `esp_err_t` type, which is either `ESP_OK` if the DAC supports the configuration or `ESP_FAIL` if it does not.
+extern esp_err_t check_dac_output_config(size_t sample_frequency, size_t interpolation_factor);
+
+/// @brief This function outputs pre-quantized values over one or both DAC channels at a specified sample frequency. A single timer outputs the values of both channels on the same tick, so they stay sample-aligned. The first call enables the channels and starts the timer. Later calls stage the values, the sample frequency and the channels, which the timer swaps in together at the next crossing or period boundary (see `dac_swap_mode_t`), without stopping the timer.
+/// @param dac_values A pointer to the pre-quantized values, interleaved per sample (`DAC_NUMBER_OF_CHANNELS` values, starting with `DAC_CHANNEL_1`), which are copied (so the caller may change them afterwards). The values of a channel that is not output are ignored.
+/// @param number_of_samples The number of samples per channel (at most `DAC_MAXIMUM_SAMPLES`).
 /// @param sample_frequency The frequency at which the signal will be output over the DAC (in Hz).
+/// @param interpolation_factor The number of values that are output per sample (at most `DAC_MAXIMUM_INTERPOLATION_FACTOR`), which are interpolated by the timer with a polyphase low-pass filter. The timer runs at `sample_frequency * interpolation_factor`.
+/// @param output_channels The `dac_output_channels_t` with the channels that are output.
+/// @return An `esp_err_t` type, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t dac_output_values(const uint8_t* dac_values, size_t number_of_samples, size_t sample_frequency, size_t interpolation_factor, dac_output_channels_t output_channels);
+
+/// @brief This function designs the fixed-point taps of the polyphase interpolator for every interpolation factor (only once), from a windowed-sinc low-pass with its cutoff at the Nyquist frequency of the samples.
+/// @return An `esp_err_t` type, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t design_dac_interpolator(void);
+
+/// @brief This function calculates a single interpolated value of a channel, from the taps of a phase and the samples before the current one (the values are periodic, so the samples wrap around).
+/// @param dac_values A pointer to the interleaved pre-quantized values.
+/// @param number_of_samples The number of samples per channel.
+/// @param current_index The index of the current sample.
+/// @param current_phase The position of the value between the current sample and the next one (below `interpolation_factor`).
+/// @param interpolation_factor The number of values per sample.
+/// @param channel The index of the channel in the interleaved values (zero for `DAC_CHANNEL_1`).
+/// @return The interpolated value, clamped to the range of the DAC.
+extern uint8_t interpolate_dac_value(const uint8_t* dac_values, size_t number_of_samples, size_t current_index, size_t current_phase, size_t interpolation_factor, size_t channel);
+
+/// @brief This function converts analog values (in volts) into the digital values of a DAC channel once, so that the timer only has to output them.
+/// @param samples A pointer to the analog values that will be converted.
+/// @param dac_values A pointer to an array of `number_of_samples * DAC_NUMBER_OF_CHANNELS` interleaved `uint8_t` values, of which the values of the channel will be stored (the values of the other channel are kept).
+/// @param number_of_samples The number of values to convert.
+/// @param channel The index of the channel in the interleaved values (zero for `DAC_CHANNEL_1`).
+/// @param prevent_dac_overflow A `bool` indicating if the analog values are clamped to the range of the DAC (otherwise out-of-range values wrap around).
 /// @return An `esp_err_t` type, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
-extern esp_err_t dac_output_values(size_t sample_frequency);
+extern esp_err_t quantize_dac_values(const float* samples, uint8_t* dac_values, size_t number_of_samples, size_t channel, bool prevent_dac_overflow);
 
-/// @brief This function handles the DAC timer and outputs a digital value based on the analog value from the DAC data.
+/// @brief This function handles the DAC timer and outputs the next pre-quantized digital value of every enabled channel from the DAC data (or the next interpolated value between two of them).
 /// @param _ The function `dac_timer_handler` takes a `void*` parameter, which is not used in the function. The function uses the following variables:
 void dac_timer_handler(void*);
 
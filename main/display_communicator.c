@@ -1,11 +1,33 @@
 #include "display_communicator.h"
 
+static SemaphoreHandle_t display_lock = NULL; // Serializes the drawing of the views, so one view never draws into another.
+
+static esp_err_t take_display_lock(void) {
+    // Check if the display is initialized:
+    if (display_lock == NULL) {
+        ESP_LOGE(DISPLAY_COMMUNICATOR_TAG, "The OLED display is not initialized yet, call 'initialize_oled' first!");
+
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(display_lock, portMAX_DELAY);
+
+    return ESP_OK;
+}
+
 void initialize_oled(size_t screen_width, size_t screen_height) {
+    if (display_lock == NULL)
+        display_lock = xSemaphoreCreateMutex(); // Create the lock once, before any task draws a view.
+
     i2c_master_init(&oled_display, CONFIG_SDA_GPIO, CONFIG_SCL_GPIO, CONFIG_RESET_GPIO); // Initialize the 'I2C' master with the specified 'GPIO' pins.
     ssd1306_init(&oled_display, screen_width, screen_height);                            // Initialize the SSD1306 OLED display with the specified screen dimensions.
 
     ssd1306_clear_screen(&oled_display, false); // Clear the screen of the OLED display.
     ssd1306_contrast(&oled_display, 0xFF);      // Set the contrast of the OLED display to the maximum value (that is '0xFF').
+
+    // Check if the lock could be created (the views fail without it):
+    if (display_lock == NULL)
+        ESP_LOGE(DISPLAY_COMMUNICATOR_TAG, "The lock of the OLED display could not be created!");
 }
 
 esp_err_t oled_view_startup(char* header_line, char* version_line) {
@@ -16,11 +38,16 @@ esp_err_t oled_view_startup(char* header_line, char* version_line) {
         return ESP_FAIL;
     }
     
+    if (take_display_lock() != ESP_OK)
+        return ESP_FAIL;
+
     ssd1306_clear_screen(&oled_display, false); // Clear the screen of the OLED display.
 
     ssd1306_display_text(&oled_display, 3, header_line, strlen(header_line), false);   // Display the header line at the specified position (line three) on the OLED display.
     ssd1306_display_text(&oled_display, 7, version_line, strlen(version_line), false); // Display the version line at the specified position (line seven) on the OLED display.
 
+    xSemaphoreGive(display_lock);
+
     return ESP_OK;
 }
 
@@ -32,6 +59,9 @@ esp_err_t oled_view_info(char* message_line) {
         return ESP_FAIL;
     }
 
+    if (take_display_lock() != ESP_OK)
+        return ESP_FAIL;
+
     ssd1306_clear_screen(&oled_display, false); // Clear the screen of the OLED display.
 
     char* info_message_header = " INFO"; // Define the header for the info message.
@@ -40,6 +70,8 @@ esp_err_t oled_view_info(char* message_line) {
     ssd1306_line(&oled_display, 0, ssd1306_get_height(&oled_display) - 35, ssd1306_get_width(&oled_display), ssd1306_get_height(&oled_display) - 35, false); // Draw a horizontal line below the info message header.
     ssd1306_display_text_cursor(&oled_display, ssd1306_get_height(&oled_display) - 15, 0, message_line, strlen(message_line), false);                        // Display the message line at the bottom of the OLED display.
 
+    xSemaphoreGive(display_lock);
+
     return ESP_OK;
 }
 
@@ -51,6 +83,9 @@ esp_err_t oled_view_error(char* message_line) {
         return ESP_FAIL;
     }
 
+    if (take_display_lock() != ESP_OK)
+        return ESP_FAIL;
+
     ssd1306_clear_screen(&oled_display, false); // Clear the screen of the OLED display.
 
     char* error_message_header = "ERROR"; // Define the header for the error message.
@@ -59,17 +94,29 @@ esp_err_t oled_view_error(char* message_line) {
     ssd1306_line(&oled_display, 0, ssd1306_get_height(&oled_display) - 35, ssd1306_get_width(&oled_display), ssd1306_get_height(&oled_display) - 35, false); // Draw a horizontal line below the error message header.
     ssd1306_display_text_cursor(&oled_display, ssd1306_get_height(&oled_display) - 15, 0, message_line, strlen(message_line), false);                        // Display the message line at the bottom of the OLED display.
 
+    xSemaphoreGive(display_lock);
+
     return ESP_OK;
 }
 
+static void format_frequency_label(size_t frequency, char* label, size_t label_length) {
+    // Shorten the frequency into kHz (with a single decimal below 10 kHz, and at most 999 kHz), so it fits into the few pixels of the label:
+    if (frequency < KILOHERTZ_LABEL_FREQUENCY)
+        snprintf(label, label_length, "%u", (unsigned int)frequency);
+    else if (frequency < 10 * KILOHERTZ_LABEL_FREQUENCY)
+        snprintf(label, label_length, "%u.%uk", (unsigned int)(frequency / KILOHERTZ_LABEL_FREQUENCY), (unsigned int)((frequency % KILOHERTZ_LABEL_FREQUENCY) / 100));
+    else
+        snprintf(label, label_length, "%uk", (unsigned int)((frequency < 1000 * KILOHERTZ_LABEL_FREQUENCY) ? frequency / KILOHERTZ_LABEL_FREQUENCY : 999));
+}
+
 esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t sample_data_length, size_t sample_frequency, float y_min_magnitude_scale, float y_max_magnitude_scale) {
-    // Check if the sample frequency exceeds the maximum allowed value:
-    if (sample_frequency > MAXIMUM_SAMPLE_FREQUENCY) {
-        ESP_LOGE(DISPLAY_COMMUNICATOR_TAG, "The sample frequency (with value '%d' Hz) could not be greater than '%d' Hz due to limited pixels on the OLED!", sample_frequency, MAXIMUM_SAMPLE_FREQUENCY);
+    // Check if `fft_data` has a valid value:
+    if (fft_data == NULL || fft_data_length == 0) {
+        ESP_LOGE(DISPLAY_COMMUNICATOR_TAG, "The value of '%s' could not be 'NULL' or empty!", "fft_data");
 
         return ESP_FAIL;
     }
-    
+
     // Get the screen width and height of the OLED display:
     int screen_width = ssd1306_get_width(&oled_display);
     int screen_height = ssd1306_get_height(&oled_display);
@@ -82,6 +129,22 @@ esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t samp
     float x_step = (float)actual_fft_width / (float)fft_data_length;
     float y_step = (float)(actual_fft_height - 1) / (y_max_magnitude_scale - y_min_magnitude_scale);
 
+    // Allocate memory for `view_data`:
+    uint8_t* view_data = calloc(screen_width * screen_height, sizeof(uint8_t));
+    float* view_data_minimum = calloc(screen_width, sizeof(float));
+    float* view_data_maximum = calloc(screen_width, sizeof(float));
+
+    // Check if memory allocation was successful, and draw the whole view at once:
+    if (view_data == NULL || view_data_minimum == NULL || view_data_maximum == NULL || take_display_lock() != ESP_OK) {
+        ESP_LOGE(DISPLAY_COMMUNICATOR_TAG, "The spectrum view could not be drawn!");
+
+        free(view_data);
+        free(view_data_minimum);
+        free(view_data_maximum);
+
+        return ESP_FAIL;
+    }
+
     ssd1306_clear_screen(&oled_display, false); // Clear the screen of the OLED display.
 
     // Calculate the x-coordinate values for displaying frequency information:
@@ -95,10 +158,10 @@ esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t samp
     char x_mid_buffer[UNIT_BUFFER_LENGTH] = {};
     char x_max_buffer[UNIT_BUFFER_LENGTH] = {};
 
-    int x_max_frequency_scale = ((sample_data_length * sample_frequency) / sample_data_length) / 2;
+    size_t x_max_frequency_scale = sample_frequency / 2; // The Nyquist frequency.
 
-    itoa(x_max_frequency_scale / 2, x_mid_buffer, 10);
-    itoa(x_max_frequency_scale, x_max_buffer, 10);
+    format_frequency_label(x_max_frequency_scale / 2, x_mid_buffer, sizeof(x_mid_buffer) / sizeof(x_mid_buffer[0]));
+    format_frequency_label(x_max_frequency_scale, x_max_buffer, sizeof(x_max_buffer) / sizeof(x_max_buffer[0]));
 
     size_t x_mid_buffer_length = strlen(x_mid_buffer);
     size_t x_max_buffer_length = strlen(x_max_buffer);
@@ -133,11 +196,6 @@ esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t samp
     ssd1306_display_text_cursor(&oled_display, y_min, 0, y_min_buffer, y_min_buffer_length, false);
     ssd1306_display_text_cursor(&oled_display, y_mid, 0, y_mid_buffer, y_mid_buffer_length, false);
     ssd1306_display_text_cursor(&oled_display, y_max, 0, y_max_buffer, y_max_buffer_length, false);
-    
-    // Allocate memory for `view_data`:
-    uint8_t* view_data = calloc(screen_width * screen_height, sizeof(uint8_t));
-    float* view_data_minimum = calloc(screen_width, sizeof(float));
-    float* view_data_maximum = calloc(screen_width, sizeof(float));
 
     // Initialize the `view_data` arrays with minimum and maximum values:
     for (int i = 0; i < screen_width; i++) {
@@ -198,6 +256,8 @@ esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t samp
         }
     }
 
+    xSemaphoreGive(display_lock);
+
     // Free the allocated memory for the `view_data`:
     free(view_data);
     free(view_data_minimum);
@@ -2,10 +2,14 @@
 #define DISPLAY_COMMUNICATOR_H_
 
 #include <float.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "esp_log.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
 #include "ssd1306.h"
 
 #define DISPLAY_COMMUNICATOR_TAG ("DISPLAY_COMMUNICATOR_H_")
@@ -16,12 +20,12 @@
 #define FFT_SCREEN_WIDTH (20)
 #define FFT_SCREEN_HEIGHT (20)
 
-#define MAXIMUM_SAMPLE_FREQUENCY (1000)
+#define KILOHERTZ_LABEL_FREQUENCY (1000) // The frequency from which the labels of the frequency axis are shown in kHz (so they fit into `UNIT_BUFFER_LENGTH`).
 
 /// @brief The declaration of an external variable `oled_display`, which means that this variable is defined in another source file (in this case 'main.c').
 extern SSD1306_t oled_display;
 
-/// @brief This function initializes an OLED display with a given screen width and height.
+/// @brief This function initializes an OLED display with a given screen width and height, and the lock that makes every view draw the whole screen at once (the views are drawn from the FFT worker, the HTTP handlers and the event loop). It must be called before any of the views.
 /// @param screen_width The width of the OLED display screen in pixels.
 /// @param screen_height The height of the OLED display screen in pixels.
 extern void initialize_oled(size_t screen_width, size_t screen_height);
@@ -42,7 +46,7 @@ extern esp_err_t oled_view_info(char* message_line);
 /// @return An `esp_err_t` type, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
 extern esp_err_t oled_view_error(char* message_line);
 
-/// @brief This function displays FFT data on an OLED screen with customizable scales.
+/// @brief This function displays FFT data on an OLED screen with customizable scales. Any sample frequency can be displayed, the labels of the frequency axis switch to kHz from `KILOHERTZ_LABEL_FREQUENCY` on.
 /// @param fft_data An array with `float` values representing the FFT data to be displayed on the OLED screen.
 /// @param fft_data_length The length of the FFT data array.
 /// @param sample_data_length The length of the sample data used to generate the FFT data.
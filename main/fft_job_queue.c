@@ -0,0 +1,276 @@
+#include "fft_job_queue.h"
+
+static void release_sample_buffer(fft_job_queue_t* job_queue, float* samples) {
+    // Mark the buffer as free, so it can be used by a new job (the lock must be held):
+    for (size_t i = 0; i < MAXIMUM_PENDING_FFT_JOBS; i++) {
+        if (job_queue->sample_buffers[i] == samples)
+            job_queue->sample_buffer_is_used[i] = false;
+    }
+}
+
+static bool fft_job_is_finished(const fft_job_t* job) {
+    return job->status == DONE_FFT_JOB || job->status == FAILED_FFT_JOB;
+}
+
+static fft_job_t* find_fft_job(fft_job_queue_t* job_queue, uint32_t job_id) {
+    // Search the slot of the job (the lock must be held):
+    for (size_t i = 0; i < MAXIMUM_FFT_JOBS; i++) {
+        if (job_queue->jobs[i].status != FREE_FFT_JOB && job_queue->jobs[i].job_id == job_id)
+            return &job_queue->jobs[i];
+    }
+
+    return NULL;
+}
+
+static void fft_job_task(void* argument) {
+    fft_job_queue_t* job_queue = argument;
+
+    while (true) {
+        size_t slot = 0;
+
+        // Wait for the next queued job:
+        if (xQueueReceive(job_queue->queue, &slot, portMAX_DELAY) != pdTRUE)
+            continue;
+
+        xSemaphoreTake(job_queue->lock, portMAX_DELAY);
+
+        fft_job_t* job = &job_queue->jobs[slot];
+
+        job->status = RUNNING_FFT_JOB;
+
+        // Copy the job, so the spectrum is computed without holding the lock (a running job is never evicted, so its samples stay valid):
+        uint32_t job_id = job->job_id;
+        float* samples = job->samples;
+        window_config_t window = job->window;
+        size_t sample_frequency = job->sample_frequency;
+        bool captures_samples = job->captures_samples;
+
+        fft_data_t fft_data = {
+            .peak_config = job->result.peak_config,
+            .averaging_config = job->result.averaging_config
+        };
+
+        xSemaphoreGive(job_queue->lock);
+
+        esp_err_t succeeded_job = ESP_OK;
+
+        // Capture the samples first, if the job has none (a failed capture fails the job):
+        if (captures_samples)
+            succeeded_job = job_queue->capture(samples, job_queue->sample_length);
+
+        if (succeeded_job == ESP_OK)
+            succeeded_job = initialize_fft_f32(&fft_data);
+
+        if (succeeded_job == ESP_OK) {
+            succeeded_job = apply_fft_f32(&fft_data, samples, window, job_queue->sample_length, sample_frequency); // Compute the spectrum, find its peaks and show it on the OLED.
+
+            // Fail the job as well when the FFT could not be released:
+            if (de_initialize_fft_f32(&fft_data) != ESP_OK)
+                succeeded_job = ESP_FAIL;
+        }
+
+        xSemaphoreTake(job_queue->lock, portMAX_DELAY);
+
+        release_sample_buffer(job_queue, samples);
+
+        job->samples = NULL;
+        job->result = fft_data;
+        job->status = succeeded_job == ESP_OK ? DONE_FFT_JOB : FAILED_FFT_JOB;
+        job->finished_time_us = esp_timer_get_time();
+
+        int64_t job_duration_us = job->finished_time_us - job->queued_time_us;
+
+        xSemaphoreGive(job_queue->lock);
+
+        record_trace_event(&trace_buffer, FFT_JOB_TRACE, TRACE_LEVEL_INFO, (const int32_t[TRACE_EVENT_VALUES]){job_id, succeeded_job == ESP_OK ? DONE_FFT_JOB : FAILED_FFT_JOB, job_duration_us}, NULL);
+    }
+}
+
+esp_err_t start_fft_job_queue(fft_job_queue_t* job_queue, size_t sample_length, fft_capture_t capture) {
+    // Check if `job_queue` has a valid value:
+    if (job_queue == NULL) {
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "The value of '%s' could not be 'NULL'!", "job_queue");
+
+        return ESP_FAIL;
+    }
+
+    job_queue->sample_length = sample_length;
+    job_queue->capture = capture;
+    job_queue->next_job_id = 1;
+
+    // Allocate a buffer for the samples of every pending job once, so queueing a job does not allocate memory:
+    for (size_t i = 0; i < MAXIMUM_PENDING_FFT_JOBS; i++) {
+        job_queue->sample_buffers[i] = malloc(sample_length * sizeof(float));
+
+        if (job_queue->sample_buffers[i] == NULL) {
+            ESP_LOGE(FFT_JOB_QUEUE_TAG, "The value of '%s' could not be 'NULL'!", "sample_buffers");
+
+            return ESP_FAIL;
+        }
+    }
+
+    job_queue->lock = xSemaphoreCreateMutex();                                 // Create the mutex that guards the slots and the buffers.
+    job_queue->queue = xQueueCreate(MAXIMUM_PENDING_FFT_JOBS, sizeof(size_t)); // Create the queue with the slots of the queued jobs (it can hold every pending job).
+
+    // Check if the mutex and the queue could be created:
+    if (job_queue->lock == NULL || job_queue->queue == NULL) {
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "lock", "queue");
+
+        return ESP_FAIL;
+    }
+
+    // Start the worker that drains the queue:
+    if (xTaskCreate(fft_job_task, "fft_job_queue", FFT_JOB_TASK_STACK_SIZE, job_queue, FFT_JOB_TASK_PRIORITY, &job_queue->task) != pdPASS) {
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "The worker of the FFT jobs could not be created!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t submit_fft_job(fft_job_queue_t* job_queue, const float* samples, window_config_t window, size_t sample_frequency, peak_config_t peak_config, averaging_config_t averaging_config, uint32_t* job_id) {
+    // Check if `job_queue` and `job_id` have a valid value:
+    if (job_queue == NULL || job_id == NULL) {
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "job_queue", "job_id");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the samples can be captured, when there are none:
+    if (samples == NULL && job_queue->capture == NULL) {
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "The value of '%s' could not be 'NULL', without a function that captures the samples!", "samples");
+
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(job_queue->lock, portMAX_DELAY);
+
+    float* job_samples = NULL;
+
+    // Claim a free buffer for the copy of the samples:
+    for (size_t i = 0; i < MAXIMUM_PENDING_FFT_JOBS && job_samples == NULL; i++) {
+        if (!job_queue->sample_buffer_is_used[i]) {
+            job_queue->sample_buffer_is_used[i] = true;
+            job_samples = job_queue->sample_buffers[i];
+        }
+    }
+
+    // Check if a buffer is free (otherwise too many jobs are pending):
+    if (job_samples == NULL) {
+        xSemaphoreGive(job_queue->lock);
+
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "There are already '%d' pending FFT jobs!", MAXIMUM_PENDING_FFT_JOBS);
+
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t slot = 0;
+
+    // Select a free slot, or else evict the job that finished first (there are more slots than pending jobs, so a finished job always exists):
+    for (size_t i = 0; i < MAXIMUM_FFT_JOBS; i++) {
+        if (job_queue->jobs[i].status == FREE_FFT_JOB) {
+            slot = i;
+
+            break;
+        }
+
+        if (fft_job_is_finished(&job_queue->jobs[i]) && (!fft_job_is_finished(&job_queue->jobs[slot]) || job_queue->jobs[i].finished_time_us < job_queue->jobs[slot].finished_time_us))
+            slot = i;
+    }
+
+    fft_job_t* job = &job_queue->jobs[slot];
+
+    // Copy the samples, so they can be changed by the next request while the job is pending:
+    if (samples != NULL)
+        memcpy(job_samples, samples, job_queue->sample_length * sizeof(float));
+
+    *job = (fft_job_t){
+        .job_id = job_queue->next_job_id,
+        .status = QUEUED_FFT_JOB,
+        .window = window,
+        .sample_frequency = sample_frequency,
+        .samples = job_samples,
+        .captures_samples = samples == NULL,
+        .result = {
+            .peak_config = peak_config,
+            .averaging_config = averaging_config
+        },
+        .queued_time_us = esp_timer_get_time()
+    };
+
+    // Skip the ID zero when the IDs wrap around:
+    if (++job_queue->next_job_id == 0)
+        job_queue->next_job_id = 1;
+
+    *job_id = job->job_id;
+
+    xSemaphoreGive(job_queue->lock);
+
+    // Hand the slot to the worker (the queue can hold every pending job, so it never blocks):
+    xQueueSend(job_queue->queue, &slot, portMAX_DELAY);
+
+    return ESP_OK;
+}
+
+esp_err_t get_fft_job(fft_job_queue_t* job_queue, uint32_t job_id, fft_job_t* job) {
+    // Check if `job_queue` and `job` have a valid value:
+    if (job_queue == NULL || job == NULL) {
+        ESP_LOGE(FFT_JOB_QUEUE_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "job_queue", "job");
+
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(job_queue->lock, portMAX_DELAY);
+
+    fft_job_t* found_job = find_fft_job(job_queue, job_id);
+
+    if (found_job != NULL) {
+        *job = *found_job;
+
+        job->samples = NULL; // The copy of the samples belongs to the worker.
+    }
+
+    xSemaphoreGive(job_queue->lock);
+
+    return found_job != NULL ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t wait_fft_job(fft_job_queue_t* job_queue, uint32_t job_id, uint32_t timeout_ms, fft_job_t* job) {
+    int64_t deadline_us = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+
+    // Poll the job until it is finished, or the deadline is passed:
+    while (true) {
+        esp_err_t succeeded_lookup = get_fft_job(job_queue, job_id, job);
+
+        if (succeeded_lookup != ESP_OK)
+            return succeeded_lookup;
+
+        if (fft_job_is_finished(job))
+            return ESP_OK;
+
+        if (esp_timer_get_time() >= deadline_us)
+            return ESP_ERR_TIMEOUT;
+
+        vTaskDelay(pdMS_TO_TICKS(FFT_JOB_POLL_DELAY_MS));
+    }
+}
+
+const char* get_fft_job_status_name(fft_job_status_t status) {
+    switch (status) {
+        case QUEUED_FFT_JOB:
+            return "QUEUED";
+
+        case RUNNING_FFT_JOB:
+            return "RUNNING";
+
+        case DONE_FFT_JOB:
+            return "DONE";
+
+        case FAILED_FFT_JOB:
+            return "FAILED";
+
+        default:
+            return "UNKNOWN";
+    }
+}
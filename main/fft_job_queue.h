@@ -0,0 +1,110 @@
+#ifndef FFT_JOB_QUEUE_H_
+#define FFT_JOB_QUEUE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "fft_transform.h"
+
+#define FFT_JOB_QUEUE_TAG ("FFT_JOB_QUEUE_H_")
+
+#define MAXIMUM_FFT_JOBS (8)         // The number of jobs in the result store (the oldest finished job is evicted by a new job).
+#define MAXIMUM_PENDING_FFT_JOBS (2) // The number of jobs that can wait for the worker at the same time (each one holds a copy of the samples).
+
+#define FFT_JOB_TASK_STACK_SIZE (6144)
+#define FFT_JOB_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
+#define FFT_JOB_POLL_DELAY_MS (10)
+
+/// @brief This is a function type called `fft_capture_t`, that captures new samples for a job on the worker (so a slow live source does not hold the request). It returns `ESP_OK`, or an error that fails the job.
+typedef esp_err_t (*fft_capture_t)(float* samples, size_t sample_length);
+
+/// @brief This is an enumeration called `fft_job_status_t` with the states of a job in the result store.
+typedef enum fft_job_status {
+    FREE_FFT_JOB,    // The slot does not contain a job.
+    QUEUED_FFT_JOB,  // The job waits for the worker.
+    RUNNING_FFT_JOB, // The worker is computing the spectrum of the job.
+    DONE_FFT_JOB,    // The peaks of the job are found.
+    FAILED_FFT_JOB   // The spectrum of the job could not be computed.
+} fft_job_status_t;
+
+/// @brief Defining a struct called `fft_job`, that contains a single FFT job, from the moment it is queued until it is evicted from the result store.
+typedef struct fft_job {
+    uint32_t job_id;         // This field contains an `uint32_t` with the ID of the job (never zero).
+    fft_job_status_t status; // This field contains the `fft_job_status_t` of the job.
+
+    window_config_t window;  // This field contains the `window_config_t` window that is applied before the FFT.
+    size_t sample_frequency; // This field contains a `size_t` with the sample frequency of the samples.
+    float* samples;          // This field is a pointer to the copy of the samples, while the job is queued or running (otherwise it is `NULL`).
+    bool captures_samples;   // This field contains a `bool`, indicating if the worker captures the samples with the `fft_capture_t` of the queue, instead of using a copy.
+
+    fft_data_t result; // This field contains the `fft_data_t` with the requested peak and averaging settings, and the found peaks once the job is done.
+
+    int64_t queued_time_us;   // This field contains an `int64_t` with the time at which the job was queued (in microseconds).
+    int64_t finished_time_us; // This field contains an `int64_t` with the time at which the job was finished (in microseconds).
+} fft_job_t;
+
+/// @brief Defining a struct called `fft_job_queue`, that contains the queued jobs, the result store and the worker that drains the queue.
+typedef struct fft_job_queue {
+    fft_job_t jobs[MAXIMUM_FFT_JOBS]; // This field contains an array with the slots of the result store.
+    uint32_t next_job_id;             // This field contains an `uint32_t` with the ID of the next job.
+
+    size_t sample_length;                                 // This field contains a `size_t` with the number of samples of every job.
+    fft_capture_t capture;                                // This field contains the `fft_capture_t` function that captures the samples of a job without samples, or `NULL`.
+    float* sample_buffers[MAXIMUM_PENDING_FFT_JOBS];      // This field contains an array of buffers, that hold the copies of the samples of the pending jobs.
+    bool sample_buffer_is_used[MAXIMUM_PENDING_FFT_JOBS]; // This field contains an array of `bool`, indicating if a buffer belongs to a pending job.
+
+    QueueHandle_t queue;    // This field contains a `QueueHandle_t` with the indices of the slots of the queued jobs.
+    SemaphoreHandle_t lock; // This field contains a `SemaphoreHandle_t` mutex, that guards the slots and the buffers.
+    TaskHandle_t task;      // This field contains the `TaskHandle_t` of the worker.
+} fft_job_queue_t;
+
+/// @brief The declaration of an external variable `fft_job_queue`, which means that this variable is defined in another source file (in this case 'main.c').
+extern fft_job_queue_t fft_job_queue;
+
+/// @brief This function allocates the buffers of the pending jobs, and starts the worker that drains the queue.
+/// @param job_queue A pointer to the `fft_job_queue_t` structure.
+/// @param sample_length The number of samples of every job.
+/// @param capture The function that captures the samples of a job that is submitted without samples (or `NULL` if every job has samples).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t start_fft_job_queue(fft_job_queue_t* job_queue, size_t sample_length, fft_capture_t capture);
+
+/// @brief This function copies the samples into a new job and queues it for the worker. The samples may be changed as soon as the function returns.
+/// @param job_queue A pointer to the `fft_job_queue_t` structure.
+/// @param samples A pointer to the `sample_length` samples of the job, or `NULL` to let the worker capture them (a failed capture fails the job).
+/// @param window The window that is applied before the FFT.
+/// @param sample_frequency The sample frequency of the samples (in Hz).
+/// @param peak_config The settings for extracting the peaks of the spectrum.
+/// @param averaging_config The settings for accumulating the spectrum with the spectra of the previous jobs.
+/// @param job_id A pointer where the ID of the new job will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully, `ESP_ERR_NO_MEM` if too many jobs are pending, or `ESP_FAIL` if there is an error.
+extern esp_err_t submit_fft_job(fft_job_queue_t* job_queue, const float* samples, window_config_t window, size_t sample_frequency, peak_config_t peak_config, averaging_config_t averaging_config, uint32_t* job_id);
+
+/// @brief This function copies a job out of the result store, so its status and peaks can be read without holding the lock.
+/// @param job_queue A pointer to the `fft_job_queue_t` structure.
+/// @param job_id The ID of the job.
+/// @param job A pointer to a `fft_job_t` structure where the job will be stored (its `samples` field is always `NULL`).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_ERR_NOT_FOUND` if the job is unknown (or already evicted).
+extern esp_err_t get_fft_job(fft_job_queue_t* job_queue, uint32_t job_id, fft_job_t* job);
+
+/// @brief This function waits until a job is done or failed, and copies it out of the result store.
+/// @param job_queue A pointer to the `fft_job_queue_t` structure.
+/// @param job_id The ID of the job.
+/// @param timeout_ms The maximum time to wait (in milliseconds).
+/// @param job A pointer to a `fft_job_t` structure where the job will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the job is finished, `ESP_ERR_TIMEOUT` if it is still pending, or `ESP_ERR_NOT_FOUND` if the job is unknown.
+extern esp_err_t wait_fft_job(fft_job_queue_t* job_queue, uint32_t job_id, uint32_t timeout_ms, fft_job_t* job);
+
+/// @brief This function converts the status of a job into its name (for example `"QUEUED"`).
+/// @param status The `fft_job_status_t` of the job.
+/// @return A string with the name of the status.
+extern const char* get_fft_job_status_name(fft_job_status_t status);
+
+#endif
@@ -0,0 +1,185 @@
+#include "fft_tables.h"
+
+#ifdef FFT_STATIC_LENGTH
+
+static size_t reverse_bits(size_t value, size_t bits) {
+    size_t reversed_value = 0;
+
+    for (size_t i = 0; i < bits; i++, value >>= 1)
+        reversed_value = (reversed_value << 1) | (value & 1);
+
+    return reversed_value;
+}
+
+static inline void swap_complex_values(float* data, size_t first, size_t second) {
+    float real = data[first * 2 + 0];
+    float imaginary = data[first * 2 + 1];
+
+    data[first * 2 + 0] = data[second * 2 + 0];
+    data[first * 2 + 1] = data[second * 2 + 1];
+    data[second * 2 + 0] = real;
+    data[second * 2 + 1] = imaginary;
+}
+
+static bool is_within_tolerance(const char* table_name, const float* table, const float* expected_table, size_t length, float tolerance) {
+    float largest_difference = 0.0f;
+
+    for (size_t i = 0; i < length; i++)
+        largest_difference = fmaxf(largest_difference, fabsf(table[i] - expected_table[i]));
+
+    if (largest_difference > tolerance) {
+        ESP_LOGE(FFT_TABLES_TAG, "The table '%s' differs '%g' from the runtime-computed one (the tolerance is '%g')!", table_name, largest_difference, tolerance);
+
+        return false;
+    }
+
+    ESP_LOGI(FFT_TABLES_TAG, "The table '%s' differs at most '%g' from the runtime-computed one.", table_name, largest_difference);
+
+    return true;
+}
+
+esp_err_t fft_static_fc32(float* data, size_t length) {
+    // Check if `data` has a valid value:
+    if (data == NULL) {
+        ESP_LOGE(FFT_TABLES_TAG, "The value of '%s' could not be 'NULL'!", "data");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the length is a power of two, that is covered by the twiddles:
+    if (length < 2 || length > FFT_STATIC_LENGTH || (length & (length - 1)) != 0) {
+        ESP_LOGE(FFT_TABLES_TAG, "The length '%d' of the FFT must be a power of two, of at most '%d'!", (int)length, FFT_STATIC_LENGTH);
+
+        return ESP_FAIL;
+    }
+
+    // Put the values in bit-reversed order, with the generated pairs for the full length (a shorter FFT computes its own):
+    if (length == FFT_STATIC_LENGTH) {
+        for (size_t i = 0; i < fft_static_bit_reversal_pair_count; i++)
+            swap_complex_values(data, fft_static_bit_reversal_pairs[i][0], fft_static_bit_reversal_pairs[i][1]);
+    }
+    else {
+        size_t bits = __builtin_ctz(length);
+
+        for (size_t i = 0; i < length; i++) {
+            size_t reversed_index = reverse_bits(i, bits);
+
+            if (i < reversed_index)
+                swap_complex_values(data, i, reversed_index);
+        }
+    }
+
+    // Combine the transforms of size `half` into transforms of size `2 * half`:
+    for (size_t half = 1; half < length; half *= 2) {
+        size_t twiddle_stride = FFT_STATIC_LENGTH / (2 * half); // The step through the twiddles of the full length.
+
+        // Load every twiddle once, and apply it to the butterflies of all the groups:
+        for (size_t k = 0; k < half; k++) {
+            float cosine = fft_static_twiddles[k * twiddle_stride * 2 + 0];
+            float sine = fft_static_twiddles[k * twiddle_stride * 2 + 1];
+
+            for (size_t first = k; first < length; first += 2 * half) {
+                size_t second = first + half;
+
+                // Multiply with `e^(-j * 2 * pi * k / (2 * half))`, like the forward FFT of `esp_dsp`:
+                float real = cosine * data[second * 2 + 0] + sine * data[second * 2 + 1];
+                float imaginary = cosine * data[second * 2 + 1] - sine * data[second * 2 + 0];
+
+                data[second * 2 + 0] = data[first * 2 + 0] - real;
+                data[second * 2 + 1] = data[first * 2 + 1] - imaginary;
+                data[first * 2 + 0] += real;
+                data[first * 2 + 1] += imaginary;
+            }
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t verify_static_fft_tables(void) {
+    float* expected_table = malloc(FFT_STATIC_LENGTH * 2 * sizeof(float)); // A runtime-computed table (or the complex output of `esp_dsp`).
+    float* static_output = malloc(FFT_STATIC_LENGTH * 2 * sizeof(float));  // The complex output of the static FFT.
+
+    // Check if the memory allocation was successful:
+    if (expected_table == NULL || static_output == NULL) {
+        ESP_LOGE(FFT_TABLES_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "expected_table", "static_output");
+
+        free(expected_table);
+        free(static_output);
+
+        return ESP_FAIL;
+    }
+
+    bool is_valid = true;
+
+    // Compare the twiddles with the factors of `cosf` and `sinf`:
+    for (size_t k = 0; k < FFT_STATIC_LENGTH / 2; k++) {
+        expected_table[k * 2 + 0] = cosf(2.0f * M_PI * k / FFT_STATIC_LENGTH);
+        expected_table[k * 2 + 1] = sinf(2.0f * M_PI * k / FFT_STATIC_LENGTH);
+    }
+
+    is_valid &= is_within_tolerance("twiddles", fft_static_twiddles, expected_table, FFT_STATIC_LENGTH, FFT_TWIDDLE_TOLERANCE);
+
+    // Compare the bit-reversal pairs exactly (every swapped index is in a single pair, and its reverse is its partner):
+    size_t number_of_swapped_indices = 0;
+    size_t bits = __builtin_ctz(FFT_STATIC_LENGTH);
+
+    for (size_t i = 0; i < FFT_STATIC_LENGTH; i++)
+        number_of_swapped_indices += (i != reverse_bits(i, bits)) ? 1 : 0;
+
+    bool has_valid_pairs = number_of_swapped_indices == fft_static_bit_reversal_pair_count * 2;
+
+    for (size_t i = 0; i < fft_static_bit_reversal_pair_count && has_valid_pairs; i++)
+        has_valid_pairs = fft_static_bit_reversal_pairs[i][0] < fft_static_bit_reversal_pairs[i][1] && reverse_bits(fft_static_bit_reversal_pairs[i][0], bits) == fft_static_bit_reversal_pairs[i][1];
+
+    if (!has_valid_pairs)
+        ESP_LOGE(FFT_TABLES_TAG, "The table '%s' differs from the runtime-computed one!", "bit_reversal_pairs");
+
+    is_valid &= has_valid_pairs;
+
+    // Compare every window with the one of `esp_dsp`:
+    for (size_t i = 0; i < WINDOW_CONFIGS_LENGTH; i++) {
+        char table_name[16] = {};
+
+        snprintf(table_name, sizeof(table_name), "window_%d", (int)i); // The index of the window in the `window_config_t` enum.
+
+        ESP_ERROR_CHECK(apply_window_function(expected_table, (window_config_t)i, FFT_STATIC_LENGTH));
+
+        is_valid &= is_within_tolerance(table_name, fft_static_window_tables[i], expected_table, FFT_STATIC_LENGTH, FFT_WINDOW_TOLERANCE);
+    }
+
+    // Compare the static FFT with the FFT of `esp_dsp`, for a windowed signal with a few tones and an offset:
+    for (size_t i = 0; i < FFT_STATIC_LENGTH; i++) {
+        float sample = 1.0f + sinf(2.0f * M_PI * 50.5f * i / FFT_STATIC_LENGTH) + 0.25f * cosf(2.0f * M_PI * 300.0f * i / FFT_STATIC_LENGTH);
+
+        static_output[i * 2 + 0] = expected_table[i * 2 + 0] = sample * fft_static_window_tables[HANN_WINDOW_F32][i];
+        static_output[i * 2 + 1] = expected_table[i * 2 + 1] = 0.0f;
+    }
+
+    ESP_ERROR_CHECK(fft_static_fc32(static_output, FFT_STATIC_LENGTH));
+
+    if (dsps_fft2r_init_fc32(NULL, FFT_STATIC_LENGTH) == ESP_OK) {
+        dsps_fft2r_fc32(expected_table, FFT_STATIC_LENGTH);
+        dsps_bit_rev_fc32(expected_table, FFT_STATIC_LENGTH);
+        dsps_fft2r_deinit_fc32();
+
+        float largest_value = 0.0f;
+
+        for (size_t i = 0; i < FFT_STATIC_LENGTH * 2; i++)
+            largest_value = fmaxf(largest_value, fabsf(expected_table[i]));
+
+        is_valid &= is_within_tolerance("fft", static_output, expected_table, FFT_STATIC_LENGTH * 2, FFT_OUTPUT_TOLERANCE * largest_value);
+    }
+    else {
+        ESP_LOGE(FFT_TABLES_TAG, "The FFT of 'esp_dsp' could not be initialized for the comparison!");
+
+        is_valid = false;
+    }
+
+    free(expected_table);
+    free(static_output);
+
+    return is_valid ? ESP_OK : ESP_FAIL;
+}
+
+#endif
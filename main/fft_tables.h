@@ -0,0 +1,48 @@
+#ifndef FFT_TABLES_H_
+#define FFT_TABLES_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_log.h"
+#include "esp_dsp.h"
+
+#include "window_transform.h"
+
+#define FFT_TABLES_TAG ("FFT_TABLES_H_")
+
+// The build defines `FFT_STATIC_LENGTH` (see 'main/CMakeLists.txt'), and generates the constant tables below for that length, which are placed in flash.
+
+#ifdef FFT_STATIC_LENGTH
+
+#define FFT_TWIDDLE_TOLERANCE (1e-6f) // The largest difference between a generated factor and one that is computed with `cosf` and `sinf`.
+#define FFT_WINDOW_TOLERANCE (1e-5f)  // The largest difference between a generated window and one that is computed by `esp_dsp` (in single precision).
+#define FFT_OUTPUT_TOLERANCE (1e-4f)  // The largest difference between the static FFT and the FFT of `esp_dsp`, relative to the largest bin.
+
+/// @brief The twiddle factors `cos(2 * pi * k / N)` and `sin(2 * pi * k / N)` of the first half of the circle, as complex pairs in natural order (so a shorter FFT uses every `N / length`-th pair).
+extern const float fft_static_twiddles[FFT_STATIC_LENGTH];
+
+/// @brief The number of pairs in `fft_static_bit_reversal_pairs`.
+extern const size_t fft_static_bit_reversal_pair_count;
+
+/// @brief The pairs of indices that are swapped by the bit reversal of `FFT_STATIC_LENGTH` complex values.
+extern const uint16_t fft_static_bit_reversal_pairs[][2];
+
+/// @brief The tables of every window function with a length of `FFT_STATIC_LENGTH`, in the same order as the `window_config_t` enum.
+extern const float fft_static_window_tables[WINDOW_CONFIGS_LENGTH][FFT_STATIC_LENGTH];
+
+/// @brief This function applies a forward FFT in-place, specialized for the constant tables: the complex values are put in bit-reversed order and transformed with radix-2 butterflies, so the result is in natural order (like `dsps_fft2r_fc32` followed by `dsps_bit_rev_fc32`).
+/// @param data A pointer to `length` complex values, stored as interleaved real and imaginary parts.
+/// @param length The number of complex values (a power of two, at most `FFT_STATIC_LENGTH`).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t fft_static_fc32(float* data, size_t length);
+
+/// @brief This function checks the generated tables against the tables that are computed at runtime (the twiddles and the bit reversal, and the windows of `esp_dsp`), and the static FFT against the FFT of `esp_dsp`. It is called at startup when the build defines `FFT_VERIFY_STATIC_TABLES`.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if every table is within its tolerance or `ESP_FAIL` if there is a mismatch.
+extern esp_err_t verify_static_fft_tables(void);
+
+#endif
+
+#endif
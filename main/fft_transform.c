@@ -1,5 +1,42 @@
 #include "fft_transform.h"
 
+static portMUX_TYPE fft_reference_spinlock = portMUX_INITIALIZER_UNLOCKED; // A spinlock that guards the creation of `fft_reference_lock`.
+static SemaphoreHandle_t fft_reference_lock = NULL;                        // A mutex that guards the (de-)initialization of the shared FFT tables.
+static size_t fft_reference_count = 0;                                     // The number of users that currently initialized the shared FFT tables.
+
+static portMUX_TYPE average_spinlock = portMUX_INITIALIZER_UNLOCKED; // A spinlock that guards the creation of `average_lock`.
+static SemaphoreHandle_t average_lock = NULL;                        // A mutex that guards the accumulated spectrum.
+static float* average_power = NULL;                                  // The accumulated power of each bin, or `NULL` if nothing is accumulated yet.
+static size_t average_bin_count = 0;                                 // The number of bins of `average_power`.
+static size_t average_frames = 0;                                    // The number of spectra in `average_power` (zero after a reset).
+static averaging_config_t average_config = {};                       // The averaging settings with which `average_power` is accumulated.
+static window_config_t average_window = 0;                           // The window of the spectra in `average_power`.
+
+static SemaphoreHandle_t get_lazy_lock(SemaphoreHandle_t* lock, portMUX_TYPE* spinlock) {
+    // Create the mutex on first use (the FFT can be used from multiple tasks at the same time):
+    if (*lock == NULL) {
+        SemaphoreHandle_t created_lock = xSemaphoreCreateMutex();
+
+        portENTER_CRITICAL(spinlock);
+
+        if (*lock == NULL) {
+            *lock = created_lock;
+            created_lock = NULL;
+        }
+
+        portEXIT_CRITICAL(spinlock);
+
+        if (created_lock != NULL)
+            vSemaphoreDelete(created_lock);
+    }
+
+    return *lock;
+}
+
+static SemaphoreHandle_t get_fft_reference_lock(void) {
+    return get_lazy_lock(&fft_reference_lock, &fft_reference_spinlock);
+}
+
 esp_err_t initialize_fft_f32(fft_data_t* fft_data) {
     // Check if `fft_data` has a valid value:
     if (fft_data == NULL) {
@@ -8,7 +45,19 @@ esp_err_t initialize_fft_f32(fft_data_t* fft_data) {
         return ESP_FAIL;
     }
 
-    ESP_ERROR_CHECK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE)); // Initialize the FFT with the specified maximum size.
+    SemaphoreHandle_t reference_lock = get_fft_reference_lock();
+
+    xSemaphoreTake(reference_lock, portMAX_DELAY);
+
+    // Only the first user initializes the shared FFT tables (the generated tables are in flash, so they need no initialization):
+#ifndef FFT_STATIC_LENGTH
+    if (fft_reference_count == 0)
+        ESP_ERROR_CHECK(dsps_fft2r_init_fc32(NULL, CONFIG_DSP_MAX_FFT_SIZE)); // Initialize the FFT with the specified maximum size.
+#endif
+
+    fft_reference_count++;
+
+    xSemaphoreGive(reference_lock);
 
     fft_data->fft_is_initialized = true;  // Set the flag indicating that the FFT is initialized.
 
@@ -23,17 +72,60 @@ esp_err_t de_initialize_fft_f32(fft_data_t* fft_data) {
         return ESP_FAIL;
     }
 
-    dsps_fft2r_deinit_fc32(); // Deinitialize the FFT.
+    // Check if this user did initialize the FFT:
+    if (!fft_data->fft_is_initialized)
+        return ESP_OK;
+
+    SemaphoreHandle_t reference_lock = get_fft_reference_lock();
+
+    xSemaphoreTake(reference_lock, portMAX_DELAY);
+
+    fft_reference_count--;
+
+    // Only the last user de-initializes the shared FFT tables:
+#ifndef FFT_STATIC_LENGTH
+    if (fft_reference_count == 0)
+        dsps_fft2r_deinit_fc32(); // Deinitialize the FFT.
+#endif
+
+    xSemaphoreGive(reference_lock);
 
     fft_data->fft_is_initialized = false; // Set the flag indicating that the FFT is not initialized.
 
     return ESP_OK;
 }
 
-esp_err_t apply_fft_f32(fft_data_t* fft_data, float* samples, window_config_t window_config, size_t sample_length, size_t sample_frequency) {
-    // Check if `fft_data` and `samples` hvae a valid value:
-    if (fft_data == NULL || samples == NULL) {
-        ESP_LOGE(FFT_TRANSFORM_TAG, "The value of '%s' and '%s' could not be 'NULL'!", "fft_data", "samples");
+esp_err_t apply_complex_fft_fc32(float* data, size_t length) {
+    // Check if `data` has a valid value:
+    if (data == NULL) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "data");
+
+        return ESP_FAIL;
+    }
+
+#ifdef FFT_STATIC_LENGTH
+    return fft_static_fc32(data, length); // Use the specialized FFT with the generated tables.
+#else
+    esp_err_t succeeded_fft = dsps_fft2r_fc32(data, length);
+
+    if (succeeded_fft == ESP_OK)
+        succeeded_fft = dsps_bit_rev_fc32(data, length);
+
+    // Check if the FFT was successful (`esp_dsp` fails on a length that is not a power of two, or above its initialized size):
+    if (succeeded_fft != ESP_OK) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The FFT of length '%d' failed ('%s')!", (int)length, esp_err_to_name(succeeded_fft));
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+#endif
+}
+
+esp_err_t compute_fft_spectrum_f32(fft_data_t* fft_data, const float* samples, window_config_t window_config, size_t sample_length, float* power_db, float* power) {
+    // Check if `fft_data`, `samples` and `power_db` have a valid value:
+    if (fft_data == NULL || samples == NULL || power_db == NULL) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "fft_data", "samples", "power_db");
 
         return ESP_FAIL;
     }
@@ -45,27 +137,33 @@ esp_err_t apply_fft_f32(fft_data_t* fft_data, float* samples, window_config_t wi
         return ESP_FAIL;
     }
 
-    // Allocate memory for the FFT window and the complex FFT output:
-    float* fft_window = calloc(sample_length, sizeof(float));
-    float* fft_y_cf = calloc(sample_length * 2, sizeof(float));
+    float* fft_y_cf = calloc(sample_length * 2, sizeof(float)); // Allocate memory for the complex FFT output.
 
     // Check if memory allocation was successful:
-    if (fft_window == NULL || fft_y_cf == NULL) {
-        ESP_LOGE(FFT_TRANSFORM_TAG, "One of the allocations failed!");
+    if (fft_y_cf == NULL) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "fft_y_cf");
 
         return ESP_FAIL;
     }
 
-    float* fft_y_cf_real_part = fft_y_cf;
-    float* fft_y_cf_magnitude = &fft_y_cf[sample_length];
+    const float* fft_window = NULL; // The cached table of the window function.
+    float* generated_window = NULL; // A window that is generated for this call only, if it could not be cached.
 
-    esp_err_t succeeded_window_generation = apply_window_function(fft_window, window_config, sample_length); // Generate the window function.
+    // Generate the window function, if no table with this length is cached:
+    if (get_window_table(window_config, sample_length, &fft_window) != ESP_OK) {
+        generated_window = calloc(sample_length, sizeof(float));
 
-    // Check if the window generation was successful:
-    if (succeeded_window_generation != ESP_OK) {
-        ESP_LOGE(FFT_TRANSFORM_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
+        // Check if the window generation was successful:
+        if (generated_window == NULL || apply_window_function(generated_window, window_config, sample_length) != ESP_OK) {
+            ESP_LOGE(FFT_TRANSFORM_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
 
-        return ESP_FAIL;
+            free(generated_window);
+            free(fft_y_cf);
+
+            return ESP_FAIL;
+        }
+
+        fft_window = generated_window;
     }
 
     // Apply the window function to the input samples and prepare the complex input for the FFT:
@@ -75,30 +173,203 @@ esp_err_t apply_fft_f32(fft_data_t* fft_data, float* samples, window_config_t wi
     }
 
     // Perform the FFT:
-    dsps_fft2r_fc32(fft_y_cf, sample_length);
-    dsps_bit_rev_fc32(fft_y_cf, sample_length);
-    dsps_cplx2reC_fc32(fft_y_cf, sample_length);
+    if (apply_complex_fft_fc32(fft_y_cf, sample_length) != ESP_OK) {
+        free(generated_window);
+        free(fft_y_cf);
 
-    // Calculate the magnitude and power of each frequency bin:
-    for (int i = 0; i < sample_length / 2; i++) {
-        fft_y_cf_real_part[i] = 10 * log10f((fft_y_cf_real_part[i * 2 + 0] * fft_y_cf_real_part[i * 2 + 0] + fft_y_cf_real_part[i * 2 + 1] * fft_y_cf_real_part[i * 2 + 1]) / sample_length);
-        fft_y_cf_magnitude[i] = (fft_y_cf_real_part[i * 2 + 0] * fft_y_cf_real_part[i * 2 + 0] + fft_y_cf_real_part[i * 2 + 1] * fft_y_cf_real_part[i * 2 + 1]) / sample_length;
+        return ESP_FAIL;
     }
 
-    // Log the FFT results in log scale:
-    ESP_LOGI(FFT_TRANSFORM_TAG, "Signal in log scale:");
-    dsps_view(fft_y_cf_real_part, sample_length / 2, 64, 10,  0, 50, '|');
+    // Split the spectrum of the real samples out of the complex output:
+    if (dsps_cplx2reC_fc32(fft_y_cf, sample_length) != ESP_OK) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The complex output of the FFT could not be split into its real spectrum!");
 
-    // Log the FFT results in absolute scale:
-    ESP_LOGI(FFT_TRANSFORM_TAG, "Signal in absolute scale:");
-    dsps_view(fft_y_cf_magnitude, sample_length / 2, 64, 10,  0, 2, '|');
+        free(generated_window);
+        free(fft_y_cf);
 
-    // Display the FFT results on an OLED screen:
-    ESP_ERROR_CHECK(oled_view_fft(fft_y_cf_real_part, sample_length / 2, sample_length, sample_frequency, 0, 50));
+        return ESP_FAIL;
+    }
+
+    // Calculate the magnitude and power of each frequency bin in a single pass:
+    spectrum_outputs_t spectrum_outputs = {
+        .power = power,
+        .power_db = power_db,
+        .power_scale = 1.0f / sample_length
+    };
+
+    esp_err_t succeeded_processing = spectrum_process_f32(fft_y_cf, sample_length / 2, &spectrum_outputs);
 
     // Free the allocated memory:
-    free(fft_window);
+    free(generated_window);
     free(fft_y_cf);
 
+    return succeeded_processing;
+}
+
+esp_err_t accumulate_spectrum_f32(fft_data_t* fft_data, window_config_t window_config, float* power, float* power_db, size_t bin_count) {
+    // Check if `fft_data`, `power` and `power_db` have a valid value:
+    if (fft_data == NULL || power == NULL || power_db == NULL) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "fft_data", "power", "power_db");
+
+        return ESP_FAIL;
+    }
+
+    averaging_config_t averaging_config = fft_data->averaging_config;
+
+    // Without averaging, the spectrum is used as it is:
+    if (averaging_config.mode == NO_AVERAGING) {
+        fft_data->averaged_frames = 1;
+
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(get_lazy_lock(&average_lock, &average_spinlock), portMAX_DELAY);
+
+    // Start over when the accumulated spectra can not be combined with the new one:
+    if (average_bin_count != bin_count || average_window != window_config || average_config.mode != averaging_config.mode || average_config.frames != averaging_config.frames || average_config.alpha != averaging_config.alpha) {
+        average_frames = 0;
+        average_config = averaging_config;
+        average_window = window_config;
+    }
+
+    // Allocate the accumulator on first use (or when the number of bins changes):
+    if (average_bin_count != bin_count) {
+        free(average_power);
+
+        average_power = malloc(bin_count * sizeof(float));
+        average_bin_count = average_power != NULL ? bin_count : 0;
+    }
+
+    // Check if the memory allocation was successful:
+    if (average_power == NULL) {
+        xSemaphoreGive(average_lock);
+
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "average_power");
+
+        return ESP_FAIL;
+    }
+
+    // The linear average is a block average, which starts over after every `frames` spectra (so every spectrum of a block has the same weight):
+    size_t block_frames = (averaging_config.mode == LINEAR_AVERAGING && averaging_config.frames > 0) ? average_frames % averaging_config.frames : average_frames;
+
+    // The first spectrum (of a block) is copied into the accumulator, and the next ones are combined with it in-place:
+    if (block_frames == 0)
+        memcpy(average_power, power, bin_count * sizeof(float));
+    else {
+        switch (averaging_config.mode) {
+            case LINEAR_AVERAGING:
+                spectrum_average_f32(average_power, power, bin_count, 1.0f / (block_frames + 1)); // The running mean of the spectra of the block.
+                break;
+
+            case EXPONENTIAL_AVERAGING:
+                spectrum_average_f32(average_power, power, bin_count, averaging_config.alpha);
+                break;
+
+            case MAX_HOLD_AVERAGING:
+                spectrum_max_hold_f32(average_power, power, bin_count);
+                break;
+
+            case MIN_HOLD_AVERAGING:
+                spectrum_min_hold_f32(average_power, power, bin_count);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    average_frames++;
+
+    // Replace the spectrum by the accumulated one:
+    memcpy(power, average_power, bin_count * sizeof(float));
+
+    fft_data->averaged_frames = block_frames + 1;
+
+    xSemaphoreGive(average_lock);
+
+    return spectrum_power_to_db_f32(power, power_db, bin_count);
+}
+
+esp_err_t reset_spectrum_average(void) {
+    xSemaphoreTake(get_lazy_lock(&average_lock, &average_spinlock), portMAX_DELAY);
+
+    average_frames = 0; // Keep the accumulator, so it is reused by the next spectrum.
+
+    xSemaphoreGive(average_lock);
+
     return ESP_OK;
 }
+
+esp_err_t apply_fft_f32(fft_data_t* fft_data, float* samples, window_config_t window_config, size_t sample_length, size_t sample_frequency) {
+    // Check if `fft_data` and `samples` hvae a valid value:
+    if (fft_data == NULL || samples == NULL) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The value of '%s' and '%s' could not be 'NULL'!", "fft_data", "samples");
+
+        return ESP_FAIL;
+    }
+
+    // Allocate memory for the spectrum in log scale and in absolute scale:
+    float* fft_y_cf = calloc(sample_length, sizeof(float));
+
+    // Check if memory allocation was successful:
+    if (fft_y_cf == NULL) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "One of the allocations failed!");
+
+        return ESP_FAIL;
+    }
+
+    float* fft_y_cf_real_part = fft_y_cf;
+    float* fft_y_cf_magnitude = &fft_y_cf[sample_length / 2];
+
+    // Compute the spectrum (this also checks if the FFT is initialized):
+    if (compute_fft_spectrum_f32(fft_data, samples, window_config, sample_length, fft_y_cf_real_part, fft_y_cf_magnitude) != ESP_OK) {
+        free(fft_y_cf);
+
+        return ESP_FAIL;
+    }
+
+    // Accumulate the spectrum with the previous ones (if averaging is enabled):
+    if (accumulate_spectrum_f32(fft_data, window_config, fft_y_cf_magnitude, fft_y_cf_real_part, sample_length / 2) != ESP_OK) {
+        free(fft_y_cf);
+
+        return ESP_FAIL;
+    }
+
+    // Extract the strongest peaks from the spectrum in log scale:
+    esp_err_t succeeded_peak_detection = detect_peaks_f32(fft_y_cf_real_part, sample_length / 2, sample_length, sample_frequency, window_config, fft_data->peak_config, fft_data->peaks, &fft_data->number_of_peaks);
+
+    // Check if the peak detection was successful:
+    if (succeeded_peak_detection != ESP_OK) {
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The peaks of the spectrum could not be detected!");
+
+        free(fft_y_cf);
+
+        return ESP_FAIL;
+    }
+
+    // Trace the found peaks (only at the verbose level, so the console does not slow down every FFT):
+    for (int i = 0; i < fft_data->number_of_peaks && trace_level_is_enabled(&trace_buffer, TRACE_LEVEL_VERBOSE); i++)
+        record_trace_event(&trace_buffer, FFT_PEAK_TRACE, TRACE_LEVEL_VERBOSE, (const int32_t[TRACE_EVENT_VALUES]){i, fft_data->number_of_peaks, 0}, (const float[TRACE_EVENT_MEASUREMENTS]){fft_data->peaks[i].frequency, fft_data->peaks[i].amplitude});
+
+    // Plot the FFT results on the console, which blocks for many milliseconds and is therefore only done at the plot level:
+    if (trace_level_is_enabled(&trace_buffer, TRACE_LEVEL_PLOT)) {
+        // Log the FFT results in log scale:
+        ESP_LOGI(FFT_TRANSFORM_TAG, "Signal in log scale:");
+        dsps_view(fft_y_cf_real_part, sample_length / 2, 64, 10,  0, 50, '|');
+
+        // Log the FFT results in absolute scale:
+        ESP_LOGI(FFT_TRANSFORM_TAG, "Signal in absolute scale:");
+        dsps_view(fft_y_cf_magnitude, sample_length / 2, 64, 10,  0, 2, '|');
+    }
+
+    // Display the FFT results on an OLED screen:
+    esp_err_t succeeded_view = oled_view_fft(fft_y_cf_real_part, sample_length / 2, sample_length, sample_frequency, 0, 50);
+
+    if (succeeded_view != ESP_OK)
+        ESP_LOGE(FFT_TRANSFORM_TAG, "The spectrum could not be displayed on the OLED!");
+
+    // Free the allocated memory:
+    free(fft_y_cf);
+
+    return succeeded_view;
+}
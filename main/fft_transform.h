@@ -5,35 +5,98 @@
 #include <math.h>
 #include <float.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
 #include "esp_dsp.h"
 
 #include "display_communicator.h"
+#include "fft_tables.h"
+#include "peak_detector.h"
+#include "spectrum_kernels.h"
+#include "trace_buffer.h"
 #include "window_transform.h"
 
 #define FFT_TRANSFORM_TAG ("FFT_TRANSFORM_H_")
 
-/// @brief Defining a struct called `fft_data`, that contains a boolean indicating whether the FFT is initialized.
+#define DEFAULT_AVERAGING_FRAMES (8)
+#define MAXIMUM_AVERAGING_FRAMES (1024)
+#define DEFAULT_AVERAGING_ALPHA (0.25f)
+
+/// @brief This is an enumeration called `averaging_mode_t` with the ways in which consecutive spectra are accumulated.
+typedef enum averaging_mode {
+    NO_AVERAGING,          // Every spectrum stands on its own.
+    LINEAR_AVERAGING,      // The mean of the spectra of a block of `frames` spectra, where every spectrum has the same weight (the next spectrum after a full block starts a new block).
+    EXPONENTIAL_AVERAGING, // An exponential moving average, where every new spectrum has a weight of `alpha`.
+    MAX_HOLD_AVERAGING,    // The highest power of every bin.
+    MIN_HOLD_AVERAGING     // The lowest power of every bin.
+} averaging_mode_t;
+
+/// @brief Defining a struct called `averaging_config`, that contains the settings for accumulating consecutive spectra.
+typedef struct averaging_config {
+    averaging_mode_t mode; // This field contains the `averaging_mode_t` of the accumulation.
+    size_t frames;         // This field contains a `size_t` with the number of spectra in a block of the linear average.
+    float alpha;           // This field contains a `float` with the weight of a new spectrum in the exponential moving average (between 0 and 1).
+} averaging_config_t;
+
+/// @brief Defining a struct called `fft_data`, that contains a boolean indicating whether the FFT is initialized, together with the peaks found in the spectrum.
 typedef struct fft_data {
     bool fft_is_initialized; // This field contains a `bool`, indicating if the FFT is successfully initialized.
+
+    peak_config_t peak_config;              // This field contains a `peak_config_t` with the settings for extracting the peaks of the spectrum.
+    fft_peak_t peaks[MAXIMUM_PEAKS_LENGTH]; // This field contains an array of `fft_peak_t` peaks, sorted from strongest to weakest.
+    size_t number_of_peaks;                 // This field contains a `size_t` with the number of found peaks.
+
+    averaging_config_t averaging_config; // This field contains an `averaging_config_t` with the settings for accumulating consecutive spectra.
+    size_t averaged_frames;              // This field contains a `size_t` with the number of spectra in the accumulated spectrum of which the peaks were found (within the current block, for the linear average).
 } fft_data_t;
 
-/// @brief This function initializes the FFT with a given maximum size and sets a flag indicating that the FFT is initialized.
+/// @brief This function initializes the FFT with a given maximum size and sets a flag indicating that the FFT is initialized. The FFT tables are shared, and only initialized by the first user.
 /// @param fft_data A pointer to a struct that contains data related to the FFT operation.
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the initialization was successful or an error code if it failed.
 extern esp_err_t initialize_fft_f32(fft_data_t* fft_data);
 
-/// @brief This function de-initializes a FFT data structure.
+/// @brief This function de-initializes a FFT data structure. The shared FFT tables are only released by the last user.
 /// @param fft_data A pointer to a struct that contains data related to the FFT (Fast Fourier Transform) operation.
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the initialization was successful or an error code if it failed.
 extern esp_err_t de_initialize_fft_f32(fft_data_t* fft_data);
 
-/// @brief This function applies a FFT to a set of float samples, using a provided window configuration, and outputs the results in both log and absolute scales.
+/// @brief This function applies a forward FFT to complex values in-place, with the result in natural order. With the generated tables (see `FFT_STATIC_LENGTH`), it uses the specialized `fft_static_fc32`, and otherwise the FFT of `esp_dsp`.
+/// @param data A pointer to `length` complex values, stored as interleaved real and imaginary parts.
+/// @param length The number of complex values (a power of two).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the transformation was successful or `ESP_FAIL` if there is an error.
+extern esp_err_t apply_complex_fft_fc32(float* data, size_t length);
+
+/// @brief This function applies a window and a FFT to a set of float samples, and stores the power of each frequency bin without logging or displaying it.
 /// @param fft_data A pointer to the FFT data structure that holds the necessary information for the FFT transformation.
+/// @param samples An array of float values representing the samples to be transformed.
+/// @param window_config An enumeration type that contains the configuration parameters for the window function to be applied to the input signal before performing the FFT.
+/// @param sample_length The length of the input signal in samples.
+/// @param power_db A pointer to an array of at least `sample_length / 2` floats, where the power of each bin in dB will be stored.
+/// @param power A pointer to an array of at least `sample_length / 2` floats, where the power of each bin in absolute scale will be stored (it may be `NULL`).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the transformation was successful or an error code if it failed.
+extern esp_err_t compute_fft_spectrum_f32(fft_data_t* fft_data, const float* samples, window_config_t window_config, size_t sample_length, float* power_db, float* power);
+
+/// @brief This function accumulates a spectrum in the shared accumulator, according to the averaging settings of `fft_data`, and replaces the spectrum by the accumulated one. The accumulator starts over when the settings, the window or the number of bins change, or after `reset_spectrum_average`.
+/// @param fft_data A pointer to the FFT data structure with the averaging settings, which receives the number of accumulated spectra.
+/// @param window_config The window that was applied before the FFT.
+/// @param power A pointer to the power of each bin in absolute scale, which is replaced by the accumulated power.
+/// @param power_db A pointer to an array where the accumulated power of each bin in dB will be stored.
+/// @param bin_count The number of bins.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t accumulate_spectrum_f32(fft_data_t* fft_data, window_config_t window_config, float* power, float* power_db, size_t bin_count);
+
+/// @brief This function discards the accumulated spectrum, so the next spectrum starts a new accumulation (for example when the samples change).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t reset_spectrum_average(void);
+
+/// @brief This function applies a FFT to a set of float samples, using a provided window configuration, outputs the results in both log and absolute scales and extracts the peaks. The spectrum is accumulated first, if averaging is enabled in `fft_data`.
+/// @param fft_data A pointer to the FFT data structure that holds the necessary information for the FFT transformation, and receives the found peaks.
 /// @param samples An array of float values representing the audio samples to be transformed.
 /// @param window_config An enumeration type that contains the configuration parameters for the window function to be applied to the input signal before performing the FFT.
 /// @param sample_length The length of the input signal in samples.
 /// @param sample_frequency The frequency at which the signal is sampled, measured in Hz (Hertz).
-/// @return An `esp_err_t` value, which is either `ESP_OK` if the initialization was successful or an error code if it failed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the spectrum was computed, its peaks detected and shown on the OLED, or `ESP_FAIL` if one of these steps failed (which fails the FFT job, instead of aborting).
 extern esp_err_t apply_fft_f32(fft_data_t* fft_data, float* samples, window_config_t window_config, size_t sample_length, size_t sample_frequency);
 
 #endif
@@ -0,0 +1,253 @@
+#include "filter_transform.h"
+
+static float get_butterworth_q(size_t order, size_t section) {
+    return 1.0f / (2.0f * cosf(M_PI * (2 * section + 1) / (2.0f * order))); // The quality factor of a section, so the cascade has the poles of a Butterworth filter of the given order.
+}
+
+static size_t get_number_of_sections(const filter_config_t* filter_config) {
+    return (filter_config->response == BAND_PASS_FILTER) ? filter_config->order : filter_config->order / 2; // A band-pass is a high-pass followed by a low-pass.
+}
+
+static esp_err_t design_biquad_cascade(filter_stage_t* filter_stage) {
+    const filter_config_t* filter_config = &filter_stage->config;
+
+    float low_frequency = filter_config->low_frequency / filter_stage->sample_frequency;
+    float high_frequency = filter_config->high_frequency / filter_stage->sample_frequency;
+
+    size_t half_order = filter_config->order / 2;
+    size_t section = 0;
+
+    // Design the sections of the lower edge (of a high-pass or a band-pass):
+    if (filter_config->response != LOW_PASS_FILTER)
+        for (size_t i = 0; i < half_order; i++)
+            ESP_ERROR_CHECK(dsps_biquad_gen_hpf_f32(filter_stage->biquad_coefficients[section++], low_frequency, get_butterworth_q(filter_config->order, i)));
+
+    // Design the sections of the upper edge (of a low-pass or a band-pass):
+    if (filter_config->response != HIGH_PASS_FILTER)
+        for (size_t i = 0; i < half_order; i++)
+            ESP_ERROR_CHECK(dsps_biquad_gen_lpf_f32(filter_stage->biquad_coefficients[section++], high_frequency, get_butterworth_q(filter_config->order, i)));
+
+    filter_stage->number_of_sections = section;
+
+    memset(filter_stage->biquad_states, 0, sizeof(filter_stage->biquad_states)); // Start the cascade from rest.
+
+    return ESP_OK;
+}
+
+esp_err_t configure_filter_stage(filter_stage_t* filter_stage, const filter_config_t* filter_config) {
+    // Check if `filter_stage` and `filter_config` have a valid value:
+    if (filter_stage == NULL || filter_config == NULL) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "filter_stage", "filter_config");
+
+        return ESP_FAIL;
+    }
+
+    if (filter_config->structure != NO_FILTER) {
+        // Check if the order is even, and fits into the cascade or the taps:
+        if (filter_config->order < 2 || filter_config->order % 2 != 0 || (filter_config->structure == BIQUAD_FILTER && get_number_of_sections(filter_config) > MAXIMUM_BIQUAD_SECTIONS) || (filter_config->structure == FIR_FILTER && filter_config->order + 1 > MAXIMUM_FIR_TAPS)) {
+            ESP_LOGE(FILTER_TRANSFORM_TAG, "The order '%d' of the filter is not supported!", (int)filter_config->order);
+
+            return ESP_FAIL;
+        }
+
+        // Check if the used cutoff frequencies are positive, and if the edges of a band-pass are in order:
+        bool has_valid_low_frequency = filter_config->response == LOW_PASS_FILTER || filter_config->low_frequency > 0.0f;
+        bool has_valid_high_frequency = filter_config->response == HIGH_PASS_FILTER || filter_config->high_frequency > 0.0f;
+
+        if (!has_valid_low_frequency || !has_valid_high_frequency || (filter_config->response == BAND_PASS_FILTER && filter_config->low_frequency >= filter_config->high_frequency)) {
+            ESP_LOGE(FILTER_TRANSFORM_TAG, "The cutoff frequencies '%.2f' and '%.2f' Hz of the filter are not valid!", filter_config->low_frequency, filter_config->high_frequency);
+
+            return ESP_FAIL;
+        }
+    }
+
+    filter_stage->config = *filter_config;
+    filter_stage->is_designed = false; // Design the coefficients (and clear the state) on the next block.
+
+    return ESP_OK;
+}
+
+static esp_err_t prepare_filter_stage(filter_stage_t* filter_stage, size_t sample_frequency) {
+    const filter_config_t* filter_config = &filter_stage->config;
+
+    // Design the coefficients, when the settings or the sample frequency changed:
+    if (!filter_stage->is_designed || filter_stage->sample_frequency != sample_frequency) {
+        float highest_frequency = (filter_config->response == HIGH_PASS_FILTER) ? filter_config->low_frequency : filter_config->high_frequency; // The highest used cutoff frequency.
+
+        // Check if the cutoff frequencies are below the Nyquist frequency:
+        if (sample_frequency == 0 || 2.0f * highest_frequency >= sample_frequency) {
+            ESP_LOGE(FILTER_TRANSFORM_TAG, "The cutoff frequencies of the filter must be below half of the sample frequency of '%d' Hz!", (int)sample_frequency);
+
+            return ESP_FAIL;
+        }
+
+        filter_stage->sample_frequency = sample_frequency;
+
+        if (filter_config->structure == BIQUAD_FILTER)
+            ESP_ERROR_CHECK(design_biquad_cascade(filter_stage));
+        else {
+            size_t number_of_taps = filter_config->order + 1;
+
+            if (design_fir_filter_f32(filter_stage->fir_coefficients, number_of_taps, filter_config->response, filter_config->low_frequency / sample_frequency, filter_config->high_frequency / sample_frequency) != ESP_OK)
+                return ESP_FAIL;
+
+            memset(filter_stage->fir_delay, 0, sizeof(filter_stage->fir_delay)); // Start the delay line from rest.
+
+            ESP_ERROR_CHECK(dsps_fir_init_f32(&filter_stage->fir, filter_stage->fir_coefficients, filter_stage->fir_delay, number_of_taps));
+        }
+
+        filter_stage->is_designed = true;
+    }
+
+    return ESP_OK;
+}
+
+static void filter_blocks(filter_stage_t* filter_stage, float* samples, size_t sample_length) {
+    // Filter the samples in blocks, so a block stays in the cache while it passes through all the sections:
+    for (size_t i = 0; i < sample_length; i += FILTER_BLOCK_LENGTH) {
+        float* block = &samples[i];
+        int block_length = (sample_length - i < FILTER_BLOCK_LENGTH) ? sample_length - i : FILTER_BLOCK_LENGTH;
+
+        if (filter_stage->config.structure == BIQUAD_FILTER) {
+            for (size_t section = 0; section < filter_stage->number_of_sections; section++)
+                dsps_biquad_f32(block, block, block_length, filter_stage->biquad_coefficients[section], filter_stage->biquad_states[section]);
+        }
+        else
+            dsps_fir_f32(&filter_stage->fir, block, block, block_length);
+    }
+}
+
+esp_err_t apply_filter_stage(filter_stage_t* filter_stage, float* samples, size_t sample_length, size_t sample_frequency) {
+    // Check if `filter_stage` and `samples` have a valid value:
+    if (filter_stage == NULL || samples == NULL) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "filter_stage", "samples");
+
+        return ESP_FAIL;
+    }
+
+    // Without a filter, the samples pass unchanged:
+    if (filter_stage->config.structure == NO_FILTER)
+        return ESP_OK;
+
+    if (prepare_filter_stage(filter_stage, sample_frequency) != ESP_OK)
+        return ESP_FAIL;
+
+    filter_blocks(filter_stage, samples, sample_length);
+
+    return ESP_OK;
+}
+
+esp_err_t apply_periodic_filter_stage(filter_stage_t* filter_stage, float* samples, size_t sample_length, size_t sample_frequency) {
+    // Check if `filter_stage` and `samples` have a valid value:
+    if (filter_stage == NULL || samples == NULL) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "filter_stage", "samples");
+
+        return ESP_FAIL;
+    }
+
+    // Without a filter, the samples pass unchanged:
+    if (filter_stage->config.structure == NO_FILTER)
+        return ESP_OK;
+
+    if (prepare_filter_stage(filter_stage, sample_frequency) != ESP_OK)
+        return ESP_FAIL;
+
+    float* priming_samples = malloc(sample_length * sizeof(float)); // A copy of the frame, that only primes the state of the filter.
+
+    // Check if the memory allocation was successful:
+    if (priming_samples == NULL) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "priming_samples");
+
+        return ESP_ERR_NO_MEM;
+    }
+
+    memcpy(priming_samples, samples, sample_length * sizeof(float));
+
+    // Start from rest, so the same frame is always filtered into the same output:
+    memset(filter_stage->biquad_states, 0, sizeof(filter_stage->biquad_states));
+    memset(filter_stage->fir_delay, 0, sizeof(filter_stage->fir_delay));
+
+    if (filter_stage->config.structure == FIR_FILTER)
+        ESP_ERROR_CHECK(dsps_fir_init_f32(&filter_stage->fir, filter_stage->fir_coefficients, filter_stage->fir_delay, filter_stage->config.order + 1));
+
+    // Filter the frame twice and keep the second pass, so its start continues from the end of the frame (as the frame is repeated) without the transient of the filter:
+    filter_blocks(filter_stage, priming_samples, sample_length);
+    filter_blocks(filter_stage, samples, sample_length);
+
+    free(priming_samples);
+
+    return ESP_OK;
+}
+
+esp_err_t design_fir_filter_f32(float* coefficients, size_t number_of_taps, filter_response_t response, float low_frequency, float high_frequency) {
+    // Check if `coefficients` has a valid value:
+    if (coefficients == NULL) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "coefficients");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the number of taps is odd (an even number has a zero at the Nyquist frequency, so it can not be a high-pass):
+    if (number_of_taps == 0 || number_of_taps % 2 == 0) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The number of taps '%d' of the FIR filter must be odd!", (int)number_of_taps);
+
+        return ESP_FAIL;
+    }
+
+    // Generate the window into the coefficients, which are multiplied with the ideal response below:
+    if (apply_window_function(coefficients, FIR_DESIGN_WINDOW, number_of_taps) != ESP_OK)
+        return ESP_FAIL;
+
+    float center = (number_of_taps - 1) / 2.0f;
+
+    // The frequency at which the pass band has a gain of one:
+    float reference_frequency = (response == LOW_PASS_FILTER) ? 0.0f : (response == HIGH_PASS_FILTER) ? 0.5f : (low_frequency + high_frequency) / 2.0f;
+    float reference_gain = 0.0f;
+
+    for (size_t i = 0; i < number_of_taps; i++) {
+        float offset = i - center;
+
+        // The ideal low-pass responses of the upper and lower edge (`2 * f * sinc(2 * f * n)`):
+        float upper_edge_low_pass = (offset == 0.0f) ? 2.0f * high_frequency : sinf(2.0f * M_PI * high_frequency * offset) / (M_PI * offset);
+        float lower_edge_low_pass = (offset == 0.0f) ? 2.0f * low_frequency : sinf(2.0f * M_PI * low_frequency * offset) / (M_PI * offset);
+
+        float ideal_response = 0.0f;
+
+        // A high-pass is an impulse minus a low-pass, and a band-pass is the difference of two low-pass filters:
+        switch (response) {
+            case LOW_PASS_FILTER:
+                ideal_response = upper_edge_low_pass;
+                break;
+
+            case HIGH_PASS_FILTER:
+                ideal_response = ((offset == 0.0f) ? 1.0f : 0.0f) - lower_edge_low_pass;
+                break;
+
+            case BAND_PASS_FILTER:
+                ideal_response = upper_edge_low_pass - lower_edge_low_pass;
+                break;
+
+            default:
+                ESP_LOGE(FILTER_TRANSFORM_TAG, "Unknown response '%d' of the FIR filter!", response);
+
+                return ESP_FAIL;
+        }
+
+        coefficients[i] *= ideal_response;
+
+        reference_gain += coefficients[i] * cosf(2.0f * M_PI * reference_frequency * offset); // The taps are symmetric, so the response at the reference frequency is real.
+    }
+
+    // Check if the pass band is not empty (for example with too few taps for a narrow band-pass):
+    if (fabsf(reference_gain) < 1e-6f) {
+        ESP_LOGE(FILTER_TRANSFORM_TAG, "The FIR filter has no gain in its pass band, use more taps!");
+
+        return ESP_FAIL;
+    }
+
+    // Normalize the taps, so the pass band has a gain of one:
+    for (size_t i = 0; i < number_of_taps; i++)
+        coefficients[i] /= reference_gain;
+
+    return ESP_OK;
+}
@@ -0,0 +1,95 @@
+#ifndef FILTER_TRANSFORM_H_
+#define FILTER_TRANSFORM_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "esp_log.h"
+#include "esp_dsp.h"
+
+#include "window_transform.h"
+
+#define FILTER_TRANSFORM_TAG ("FILTER_TRANSFORM_H_")
+
+#define MAXIMUM_BIQUAD_SECTIONS (8) // The number of second-order sections of a cascade (so a low-pass or high-pass has an order of at most 16, and a band-pass of at most 8).
+#define MAXIMUM_FIR_TAPS (129)      // The number of taps of a FIR filter (an order of at most 128).
+#define BIQUAD_COEFFICIENTS_LENGTH (5)
+
+#define FILTER_BLOCK_LENGTH (256) // The number of samples that pass through all the sections, before the next block is processed.
+#define DEFAULT_FILTER_ORDER (4)
+#define FIR_DESIGN_WINDOW (BLACKMAN_WINDOW_F32)
+
+/// @brief This is an enumeration called `filter_structure_t` with the different implementations of the filter stage.
+typedef enum filter_structure {
+    NO_FILTER,     // The samples pass unchanged (the default).
+    BIQUAD_FILTER, // A cascade of Butterworth second-order sections, processed with `dsps_biquad_f32`.
+    FIR_FILTER     // A windowed-sinc FIR filter with linear phase, processed with `dsps_fir_f32`.
+} filter_structure_t;
+
+/// @brief This is an enumeration called `filter_response_t` with the different frequency responses of the filter stage.
+typedef enum filter_response {
+    LOW_PASS_FILTER,  // Passes the frequencies below `high_frequency`.
+    HIGH_PASS_FILTER, // Passes the frequencies above `low_frequency`.
+    BAND_PASS_FILTER  // Passes the frequencies between `low_frequency` and `high_frequency`.
+} filter_response_t;
+
+/// @brief Defining a struct called `filter_config`, that contains the settings of the filter stage.
+typedef struct filter_config {
+    filter_structure_t structure; // This field contains the `filter_structure_t` of the filter.
+    filter_response_t response;   // This field contains the `filter_response_t` of the filter.
+
+    float low_frequency;  // This field contains a `float` with the cutoff frequency of a high-pass, or the lower edge of a band-pass (in Hz).
+    float high_frequency; // This field contains a `float` with the cutoff frequency of a low-pass, or the upper edge of a band-pass (in Hz).
+
+    size_t order; // This field contains a `size_t` with the (even) order of the filter. A band-pass cascade has this order on both of its edges.
+} filter_config_t;
+
+/// @brief Defining a struct called `filter_stage`, that contains a configured filter, its designed coefficients and its state, which is kept between blocks and calls.
+typedef struct filter_stage {
+    filter_config_t config; // This field contains the `filter_config_t` settings of the filter.
+
+    bool is_designed;        // This field contains a `bool`, indicating if the coefficients below match the settings and `sample_frequency`.
+    size_t sample_frequency; // This field contains a `size_t` with the sample frequency for which the coefficients are designed (in Hz).
+
+    size_t number_of_sections;                                                    // This field contains a `size_t` with the number of used second-order sections.
+    float biquad_coefficients[MAXIMUM_BIQUAD_SECTIONS][BIQUAD_COEFFICIENTS_LENGTH]; // This field contains the coefficients `b0, b1, b2, a1, a2` of every section.
+    float biquad_states[MAXIMUM_BIQUAD_SECTIONS][2];                              // This field contains the delay line of every section.
+
+    float fir_coefficients[MAXIMUM_FIR_TAPS]; // This field contains the taps of the FIR filter.
+    float fir_delay[MAXIMUM_FIR_TAPS];        // This field contains the delay line of the FIR filter.
+    fir_f32_t fir;                            // This field contains the `fir_f32_t` instance of esp-dsp, that owns the position in the delay line.
+} filter_stage_t;
+
+/// @brief This function checks the settings of a filter, and applies them to the filter stage. The coefficients are designed (and the state is cleared) on the next call to `apply_filter_stage`.
+/// @param filter_stage A pointer to the `filter_stage_t` structure.
+/// @param filter_config A pointer to the new settings.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the settings are invalid (the previous settings are kept).
+extern esp_err_t configure_filter_stage(filter_stage_t* filter_stage, const filter_config_t* filter_config);
+
+/// @brief This function filters a buffer of samples in-place, in blocks of `FILTER_BLOCK_LENGTH` samples that pass through all the sections before the next block. The state of the filter continues from the previous call.
+/// @param filter_stage A pointer to the `filter_stage_t` structure.
+/// @param samples A pointer to the samples, which are replaced by the filtered samples.
+/// @param sample_length The number of samples.
+/// @param sample_frequency The sample frequency of the samples (in Hz). The coefficients are designed again when it changes.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t apply_filter_stage(filter_stage_t* filter_stage, float* samples, size_t sample_length, size_t sample_frequency);
+
+/// @brief This function filters a periodic frame of samples in-place (a frame that is repeated as it is, like the frame of the synthesizer that the DAC loops). The frame is filtered twice from rest, and the second pass is kept, so the frame starts in the state at its own end: without the transient of the filter, and without a discontinuity where the frame wraps around. This is exact for a FIR filter (with fewer taps than samples), and for a biquad cascade whose response decays within the frame.
+/// @param filter_stage A pointer to the `filter_stage_t` structure.
+/// @param samples A pointer to the samples of one period, which are replaced by the filtered samples.
+/// @param sample_length The number of samples.
+/// @param sample_frequency The sample frequency of the samples (in Hz). The coefficients are designed again when it changes.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully, `ESP_ERR_NO_MEM` if the copy of the frame could not be allocated, or `ESP_FAIL` if there is an error (for example a filter that does not fit the sample frequency).
+extern esp_err_t apply_periodic_filter_stage(filter_stage_t* filter_stage, float* samples, size_t sample_length, size_t sample_frequency);
+
+/// @brief This function designs the taps of a linear-phase FIR filter with the windowed-sinc method (using the `FIR_DESIGN_WINDOW` window), normalized to a gain of one in the pass band.
+/// @param coefficients A pointer to an array where the taps will be stored.
+/// @param number_of_taps The number of taps (odd, so a high-pass is possible as well).
+/// @param response The `filter_response_t` of the filter.
+/// @param low_frequency The cutoff frequency of a high-pass, or the lower edge of a band-pass, relative to the sample frequency.
+/// @param high_frequency The cutoff frequency of a low-pass, or the upper edge of a band-pass, relative to the sample frequency.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t design_fir_filter_f32(float* coefficients, size_t number_of_taps, filter_response_t response, float low_frequency, float high_frequency);
+
+#endif
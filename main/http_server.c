@@ -25,6 +25,17 @@ void start_wifi_connection(const char* ssid_name, const char* pass_name) {
 void start_webserver(httpd_handle_t server_handle) {
     httpd_config_t http_configuration = HTTPD_DEFAULT_CONFIG(); // Create the default HTTP server configuration.
 
+    http_configuration.max_uri_handlers = MAXIMUM_URI_HANDLERS; // Raise the number of URI handlers (the default of 8 is too small for all the endpoints).
+
+    program_data.source_lock = xSemaphoreCreateMutex(); // Create the mutex that guards the source, before a handler or the worker of the FFT jobs can use it.
+
+    // Check if the mutex could be created:
+    if (program_data.source_lock == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' could not be 'NULL'!", "source_lock");
+
+        return;
+    }
+
     ESP_ERROR_CHECK(httpd_start(&server_handle, &http_configuration)); // Start the HTTP server with the provided server handle and configuration.
 
     // Define the URI and corresponding handler for the `/wave` endpoint:
@@ -43,6 +54,22 @@ void start_webserver(httpd_handle_t server_handle) {
         .user_ctx = NULL
     };
 
+    // Define the URI and corresponding handler for the `/fft/status` endpoint:
+    httpd_uri_t fft_status_uri = {
+        .uri = "/fft/status",
+        .method = HTTP_GET,
+        .handler = fft_status_get_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for the `/fft/result` endpoint:
+    httpd_uri_t fft_result_uri = {
+        .uri = "/fft/result",
+        .method = HTTP_GET,
+        .handler = fft_result_get_handler,
+        .user_ctx = NULL
+    };
+
     // Define the URI and corresponding handler for the `/dac` endpoint:
     httpd_uri_t dac_uri = {
         .uri = "/dac",
@@ -51,10 +78,92 @@ void start_webserver(httpd_handle_t server_handle) {
         .user_ctx = NULL
     };
 
+    // Define the URI and corresponding handler for the `/source` endpoint:
+    httpd_uri_t source_uri = {
+        .uri = "/source",
+        .method = HTTP_POST,
+        .handler = source_post_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for the `/filter` endpoint:
+    httpd_uri_t filter_uri = {
+        .uri = "/filter",
+        .method = HTTP_POST,
+        .handler = filter_post_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for the `/replay` endpoint:
+    httpd_uri_t replay_uri = {
+        .uri = "/replay",
+        .method = HTTP_POST,
+        .handler = replay_post_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for the `/correlate` endpoint:
+    httpd_uri_t correlate_uri = {
+        .uri = "/correlate",
+        .method = HTTP_POST,
+        .handler = correlate_post_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for the `/metrics` endpoint:
+    httpd_uri_t metrics_uri = {
+        .uri = "/metrics",
+        .method = HTTP_POST,
+        .handler = metrics_post_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for the `/stream` WebSocket endpoint:
+    httpd_uri_t stream_uri = {
+        .uri = "/stream",
+        .method = HTTP_GET,
+        .handler = stream_ws_handler,
+        .user_ctx = NULL,
+        .is_websocket = true
+    };
+
+    // Define the URI and corresponding handler for reading the `/trace` endpoint:
+    httpd_uri_t trace_get_uri = {
+        .uri = "/trace",
+        .method = HTTP_GET,
+        .handler = trace_get_handler,
+        .user_ctx = NULL
+    };
+
+    // Define the URI and corresponding handler for configuring the `/trace` endpoint:
+    httpd_uri_t trace_post_uri = {
+        .uri = "/trace",
+        .method = HTTP_POST,
+        .handler = trace_post_handler,
+        .user_ctx = NULL
+    };
+
     // Register the URI handlers with the HTTP server:
     httpd_register_uri_handler(server_handle, &wave_uri);
     httpd_register_uri_handler(server_handle, &fft_uri);
+    httpd_register_uri_handler(server_handle, &fft_status_uri);
+    httpd_register_uri_handler(server_handle, &fft_result_uri);
     httpd_register_uri_handler(server_handle, &dac_uri);
+    httpd_register_uri_handler(server_handle, &source_uri);
+    httpd_register_uri_handler(server_handle, &filter_uri);
+    httpd_register_uri_handler(server_handle, &replay_uri);
+    httpd_register_uri_handler(server_handle, &correlate_uri);
+    httpd_register_uri_handler(server_handle, &metrics_uri);
+    httpd_register_uri_handler(server_handle, &stream_uri);
+    httpd_register_uri_handler(server_handle, &trace_get_uri);
+    httpd_register_uri_handler(server_handle, &trace_post_uri);
+
+#ifdef FFT_STATIC_LENGTH
+    _Static_assert(NUMBER_OF_SAMPLES <= FFT_STATIC_LENGTH, "The generated FFT tables must cover the frame size of the FFT!");
+#endif
+
+    ESP_ERROR_CHECK(start_fft_job_queue(&fft_job_queue, NUMBER_OF_SAMPLES, capture_program_samples));                                       // Start the worker that drains the queue of FFT jobs (which captures the samples of a live source).
+    ESP_ERROR_CHECK(start_spectrum_stream(&spectrum_stream, server_handle, program_data.samples, NUMBER_OF_SAMPLES, &program_data.window)); // Start streaming the spectrum to the WebSocket clients.
 
     ESP_LOGI(WIFI_SERVER_TAG, "The webserver with all the URI handlers is started!");
 }
@@ -117,17 +226,66 @@ esp_err_t wave_post_handler(httpd_req_t* request) {
         return ESP_FAIL;
     }
 
-    ESP_LOGI(WIFI_SERVER_TAG, "The 'wave_post_handler' function is invoked, with content '%s'", content);
+    bool is_binary_content = request_has_binary_content(request);
+
+    trace_request(WAVE_REQUEST_TRACE, "wave_post_handler", content, return_length, is_binary_content); // Record the request, without blocking on the console.
 
     ESP_ERROR_CHECK(oled_view_info("Call to 'wave'!")); // Display an informational message on the OLED.
 
-    ESP_ERROR_CHECK(parse_wave_data(content)); // Parse the wave data from the content.
+    dac_output_channels_t wave_channels = DAC_OUTPUT_CHANNEL_1; // The channels that receive the waves (a binary message always targets the source).
+
+    // Parse the wave data from the content (in the binary format or as JSON):
+    if (is_binary_content) {
+        if (parse_wave_binary((const uint8_t*)content, return_length) != ESP_OK) {
+            httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid binary wave message!");
+
+            return ESP_FAIL;
+        }
+    }
+    else if (parse_wave_data(content, &wave_channels) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid wave data, or a sample frequency that the DAC does not support!");
+
+        return ESP_FAIL;
+    }
+
+    take_source_lock();
+
+    // Switch back to the synthesizer, if the samples are currently fed by another source (or no source is opened), unless the waves are only for the second channel:
+    if ((wave_channels & DAC_OUTPUT_CHANNEL_1) && (program_data.sample_source.type != SYNTHESIZER_SOURCE || program_data.sample_source.read == NULL)) {
+        ESP_ERROR_CHECK(close_sample_source(&program_data.sample_source));
+        ESP_ERROR_CHECK(open_synthesizer_source(&program_data.sample_source, program_data.waves, &program_data.number_of_waves, program_data.sample_frequency));
+    }
+
+    bool generates_samples = program_data.sample_source.type == SYNTHESIZER_SOURCE && program_data.sample_source.read != NULL; // A live source keeps its samples.
+
+    if (generates_samples)
+        program_data.sample_source.sample_frequency = program_data.sample_frequency;
+
+    give_source_lock();
+
+    // Generate the waveforms of the synthesizer again, since the waves or the sample frequency may have changed:
+    if (generates_samples) {
+        if (read_program_samples() != ESP_OK) {
+            httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The waves are stored, but their samples could not be generated!");
+
+            return ESP_FAIL;
+        }
+
+        ESP_ERROR_CHECK(reset_spectrum_average()); // Discard the spectra of the previous waves from the average.
+    }
+
+    // Stage the new values (and sample frequency) of the DAC, if it is outputting the samples (the running output swaps them in without a glitch):
+    if (program_data.dac_is_enabled) {
+        if (output_program_dac_values() != ESP_OK) {
+            httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The waves are applied, but could not be output by the DAC!"); // The sample frequency is already checked while parsing.
 
-    // Reset the sampled data.
-    for (int i = 0; i < NUMBER_OF_SAMPLES; i++)
-        program_data.samples[i] = 0;
+            return ESP_FAIL;
+        }
+    }
 
-    ESP_ERROR_CHECK(generate_waves_f32(program_data.waves, program_data.samples, NUMBER_OF_SAMPLES, program_data.number_of_waves)); // Generate the waveforms based on the wave data.
+    // Store the new waves, so they are restored after a reboot:
+    if (save_program_data(program_data.dac_is_enabled) != ESP_OK)
+        ESP_LOGE(WIFI_SERVER_TAG, "The waves are applied, but could not be stored!");
 
     // Send a response indicating successful execution of the function.
     const char* response = "Successful execution of the function 'wave_post_handler'!\n";
@@ -149,20 +307,114 @@ esp_err_t fft_post_handler(httpd_req_t* request) {
         return ESP_FAIL;
     }
 
-    ESP_LOGI(WIFI_SERVER_TAG, "The 'fft_post_handler' function is invoked, with content '%s'", content);
+    bool is_binary_content = request_has_binary_content(request);
+
+    trace_request(FFT_REQUEST_TRACE, "fft_post_handler", content, return_length, is_binary_content); // Record the request, without blocking on the console.
 
     ESP_ERROR_CHECK(oled_view_info("Call to 'fft'!")); // Display an informational message on the OLED.
 
-    ESP_ERROR_CHECK(parse_fft_data(content)); // Parse the FFT data from the content.
+    // Parse the FFT data from the content (in the binary format or as JSON):
+    if (is_binary_content) {
+        if (parse_fft_binary((const uint8_t*)content, return_length) != ESP_OK) {
+            httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid binary FFT message!");
+
+            return ESP_FAIL;
+        }
+    }
+    else if (parse_fft_data(content) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid FFT data!");
+
+        return ESP_FAIL;
+    }
 
-    fft_data_t data_for_fft = {}; // Create an instance of `fft_data_t`.
+    // A live source is captured by the worker, so the request returns at once (the synthesizer already generated its samples on the call to `/wave`, so they are copied):
+    const float* job_samples = (program_data.sample_source.type == SYNTHESIZER_SOURCE) ? program_data.samples : NULL;
 
-    ESP_ERROR_CHECK(initialize_fft_f32(&data_for_fft));                                                                                         // Initialize the FFT module.
-    ESP_ERROR_CHECK(apply_fft_f32(&data_for_fft, program_data.samples, program_data.window, NUMBER_OF_SAMPLES, program_data.sample_frequency)); // Apply FFT on the sample data using the initialized FFT module.
-    ESP_ERROR_CHECK(de_initialize_fft_f32(&data_for_fft));                                                                                      // De-initialize the FFT module.
+    uint32_t job_id = 0;
 
-    // Send a response indicating successful execution of the function:
-    const char* response = "Successful execution of the function 'fft_post_handler'!\n";
+    esp_err_t succeeded_submit = submit_fft_job(&fft_job_queue, job_samples, program_data.window, program_data.sample_frequency, program_data.peak_config, program_data.averaging_config, &job_id); // Queue the FFT for the worker.
+
+    // Check if the job is queued (a busy worker is reported, instead of holding the connection until it is free):
+    if (succeeded_submit != ESP_OK) {
+        if (succeeded_submit == ESP_ERR_NO_MEM) {
+            httpd_resp_set_status(request, "503 Service Unavailable");
+            httpd_resp_send(request, "Too many pending FFT jobs!", HTTPD_RESP_USE_STRLEN);
+        }
+        else
+            httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The FFT job could not be queued!");
+
+        return ESP_FAIL;
+    }
+
+    // Store the window, so it is restored after a reboot:
+    if (save_program_data(false) != ESP_OK)
+        ESP_LOGE(WIFI_SERVER_TAG, "The window is applied, but could not be stored!");
+
+    char response[MAXIMUM_RESPONSE_LENGTH] = {};
+
+    // A binary client expects the peaks in the response, so wait for the job (the FFT still runs on the worker):
+    if (is_binary_content) {
+        fft_job_t job = {};
+
+        if (wait_fft_job(&fft_job_queue, job_id, FFT_JOB_BINARY_TIMEOUT_MS, &job) != ESP_OK || job.status != DONE_FFT_JOB) {
+            httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The FFT job did not finish!");
+
+            return ESP_FAIL;
+        }
+
+        size_t response_length = 0;
+
+        ESP_ERROR_CHECK(format_peak_binary_response(&job.result, (uint8_t*)response, sizeof(response) / sizeof(response[0]), &response_length)); // Format the found peaks as the binary response.
+
+        httpd_resp_set_type(request, BINARY_PROTOCOL_CONTENT_TYPE);
+        httpd_resp_send(request, response, response_length);
+
+        return ESP_OK;
+    }
+
+    // Send a response with the ID of the job, which is polled on `/fft/status` and `/fft/result`:
+    snprintf(response, sizeof(response) / sizeof(response[0]), "{\"job_id\":%u,\"status\":\"%s\"}\n", (unsigned int)job_id, get_fft_job_status_name(QUEUED_FFT_JOB));
+
+    httpd_resp_set_status(request, "202 Accepted");
+    httpd_resp_set_type(request, "application/json");
+    httpd_resp_send(request, response, strlen(response));
+
+    return ESP_OK;
+}
+
+esp_err_t fft_status_get_handler(httpd_req_t* request) {
+    fft_job_t job = {};
+
+    // Look up the job of the `id` query parameter:
+    if (find_requested_fft_job(request, &job) != ESP_OK)
+        return ESP_FAIL;
+
+    char response[MAXIMUM_RESPONSE_LENGTH] = {};
+
+    snprintf(response, sizeof(response) / sizeof(response[0]), "{\"job_id\":%u,\"status\":\"%s\"}\n", (unsigned int)job.job_id, get_fft_job_status_name(job.status));
+
+    httpd_resp_set_type(request, "application/json");
+    httpd_resp_send(request, response, strlen(response));
+
+    return ESP_OK;
+}
+
+esp_err_t fft_result_get_handler(httpd_req_t* request) {
+    fft_job_t job = {};
+
+    // Look up the job of the `id` query parameter:
+    if (find_requested_fft_job(request, &job) != ESP_OK)
+        return ESP_FAIL;
+
+    char response[MAXIMUM_RESPONSE_LENGTH] = {};
+
+    ESP_ERROR_CHECK(format_fft_job_response(&job, response, sizeof(response) / sizeof(response[0]))); // Format the status of the job, and its peaks if it is done.
+
+    // A job that is not finished yet is reported with its status only:
+    if (job.status == QUEUED_FFT_JOB || job.status == RUNNING_FFT_JOB)
+        httpd_resp_set_status(request, "202 Accepted");
+
+    httpd_resp_set_type(request, "application/json");
     httpd_resp_send(request, response, strlen(response));
 
     return ESP_OK;
@@ -181,19 +433,44 @@ esp_err_t dac_post_handler(httpd_req_t* request) {
         return ESP_FAIL;
     }
 
-    ESP_LOGI(WIFI_SERVER_TAG, "The 'dac_post_handler' function is invoked, with content '%s'", content);
+    bool is_binary_content = request_has_binary_content(request);
+
+    trace_request(DAC_REQUEST_TRACE, "dac_post_handler", content, return_length, is_binary_content); // Record the request, without blocking on the console.
 
     ESP_ERROR_CHECK(oled_view_info("Call to 'dac'!")); // Display an informational message on the OLED.
 
-    ESP_ERROR_CHECK(parse_dac_data(content)); // Parse the DAC data from the content.
+    // Parse the DAC data from the content (in the binary format or as JSON):
+    if (is_binary_content) {
+        if (parse_dac_binary((const uint8_t*)content, return_length) != ESP_OK) {
+            httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid binary DAC message!");
+
+            return ESP_FAIL;
+        }
+    }
+    else if (parse_dac_data(content) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid DAC data!");
+
+        return ESP_FAIL;
+    }
+
+    // Set the DAC configurations:
+    portENTER_CRITICAL(&dac_data.lock);
+    dac_data.swap_mode = program_data.dac_swap_mode;
+    dac_data.keep_phase = program_data.keep_dac_phase;
+    portEXIT_CRITICAL(&dac_data.lock);
 
-    // Set the DAC data values and configurations:
-    dac_data.digital_samples = program_data.samples;
-    dac_data.number_of_samples = NUMBER_OF_SAMPLES;
+    // Convert the samples into DAC values once (instead of on every tick of the timer), and output them with the specified sample frequency (a running output swaps them in without a glitch):
+    if (output_program_dac_values() != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "The sample frequency (times the interpolation factor) is not supported by the DAC!");
 
-    dac_data.prevent_dac_overflow_conversion = program_data.prevent_dac_overflow;
-    
-    ESP_ERROR_CHECK(dac_output_values(program_data.sample_frequency)); // Output the DAC values with the specified sample frequency.
+        return ESP_FAIL;
+    }
+
+    program_data.dac_is_enabled = true;
+
+    // Store the DAC settings and values, so the output resumes after a reboot:
+    if (save_program_data(true) != ESP_OK)
+        ESP_LOGE(WIFI_SERVER_TAG, "The DAC settings are applied, but could not be stored!");
 
     // Send a response indicating successful execution of the function:
     const char* response = "Successful execution of the function 'dac_post_handler'!\n";
@@ -202,156 +479,2132 @@ esp_err_t dac_post_handler(httpd_req_t* request) {
     return ESP_OK;
 }
 
-esp_err_t parse_wave_data(const char* json_data) {
-    cJSON* root = cJSON_Parse(json_data);
+esp_err_t source_post_handler(httpd_req_t* request) {
+    char content[MAXIMUM_CONTENT_LENGTH] = {};
 
-    // Failed to parse the JSON data:
-    if (root == NULL) {
-        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+    int return_length = httpd_req_recv(request, content, sizeof(content) / sizeof(content[0])); // Receive the content of the HTTP POST request.
+
+    // Check if an error occurred or the request timed out:
+    if (return_length <= 0) {
+        if (return_length == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(request);
 
         return ESP_FAIL;
     }
 
-    cJSON* sample_frequency_item = cJSON_GetObjectItem(root, "sample_frequency");
+    trace_request(SOURCE_REQUEST_TRACE, "source_post_handler", content, return_length, false); // Record the request, without blocking on the console.
 
-    // Check if `sample_frequency` item exists and is a number:
-    if (cJSON_IsNumber(sample_frequency_item)) 
-        program_data.sample_frequency = sample_frequency_item->valueint;
+    ESP_ERROR_CHECK(oled_view_info("Call to 'src'!")); // Display an informational message on the OLED.
 
-    cJSON* waves_array = cJSON_GetObjectItem(root, "waves");
+    // Parse the source data from the content, and open the selected source (the current source is kept when it fails):
+    take_source_lock();
 
-    // Check if `waves` item exists and is an array:
-    if (!cJSON_IsArray(waves_array)) {
-        ESP_LOGE(WIFI_SERVER_TAG, "Invalid waves array in JSON data!");
+    esp_err_t succeeded_parsing = parse_source_data(content);
 
-        cJSON_Delete(root);
+    give_source_lock();
+
+    if (succeeded_parsing != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid source configuration!");
 
         return ESP_FAIL;
     }
 
-    int wave_count = cJSON_GetArraySize(waves_array);
+    ESP_ERROR_CHECK(reset_spectrum_average()); // Discard the spectra of the previous source from the average.
 
-    // Truncate the wave count if it exceeds the maximum supported waves:
-    if (wave_count > MAXIMUM_WAVES_LENGTH) {
-        ESP_LOGW(WIFI_SERVER_TAG, "Received more waves than supported. Truncating it to '%d' waves!", MAXIMUM_WAVES_LENGTH);
+    // Send a response indicating successful execution of the function:
+    const char* response = "Successful execution of the function 'source_post_handler'!\n";
+    httpd_resp_send(request, response, strlen(response));
 
-        wave_count = MAXIMUM_WAVES_LENGTH;
+    return ESP_OK;
+}
+
+esp_err_t filter_post_handler(httpd_req_t* request) {
+    char content[MAXIMUM_CONTENT_LENGTH] = {};
+
+    int return_length = httpd_req_recv(request, content, sizeof(content) / sizeof(content[0])); // Receive the content of the HTTP POST request.
+
+    // Check if an error occurred or the request timed out:
+    if (return_length <= 0) {
+        if (return_length == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(request);
+
+        return ESP_FAIL;
     }
 
-    for (int i = 0; i < wave_count; i++) {
-        cJSON* wave_item = cJSON_GetArrayItem(waves_array, i);
-        cJSON* amplitude_item = cJSON_GetObjectItem(wave_item, "amplitude");
-        cJSON* frequency_item = cJSON_GetObjectItem(wave_item, "frequency");
-        cJSON* phase_item = cJSON_GetObjectItem(wave_item, "phase");
-        cJSON* offset_item = cJSON_GetObjectItem(wave_item, "offset");
+    trace_request(FILTER_REQUEST_TRACE, "filter_post_handler", content, return_length, false); // Record the request, without blocking on the console.
 
-        // Check if all required wave properties exist and are numbers:
-        if (cJSON_IsNumber(amplitude_item) && cJSON_IsNumber(frequency_item) && cJSON_IsNumber(phase_item) && cJSON_IsNumber(offset_item)) {
-            float frequency = (float)frequency_item->valuedouble;
-            float absolute_frequency = frequency / program_data.sample_frequency;
-
-            // Check if the absolute frequency is valid:
-            if (absolute_frequency <= 1.0f) {
-                program_data.waves[i].amplitude = (float)amplitude_item->valuedouble;
-                program_data.waves[i].frequency = absolute_frequency;
-                program_data.waves[i].phase = (float)phase_item->valuedouble;
-                program_data.waves[i].offset = (float)offset_item->valuedouble;
-            }
-            else
-                ESP_LOGW(WIFI_SERVER_TAG, "Wave '%d' is ignored due to an invalid frequency of '%.2f' Hz!", i, frequency);
-        }
+    ESP_ERROR_CHECK(oled_view_info("Call to 'flt'!")); // Display an informational message on the OLED.
+
+    // Parse the filter data from the content, and configure the filter stage with it:
+    take_source_lock();
+
+    esp_err_t succeeded_parsing = parse_filter_data(content);
+
+    give_source_lock();
+
+    if (succeeded_parsing != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid filter configuration!");
+
+        return ESP_FAIL;
     }
 
-    program_data.number_of_waves = wave_count;
+    // Filter the samples of the synthesizer again (a live source is filtered on its next read):
+    if (program_data.sample_source.type == SYNTHESIZER_SOURCE && program_data.sample_frequency > 0 && read_program_samples() != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The filter is applied, but the samples could not be filtered!");
 
-    cJSON_Delete(root);
+        return ESP_FAIL;
+    }
+
+    ESP_ERROR_CHECK(reset_spectrum_average()); // Discard the spectra of the unfiltered samples from the average.
+
+    // Stage the filtered values of the DAC, if it is outputting the samples:
+    if (program_data.dac_is_enabled && program_data.sample_source.type == SYNTHESIZER_SOURCE && output_program_dac_values() != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The filter is applied, but could not be output by the DAC!");
+
+        return ESP_FAIL;
+    }
+
+    // Store the new filter, so it is restored after a reboot:
+    if (save_program_data(program_data.dac_is_enabled) != ESP_OK)
+        ESP_LOGE(WIFI_SERVER_TAG, "The filter is applied, but could not be stored!");
+
+    // Send a response indicating successful execution of the function:
+    const char* response = "Successful execution of the function 'filter_post_handler'!\n";
+    httpd_resp_send(request, response, strlen(response));
 
     return ESP_OK;
 }
 
-esp_err_t parse_fft_data(const char* json_data) {
-    cJSON* root = cJSON_Parse(json_data);
+esp_err_t replay_post_handler(httpd_req_t* request) {
+    size_t content_length = request->content_len;
 
-    // Failed to parse the JSON data:
-    if (root == NULL) {
-        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+    // Check if the recording has a supported length:
+    if (content_length < REPLAY_HEADER_LENGTH || content_length > REPLAY_MAXIMUM_LENGTH) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The recording has an unsupported length of '%d' bytes!", (int)content_length);
+
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Unsupported length of the recording!");
 
         return ESP_FAIL;
     }
 
-    cJSON* window_item = cJSON_GetObjectItem(root, "window");
+    uint8_t* recording = malloc(content_length); // Allocate memory for the complete recording.
 
-    // Define a structure to map window names to window configurations:
-    typedef struct {
-        const char* window_name;
-        window_config_t window_config;
-    } window_mapping_t;
+    // Check if the memory allocation was successful:
+    if (recording == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' could not be 'NULL'!", "recording");
 
-    // Define the mappings of window names to window configurations:
-    const window_mapping_t window_mappings[] = {
-        {"HANN_F32", HANN_WINDOW_F32},
-        {"BLACKMAN_F32", BLACKMAN_WINDOW_F32},
-        {"BLACKMAN_HARRIS_F32", BLACKMAN_HARRIS_WINDOW_F32},
-        {"BLACKMAN_NUTTALL_F32", BLACKMAN_NUTTALL_WINDOW_F32},
-        {"NUTTALL_F32", NUTTALL_WINDOW_F32},
-        {"FLAT_TOP_F32", FLAT_TOP_WINDOW_F32}
-    };
+        return ESP_FAIL;
+    }
 
-    if (cJSON_IsString(window_item)) {
-        const char* window_string = window_item->valuestring;
-        int num_mappings = sizeof(window_mappings) / sizeof(window_mappings[0]);
+    size_t received_length = 0;
+    size_t number_of_timeouts = 0;
 
-        // Iterate through the window mappings and find a match for the provided window name:
-        for (int i = 0; i < num_mappings; i++) {
-            if (strcmp(window_string, window_mappings[i].window_name) == 0) {
-                program_data.window = window_mappings[i].window_config;
+    // Receive the complete recording, which arrives in multiple parts:
+    while (received_length < content_length) {
+        int return_length = httpd_req_recv(request, (char*)&recording[received_length], content_length - received_length);
 
-                cJSON_Delete(root);
+        // Retry on a few timeouts in a row (a stalled client does not keep the worker of the server forever), and stop on any other error:
+        if (return_length == HTTPD_SOCK_ERR_TIMEOUT && ++number_of_timeouts < MAXIMUM_RECEIVE_TIMEOUTS)
+            continue;
 
-                return ESP_OK;
-            }
+        if (return_length <= 0) {
+            if (return_length == HTTPD_SOCK_ERR_TIMEOUT)
+                httpd_resp_send_408(request);
+
+            free(recording);
+
+            return ESP_FAIL;
         }
 
-        ESP_LOGW(WIFI_SERVER_TAG, "Unknown window configuration '%s'!", window_string); // The provided window name does not match any known window configurations.
-    } 
-    else 
-        ESP_LOGW(WIFI_SERVER_TAG, "Invalid window configuration in JSON data!"); // The `window` item is not a string
+        number_of_timeouts = 0;
+        received_length += return_length;
+    }
 
-    cJSON_Delete(root);
+    trace_request(REPLAY_REQUEST_TRACE, "replay_post_handler", NULL, content_length, true); // Record the request, without blocking on the console.
 
-    return ESP_OK;
-}
+    ESP_ERROR_CHECK(oled_view_info("Call to 'rpl'!")); // Display an informational message on the OLED.
 
-esp_err_t parse_dac_data(const char* json_data) {
-    cJSON* root = cJSON_Parse(json_data);
+    sample_source_t replay_source = {};
 
-    // Failed to parse the JSON data:
-    if (root == NULL) {
-        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse the JSON data!");
+    // Open the recording as the new source, which becomes the owner of the recording:
+    if (open_replay_memory_source(&replay_source, recording, content_length, true) != ESP_OK) {
+        free(recording);
+
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid recording!");
 
         return ESP_FAIL;
     }
 
-    cJSON* prevent_overflow_value = cJSON_GetObjectItem(root, "prevent_overflow_value");
+    // Replace the current source with the recording:
+    take_source_lock();
 
-    // Check if `prevent_overflow_value` is a boolean true value:
-    if (cJSON_IsTrue(prevent_overflow_value)) 
-        program_data.prevent_dac_overflow = true;
+    ESP_ERROR_CHECK(close_sample_source(&program_data.sample_source));
 
-    // Check if `prevent_overflow_value` is a boolean false value:
-    else if (cJSON_IsFalse(prevent_overflow_value))
-        program_data.prevent_dac_overflow = false;
+    program_data.sample_source = replay_source;
+    program_data.sample_frequency = replay_source.sample_frequency;
 
-    // Failed to parse `prevent_overflow_value` or it is not a boolean:
-    else {
-        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse 'prevent_overflow_value', or it is not a boolean!");
+    give_source_lock();
 
-        cJSON_Delete(root);
+    // Load the first samples of the recording (and filter them):
+    if (read_program_samples() != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The recording is opened, but its samples could not be read!");
 
         return ESP_FAIL;
     }
 
-    cJSON_Delete(root);
+    ESP_ERROR_CHECK(reset_spectrum_average()); // Discard the spectra of the previous source from the average.
+
+    // Send a response indicating successful execution of the function:
+    const char* response = "Successful execution of the function 'replay_post_handler'!\n";
+    httpd_resp_send(request, response, strlen(response));
+
+    return ESP_OK;
+}
+
+esp_err_t correlate_post_handler(httpd_req_t* request) {
+    char content[MAXIMUM_CONTENT_LENGTH] = {};
+
+    int return_length = httpd_req_recv(request, content, sizeof(content) / sizeof(content[0])); // Receive the content of the HTTP POST request.
+
+    // Check if an error occurred or the request timed out:
+    if (return_length <= 0) {
+        if (return_length == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(request);
+
+        return ESP_FAIL;
+    }
+
+    trace_request(CORRELATE_REQUEST_TRACE, "correlate_post_handler", content, return_length, false); // Record the request, without blocking on the console.
+
+    ESP_ERROR_CHECK(oled_view_info("Call to 'cor'!")); // Display an informational message on the OLED.
+
+    // Parse the reference and the settings of the correlation from the content:
+    if (parse_correlation_data(content) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid correlation configuration!");
+
+        return ESP_FAIL;
+    }
+
+    size_t reference_length = program_data.reference_length;
+    size_t output_length = NUMBER_OF_SAMPLES + reference_length - 1; // The number of lags of the full result.
+
+    // Select the FFT length: a single block holds the full result, and a stream holds a few references per block:
+    size_t fft_length = (program_data.correlation_method == SINGLE_BLOCK_CORRELATION) ? get_correlation_fft_length(output_length) : get_streaming_fft_length(reference_length);
+
+    if (fft_length == 0) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "The samples and the reference do not fit in a single block, use 'OVERLAP_ADD' or 'OVERLAP_SAVE'!");
+
+        return ESP_FAIL;
+    }
+
+    float* reference = calloc(reference_length, sizeof(float)); // The samples of the reference (the waves are added onto zeros).
+    float* output = malloc(output_length * sizeof(float));      // The full result, of which the peak is searched.
+
+    // Check if the memory allocation was successful:
+    if (reference == NULL || output == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "reference", "output");
+
+        free(reference);
+        free(output);
+
+        return ESP_FAIL;
+    }
+
+    ESP_ERROR_CHECK(generate_waves_f32(program_data.reference_waves, reference, reference_length, program_data.number_of_reference_waves)); // Generate the reference from its waves.
+
+    correlation_kernel_t* kernel = &program_data.correlation_kernel;
+
+    // Transform the reference again only if it changed, and reuse the cached spectrum otherwise:
+    bool is_cached_kernel = kernel->kernel_spectrum != NULL && kernel->mode == program_data.correlation_mode && kernel->fft_length == fft_length && kernel->reference_length == reference_length && memcmp(program_data.correlation_reference, reference, reference_length * sizeof(float)) == 0;
+
+    if (!is_cached_kernel) {
+        free(program_data.correlation_reference);
+        program_data.correlation_reference = NULL;
+
+        if (prepare_correlation_kernel(kernel, reference, reference_length, program_data.correlation_mode, fft_length) != ESP_OK) {
+            httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The reference could not be prepared!");
+
+            free(reference);
+            free(output);
+
+            return ESP_FAIL;
+        }
+
+        program_data.correlation_reference = reference; // The kernel keeps the samples of its reference.
+    }
+    else
+        free(reference);
+
+    // Capture the next samples, if they are fed by a live source (the synthesizer already generated them on the call to `/wave`):
+    if (program_data.sample_source.type != SYNTHESIZER_SOURCE && read_program_samples() != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The samples could not be captured from the source!");
+
+        return ESP_FAIL;
+    }
+
+    int64_t start_time_us = esp_timer_get_time();
+
+    esp_err_t succeeded_correlation = ESP_OK;
+
+    // Process the samples in a single FFT, or stream them block by block and flush the last lags with zeros:
+    if (program_data.correlation_method == SINGLE_BLOCK_CORRELATION)
+        succeeded_correlation = apply_correlation_f32(kernel, program_data.samples, NUMBER_OF_SAMPLES, output);
+    else {
+        float* flush_samples = calloc(reference_length, sizeof(float)); // The zeros that push the last lags out of the stream.
+
+        ESP_ERROR_CHECK(reset_correlation_stream(kernel));
+
+        succeeded_correlation = (flush_samples != NULL) ? stream_correlation_f32(kernel, program_data.correlation_method, program_data.samples, NUMBER_OF_SAMPLES, output) : ESP_FAIL;
+
+        if (succeeded_correlation == ESP_OK)
+            succeeded_correlation = stream_correlation_f32(kernel, program_data.correlation_method, flush_samples, reference_length - 1, &output[NUMBER_OF_SAMPLES]);
+
+        free(flush_samples);
+    }
+
+    int64_t correlation_duration_us = esp_timer_get_time() - start_time_us;
+
+    if (succeeded_correlation != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The correlation failed!");
+
+        free(output);
+
+        return ESP_FAIL;
+    }
+
+    correlation_peak_t peak = {};
+
+    // A cross-correlation starts at the most negative lag, where only the last reference sample overlaps the first sample:
+    int first_lag = (program_data.correlation_mode == CROSS_CORRELATION) ? -(int)(reference_length - 1) : 0;
+
+    ESP_ERROR_CHECK(find_correlation_peak_f32(output, output_length, first_lag, &peak));
+
+    if (program_data.correlation_mode == CROSS_CORRELATION)
+        ESP_ERROR_CHECK(normalize_correlation_peak_f32(&peak, program_data.samples, NUMBER_OF_SAMPLES, program_data.correlation_reference, reference_length));
+
+    free(output);
+
+    record_trace_event(&trace_buffer, CORRELATION_TRACE, TRACE_LEVEL_INFO, (const int32_t[TRACE_EVENT_VALUES]){correlation_duration_us, output_length, reference_length}, (const float[TRACE_EVENT_MEASUREMENTS]){peak.value, peak.lag});
+
+    char response[MAXIMUM_RESPONSE_LENGTH] = {};
+
+    // Send a response with the peak, and its lag in samples and in time:
+    snprintf(response, sizeof(response) / sizeof(response[0]), "{\"mode\":\"%s\",\"method\":\"%s\",\"fft_length\":%u,\"cached\":%s,\"lag\":%.3f,\"delay_ms\":%.4f,\"peak\":%.6g,\"normalized_peak\":%.4f,\"duration_us\":%lld}\n",
+             get_correlation_mode_name(program_data.correlation_mode),
+             get_correlation_method_name(program_data.correlation_method),
+             (unsigned int)fft_length,
+             is_cached_kernel ? "true" : "false",
+             peak.lag,
+             (program_data.sample_frequency > 0) ? peak.lag * 1000.0f / program_data.sample_frequency : 0.0f,
+             peak.value,
+             peak.normalized_value,
+             (long long)correlation_duration_us);
+
+    httpd_resp_set_type(request, "application/json");
+    httpd_resp_send(request, response, strlen(response));
+
+    return ESP_OK;
+}
+
+esp_err_t metrics_post_handler(httpd_req_t* request) {
+    char content[MAXIMUM_CONTENT_LENGTH] = {};
+
+    int return_length = httpd_req_recv(request, content, sizeof(content) / sizeof(content[0])); // Receive the content of the HTTP POST request.
+
+    // Check if an error occurred or the request timed out:
+    if (return_length <= 0) {
+        if (return_length == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(request);
+
+        return ESP_FAIL;
+    }
+
+    trace_request(METRICS_REQUEST_TRACE, "metrics_post_handler", content, return_length, false); // Record the request, without blocking on the console.
+
+    ESP_ERROR_CHECK(oled_view_info("Call to 'met'!")); // Display an informational message on the OLED.
+
+    // Parse the settings of the measurement from the content:
+    if (parse_metrics_data(content) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid metrics configuration!");
+
+        return ESP_FAIL;
+    }
+
+    // Capture the next samples, if they are fed by a live source (the synthesizer already generated them on the call to `/wave`):
+    if (program_data.sample_source.type != SYNTHESIZER_SOURCE && read_program_samples() != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The samples could not be captured from the source!");
+
+        return ESP_FAIL;
+    }
+
+    float* spectrum = malloc(NUMBER_OF_SAMPLES * sizeof(float)); // The power of each bin in dB (first half) and in absolute scale (second half).
+
+    // Check if the memory allocation was successful:
+    if (spectrum == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' could not be 'NULL'!", "spectrum");
+
+        return ESP_FAIL;
+    }
+
+    float* power_db = spectrum;
+    float* power = &spectrum[NUMBER_OF_SAMPLES / 2];
+
+    int64_t start_time_us = esp_timer_get_time();
+
+    fft_data_t fft_data = {};
+    quality_metrics_t quality_metrics = {};
+
+    // Compute a single spectrum (without averaging, so the accumulated spectrum of `/fft` is not disturbed), and measure the tone in it:
+    ESP_ERROR_CHECK(initialize_fft_f32(&fft_data));
+
+    esp_err_t succeeded_measurement = compute_fft_spectrum_f32(&fft_data, program_data.samples, program_data.quality_window, NUMBER_OF_SAMPLES, power_db, power);
+
+    ESP_ERROR_CHECK(de_initialize_fft_f32(&fft_data));
+
+    if (succeeded_measurement == ESP_OK)
+        succeeded_measurement = measure_signal_quality_f32(power, NUMBER_OF_SAMPLES / 2, NUMBER_OF_SAMPLES, program_data.sample_frequency, program_data.quality_window, program_data.quality_config, &quality_metrics);
+
+    int64_t measurement_duration_us = esp_timer_get_time() - start_time_us;
+
+    free(spectrum);
+
+    if (succeeded_measurement != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_500_INTERNAL_SERVER_ERROR, "The samples do not contain a tone that could be measured!");
+
+        return ESP_FAIL;
+    }
+
+    record_trace_event(&trace_buffer, METRICS_TRACE, TRACE_LEVEL_INFO, (const int32_t[TRACE_EVENT_VALUES]){measurement_duration_us, quality_metrics.number_of_harmonics, 0}, (const float[TRACE_EVENT_MEASUREMENTS]){quality_metrics.thd_db, quality_metrics.sinad_db});
+
+    char response[MAXIMUM_RESPONSE_LENGTH] = {};
+
+    ESP_ERROR_CHECK(format_metrics_response(&quality_metrics, measurement_duration_us, response, sizeof(response) / sizeof(response[0]))); // Format the figures as a compact JSON response.
+
+    httpd_resp_set_type(request, "application/json");
+    httpd_resp_send(request, response, strlen(response));
+
+    return ESP_OK;
+}
+
+esp_err_t stream_ws_handler(httpd_req_t* request) {
+    int socket = httpd_req_to_sockfd(request);
+
+    // Add the client to the stream, when the WebSocket handshake is done:
+    if (request->method == HTTP_GET) {
+        ESP_LOGI(WIFI_SERVER_TAG, "The 'stream_ws_handler' function is invoked, with a new client on socket '%d'", socket);
+
+        return add_stream_client(&spectrum_stream, socket);
+    }
+
+    char content[MAXIMUM_CONTENT_LENGTH] = {};
+
+    httpd_ws_frame_t websocket_frame = {
+        .type = HTTPD_WS_TYPE_TEXT,
+        .payload = (uint8_t*)content
+    };
+
+    // Receive the text frame with the settings of the client (leaving room for the terminating character):
+    if (httpd_ws_recv_frame(request, &websocket_frame, sizeof(content) - 1) != ESP_OK) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to receive the WebSocket frame of the client on socket '%d'!", socket);
+
+        return ESP_FAIL;
+    }
+
+    // Ignore all the frames that do not contain settings:
+    if (websocket_frame.type != HTTPD_WS_TYPE_TEXT)
+        return ESP_OK;
+
+    trace_request(STREAM_REQUEST_TRACE, "stream_ws_handler", content, websocket_frame.len, false); // Record the message, without blocking on the console.
+
+    return parse_stream_data(socket, content);
+}
+
+esp_err_t trace_get_handler(httpd_req_t* request) {
+    char query[MAXIMUM_QUERY_LENGTH] = {};
+    char query_value[MAXIMUM_QUERY_LENGTH] = {};
+
+    uint32_t next_sequence = get_trace_sequence(&trace_buffer);
+    size_t number_of_requested_events = DEFAULT_TRACE_EVENTS;
+    bool has_query = httpd_req_get_url_query_str(request, query, sizeof(query) / sizeof(query[0])) == ESP_OK;
+
+    // Read the optional `count` parameter, with the largest number of events to return (at most the complete ring):
+    if (has_query && httpd_query_key_value(query, "count", query_value, sizeof(query_value) / sizeof(query_value[0])) == ESP_OK) {
+        char* value_end = NULL;
+        unsigned long count = strtoul(query_value, &value_end, 10);
+
+        if (value_end == query_value || *value_end != '\0' || count == 0) {
+            httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid 'count' of trace events!");
+
+            return ESP_FAIL;
+        }
+
+        number_of_requested_events = (count < TRACE_BUFFER_LENGTH) ? count : TRACE_BUFFER_LENGTH;
+    }
+
+    uint32_t sequence = next_sequence - ((next_sequence < number_of_requested_events) ? next_sequence : number_of_requested_events); // Without `since`, return the last events.
+
+    // Read the optional `since` parameter, with the sequence number of the first event to return (the `next_sequence` of a previous response):
+    if (has_query && httpd_query_key_value(query, "since", query_value, sizeof(query_value) / sizeof(query_value[0])) == ESP_OK) {
+        char* value_end = NULL;
+        unsigned long since = strtoul(query_value, &value_end, 10);
+
+        if (value_end == query_value || *value_end != '\0' || since > UINT32_MAX) {
+            httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid 'since' sequence number of the trace!");
+
+            return ESP_FAIL;
+        }
+
+        sequence = since;
+    }
+
+    httpd_resp_set_type(request, "application/json");
+    httpd_resp_send_chunk(request, "{\"events\":[", HTTPD_RESP_USE_STRLEN);
+
+    trace_event_t events[TRACE_EVENTS_PER_CHUNK] = {};
+    char event_response[MAXIMUM_TRACE_EVENT_LENGTH] = {};
+
+    size_t number_of_sent_events = 0;
+    uint32_t dropped_events = 0;
+
+    // Send the events in small chunks, so neither the events nor the response need a large buffer:
+    while (number_of_sent_events < number_of_requested_events) {
+        size_t number_of_events = 0;
+        size_t maximum_events = number_of_requested_events - number_of_sent_events;
+
+        ESP_ERROR_CHECK(read_trace_events(&trace_buffer, &sequence, events, (maximum_events < TRACE_EVENTS_PER_CHUNK) ? maximum_events : TRACE_EVENTS_PER_CHUNK, &number_of_events, &dropped_events));
+
+        if (number_of_events == 0)
+            break;
+
+        for (size_t i = 0; i < number_of_events; i++, number_of_sent_events++) {
+            if (number_of_sent_events > 0)
+                httpd_resp_send_chunk(request, ",", 1);
+
+            ESP_ERROR_CHECK(format_trace_event_response(&events[i], event_response, sizeof(event_response) / sizeof(event_response[0])));
+
+            // Stop, when the client is gone:
+            if (httpd_resp_send_chunk(request, event_response, HTTPD_RESP_USE_STRLEN) != ESP_OK)
+                return ESP_FAIL;
+        }
+    }
+
+    // Close the array with the number of dropped events, and the sequence number to pass as `since` on the next request:
+    snprintf(event_response, sizeof(event_response) / sizeof(event_response[0]), "],\"dropped_events\":%u,\"next_sequence\":%u,\"level\":\"%s\",\"console\":%s}\n",
+             (unsigned int)dropped_events,
+             (unsigned int)sequence,
+             get_trace_level_name(atomic_load(&trace_buffer.level)),
+             atomic_load(&trace_buffer.console_output) ? "true" : "false");
+
+    httpd_resp_send_chunk(request, event_response, HTTPD_RESP_USE_STRLEN);
+    httpd_resp_send_chunk(request, NULL, 0); // Finish the chunked response.
+
+    return ESP_OK;
+}
+
+esp_err_t trace_post_handler(httpd_req_t* request) {
+    char content[MAXIMUM_CONTENT_LENGTH] = {};
+
+    int return_length = httpd_req_recv(request, content, sizeof(content) / sizeof(content[0])); // Receive the content of the HTTP POST request.
+
+    // Check if an error occurred or the request timed out:
+    if (return_length <= 0) {
+        if (return_length == HTTPD_SOCK_ERR_TIMEOUT)
+            httpd_resp_send_408(request);
+
+        return ESP_FAIL;
+    }
+
+    trace_request(TRACE_REQUEST_TRACE, "trace_post_handler", content, return_length, false); // Record the request, without blocking on the console.
+
+    // Parse the level and the console output of the trace from the content:
+    if (parse_trace_data(content) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "Invalid trace configuration!");
+
+        return ESP_FAIL;
+    }
+
+    char response[MAXIMUM_RESPONSE_LENGTH] = {};
+
+    // Send a response with the applied settings:
+    snprintf(response, sizeof(response) / sizeof(response[0]), "{\"level\":\"%s\",\"console\":%s,\"next_sequence\":%u}\n",
+             get_trace_level_name(atomic_load(&trace_buffer.level)),
+             atomic_load(&trace_buffer.console_output) ? "true" : "false",
+             (unsigned int)get_trace_sequence(&trace_buffer));
+
+    httpd_resp_set_type(request, "application/json");
+    httpd_resp_send(request, response, strlen(response));
+
+    return ESP_OK;
+}
+
+void trace_request(trace_stage_t stage, const char* handler_name, const char* content, int content_length, bool is_binary_content) {
+    record_trace_event(&trace_buffer, stage, TRACE_LEVEL_INFO, (const int32_t[TRACE_EVENT_VALUES]){content_length, is_binary_content, 0}, NULL);
+
+    // Only log the content itself at the verbose level, because the console blocks the handler until the line is written:
+    if (!trace_level_is_enabled(&trace_buffer, TRACE_LEVEL_VERBOSE))
+        return;
+
+    if (is_binary_content || content == NULL)
+        ESP_LOGI(WIFI_SERVER_TAG, "The '%s' function is invoked, with '%d' bytes of binary content", handler_name, content_length);
+    else
+        ESP_LOGI(WIFI_SERVER_TAG, "The '%s' function is invoked, with content '%s'", handler_name, content);
+}
+
+esp_err_t parse_wave_data(const char* json_data, dac_output_channels_t* wave_channels) {
+    // Check if `wave_channels` has a valid value:
+    if (wave_channels == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' could not be 'NULL'!", "wave_channels");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* channel_item = cJSON_GetObjectItem(root, "channel");
+
+    *wave_channels = DAC_OUTPUT_CHANNEL_1;
+
+    // Check if the optional `channel` item exists and is a known channel (the waves are for the source by default):
+    if (cJSON_IsString(channel_item) && parse_dac_channels(channel_item->valuestring, wave_channels) != ESP_OK) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown channel '%s'!", channel_item->valuestring);
+
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    cJSON* sample_frequency_item = cJSON_GetObjectItem(root, "sample_frequency");
+    cJSON* waves_array = cJSON_GetObjectItem(root, "waves");
+
+    // Check if the optional `sample_frequency` item is a positive number, and if `waves` item exists and is an array:
+    if ((sample_frequency_item != NULL && (!cJSON_IsNumber(sample_frequency_item) || sample_frequency_item->valueint < 1)) || !cJSON_IsArray(waves_array)) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid sample frequency or waves array in JSON data!");
+
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    size_t sample_frequency = program_data.sample_frequency; // The sample frequency after the request.
+
+    // Both channels share the sample frequency, so only waves for the second channel keep the one of a live source:
+    if (sample_frequency_item != NULL) {
+        if (!(*wave_channels & DAC_OUTPUT_CHANNEL_1) && program_data.sample_source.type != SYNTHESIZER_SOURCE)
+            ESP_LOGW(WIFI_SERVER_TAG, "The sample frequency of the source is kept for the second channel!");
+        else
+            sample_frequency = sample_frequency_item->valueint;
+    }
+
+    // Check if a running DAC can output the samples at the new sample frequency, before anything is changed:
+    if (program_data.dac_is_enabled && check_dac_output_config(sample_frequency, program_data.dac_interpolation_factor) != ESP_OK) {
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    wave_config_t waves[MAXIMUM_WAVES_LENGTH] = {};
+    size_t number_of_waves = 0;
+
+    // Convert the waves into wave configurations, relative to the new sample frequency:
+    if (parse_wave_items(waves_array, sample_frequency, waves, &number_of_waves) != ESP_OK) {
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    cJSON_Delete(root);
+
+    // Store the waves, now that the complete request is validated (the waves of the synthesizer that are not replaced keep their frequencies in Hz):
+    if (!(*wave_channels & DAC_OUTPUT_CHANNEL_1) && program_data.sample_frequency > 0 && sample_frequency != program_data.sample_frequency)
+        ESP_ERROR_CHECK(rescale_wave_configs(program_data.waves, program_data.number_of_waves, program_data.sample_frequency, sample_frequency));
+
+    program_data.sample_frequency = sample_frequency;
+
+    if (*wave_channels & DAC_OUTPUT_CHANNEL_1) {
+        memcpy(program_data.waves, waves, sizeof(waves));
+
+        program_data.number_of_waves = number_of_waves;
+    }
+
+    if (*wave_channels & DAC_OUTPUT_CHANNEL_2) {
+        memcpy(program_data.second_channel_waves, waves, sizeof(waves));
+
+        program_data.number_of_second_channel_waves = number_of_waves;
+        program_data.second_channel_sample_frequency = sample_frequency;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t parse_wave_items(const cJSON* waves_array, size_t sample_frequency, wave_config_t* wave_configs, size_t* number_of_waves) {
+    // Check if `waves_array`, `wave_configs` and `number_of_waves` have a valid value:
+    if (!cJSON_IsArray(waves_array) || wave_configs == NULL || number_of_waves == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "waves_array", "wave_configs", "number_of_waves");
+
+        return ESP_FAIL;
+    }
+
+    int wave_count = cJSON_GetArraySize(waves_array);
+
+    // Truncate the wave count if it exceeds the maximum supported waves:
+    if (wave_count > MAXIMUM_WAVES_LENGTH) {
+        ESP_LOGW(WIFI_SERVER_TAG, "Received more waves than supported. Truncating it to '%d' waves!", MAXIMUM_WAVES_LENGTH);
+
+        wave_count = MAXIMUM_WAVES_LENGTH;
+    }
+
+    for (int i = 0; i < wave_count; i++) {
+        cJSON* wave_item = cJSON_GetArrayItem(waves_array, i);
+        cJSON* amplitude_item = cJSON_GetObjectItem(wave_item, "amplitude");
+        cJSON* frequency_item = cJSON_GetObjectItem(wave_item, "frequency");
+        cJSON* phase_item = cJSON_GetObjectItem(wave_item, "phase");
+        cJSON* offset_item = cJSON_GetObjectItem(wave_item, "offset");
+        cJSON* type_item = cJSON_GetObjectItem(wave_item, "type");
+        cJSON* duty_cycle_item = cJSON_GetObjectItem(wave_item, "duty_cycle");
+        cJSON* end_frequency_item = cJSON_GetObjectItem(wave_item, "end_frequency");
+
+        // Check if all required wave properties exist and are numbers:
+        if (cJSON_IsNumber(amplitude_item) && cJSON_IsNumber(frequency_item) && cJSON_IsNumber(phase_item) && cJSON_IsNumber(offset_item)) {
+            float frequency = (float)frequency_item->valuedouble;
+            float absolute_frequency = frequency / sample_frequency;
+
+            // The optional end frequency of a chirp defaults to the (start) frequency:
+            float end_frequency = cJSON_IsNumber(end_frequency_item) ? (float)end_frequency_item->valuedouble : frequency;
+            float absolute_end_frequency = end_frequency / sample_frequency;
+
+            // The optional type defaults to a sine:
+            wave_type_t wave_type = SINE_WAVE;
+
+            if (cJSON_IsString(type_item) && parse_wave_type(type_item->valuestring, &wave_type) != ESP_OK)
+                ESP_LOGW(WIFI_SERVER_TAG, "Wave '%d' has an unknown type '%s', so a sine is used!", i, type_item->valuestring);
+
+            // Check if the absolute frequencies are valid:
+            if (absolute_frequency <= 1.0f && absolute_end_frequency <= 1.0f) {
+                wave_configs[i] = (wave_config_t){
+                    .amplitude = (float)amplitude_item->valuedouble,
+                    .frequency = absolute_frequency,
+                    .phase = (float)phase_item->valuedouble,
+                    .offset = (float)offset_item->valuedouble,
+                    .type = wave_type,
+                    .duty_cycle = cJSON_IsNumber(duty_cycle_item) ? fmaxf(0.0f, fminf((float)duty_cycle_item->valuedouble, 1.0f)) : DEFAULT_DUTY_CYCLE,
+                    .end_frequency = absolute_end_frequency
+                };
+            }
+            else
+                ESP_LOGW(WIFI_SERVER_TAG, "Wave '%d' is ignored due to an invalid frequency of '%.2f' Hz!", i, fmaxf(frequency, end_frequency));
+        }
+    }
+
+    *number_of_waves = wave_count;
+
+    return ESP_OK;
+}
+
+esp_err_t parse_wave_type(const char* type_name, wave_type_t* wave_type) {
+    // Check if `type_name` and `wave_type` have a valid value:
+    if (type_name == NULL || wave_type == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "type_name", "wave_type");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map wave type names to wave types:
+    typedef struct {
+        const char* type_name;
+        wave_type_t wave_type;
+    } wave_type_mapping_t;
+
+    // Define the mappings of wave type names to wave types:
+    const wave_type_mapping_t wave_type_mappings[] = {
+        {"SINE", SINE_WAVE},
+        {"SQUARE", SQUARE_WAVE},
+        {"SAWTOOTH", SAWTOOTH_WAVE},
+        {"TRIANGLE", TRIANGLE_WAVE},
+        {"PULSE", PULSE_WAVE},
+        {"CHIRP", CHIRP_WAVE},
+        {"NOISE", NOISE_WAVE}
+    };
+
+    int num_mappings = sizeof(wave_type_mappings) / sizeof(wave_type_mappings[0]);
+
+    // Iterate through the wave type mappings and find a match for the provided name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(type_name, wave_type_mappings[i].type_name) == 0) {
+            *wave_type = wave_type_mappings[i].wave_type;
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+esp_err_t parse_filter_data(const char* json_data) {
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    filter_config_t filter_config = program_data.filter_stage.config; // Start from the current filter, so every item is optional.
+
+    // Define a structure to map structure names to filter structures:
+    typedef struct {
+        const char* structure_name;
+        filter_structure_t structure;
+    } filter_structure_mapping_t;
+
+    // Define a structure to map response names to filter responses:
+    typedef struct {
+        const char* response_name;
+        filter_response_t response;
+    } filter_response_mapping_t;
+
+    // Define the mappings of the names to the structures and responses:
+    const filter_structure_mapping_t structure_mappings[] = {
+        {"NONE", NO_FILTER},
+        {"BIQUAD", BIQUAD_FILTER},
+        {"FIR", FIR_FILTER}
+    };
+
+    const filter_response_mapping_t response_mappings[] = {
+        {"LOW_PASS", LOW_PASS_FILTER},
+        {"HIGH_PASS", HIGH_PASS_FILTER},
+        {"BAND_PASS", BAND_PASS_FILTER}
+    };
+
+    cJSON* structure_item = cJSON_GetObjectItem(root, "structure");
+    cJSON* response_item = cJSON_GetObjectItem(root, "response");
+    bool has_valid_names = true;
+
+    // Check if the optional `structure` item exists and is a known name:
+    if (cJSON_IsString(structure_item)) {
+        bool is_known_structure = false;
+
+        for (int i = 0; i < sizeof(structure_mappings) / sizeof(structure_mappings[0]); i++) {
+            if (strcmp(structure_item->valuestring, structure_mappings[i].structure_name) == 0) {
+                filter_config.structure = structure_mappings[i].structure;
+                is_known_structure = true;
+            }
+        }
+
+        has_valid_names = has_valid_names && is_known_structure;
+    }
+
+    // Check if the optional `response` item exists and is a known name:
+    if (cJSON_IsString(response_item)) {
+        bool is_known_response = false;
+
+        for (int i = 0; i < sizeof(response_mappings) / sizeof(response_mappings[0]); i++) {
+            if (strcmp(response_item->valuestring, response_mappings[i].response_name) == 0) {
+                filter_config.response = response_mappings[i].response;
+                is_known_response = true;
+            }
+        }
+
+        has_valid_names = has_valid_names && is_known_response;
+    }
+
+    cJSON* cutoff_frequency_item = cJSON_GetObjectItem(root, "cutoff_frequency");
+    cJSON* low_frequency_item = cJSON_GetObjectItem(root, "low_frequency");
+    cJSON* high_frequency_item = cJSON_GetObjectItem(root, "high_frequency");
+    cJSON* order_item = cJSON_GetObjectItem(root, "order");
+
+    // The `cutoff_frequency` is the lower edge of a high-pass, and the upper edge of a low-pass:
+    if (cJSON_IsNumber(cutoff_frequency_item)) {
+        if (filter_config.response == HIGH_PASS_FILTER)
+            filter_config.low_frequency = (float)cutoff_frequency_item->valuedouble;
+        else
+            filter_config.high_frequency = (float)cutoff_frequency_item->valuedouble;
+    }
+
+    if (cJSON_IsNumber(low_frequency_item))
+        filter_config.low_frequency = (float)low_frequency_item->valuedouble;
+
+    if (cJSON_IsNumber(high_frequency_item))
+        filter_config.high_frequency = (float)high_frequency_item->valuedouble;
+
+    if (cJSON_IsNumber(order_item))
+        filter_config.order = order_item->valueint > 0 ? order_item->valueint : 0;
+
+    cJSON_Delete(root);
+
+    // Check if the names are known:
+    if (!has_valid_names) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown structure or response of the filter!");
+
+        return ESP_FAIL;
+    }
+
+    float highest_frequency = (filter_config.response == HIGH_PASS_FILTER) ? filter_config.low_frequency : filter_config.high_frequency; // The highest used cutoff frequency.
+
+    // Check if the cutoff frequencies are below the Nyquist frequency of the current samples:
+    if (filter_config.structure != NO_FILTER && program_data.sample_frequency > 0 && 2.0f * highest_frequency >= program_data.sample_frequency) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The cutoff frequencies of the filter must be below '%.2f' Hz!", program_data.sample_frequency / 2.0f);
+
+        return ESP_FAIL;
+    }
+
+    return configure_filter_stage(&program_data.filter_stage, &filter_config); // Check the settings, and apply them to the filter stage.
+}
+
+void take_source_lock(void) {
+    // Before the webserver is started, no worker reads the source:
+    if (program_data.source_lock != NULL)
+        xSemaphoreTake(program_data.source_lock, portMAX_DELAY);
+}
+
+void give_source_lock(void) {
+    if (program_data.source_lock != NULL)
+        xSemaphoreGive(program_data.source_lock);
+}
+
+static esp_err_t read_source_samples(float* samples, size_t sample_length) {
+    // Read the next samples from the source (the lock of the source must be held):
+    if (read_sample_source(&program_data.sample_source, samples, sample_length) != ESP_OK)
+        return ESP_FAIL;
+
+    // The synthesizer repeats the same frame (which the DAC loops), so it is filtered as one period, and the other sources continue the state of the filter:
+    bool is_periodic = program_data.sample_source.type == SYNTHESIZER_SOURCE;
+
+    esp_err_t succeeded_filtering = is_periodic ? apply_periodic_filter_stage(&program_data.filter_stage, samples, sample_length, program_data.sample_source.sample_frequency) : apply_filter_stage(&program_data.filter_stage, samples, sample_length, program_data.sample_source.sample_frequency);
+
+    // Fail the read if the filter could not allocate its memory (the samples would silently stay unfiltered):
+    if (succeeded_filtering == ESP_ERR_NO_MEM)
+        return ESP_FAIL;
+
+    // Pass the samples through the filter stage (a filter that does not fit the sample frequency of the source is bypassed, instead of failing the read):
+    if (succeeded_filtering != ESP_OK)
+        ESP_LOGW(WIFI_SERVER_TAG, "The filter is bypassed for the sample frequency of '%d' Hz!", (int)program_data.sample_source.sample_frequency);
+
+    return ESP_OK;
+}
+
+esp_err_t read_program_samples(void) {
+    take_source_lock();
+
+    // Hold the samples while they are written, so the spectrum stream does not copy a half-written frame:
+    take_stream_sample_lock(&spectrum_stream);
+
+    esp_err_t succeeded_read = read_source_samples(program_data.samples, NUMBER_OF_SAMPLES);
+
+    give_stream_sample_lock(&spectrum_stream);
+    give_source_lock();
+
+    return succeeded_read;
+}
+
+esp_err_t capture_program_samples(float* samples, size_t sample_length) {
+    // Check if `samples` has a valid value, and the length of the samples:
+    if (samples == NULL || sample_length != NUMBER_OF_SAMPLES) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' could not be 'NULL', and must contain '%d' samples!", "samples", NUMBER_OF_SAMPLES);
+
+        return ESP_FAIL;
+    }
+
+    take_source_lock();
+
+    esp_err_t succeeded_capture = ESP_OK;
+
+    // The synthesizer generated its samples on the call to `/wave` (also when the source changed since the job was queued), so they are only copied:
+    if (program_data.sample_source.type == SYNTHESIZER_SOURCE)
+        memcpy(samples, program_data.samples, sample_length * sizeof(float));
+    else
+        succeeded_capture = read_source_samples(samples, sample_length);
+
+    give_source_lock();
+
+    return succeeded_capture;
+}
+
+esp_err_t parse_averaging_mode(const char* mode_name, averaging_mode_t* averaging_mode) {
+    // Check if `mode_name` and `averaging_mode` have a valid value:
+    if (mode_name == NULL || averaging_mode == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "mode_name", "averaging_mode");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map averaging mode names to averaging modes:
+    typedef struct {
+        const char* mode_name;
+        averaging_mode_t averaging_mode;
+    } averaging_mode_mapping_t;
+
+    // Define the mappings of averaging mode names to averaging modes:
+    const averaging_mode_mapping_t averaging_mode_mappings[] = {
+        {"NONE", NO_AVERAGING},
+        {"LINEAR", LINEAR_AVERAGING},
+        {"EXPONENTIAL", EXPONENTIAL_AVERAGING},
+        {"MAX_HOLD", MAX_HOLD_AVERAGING},
+        {"MIN_HOLD", MIN_HOLD_AVERAGING}
+    };
+
+    int num_mappings = sizeof(averaging_mode_mappings) / sizeof(averaging_mode_mappings[0]);
+
+    // Iterate through the mappings and find a match for the provided name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(mode_name, averaging_mode_mappings[i].mode_name) == 0) {
+            *averaging_mode = averaging_mode_mappings[i].averaging_mode;
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+esp_err_t parse_fft_data(const char* json_data) {
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    // Start from the current settings, so every item is optional (they are only applied when the complete request is valid):
+    peak_config_t peak_config = program_data.peak_config;
+    averaging_config_t averaging_config = program_data.averaging_config;
+    window_config_t window = program_data.window;
+    bool has_valid_names = true;
+
+    cJSON* peak_threshold_item = cJSON_GetObjectItem(root, "peak_threshold");
+    cJSON* maximum_peaks_item = cJSON_GetObjectItem(root, "maximum_peaks");
+
+    // Check if the optional `peak_threshold` item exists and is a number:
+    if (cJSON_IsNumber(peak_threshold_item))
+        peak_config.threshold_db = (float)peak_threshold_item->valuedouble;
+
+    // Check if the optional `maximum_peaks` item exists and is a number:
+    if (cJSON_IsNumber(maximum_peaks_item)) {
+        int maximum_peaks = maximum_peaks_item->valueint;
+
+        // Truncate the maximum number of peaks if it exceeds the supported length:
+        if (maximum_peaks < 0 || maximum_peaks > MAXIMUM_PEAKS_LENGTH) {
+            ESP_LOGW(WIFI_SERVER_TAG, "Requested an unsupported number of peaks. Truncating it to '%d' peaks!", MAXIMUM_PEAKS_LENGTH);
+
+            maximum_peaks = MAXIMUM_PEAKS_LENGTH;
+        }
+
+        peak_config.maximum_peaks = maximum_peaks;
+    }
+
+    cJSON* averaging_item = cJSON_GetObjectItem(root, "averaging");
+    cJSON* averaging_frames_item = cJSON_GetObjectItem(root, "averaging_frames");
+    cJSON* averaging_alpha_item = cJSON_GetObjectItem(root, "averaging_alpha");
+
+    // Check if the optional `averaging` item exists and is a known mode:
+    if (cJSON_IsString(averaging_item) && parse_averaging_mode(averaging_item->valuestring, &averaging_config.mode) != ESP_OK) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown averaging mode '%s'!", averaging_item->valuestring);
+
+        has_valid_names = false;
+    }
+
+    // Check if the optional `averaging_frames` item exists and is a number:
+    if (cJSON_IsNumber(averaging_frames_item)) {
+        int averaging_frames = averaging_frames_item->valueint;
+
+        // Truncate the number of frames if it is not supported:
+        if (averaging_frames < 1 || averaging_frames > MAXIMUM_AVERAGING_FRAMES) {
+            ESP_LOGW(WIFI_SERVER_TAG, "Requested an unsupported number of averaged frames. Truncating it to '%d' frames!", MAXIMUM_AVERAGING_FRAMES);
+
+            averaging_frames = averaging_frames < 1 ? 1 : MAXIMUM_AVERAGING_FRAMES;
+        }
+
+        averaging_config.frames = averaging_frames;
+    }
+
+    // Check if the optional `averaging_alpha` item exists and is a number (clamped between 0.001 and 1, so the average keeps moving):
+    if (cJSON_IsNumber(averaging_alpha_item))
+        averaging_config.alpha = fmaxf(0.001f, fminf((float)averaging_alpha_item->valuedouble, 1.0f));
+
+    cJSON* window_item = cJSON_GetObjectItem(root, "window");
+
+    // Check if the `window` item exists and is a known window (without it, the current window is kept):
+    if (cJSON_IsString(window_item)) {
+        if (parse_window_config(window_item->valuestring, &window) != ESP_OK) {
+            ESP_LOGE(WIFI_SERVER_TAG, "Unknown window configuration '%s'!", window_item->valuestring); // The provided window name does not match any known window configurations.
+
+            has_valid_names = false;
+        }
+    } 
+    else 
+        ESP_LOGW(WIFI_SERVER_TAG, "Invalid window configuration in JSON data!"); // The `window` item is not a string
+
+    cJSON_Delete(root);
+
+    // Check if the names are known, before anything is changed:
+    if (!has_valid_names)
+        return ESP_FAIL;
+
+    program_data.peak_config = peak_config;
+    program_data.averaging_config = averaging_config;
+    program_data.window = window;
+
+    return ESP_OK;
+}
+
+esp_err_t parse_window_config(const char* window_name, window_config_t* window_config) {
+    // Check if `window_name` and `window_config` have a valid value:
+    if (window_name == NULL || window_config == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "window_name", "window_config");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map window names to window configurations:
+    typedef struct {
+        const char* window_name;
+        window_config_t window_config;
+    } window_mapping_t;
+
+    // Define the mappings of window names to window configurations:
+    const window_mapping_t window_mappings[] = {
+        {"HANN_F32", HANN_WINDOW_F32},
+        {"BLACKMAN_F32", BLACKMAN_WINDOW_F32},
+        {"BLACKMAN_HARRIS_F32", BLACKMAN_HARRIS_WINDOW_F32},
+        {"BLACKMAN_NUTTALL_F32", BLACKMAN_NUTTALL_WINDOW_F32},
+        {"NUTTALL_F32", NUTTALL_WINDOW_F32},
+        {"FLAT_TOP_F32", FLAT_TOP_WINDOW_F32}
+    };
+
+    int num_mappings = sizeof(window_mappings) / sizeof(window_mappings[0]);
+
+    // Iterate through the window mappings and find a match for the provided window name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(window_name, window_mappings[i].window_name) == 0) {
+            *window_config = window_mappings[i].window_config;
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+esp_err_t parse_dac_data(const char* json_data) {
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse the JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* prevent_overflow_value = cJSON_GetObjectItem(root, "prevent_overflow_value");
+
+    // Check if `prevent_overflow_value` exists and is a boolean:
+    if (!cJSON_IsBool(prevent_overflow_value)) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse 'prevent_overflow_value', or it is not a boolean!");
+
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    // Start from the current settings, so the other items are optional (they are only applied when the complete request is valid):
+    dac_swap_mode_t swap_mode = program_data.dac_swap_mode;
+    bool keep_phase = program_data.keep_dac_phase;
+    size_t interpolation_factor = program_data.dac_interpolation_factor;
+    dac_output_channels_t channels = program_data.dac_channels;
+    bool has_valid_settings = true;
+
+    cJSON* swap_mode_item = cJSON_GetObjectItem(root, "swap_mode");
+    cJSON* keep_phase_item = cJSON_GetObjectItem(root, "keep_phase");
+    cJSON* interpolation_factor_item = cJSON_GetObjectItem(root, "interpolation_factor");
+    cJSON* channels_item = cJSON_GetObjectItem(root, "channels");
+
+    // Check if the optional `swap_mode` item exists and is a known mode:
+    if (cJSON_IsString(swap_mode_item)) {
+        if (strcmp(swap_mode_item->valuestring, "CROSSING") == 0)
+            swap_mode = DAC_SWAP_AT_CROSSING;
+        else if (strcmp(swap_mode_item->valuestring, "PERIOD") == 0)
+            swap_mode = DAC_SWAP_AT_PERIOD;
+        else {
+            ESP_LOGE(WIFI_SERVER_TAG, "Unknown swap mode '%s'!", swap_mode_item->valuestring);
+
+            has_valid_settings = false;
+        }
+    }
+
+    // Check if the optional `keep_phase` item exists and is a boolean:
+    if (cJSON_IsBool(keep_phase_item))
+        keep_phase = cJSON_IsTrue(keep_phase_item);
+
+    // Check if the optional `interpolation_factor` item exists and is a supported number:
+    if (cJSON_IsNumber(interpolation_factor_item)) {
+        if (interpolation_factor_item->valueint >= 1 && interpolation_factor_item->valueint <= DAC_MAXIMUM_INTERPOLATION_FACTOR)
+            interpolation_factor = interpolation_factor_item->valueint;
+        else {
+            ESP_LOGE(WIFI_SERVER_TAG, "The interpolation factor '%d' must be between '1' and '%d'!", interpolation_factor_item->valueint, DAC_MAXIMUM_INTERPOLATION_FACTOR);
+
+            has_valid_settings = false;
+        }
+    }
+
+    // Check if the optional `channels` item exists and is a known selection of channels:
+    if (cJSON_IsString(channels_item) && parse_dac_channels(channels_item->valuestring, &channels) != ESP_OK) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown DAC channels '%s'!", channels_item->valuestring);
+
+        has_valid_settings = false;
+    }
+
+    bool prevent_overflow = cJSON_IsTrue(prevent_overflow_value);
+
+    cJSON_Delete(root);
+
+    // Check if the settings are supported, before anything is changed:
+    if (!has_valid_settings)
+        return ESP_FAIL;
+
+    program_data.prevent_dac_overflow = prevent_overflow;
+    program_data.dac_swap_mode = swap_mode;
+    program_data.keep_dac_phase = keep_phase;
+    program_data.dac_interpolation_factor = interpolation_factor;
+    program_data.dac_channels = channels;
+
+    return ESP_OK;
+}
+
+esp_err_t parse_dac_channels(const char* channels_name, dac_output_channels_t* output_channels) {
+    // Check if `channels_name` and `output_channels` have a valid value:
+    if (channels_name == NULL || output_channels == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "channels_name", "output_channels");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map channel names to DAC channels:
+    typedef struct {
+        const char* channels_name;
+        dac_output_channels_t output_channels;
+    } dac_channels_mapping_t;
+
+    // Define the mappings of channel names to DAC channels:
+    const dac_channels_mapping_t dac_channels_mappings[] = {
+        {"CHANNEL_1", DAC_OUTPUT_CHANNEL_1},
+        {"CHANNEL_2", DAC_OUTPUT_CHANNEL_2},
+        {"BOTH", DAC_OUTPUT_BOTH_CHANNELS}
+    };
+
+    int num_mappings = sizeof(dac_channels_mappings) / sizeof(dac_channels_mappings[0]);
+
+    // Iterate through the channel mappings and find a match for the provided name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(channels_name, dac_channels_mappings[i].channels_name) == 0) {
+            *output_channels = dac_channels_mappings[i].output_channels;
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+esp_err_t output_program_dac_values(void) {
+    // The first channel outputs the samples of the source:
+    if (quantize_dac_values(program_data.samples, program_data.dac_values, NUMBER_OF_SAMPLES, 0, program_data.prevent_dac_overflow) != ESP_OK)
+        return ESP_FAIL;
+
+    // The second channel outputs its own waves, generated at the current sample frequency:
+    if (program_data.dac_channels & DAC_OUTPUT_CHANNEL_2) {
+        wave_config_t second_channel_waves[MAXIMUM_WAVES_LENGTH] = {};
+
+        memcpy(second_channel_waves, program_data.second_channel_waves, program_data.number_of_second_channel_waves * sizeof(wave_config_t));
+
+        // Keep the frequencies of the waves in Hz, if the sample frequency changed since they were received:
+        if (program_data.second_channel_sample_frequency > 0 && program_data.second_channel_sample_frequency != program_data.sample_frequency && program_data.sample_frequency > 0)
+            ESP_ERROR_CHECK(rescale_wave_configs(second_channel_waves, program_data.number_of_second_channel_waves, program_data.second_channel_sample_frequency, program_data.sample_frequency));
+
+        float* second_channel_samples = calloc(NUMBER_OF_SAMPLES, sizeof(float)); // Allocate a buffer for the samples of the second channel (the waves are added to it).
+
+        // Check if the memory allocation was successful:
+        if (second_channel_samples == NULL) {
+            ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' could not be 'NULL'!", "second_channel_samples");
+
+            return ESP_FAIL;
+        }
+
+        esp_err_t succeeded_generating = generate_waves_f32(second_channel_waves, second_channel_samples, NUMBER_OF_SAMPLES, program_data.number_of_second_channel_waves);
+
+        if (succeeded_generating == ESP_OK)
+            succeeded_generating = quantize_dac_values(second_channel_samples, program_data.dac_values, NUMBER_OF_SAMPLES, 1, program_data.prevent_dac_overflow);
+
+        free(second_channel_samples);
+
+        if (succeeded_generating != ESP_OK)
+            return ESP_FAIL;
+    }
+
+    return dac_output_values(program_data.dac_values, NUMBER_OF_SAMPLES, program_data.sample_frequency, program_data.dac_interpolation_factor, program_data.dac_channels);
+}
+
+esp_err_t parse_source_data(const char* json_data) {
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* source_item = cJSON_GetObjectItem(root, "source");
+    cJSON* adc_channel_item = cJSON_GetObjectItem(root, "adc_channel");
+    cJSON* sample_frequency_item = cJSON_GetObjectItem(root, "sample_frequency");
+
+    bool is_synthesizer = cJSON_IsString(source_item) && strcmp(source_item->valuestring, "SYNTHESIZER") == 0;
+    bool is_adc = cJSON_IsString(source_item) && strcmp(source_item->valuestring, "ADC") == 0;
+
+    // Check if `source` item is a known source (a recording is selected by sending it to `/replay`), and if the optional items are valid numbers:
+    if ((!is_synthesizer && !is_adc) || (sample_frequency_item != NULL && (!cJSON_IsNumber(sample_frequency_item) || sample_frequency_item->valuedouble < 1.0)) || (adc_channel_item != NULL && !cJSON_IsNumber(adc_channel_item))) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid source configuration in JSON data!");
+
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    size_t sample_frequency = (sample_frequency_item != NULL) ? sample_frequency_item->valueint : program_data.sample_frequency;
+    int adc_channel = (adc_channel_item != NULL) ? adc_channel_item->valueint : ADC_CHANNEL_0;
+
+    cJSON_Delete(root);
+
+    // Check the settings of the ADC, before the current source is touched:
+    if (is_adc && check_adc_source_config(adc_channel, sample_frequency) != ESP_OK)
+        return ESP_FAIL;
+
+    sample_source_t selected_source = {};
+
+    // Open the selected source next to the current one, so the current source is kept when it fails:
+    if (is_synthesizer || program_data.sample_source.type != ADC_SOURCE || program_data.sample_source.read == NULL) {
+        esp_err_t succeeded_open = is_synthesizer ? open_synthesizer_source(&selected_source, program_data.waves, &program_data.number_of_waves, sample_frequency) : open_adc_source(&selected_source, adc_channel, sample_frequency);
+
+        if (succeeded_open != ESP_OK)
+            return ESP_FAIL;
+
+        // Replace the current source with the selected source:
+        if (close_sample_source(&program_data.sample_source) != ESP_OK)
+            ESP_LOGW(WIFI_SERVER_TAG, "The previous source could not be closed cleanly!");
+    }
+    else {
+        // The ADC has a single continuous driver, so a running capture is stopped before it is started with the new settings:
+        if (close_sample_source(&program_data.sample_source) != ESP_OK)
+            ESP_LOGW(WIFI_SERVER_TAG, "The previous source could not be closed cleanly!");
+
+        if (open_adc_source(&selected_source, adc_channel, sample_frequency) != ESP_OK) {
+            // Restore the previous capture, or fall back to the synthesizer (so there is always a source):
+            if (open_adc_source(&program_data.sample_source, program_data.adc_channel, program_data.sample_frequency) != ESP_OK) {
+                ESP_LOGE(WIFI_SERVER_TAG, "The previous ADC capture could not be restored, the samples are synthesized again!");
+
+                ESP_ERROR_CHECK(open_synthesizer_source(&program_data.sample_source, program_data.waves, &program_data.number_of_waves, program_data.sample_frequency));
+            }
+
+            return ESP_FAIL;
+        }
+    }
+
+    program_data.sample_source = selected_source;
+    program_data.sample_frequency = selected_source.sample_frequency;
+
+    if (is_adc)
+        program_data.adc_channel = adc_channel;
+
+    return ESP_OK;
+}
+
+esp_err_t parse_correlation_mode(const char* mode_name, correlation_mode_t* correlation_mode) {
+    // Check if `mode_name` and `correlation_mode` have a valid value:
+    if (mode_name == NULL || correlation_mode == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "mode_name", "correlation_mode");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map correlation mode names to correlation modes:
+    typedef struct {
+        const char* mode_name;
+        correlation_mode_t correlation_mode;
+    } correlation_mode_mapping_t;
+
+    // Define the mappings of correlation mode names to correlation modes:
+    const correlation_mode_mapping_t correlation_mode_mappings[] = {
+        {"CROSS_CORRELATION", CROSS_CORRELATION},
+        {"CONVOLUTION", CONVOLUTION}
+    };
+
+    int num_mappings = sizeof(correlation_mode_mappings) / sizeof(correlation_mode_mappings[0]);
+
+    // Iterate through the mappings and find a match for the provided name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(mode_name, correlation_mode_mappings[i].mode_name) == 0) {
+            *correlation_mode = correlation_mode_mappings[i].correlation_mode;
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+esp_err_t parse_correlation_method(const char* method_name, correlation_method_t* correlation_method) {
+    // Check if `method_name` and `correlation_method` have a valid value:
+    if (method_name == NULL || correlation_method == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "method_name", "correlation_method");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map correlation method names to correlation methods:
+    typedef struct {
+        const char* method_name;
+        correlation_method_t correlation_method;
+    } correlation_method_mapping_t;
+
+    // Define the mappings of correlation method names to correlation methods:
+    const correlation_method_mapping_t correlation_method_mappings[] = {
+        {"SINGLE_BLOCK", SINGLE_BLOCK_CORRELATION},
+        {"OVERLAP_ADD", OVERLAP_ADD_CORRELATION},
+        {"OVERLAP_SAVE", OVERLAP_SAVE_CORRELATION}
+    };
+
+    int num_mappings = sizeof(correlation_method_mappings) / sizeof(correlation_method_mappings[0]);
+
+    // Iterate through the mappings and find a match for the provided name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(method_name, correlation_method_mappings[i].method_name) == 0) {
+            *correlation_method = correlation_method_mappings[i].correlation_method;
+
+            return ESP_OK;
+        }
+    }
+
+    return ESP_FAIL;
+}
+
+esp_err_t parse_correlation_data(const char* json_data) {
+    // Check if the samples have a sample frequency, to which the frequencies of the reference are relative:
+    if (program_data.sample_frequency == 0) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The samples have no sample frequency yet, call '/wave' or '/source' first!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    // Start from the current settings, so every item is optional (they are only applied when the complete request is valid):
+    size_t reference_length = program_data.reference_length;
+    correlation_mode_t correlation_mode = program_data.correlation_mode;
+    bool has_valid_names = true;
+
+    cJSON* length_item = cJSON_GetObjectItem(root, "length");
+
+    // Check if the optional `length` item exists and is a number:
+    if (cJSON_IsNumber(length_item)) {
+        // Check if the reference has a supported length:
+        if (length_item->valueint < 1 || length_item->valueint > MAXIMUM_REFERENCE_LENGTH) {
+            ESP_LOGE(WIFI_SERVER_TAG, "The length '%d' of the reference must be between '1' and '%d'!", length_item->valueint, MAXIMUM_REFERENCE_LENGTH);
+
+            cJSON_Delete(root);
+
+            return ESP_FAIL;
+        }
+
+        reference_length = length_item->valueint;
+    }
+
+    cJSON* mode_item = cJSON_GetObjectItem(root, "mode");
+
+    // Check if the optional `mode` item exists and is a known mode:
+    if (cJSON_IsString(mode_item) && parse_correlation_mode(mode_item->valuestring, &correlation_mode) != ESP_OK) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown correlation mode '%s'!", mode_item->valuestring);
+
+        has_valid_names = false;
+    }
+
+    cJSON* method_item = cJSON_GetObjectItem(root, "method");
+
+    // Use a single block if the samples and the reference fit in a single FFT, so the optional `method` only has to select a stream:
+    correlation_method_t correlation_method = (get_correlation_fft_length(NUMBER_OF_SAMPLES + reference_length - 1) != 0) ? SINGLE_BLOCK_CORRELATION : OVERLAP_SAVE_CORRELATION;
+
+    if (cJSON_IsString(method_item) && parse_correlation_method(method_item->valuestring, &correlation_method) != ESP_OK) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown correlation method '%s'!", method_item->valuestring);
+
+        has_valid_names = false;
+    }
+
+    cJSON* waves_array = cJSON_GetObjectItem(root, "waves");
+
+    wave_config_t reference_waves[MAXIMUM_WAVES_LENGTH] = {}; // A skipped wave is silent, instead of keeping a wave of the previous reference.
+    size_t number_of_reference_waves = program_data.number_of_reference_waves;
+
+    // Check if the optional `waves` item exists and is an array (otherwise the previous reference is used):
+    if (cJSON_IsArray(waves_array)) {
+        if (parse_wave_items(waves_array, program_data.sample_frequency, reference_waves, &number_of_reference_waves) != ESP_OK)
+            has_valid_names = false;
+    }
+    else
+        memcpy(reference_waves, program_data.reference_waves, sizeof(reference_waves));
+
+    cJSON_Delete(root);
+
+    // Check if the names and the waves are valid, and if there is a reference to correlate with, before anything is changed:
+    if (!has_valid_names || number_of_reference_waves == 0) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid mode, method or waves array in JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    program_data.reference_length = reference_length;
+    program_data.correlation_mode = correlation_mode;
+    program_data.correlation_method = correlation_method;
+    program_data.number_of_reference_waves = number_of_reference_waves;
+
+    memcpy(program_data.reference_waves, reference_waves, sizeof(reference_waves));
+
+    return ESP_OK;
+}
+
+esp_err_t parse_metrics_data(const char* json_data) {
+    // Check if the samples have a sample frequency, to which the frequencies are relative:
+    if (program_data.sample_frequency == 0) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The samples have no sample frequency yet, call '/wave' or '/source' first!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* harmonics_item = cJSON_GetObjectItem(root, "harmonics");
+    cJSON* fundamental_frequency_item = cJSON_GetObjectItem(root, "fundamental_frequency");
+    cJSON* window_item = cJSON_GetObjectItem(root, "window");
+
+    // Check if the optional `harmonics` item exists and is a number:
+    if (cJSON_IsNumber(harmonics_item)) {
+        int number_of_harmonics = harmonics_item->valueint;
+
+        // Truncate the number of harmonics if it exceeds the supported length:
+        if (number_of_harmonics < 0 || number_of_harmonics > MAXIMUM_QUALITY_HARMONICS) {
+            ESP_LOGW(WIFI_SERVER_TAG, "Requested an unsupported number of harmonics. Truncating it to '%d' harmonics!", MAXIMUM_QUALITY_HARMONICS);
+
+            number_of_harmonics = MAXIMUM_QUALITY_HARMONICS;
+        }
+
+        program_data.quality_config.number_of_harmonics = number_of_harmonics;
+    }
+
+    // Check if the optional `fundamental_frequency` item exists and is a number (zero searches the strongest tone):
+    if (cJSON_IsNumber(fundamental_frequency_item)) {
+        float fundamental_frequency = (float)fundamental_frequency_item->valuedouble;
+
+        // Check if the fundamental frequency is below the Nyquist frequency:
+        if (fundamental_frequency < 0.0f || fundamental_frequency >= 0.5f * program_data.sample_frequency) {
+            ESP_LOGE(WIFI_SERVER_TAG, "The fundamental frequency '%.2f' Hz must be below half of the sample frequency!", fundamental_frequency);
+
+            cJSON_Delete(root);
+
+            return ESP_FAIL;
+        }
+
+        program_data.quality_config.fundamental_frequency = fundamental_frequency;
+    }
+
+    // Check if the optional `window` item exists and is a string (an unknown window keeps the current one):
+    if (cJSON_IsString(window_item) && parse_window_config(window_item->valuestring, &program_data.quality_window) != ESP_OK)
+        ESP_LOGW(WIFI_SERVER_TAG, "Unknown window configuration '%s'!", window_item->valuestring);
+
+    cJSON_Delete(root);
+
+    return ESP_OK;
+}
+
+esp_err_t parse_stream_data(int socket, const char* json_data) {
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* frame_rate_item = cJSON_GetObjectItem(root, "frame_rate");
+    cJSON* encoding_item = cJSON_GetObjectItem(root, "encoding");
+
+    size_t frame_rate = (cJSON_IsNumber(frame_rate_item) && frame_rate_item->valueint > 0) ? frame_rate_item->valueint : DEFAULT_STREAM_FRAME_RATE;
+    stream_encoding_t encoding = QUANTIZED_STREAM_ENCODING;
+
+    // Define a structure to map encoding names to stream encodings:
+    typedef struct {
+        const char* encoding_name;
+        stream_encoding_t encoding;
+    } encoding_mapping_t;
+
+    // Define the mappings of encoding names to stream encodings:
+    const encoding_mapping_t encoding_mappings[] = {
+        {"FULL", FULL_STREAM_ENCODING},
+        {"QUANTIZED", QUANTIZED_STREAM_ENCODING},
+        {"DELTA", DELTA_STREAM_ENCODING}
+    };
+
+    if (cJSON_IsString(encoding_item)) {
+        const char* encoding_string = encoding_item->valuestring;
+        int num_mappings = sizeof(encoding_mappings) / sizeof(encoding_mappings[0]);
+        bool found_mapping = false;
+
+        // Iterate through the encoding mappings and find a match for the provided encoding name:
+        for (int i = 0; i < num_mappings && !found_mapping; i++) {
+            if (strcmp(encoding_string, encoding_mappings[i].encoding_name) == 0) {
+                encoding = encoding_mappings[i].encoding;
+                found_mapping = true;
+            }
+        }
+
+        if (!found_mapping)
+            ESP_LOGW(WIFI_SERVER_TAG, "Unknown stream encoding '%s'!", encoding_string); // The provided encoding name does not match any known encodings.
+    }
+
+    cJSON_Delete(root);
+
+    return configure_stream_client(&spectrum_stream, socket, frame_rate, encoding);
+}
+
+esp_err_t parse_trace_data(const char* json_data) {
+    cJSON* root = cJSON_Parse(json_data);
+
+    // Failed to parse the JSON data:
+    if (root == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Failed to parse JSON data!");
+
+        return ESP_FAIL;
+    }
+
+    cJSON* level_item = cJSON_GetObjectItem(root, "level");
+    cJSON* console_item = cJSON_GetObjectItem(root, "console");
+
+    trace_level_t level = atomic_load(&trace_buffer.level);
+
+    // Check if the optional `level` item exists, and if it is a known level:
+    if (level_item != NULL && (!cJSON_IsString(level_item) || parse_trace_level(level_item->valuestring, &level) != ESP_OK)) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid level of the trace!");
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    // Check if the optional `console` item exists, and if it is a boolean:
+    if (console_item != NULL && !cJSON_IsBool(console_item)) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The value of '%s' must be a boolean!", "console");
+        cJSON_Delete(root);
+
+        return ESP_FAIL;
+    }
+
+    // Apply the settings, now that the complete message is validated:
+    atomic_store(&trace_buffer.level, level);
+
+    if (console_item != NULL)
+        atomic_store(&trace_buffer.console_output, cJSON_IsTrue(console_item));
+
+    cJSON_Delete(root);
+
+    return ESP_OK;
+}
+
+esp_err_t parse_trace_level(const char* level_name, trace_level_t* level) {
+    // Check if `level_name` and `level` have a valid value:
+    if (level_name == NULL || level == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "level_name", "level");
+
+        return ESP_FAIL;
+    }
+
+    // Define a structure to map level names to trace levels:
+    typedef struct {
+        const char* level_name;
+        trace_level_t level;
+    } level_mapping_t;
+
+    // Define the mappings of level names to trace levels:
+    const level_mapping_t level_mappings[] = {
+        {"OFF", TRACE_LEVEL_OFF},
+        {"INFO", TRACE_LEVEL_INFO},
+        {"VERBOSE", TRACE_LEVEL_VERBOSE},
+        {"PLOT", TRACE_LEVEL_PLOT}
+    };
+
+    int num_mappings = sizeof(level_mappings) / sizeof(level_mappings[0]);
+
+    // Iterate through the level mappings and find a match for the provided level name:
+    for (int i = 0; i < num_mappings; i++) {
+        if (strcmp(level_name, level_mappings[i].level_name) == 0) {
+            *level = level_mappings[i].level;
+
+            return ESP_OK;
+        }
+    }
+
+    ESP_LOGW(WIFI_SERVER_TAG, "Unknown trace level '%s'!", level_name); // The provided level name does not match any known levels.
+
+    return ESP_FAIL;
+}
+
+bool request_has_binary_content(httpd_req_t* request) {
+    char content_type[MAXIMUM_CONTENT_TYPE_LENGTH] = {};
+
+    // Check if the `Content-Type` header is present, and if it fits into the buffer:
+    if (httpd_req_get_hdr_value_str(request, "Content-Type", content_type, sizeof(content_type) / sizeof(content_type[0])) != ESP_OK)
+        return false;
+
+    return strncmp(content_type, BINARY_PROTOCOL_CONTENT_TYPE, strlen(BINARY_PROTOCOL_CONTENT_TYPE)) == 0;
+}
+
+esp_err_t parse_wave_binary(const uint8_t* binary_data, size_t binary_length) {
+    const uint8_t* payload = NULL;
+    size_t payload_length = 0;
+
+    // Check if the message has a valid header, and contains at least the fixed part of the payload:
+    if (binary_read_header(binary_data, binary_length, BINARY_WAVE_MESSAGE, &payload, &payload_length) != 0 || payload_length < BINARY_WAVE_PAYLOAD_HEADER_LENGTH) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid header of the binary wave message!");
+
+        return ESP_FAIL;
+    }
+
+    size_t sample_frequency = binary_read_u32(&payload[0]);
+    size_t wave_count = payload[4];
+
+    // Check if the sample frequency is valid, and all the announced waves are supported and present:
+    if (sample_frequency == 0 || wave_count > MAXIMUM_WAVES_LENGTH || payload_length < BINARY_WAVE_PAYLOAD_HEADER_LENGTH + wave_count * BINARY_WAVE_RECORD_LENGTH) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid sample frequency or number of waves in the binary wave message!");
+
+        return ESP_FAIL;
+    }
+
+    wave_config_t waves[MAXIMUM_WAVES_LENGTH] = {};
+
+    // Decode every wave record, and reject the complete message if one of the waves is invalid:
+    for (int i = 0; i < wave_count; i++) {
+        const uint8_t* record = &payload[BINARY_WAVE_PAYLOAD_HEADER_LENGTH + i * BINARY_WAVE_RECORD_LENGTH];
+
+        float frequency = binary_read_f32(&record[4]);
+        float absolute_frequency = frequency / sample_frequency;
+
+        waves[i].amplitude = binary_read_f32(&record[0]);
+        waves[i].frequency = absolute_frequency;
+        waves[i].phase = binary_read_f32(&record[8]);
+        waves[i].offset = binary_read_f32(&record[12]);
+
+        // Check if all the fields are finite numbers, and if the absolute frequency is valid:
+        if (!isfinite(waves[i].amplitude) || !isfinite(waves[i].phase) || !isfinite(waves[i].offset) || !(absolute_frequency >= 0.0f && absolute_frequency <= 1.0f)) {
+            ESP_LOGE(WIFI_SERVER_TAG, "Wave '%d' of the binary wave message is invalid!", i);
+
+            return ESP_FAIL;
+        }
+    }
+
+    // Check if a running DAC can output the samples at the new sample frequency:
+    if (program_data.dac_is_enabled && check_dac_output_config(sample_frequency, program_data.dac_interpolation_factor) != ESP_OK)
+        return ESP_FAIL;
+
+    // Store the decoded waves, now that the complete message is validated:
+    program_data.sample_frequency = sample_frequency;
+    program_data.number_of_waves = wave_count;
+
+    memcpy(program_data.waves, waves, sizeof(waves));
+
+    return ESP_OK;
+}
+
+esp_err_t parse_fft_binary(const uint8_t* binary_data, size_t binary_length) {
+    const uint8_t* payload = NULL;
+    size_t payload_length = 0;
+
+    // Check if the message has a valid header, and contains the complete payload:
+    if (binary_read_header(binary_data, binary_length, BINARY_FFT_MESSAGE, &payload, &payload_length) != 0 || payload_length < BINARY_FFT_PAYLOAD_LENGTH) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid header of the binary FFT message!");
+
+        return ESP_FAIL;
+    }
+
+    uint8_t window_id = payload[0];
+    uint8_t flags = payload[1];
+    uint8_t maximum_peaks = payload[2];
+    float peak_threshold = binary_read_f32(&payload[4]);
+
+    _Static_assert((int)BINARY_FLAT_TOP_WINDOW == (int)FLAT_TOP_WINDOW_F32, "The window IDs of the binary protocol must match the 'window_config_t' enum!");
+
+    // Check if the window ID is a known window configuration:
+    if (window_id > BINARY_FLAT_TOP_WINDOW) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Unknown window ID '%d' in the binary FFT message!", window_id);
+
+        return ESP_FAIL;
+    }
+
+    // Check if the (optional) peak settings are valid:
+    if ((flags & BINARY_FFT_FLAG_PEAK_CONFIG) && (maximum_peaks > MAXIMUM_PEAKS_LENGTH || !isfinite(peak_threshold))) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid peak settings in the binary FFT message!");
+
+        return ESP_FAIL;
+    }
+
+    program_data.window = (window_config_t)window_id;
+
+    if (flags & BINARY_FFT_FLAG_PEAK_CONFIG) {
+        program_data.peak_config.threshold_db = peak_threshold;
+        program_data.peak_config.maximum_peaks = maximum_peaks;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t parse_dac_binary(const uint8_t* binary_data, size_t binary_length) {
+    const uint8_t* payload = NULL;
+    size_t payload_length = 0;
+
+    // Check if the message has a valid header, and contains the complete payload:
+    if (binary_read_header(binary_data, binary_length, BINARY_DAC_MESSAGE, &payload, &payload_length) != 0 || payload_length < BINARY_DAC_PAYLOAD_LENGTH) {
+        ESP_LOGE(WIFI_SERVER_TAG, "Invalid header of the binary DAC message!");
+
+        return ESP_FAIL;
+    }
+
+    program_data.prevent_dac_overflow = (payload[0] & BINARY_DAC_FLAG_PREVENT_OVERFLOW) != 0;
+    program_data.keep_dac_phase = (payload[0] & BINARY_DAC_FLAG_KEEP_PHASE) != 0;
+    program_data.dac_swap_mode = (payload[0] & BINARY_DAC_FLAG_SWAP_AT_PERIOD) != 0 ? DAC_SWAP_AT_PERIOD : DAC_SWAP_AT_CROSSING;
+
+    return ESP_OK;
+}
+
+esp_err_t format_peak_binary_response(const fft_data_t* fft_data, uint8_t* response, size_t response_length, size_t* written_length) {
+    // Check if `fft_data`, `response` and `written_length` have a valid value:
+    if (fft_data == NULL || response == NULL || written_length == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "fft_data", "response", "written_length");
+
+        return ESP_FAIL;
+    }
+
+    size_t payload_length = BINARY_PEAK_PAYLOAD_HEADER_LENGTH + fft_data->number_of_peaks * BINARY_PEAK_RECORD_LENGTH;
+
+    // Check if the complete response fits into the buffer:
+    if (BINARY_HEADER_LENGTH + payload_length > response_length) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The peaks do not fit into the response!");
+
+        return ESP_FAIL;
+    }
+
+    uint8_t* payload = &response[BINARY_HEADER_LENGTH];
+
+    // Write the header, the number of peaks and a record for every peak:
+    binary_write_header(response, BINARY_PEAK_MESSAGE, payload_length);
+
+    memset(payload, 0, BINARY_PEAK_PAYLOAD_HEADER_LENGTH);
+    payload[0] = fft_data->number_of_peaks;
+
+    for (int i = 0; i < fft_data->number_of_peaks; i++) {
+        uint8_t* record = &payload[BINARY_PEAK_PAYLOAD_HEADER_LENGTH + i * BINARY_PEAK_RECORD_LENGTH];
+
+        binary_write_f32(&record[0], fft_data->peaks[i].frequency);
+        binary_write_f32(&record[4], fft_data->peaks[i].amplitude);
+    }
+
+    *written_length = BINARY_HEADER_LENGTH + payload_length;
+
+    return ESP_OK;
+}
+
+esp_err_t save_program_data(bool store_dac_values) {
+    _Static_assert(NUMBER_OF_SAMPLES <= DAC_MAXIMUM_SAMPLES, "The DAC must be able to hold all the samples!");
+    _Static_assert(MAXIMUM_STORED_WAVES == MAXIMUM_WAVES_LENGTH, "The stored configuration must be able to hold all the waves!");
+
+    stored_config_t stored_config;
+
+    memset(&stored_config, 0, sizeof(stored_config)); // Clear the padding as well, because unchanged configurations are detected by comparing their bytes.
+
+    stored_config.sample_frequency = program_data.sample_frequency;
+    stored_config.number_of_waves = program_data.number_of_waves;
+    stored_config.window = program_data.window;
+    stored_config.dac_is_enabled = program_data.dac_is_enabled;
+    stored_config.prevent_dac_overflow = program_data.prevent_dac_overflow;
+    stored_config.dac_swap_mode = program_data.dac_swap_mode;
+    stored_config.keep_dac_phase = program_data.keep_dac_phase;
+    stored_config.dac_interpolation_factor = program_data.dac_interpolation_factor;
+    stored_config.dac_channels = program_data.dac_channels;
+    stored_config.number_of_second_channel_waves = program_data.number_of_second_channel_waves;
+    stored_config.second_channel_sample_frequency = program_data.second_channel_sample_frequency;
+    stored_config.filter = program_data.filter_stage.config;
+
+    memcpy(stored_config.waves, program_data.waves, program_data.number_of_waves * sizeof(wave_config_t));
+    memcpy(stored_config.second_channel_waves, program_data.second_channel_waves, program_data.number_of_second_channel_waves * sizeof(wave_config_t));
+
+    if (store_dac_values)
+        stored_config.dac_values_length = NUMBER_OF_SAMPLES * DAC_NUMBER_OF_CHANNELS;
+
+    return save_stored_config(&stored_config, program_data.dac_values);
+}
+
+esp_err_t restore_program_data(void) {
+    stored_config_t stored_config = {};
+
+    esp_err_t succeeded_loading = load_stored_config(&stored_config, program_data.dac_values, NUMBER_OF_SAMPLES * DAC_NUMBER_OF_CHANNELS);
+
+    // Check if a configuration is stored (after the first boot, nothing is stored yet):
+    if (succeeded_loading != ESP_OK) {
+        if (succeeded_loading == ESP_ERR_NOT_FOUND) {
+            ESP_LOGI(WIFI_SERVER_TAG, "No stored configuration found, so the program starts empty!");
+
+            return ESP_OK;
+        }
+
+        return ESP_FAIL;
+    }
+
+    // Restore the configuration into the program data:
+    program_data.sample_frequency = stored_config.sample_frequency;
+    program_data.number_of_waves = stored_config.number_of_waves;
+    program_data.window = stored_config.window;
+    program_data.prevent_dac_overflow = stored_config.prevent_dac_overflow;
+    program_data.dac_swap_mode = stored_config.dac_swap_mode;
+    program_data.keep_dac_phase = stored_config.keep_dac_phase;
+    program_data.dac_interpolation_factor = stored_config.dac_interpolation_factor;
+    program_data.dac_channels = stored_config.dac_channels;
+    program_data.number_of_second_channel_waves = stored_config.number_of_second_channel_waves;
+    program_data.second_channel_sample_frequency = stored_config.second_channel_sample_frequency;
+
+    // Restore the filter (an invalid stored filter is ignored):
+    if (configure_filter_stage(&program_data.filter_stage, &stored_config.filter) != ESP_OK)
+        ESP_LOGW(WIFI_SERVER_TAG, "The stored filter is ignored!");
+
+    memcpy(program_data.waves, stored_config.waves, stored_config.number_of_waves * sizeof(wave_config_t));
+    memcpy(program_data.second_channel_waves, stored_config.second_channel_waves, stored_config.number_of_second_channel_waves * sizeof(wave_config_t));
+
+    bool resumes_dac = stored_config.dac_is_enabled; // The DAC is resumed if it was running, and the stored settings are supported (otherwise the board starts silent).
+
+    if (resumes_dac && (program_data.sample_frequency == 0 || check_dac_output_config(program_data.sample_frequency, program_data.dac_interpolation_factor) != ESP_OK)) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The stored sample frequency is not supported by the DAC, so the DAC starts silent!");
+
+        resumes_dac = false;
+    }
+
+    dac_data.swap_mode = program_data.dac_swap_mode;
+    dac_data.keep_phase = program_data.keep_dac_phase;
+
+    // Resume the DAC output first, directly from the stored values:
+    if (resumes_dac && stored_config.dac_values_length == NUMBER_OF_SAMPLES * DAC_NUMBER_OF_CHANNELS) {
+        if (dac_output_values(program_data.dac_values, NUMBER_OF_SAMPLES, program_data.sample_frequency, program_data.dac_interpolation_factor, program_data.dac_channels) == ESP_OK)
+            program_data.dac_is_enabled = true;
+        else {
+            ESP_LOGE(WIFI_SERVER_TAG, "The stored DAC values could not be output, so the DAC starts silent!");
+
+            resumes_dac = false;
+        }
+    }
+
+    // Generate the samples for the FFT from the restored waves (the DAC is already running at this point):
+    if (program_data.sample_frequency > 0) {
+        program_data.sample_source.sample_frequency = program_data.sample_frequency;
+
+        if (read_program_samples() != ESP_OK)
+            ESP_LOGE(WIFI_SERVER_TAG, "The samples of the stored waves could not be generated!");
+    }
+
+    // Without stored values, the DAC values have to be computed from the generated samples (quantize the samples of both channels, and output them):
+    if (resumes_dac && !program_data.dac_is_enabled) {
+        if (output_program_dac_values() == ESP_OK)
+            program_data.dac_is_enabled = true;
+        else
+            ESP_LOGE(WIFI_SERVER_TAG, "The DAC values could not be computed, so the DAC starts silent!");
+    }
+
+    ESP_LOGI(WIFI_SERVER_TAG, "The stored configuration with '%d' waves is restored!", (int)program_data.number_of_waves);
+
+    return ESP_OK;
+}
+
+static int append_peak_list(const fft_data_t* fft_data, char* response, size_t response_length, int written_length) {
+    if (written_length < response_length)
+        written_length += snprintf(&response[written_length], response_length - written_length, "\"peaks\":[");
+
+    // Append every peak as a compact object with its frequency and amplitude:
+    for (int i = 0; i < fft_data->number_of_peaks && written_length < response_length; i++)
+        written_length += snprintf(&response[written_length], response_length - written_length, "%s{\"frequency\":%.2f,\"amplitude\":%.3f}", (i > 0) ? "," : "", fft_data->peaks[i].frequency, fft_data->peaks[i].amplitude);
+
+    if (written_length < response_length)
+        written_length += snprintf(&response[written_length], response_length - written_length, "]");
+
+    return written_length;
+}
+
+esp_err_t format_peak_response(const fft_data_t* fft_data, char* response, size_t response_length) {
+    // Check if `fft_data` and `response` have a valid value:
+    if (fft_data == NULL || response == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "fft_data", "response");
+
+        return ESP_FAIL;
+    }
+
+    int written_length = snprintf(response, response_length, "{");
+
+    written_length = append_peak_list(fft_data, response, response_length, written_length);
+
+    if (written_length < response_length)
+        written_length += snprintf(&response[written_length], response_length - written_length, "}\n");
+
+    // Check if the complete response did fit into the buffer:
+    if (written_length >= response_length) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The peaks do not fit into the response!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t format_fft_job_response(const fft_job_t* job, char* response, size_t response_length) {
+    // Check if `job` and `response` have a valid value:
+    if (job == NULL || response == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "job", "response");
+
+        return ESP_FAIL;
+    }
+
+    int written_length = snprintf(response, response_length, "{\"job_id\":%u,\"status\":\"%s\"", (unsigned int)job->job_id, get_fft_job_status_name(job->status));
+
+    // Append the peaks, once the job is done:
+    if (job->status == DONE_FFT_JOB && written_length < response_length) {
+        written_length += snprintf(&response[written_length], response_length - written_length, ",\"averaged_frames\":%u,", (unsigned int)job->result.averaged_frames);
+        written_length = append_peak_list(&job->result, response, response_length, written_length);
+    }
+
+    if (written_length < response_length)
+        written_length += snprintf(&response[written_length], response_length - written_length, "}\n");
+
+    // Check if the complete response did fit into the buffer:
+    if (written_length >= response_length) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The peaks do not fit into the response!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t format_metrics_response(const quality_metrics_t* quality_metrics, int64_t duration_us, char* response, size_t response_length) {
+    // Check if `quality_metrics` and `response` have a valid value:
+    if (quality_metrics == NULL || response == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "quality_metrics", "response");
+
+        return ESP_FAIL;
+    }
+
+    int written_length = snprintf(response, response_length, "{\"fundamental_frequency\":%.2f,\"amplitude\":%.4f,\"thd_db\":%.2f,\"thd_percent\":%.4f,\"snr_db\":%.2f,\"sinad_db\":%.2f,\"enob\":%.2f,\"sfdr_db\":%.2f,\"spur_frequency\":%.2f,\"noise_floor_dbc\":%.2f,\"harmonics_dbc\":[",
+                                  quality_metrics->fundamental_frequency,
+                                  quality_metrics->fundamental_amplitude,
+                                  quality_metrics->thd_db,
+                                  quality_metrics->thd_percent,
+                                  quality_metrics->snr_db,
+                                  quality_metrics->sinad_db,
+                                  quality_metrics->enob,
+                                  quality_metrics->sfdr_db,
+                                  quality_metrics->spur_frequency,
+                                  quality_metrics->noise_floor_db);
+
+    // Append the level of every harmonic (a harmonic that is not measured, because it falls on another lobe, is `null`):
+    for (size_t i = 0; i < quality_metrics->number_of_harmonics && written_length < response_length; i++) {
+        if (isfinite(quality_metrics->harmonic_levels_dbc[i]))
+            written_length += snprintf(&response[written_length], response_length - written_length, "%s%.2f", (i > 0) ? "," : "", quality_metrics->harmonic_levels_dbc[i]);
+        else
+            written_length += snprintf(&response[written_length], response_length - written_length, "%snull", (i > 0) ? "," : "");
+    }
+
+    if (written_length < response_length)
+        written_length += snprintf(&response[written_length], response_length - written_length, "],\"duration_us\":%lld}\n", (long long)duration_us);
+
+    // Check if the complete response did fit into the buffer:
+    if (written_length >= response_length) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The metrics do not fit into the response!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t format_trace_event_response(const trace_event_t* event, char* response, size_t response_length) {
+    // Check if `event` and `response` have a valid value:
+    if (event == NULL || response == NULL) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "event", "response");
+
+        return ESP_FAIL;
+    }
+
+    int written_length = snprintf(response, response_length, "{\"sequence\":%u,\"timestamp_us\":%lld,\"stage\":\"%s\",\"level\":\"%s\",\"values\":[%ld,%ld,%ld],\"measurements\":[%.6g,%.6g]}",
+                                  (unsigned int)event->sequence,
+                                  (long long)event->timestamp_us,
+                                  get_trace_stage_name(event->stage),
+                                  get_trace_level_name(event->level),
+                                  (long)event->values[0],
+                                  (long)event->values[1],
+                                  (long)event->values[2],
+                                  isfinite(event->measurements[0]) ? event->measurements[0] : 0.0f,
+                                  isfinite(event->measurements[1]) ? event->measurements[1] : 0.0f);
+
+    // Check if the complete event did fit into the buffer:
+    if (written_length < 0 || written_length >= response_length) {
+        ESP_LOGE(WIFI_SERVER_TAG, "The trace event does not fit into the response!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t find_requested_fft_job(httpd_req_t* request, fft_job_t* job) {
+    char query[MAXIMUM_QUERY_LENGTH] = {};
+    char job_id_value[MAXIMUM_QUERY_LENGTH] = {};
+
+    // Read the `id` parameter from the query of the URL:
+    if (httpd_req_get_url_query_str(request, query, sizeof(query) / sizeof(query[0])) != ESP_OK || httpd_query_key_value(query, "id", job_id_value, sizeof(job_id_value) / sizeof(job_id_value[0])) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_400_BAD_REQUEST, "The 'id' of the FFT job is missing!");
+
+        return ESP_FAIL;
+    }
+
+    char* value_end = NULL;
+    unsigned long job_id = strtoul(job_id_value, &value_end, 10);
+
+    // Check if the ID is a valid number, and if the job is still in the result store:
+    if (value_end == job_id_value || *value_end != '\0' || job_id == 0 || job_id > UINT32_MAX || get_fft_job(&fft_job_queue, job_id, job) != ESP_OK) {
+        httpd_resp_send_err(request, HTTPD_404_NOT_FOUND, "Unknown FFT job (it may already be evicted from the result store)!");
+
+        return ESP_FAIL;
+    }
 
     return ESP_OK;
 }
@@ -9,8 +9,20 @@
 #include "esp_netif.h"
 #include "esp_http_server.h"
 
+#include "adc_source.h"
+#include "binary_protocol.h"
+#include "config_storage.h"
+#include "correlation_transform.h"
 #include "dac_communicator.h"
+#include "fft_job_queue.h"
 #include "fft_transform.h"
+#include "filter_transform.h"
+#include "quality_metrics.h"
+#include "replay_source.h"
+#include "sample_source.h"
+#include "spectrum_stream.h"
+#include "synthesizer_source.h"
+#include "trace_buffer.h"
 #include "wave_transform.h"
 #include "window_transform.h"
 
@@ -18,20 +30,72 @@
 
 #define MAXIMUM_CONTENT_LENGTH (250)
 #define MAXIMUM_WAVES_LENGTH (10)
+#define MAXIMUM_RESPONSE_LENGTH (1024)
+#define MAXIMUM_CONTENT_TYPE_LENGTH (64)
+#define MAXIMUM_QUERY_LENGTH (32)
+#define MAXIMUM_RECEIVE_TIMEOUTS (5) // The number of consecutive timeouts after which a request that arrives in multiple parts is answered with status 408.
+#define MAXIMUM_URI_HANDLERS (16)
+#define MAXIMUM_TRACE_EVENT_LENGTH (192) // The longest JSON object of a single trace event.
+#define DEFAULT_TRACE_EVENTS (32)        // The number of most recent events that `/trace` returns, without a `count` query parameter.
+#define TRACE_EVENTS_PER_CHUNK (8)       // The number of events that `/trace` reads from the ring at once.
 
-#define NUMBER_OF_SAMPLES (2048)
+#define FFT_JOB_BINARY_TIMEOUT_MS (5000)
+
+#define NUMBER_OF_SAMPLES (2048) // The frame size of the FFT ('main/CMakeLists.txt' reads it, to generate the FFT tables for this length).
+
+#if defined(FFT_STATIC_LENGTH) && FFT_STATIC_LENGTH != NUMBER_OF_SAMPLES
+#error "The generated FFT tables do not match 'NUMBER_OF_SAMPLES'!"
+#endif
+
+#define DEFAULT_REFERENCE_LENGTH (256)
 
 /// @brief Defining a struct called `program_data`, that contains all the needed data for running the HTTP server (the actual program - completely event based).
 typedef struct program_data {
     float samples[NUMBER_OF_SAMPLES]; // This field is an array of `float` samples.
     size_t sample_frequency;          // This field contains a `size_t` with the sample frequency.
 
+    sample_source_t sample_source; // This field contains the `sample_source_t` that feeds the samples (the synthesizer, the ADC or a replayed recording).
+    SemaphoreHandle_t source_lock; // This field contains a `SemaphoreHandle_t` mutex, that guards the source and the filter stage (the worker of the FFT jobs captures samples from them).
+    adc_channel_t adc_channel;     // This field contains the `adc_channel_t` that the ADC source captures (so its capture can be restored).
+
     wave_config_t waves[MAXIMUM_WAVES_LENGTH]; // This field contains an array of `wave_config_t` waves.
     size_t number_of_waves;                    // This field contains a `size_t` with the number of waves.
 
+    filter_stage_t filter_stage; // This field contains the `filter_stage_t` through which the samples of the source pass.
+
     window_config_t window; // This field represents a `window_config_t` window.
 
+    peak_config_t peak_config; // This field contains a `peak_config_t` with the settings for extracting the peaks of the spectrum.
+
+    averaging_config_t averaging_config; // This field contains an `averaging_config_t` with the settings for accumulating consecutive spectra.
+
     bool prevent_dac_overflow; // Field with a boolean flag to prevent DAC overflow.
+    bool dac_is_enabled;       // Field with a boolean flag, indicating if the DAC is outputting the samples.
+    bool keep_dac_phase;       // Field with a boolean flag, indicating if new DAC values continue at the same position in their period.
+
+    dac_swap_mode_t dac_swap_mode;   // This field contains the `dac_swap_mode_t` with the moment at which new DAC values are swapped in.
+    size_t dac_interpolation_factor; // This field contains a `size_t` with the number of values that the DAC outputs per sample (see `dac_output_values`).
+
+    dac_output_channels_t dac_channels; // This field contains the `dac_output_channels_t` with the DAC channels that are output.
+
+    uint8_t dac_values[NUMBER_OF_SAMPLES * DAC_NUMBER_OF_CHANNELS]; // This field is an array with the samples of both channels, pre-quantized for the DAC and interleaved per sample.
+
+    wave_config_t second_channel_waves[MAXIMUM_WAVES_LENGTH]; // This field contains an array of `wave_config_t` waves, of which the samples of `DAC_CHANNEL_2` are generated (`DAC_CHANNEL_1` outputs the samples of the source).
+    size_t number_of_second_channel_waves;                    // This field contains a `size_t` with the number of waves of the second channel.
+    size_t second_channel_sample_frequency;                   // This field contains a `size_t` with the sample frequency to which the waves of the second channel are relative (they are converted when the sample frequency changes).
+
+    wave_config_t reference_waves[MAXIMUM_WAVES_LENGTH]; // This field contains an array of `wave_config_t` waves, of which the reference of `/correlate` is generated.
+    size_t number_of_reference_waves;                    // This field contains a `size_t` with the number of reference waves.
+    size_t reference_length;                             // This field contains a `size_t` with the number of samples of the reference.
+
+    correlation_mode_t correlation_mode;     // This field contains the `correlation_mode_t` that is applied with the reference.
+    correlation_method_t correlation_method; // This field contains the `correlation_method_t` with which the samples are processed.
+
+    correlation_kernel_t correlation_kernel; // This field contains the `correlation_kernel_t` with the cached spectrum of the last reference.
+    float* correlation_reference;            // This field is a pointer to the samples of the reference of the cached kernel (to detect a changed reference, and to normalize the peak).
+
+    quality_config_t quality_config; // This field contains a `quality_config_t` with the settings of the signal quality measurement of `/metrics`.
+    window_config_t quality_window;  // This field contains the `window_config_t` window of the signal quality measurement (a window with low side lobes, so their leakage does not count as noise).
 } program_data_t;
 
 extern program_data_t program_data;
@@ -41,7 +105,7 @@ extern program_data_t program_data;
 /// @param pass_name The password of the Wi-Fi network that you want to connect to.
 extern void start_wifi_connection(const char* ssid_name, const char* pass_name);
 
-/// @brief This function starts a web server and registers URI handlers for POST requests to `/wave`, `/fft`, and `/dac`.
+/// @brief This function starts a web server, registers URI handlers for POST requests to `/wave`, `/fft`, `/dac`, `/source`, `/filter`, `/replay`, `/correlate`, `/metrics` and `/trace` and GET requests to `/fft/status`, `/fft/result` and `/trace`, starts the worker of the FFT jobs, and starts the spectrum stream on the `/stream` WebSocket.
 /// @param server_handle A handle to the HTTP server instance that is being started.
 extern void start_webserver(httpd_handle_t server_handle);
 
@@ -61,29 +125,264 @@ extern void wifi_event_handler(void*, esp_event_base_t, int32_t event_id, void*)
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
 extern esp_err_t wave_post_handler(httpd_req_t* request);
 
-/// @brief This function handles a POST request for FFT data, parses the data, applies FFT on it, and sends a response.
+/// @brief This function handles a POST request for FFT data, parses the data, queues a FFT job for the worker, and sends a response with the ID of the job (a binary request waits for the job, and is answered with the found peaks).
 /// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
 extern esp_err_t fft_post_handler(httpd_req_t* request);
 
+/// @brief This function handles a GET request for the status of the FFT job in the `id` query parameter.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t fft_status_get_handler(httpd_req_t* request);
+
+/// @brief This function handles a GET request for the result of the FFT job in the `id` query parameter, and sends its peaks once it is done (before that, it is answered with `202 Accepted` and the status).
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t fft_result_get_handler(httpd_req_t* request);
+
 /// @brief This function handles a POST request for a DAC output and sends a response indicating successful execution.
 /// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
 extern esp_err_t dac_post_handler(httpd_req_t* request);
 
-/// @brief This function parses JSON data containing wave information and stores it in a program data structure.
+/// @brief This function handles a POST request for selecting the source of the samples (the synthesizer or the ADC) and sends a response indicating successful execution.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t source_post_handler(httpd_req_t* request);
+
+/// @brief This function handles a POST request for configuring the filter stage, filters the samples again and sends a response indicating successful execution.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t filter_post_handler(httpd_req_t* request);
+
+/// @brief This function handles a POST request with a recording (see `replay_header_t`), that is replayed as the source of the samples.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t replay_post_handler(httpd_req_t* request);
+
+/// @brief This function handles a POST request for correlating (or convolving) the current samples with a reference, that is generated from waves, and sends a response with the peak of the result and its lag.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t correlate_post_handler(httpd_req_t* request);
+
+/// @brief This function handles a POST request for measuring the quality of the tone in the current samples, and sends a response with its THD, SNR, SINAD, ENOB and SFDR.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t metrics_post_handler(httpd_req_t* request);
+
+/// @brief This function handles the WebSocket handshake of a client that joins the spectrum stream, and the text frames with which the client configures its frame rate and encoding.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t stream_ws_handler(httpd_req_t* request);
+
+/// @brief This function handles a GET request for the events of the trace, from the `since` query parameter on (or the last `count` events), and sends them as a chunked JSON response.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t trace_get_handler(httpd_req_t* request);
+
+/// @brief This function handles a POST request for the level of the trace and its console output, and sends a response with the applied settings.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t trace_post_handler(httpd_req_t* request);
+
+/// @brief This function records a request in the trace without blocking, and only logs its content directly at the `TRACE_LEVEL_VERBOSE` level (which blocks on the console).
+/// @param stage The `trace_stage_t` of the endpoint.
+/// @param handler_name The name of the handler, for the direct log.
+/// @param content A string with the content of the request, or `NULL` if it is not logged.
+/// @param content_length The length of the content in bytes.
+/// @param is_binary_content A `bool` indicating if the content is in the binary format (which is not logged as a string).
+extern void trace_request(trace_stage_t stage, const char* handler_name, const char* content, int content_length, bool is_binary_content);
+
+/// @brief This function parses JSON data containing wave information and stores it in a program data structure, as the waves of the source (`DAC_CHANNEL_1`), of the second DAC channel, or of both. The complete request is validated first (including the sample frequency for a running DAC), so nothing is changed when it is rejected.
 /// @param json_data A string containing JSON data to be parsed.
+/// @param wave_channels A pointer where the `dac_output_channels_t` with the channels that receive the waves will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_wave_data(const char* json_data, dac_output_channels_t* wave_channels);
+
+/// @brief This function parses a JSON array of waves (with frequencies in Hz) into wave configurations, relative to a sample frequency. A wave with missing properties or an invalid frequency is skipped, and keeps its previous configuration.
+/// @param waves_array A pointer to the `cJSON` array of waves.
+/// @param sample_frequency The sample frequency to which the frequencies are relative (in Hz).
+/// @param wave_configs A pointer to an array of `MAXIMUM_WAVES_LENGTH` wave configurations, where the waves will be stored.
+/// @param number_of_waves A pointer where the number of waves will be stored (truncated to `MAXIMUM_WAVES_LENGTH`).
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
-extern esp_err_t parse_wave_data(const char* json_data);
+extern esp_err_t parse_wave_items(const cJSON* waves_array, size_t sample_frequency, wave_config_t* wave_configs, size_t* number_of_waves);
+
+/// @brief This function converts the name of a wave type (for example `"SQUARE"`) into its `wave_type_t` value.
+/// @param type_name A string with the name of the wave type.
+/// @param wave_type A pointer where the `wave_type_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_wave_type(const char* type_name, wave_type_t* wave_type);
 
-/// @brief This function parses JSON data and extracts a window configuration value from it.
+/// @brief This function parses JSON data containing the settings of the filter stage (every item is optional), checks them against the current sample frequency, and configures the filter stage with them.
 /// @param json_data A string containing JSON data to be parsed.
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_filter_data(const char* json_data);
+
+/// @brief This function takes the lock of the source, which must be held while the source or the filter stage is changed (it does nothing before the webserver is started).
+extern void take_source_lock(void);
+
+/// @brief This function gives back the lock of the source, that is taken with `take_source_lock`.
+extern void give_source_lock(void);
+
+/// @brief This function reads the next samples from the source into the program data structure, and passes them through the filter stage (which is bypassed if its cutoff frequencies do not fit the sample frequency). It takes the lock of the source itself.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t read_program_samples(void);
+
+/// @brief This function captures the next samples of a live source for an FFT job on its worker, without changing the samples of the program data structure (the samples of the synthesizer are copied, since they are generated on the call to `/wave`).
+/// @param samples A pointer to a buffer where the samples will be stored.
+/// @param sample_length The number of samples (equal to `NUMBER_OF_SAMPLES`).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (which fails the job).
+extern esp_err_t capture_program_samples(float* samples, size_t sample_length);
+
+/// @brief This function converts the name of an averaging mode (for example `"MAX_HOLD"`) into its `averaging_mode_t` value.
+/// @param mode_name A string with the name of the averaging mode.
+/// @param averaging_mode A pointer where the `averaging_mode_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_averaging_mode(const char* mode_name, averaging_mode_t* averaging_mode);
+
+/// @brief This function parses JSON data and extracts a window configuration value (and optionally the peak and averaging settings) from it.
+/// @param json_data A string containing JSON data to be parsed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (like an unknown window or averaging mode, which keeps all the current settings).
 extern esp_err_t parse_fft_data(const char* json_data);
 
+/// @brief This function converts the name of a window (for example `"HANN_F32"`) into its `window_config_t` value.
+/// @param window_name A string with the name of the window.
+/// @param window_config A pointer where the `window_config_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_window_config(const char* window_name, window_config_t* window_config);
+
 /// @brief The function parses a JSON string and extracts a boolean value to set a flag in a program's data structure.
 /// @param json_data A string containing JSON data to be parsed.
-/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (like an unsupported swap mode, interpolation factor or selection of channels, which keeps all the current settings).
 extern esp_err_t parse_dac_data(const char* json_data);
 
+/// @brief This function converts the name of a DAC channel selection into its `dac_output_channels_t` value (for example `"BOTH"`).
+/// @param channels_name A string with the name of the channels.
+/// @param output_channels A pointer where the `dac_output_channels_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_dac_channels(const char* channels_name, dac_output_channels_t* output_channels);
+
+/// @brief This function quantizes the samples of the source for `DAC_CHANNEL_1` and the waves of the second channel for `DAC_CHANNEL_2` into the interleaved DAC values, and outputs them over the selected channels (a running output swaps them in).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (also if the sample frequency is not supported by the DAC).
+extern esp_err_t output_program_dac_values(void);
+
+/// @brief This function parses JSON data containing the source selection, and opens the selected source in the program data structure. The current source is only replaced once the selected source is opened (a failed restart of the ADC restores its previous capture).
+/// @param json_data A string containing JSON data to be parsed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (in which case the current source is kept).
+extern esp_err_t parse_source_data(const char* json_data);
+
+/// @brief This function converts the name of a correlation mode (for example `"CONVOLUTION"`) into its `correlation_mode_t` value.
+/// @param mode_name A string with the name of the correlation mode.
+/// @param correlation_mode A pointer where the `correlation_mode_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_correlation_mode(const char* mode_name, correlation_mode_t* correlation_mode);
+
+/// @brief This function converts the name of a correlation method (for example `"OVERLAP_SAVE"`) into its `correlation_method_t` value.
+/// @param method_name A string with the name of the correlation method.
+/// @param correlation_method A pointer where the `correlation_method_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_correlation_method(const char* method_name, correlation_method_t* correlation_method);
+
+/// @brief This function parses JSON data containing the reference waves, the reference length, the mode and the method of a correlation, and stores them in the program data structure. Without a method, a single block is used if the samples and the reference fit in a single FFT, and overlap-save otherwise.
+/// @param json_data A string containing JSON data to be parsed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (like an unknown mode or method, or an invalid wave, which keeps the current reference and settings).
+extern esp_err_t parse_correlation_data(const char* json_data);
+
+/// @brief This function parses JSON data containing the settings of the signal quality measurement (the number of harmonics, the fundamental frequency and the window, which are all optional), and stores them in the program data structure.
+/// @param json_data A string containing JSON data to be parsed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_metrics_data(const char* json_data);
+
+/// @brief This function parses JSON data containing the frame rate and encoding of a client of the spectrum stream, and applies them to the client.
+/// @param socket The socket descriptor of the client.
+/// @param json_data A string containing JSON data to be parsed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_stream_data(int socket, const char* json_data);
+
+/// @brief This function parses JSON data containing the level of the trace and its console output, and applies them to the trace buffer.
+/// @param json_data A string containing JSON data to be parsed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_trace_data(const char* json_data);
+
+/// @brief This function converts the name of a trace level into its `trace_level_t` value (for example `"VERBOSE"`).
+/// @param level_name A string with the name of the level.
+/// @param level A pointer where the `trace_level_t` value will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the name is unknown.
+extern esp_err_t parse_trace_level(const char* level_name, trace_level_t* level);
+
+/// @brief This function checks if the `Content-Type` of a request is the binary format (`application/octet-stream`), see 'binary_protocol.h'.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @return A `bool`, which is `true` if the content of the request is in the binary format.
+extern bool request_has_binary_content(httpd_req_t* request);
+
+/// @brief This function decodes a binary wave message and stores the waves in the program data structure (only if the complete message is valid, and a running DAC supports its sample frequency).
+/// @param binary_data A pointer to the binary message.
+/// @param binary_length The length of the binary message in bytes.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_wave_binary(const uint8_t* binary_data, size_t binary_length);
+
+/// @brief This function decodes a binary FFT message and stores the window (and optionally the peak settings) in the program data structure.
+/// @param binary_data A pointer to the binary message.
+/// @param binary_length The length of the binary message in bytes.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_fft_binary(const uint8_t* binary_data, size_t binary_length);
+
+/// @brief This function decodes a binary DAC message and stores the flags in the program data structure.
+/// @param binary_data A pointer to the binary message.
+/// @param binary_length The length of the binary message in bytes.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_dac_binary(const uint8_t* binary_data, size_t binary_length);
+
+/// @brief This function formats the peaks found by the FFT as a binary peak message.
+/// @param fft_data A pointer to the FFT data structure that contains the found peaks.
+/// @param response A pointer to a buffer where the binary response will be stored.
+/// @param response_length The length of the `response` buffer.
+/// @param written_length A pointer to a `size_t` where the length of the binary response will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the response does not fit.
+extern esp_err_t format_peak_binary_response(const fft_data_t* fft_data, uint8_t* response, size_t response_length, size_t* written_length);
+
+/// @brief This function stores the current configuration of the program data structure in NVS, so it can be restored after a reboot (see `restore_program_data`).
+/// @param store_dac_values A `bool` indicating if the pre-quantized DAC values are stored as well.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t save_program_data(bool store_dac_values);
+
+/// @brief This function restores the stored configuration into the program data structure, and resumes the DAC output from the stored pre-quantized values (without generating the waves first).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully (also if nothing is stored) or `ESP_FAIL` if there is an error.
+extern esp_err_t restore_program_data(void);
+
+/// @brief This function formats the peaks found by the FFT as a compact JSON response.
+/// @param fft_data A pointer to the FFT data structure that contains the found peaks.
+/// @param response A pointer to a character array where the JSON response will be stored.
+/// @param response_length The length of the `response` character array.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the response does not fit.
+extern esp_err_t format_peak_response(const fft_data_t* fft_data, char* response, size_t response_length);
+
+/// @brief This function formats the status of a FFT job as a compact JSON response, together with its peaks once it is done.
+/// @param job A pointer to the FFT job.
+/// @param response A pointer to a character array where the JSON response will be stored.
+/// @param response_length The length of the `response` character array.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the response does not fit.
+extern esp_err_t format_fft_job_response(const fft_job_t* job, char* response, size_t response_length);
+
+/// @brief This function formats the figures of a signal quality measurement as a compact JSON response.
+/// @param quality_metrics A pointer to the measured `quality_metrics_t` structure.
+/// @param duration_us The duration of the measurement (in microseconds).
+/// @param response A pointer to a character array where the JSON response will be stored.
+/// @param response_length The length of the `response` character array.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the response does not fit.
+extern esp_err_t format_metrics_response(const quality_metrics_t* quality_metrics, int64_t duration_us, char* response, size_t response_length);
+
+/// @brief This function formats a single trace event as a compact JSON object.
+/// @param event A pointer to the `trace_event_t` structure.
+/// @param response A pointer to a character array where the JSON object will be stored.
+/// @param response_length The length of the `response` character array.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the object does not fit.
+extern esp_err_t format_trace_event_response(const trace_event_t* event, char* response, size_t response_length);
+
+/// @brief This function looks up the FFT job in the `id` query parameter of a request, and sends an error response if it is missing or unknown.
+/// @param request A pointer to the HTTP request structure, which contains information about the incoming HTTP request.
+/// @param job A pointer to a `fft_job_t` structure where the job will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the job is unknown (the error response is already sent).
+extern esp_err_t find_requested_fft_job(httpd_req_t* request, fft_job_t* job);
+
 #endif
@@ -12,9 +12,14 @@
 
 // Instantiate the 'dac_data' structure, with all its initial values:
 dac_data_t dac_data = {
-    .digital_samples = NULL, 
+    .dac_values = NULL,
     .number_of_samples = 0,
-    .timer = NULL
+    .interpolation_factor = 1,
+    .output_channels = DAC_OUTPUT_CHANNEL_1,
+    .swap_mode = DAC_SWAP_AT_CROSSING,
+    .keep_phase = false,
+    .timer = NULL,
+    .lock = portMUX_INITIALIZER_UNLOCKED
 };
 
 // Instantiate the 'program_data' structure, with all its initial values:
@@ -23,18 +28,74 @@ program_data_t program_data = {
     .sample_frequency = 0,
     .waves = {},
     .number_of_waves = 0,
+    .filter_stage = {
+        .config = {
+            .structure = NO_FILTER,
+            .order = DEFAULT_FILTER_ORDER
+        }
+    },
     .window = 0,
-    .prevent_dac_overflow = false
+    .peak_config = {
+        .threshold_db = DEFAULT_PEAK_THRESHOLD_DB,
+        .maximum_peaks = MAXIMUM_PEAKS_LENGTH
+    },
+    .averaging_config = {
+        .mode = NO_AVERAGING,
+        .frames = DEFAULT_AVERAGING_FRAMES,
+        .alpha = DEFAULT_AVERAGING_ALPHA
+    },
+    .prevent_dac_overflow = false,
+    .dac_is_enabled = false,
+    .keep_dac_phase = false,
+    .dac_swap_mode = DAC_SWAP_AT_CROSSING,
+    .dac_interpolation_factor = 1,
+    .dac_channels = DAC_OUTPUT_CHANNEL_1,
+    .dac_values = {0},
+    .second_channel_waves = {},
+    .number_of_second_channel_waves = 0,
+    .second_channel_sample_frequency = 0,
+    .reference_waves = {},
+    .number_of_reference_waves = 0,
+    .reference_length = DEFAULT_REFERENCE_LENGTH,
+    .correlation_mode = CROSS_CORRELATION,
+    .correlation_method = SINGLE_BLOCK_CORRELATION,
+    .correlation_kernel = {},
+    .correlation_reference = NULL,
+    .quality_config = {
+        .number_of_harmonics = DEFAULT_QUALITY_HARMONICS,
+        .fundamental_frequency = 0.0f
+    },
+    .quality_window = BLACKMAN_HARRIS_WINDOW_F32
 };
 
+spectrum_stream_t spectrum_stream = {}; // Instantiate the 'spectrum_stream' structure, without any clients.
+
+fft_job_queue_t fft_job_queue = {}; // Instantiate the 'fft_job_queue' structure, without any jobs.
+
+trace_buffer_t trace_buffer = {}; // Instantiate the 'trace_buffer' structure, without any events.
+
 SSD1306_t oled_display; // Instantiate the 'oled_display' structure.
 
 void app_main() {
-    ESP_ERROR_CHECK(nvs_flash_init()); // Initialize the 'NVS Flash' for storing Wi-Fi communication data.
+    ESP_ERROR_CHECK(nvs_flash_init());                                  // Initialize the 'NVS Flash' for storing Wi-Fi communication data and the last applied configuration.
+    ESP_ERROR_CHECK(start_trace_buffer(&trace_buffer, TRACE_LEVEL_INFO)); // Start tracing, before any task records an event.
+
+#ifdef FFT_VERIFY_STATIC_TABLES
+    ESP_ERROR_CHECK(verify_static_fft_tables()); // Check the generated FFT tables against the runtime-computed ones.
+#endif
+
+#ifdef SPECTRUM_KERNELS_BENCHMARK
+    spectrum_benchmark_t spectrum_benchmark = {};
+
+    ESP_ERROR_CHECK(benchmark_spectrum_kernels_f32(NUMBER_OF_SAMPLES / 2, SPECTRUM_BENCHMARK_ITERATIONS, &spectrum_benchmark)); // Time the fused spectrum kernels against the scalar loops, and check their accuracy.
+#endif
 
     initialize_oled(OLED_WIDTH, OLED_HEIGHT);                                 // Initialize the OLED display.
     ESP_ERROR_CHECK(oled_view_startup("  FFT CREATOR  ", " 2023 (c) bobaa")); // Show a startup screen on OLED display.
 
+    ESP_ERROR_CHECK(open_synthesizer_source(&program_data.sample_source, program_data.waves, &program_data.number_of_waves, program_data.sample_frequency)); // Feed the samples from the synthesizer by default.
+    ESP_ERROR_CHECK(restore_program_data());                                                                                                                // Restore the last applied configuration, and resume the DAC output.
+
     httpd_handle_t server_handle = NULL; // An HTTP server handle.
 
     start_wifi_connection(SSID_NAME, PASS_NAME); // Start the Wi-Fi connection.
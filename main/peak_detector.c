@@ -0,0 +1,68 @@
+#include "peak_detector.h"
+
+esp_err_t detect_peaks_f32(const float* power_db, size_t bin_count, size_t sample_length, size_t sample_frequency, window_config_t window_config, peak_config_t peak_config, fft_peak_t* peaks, size_t* number_of_peaks) {
+    // Check if `power_db`, `peaks` and `number_of_peaks` have a valid value:
+    if (power_db == NULL || peaks == NULL || number_of_peaks == NULL) {
+        ESP_LOGE(PEAK_DETECTOR_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "power_db", "peaks", "number_of_peaks");
+
+        return ESP_FAIL;
+    }
+
+    window_properties_t window_properties = {};
+
+    // Retrieve the coherent gain of the window, for correcting the amplitudes of the peaks:
+    if (get_window_properties(window_config, &window_properties) != ESP_OK) {
+        ESP_LOGE(PEAK_DETECTOR_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
+
+        return ESP_FAIL;
+    }
+
+    size_t maximum_peaks = peak_config.maximum_peaks;
+
+    // Truncate the maximum number of peaks if it exceeds the supported length:
+    if (maximum_peaks > MAXIMUM_PEAKS_LENGTH)
+        maximum_peaks = MAXIMUM_PEAKS_LENGTH;
+
+    float bin_resolution = (float)sample_frequency / (float)sample_length;
+    float amplitude_scale = 1.0f / (sample_length * window_properties.coherent_gain); // Not 2 / (N * gain), because `dsps_cplx2reC_fc32` already doubles the bins above DC.
+
+    size_t found_peaks = 0;
+
+    // Search for local maxima above the threshold (the DC bin and the last bin have no two neighbours, so they are skipped):
+    for (int i = 1; i + 1 < bin_count; i++) {
+        float left = power_db[i - 1];
+        float center = power_db[i];
+        float right = power_db[i + 1];
+
+        if (center < peak_config.threshold_db || center <= left || center < right)
+            continue;
+
+        // Apply a parabolic fit on the logarithmic values (a Gaussian fit on the magnitudes), for the sub-bin offset and the peak power:
+        float denominator = left - 2.0f * center + right;
+        float offset = (denominator != 0.0f) ? 0.5f * (left - right) / denominator : 0.0f;
+        float interpolated_power_db = center - 0.25f * (left - right) * offset;
+
+        // Skip the peak if the list is full and it is weaker than the weakest peak in the list:
+        if (found_peaks == maximum_peaks && (maximum_peaks == 0 || interpolated_power_db <= peaks[found_peaks - 1].power_db))
+            continue;
+
+        // Find the position of the peak in the list (sorted from strongest to weakest), and shift the weaker peaks:
+        size_t position = (found_peaks < maximum_peaks) ? found_peaks++ : found_peaks - 1;
+
+        while (position > 0 && peaks[position - 1].power_db < interpolated_power_db) {
+            peaks[position] = peaks[position - 1];
+            position--;
+        }
+
+        // Convert the power (normalized by the FFT length) back to the amplitude of the tone, corrected for the window:
+        float magnitude = sqrtf(powf(10.0f, interpolated_power_db / 10.0f) * sample_length);
+
+        peaks[position].frequency = (i + offset) * bin_resolution;
+        peaks[position].amplitude = magnitude * amplitude_scale;
+        peaks[position].power_db = interpolated_power_db;
+    }
+
+    *number_of_peaks = found_peaks;
+
+    return ESP_OK;
+}
@@ -0,0 +1,41 @@
+#ifndef PEAK_DETECTOR_H_
+#define PEAK_DETECTOR_H_
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "esp_log.h"
+
+#include "window_transform.h"
+
+#define PEAK_DETECTOR_TAG ("PEAK_DETECTOR_H_")
+
+#define MAXIMUM_PEAKS_LENGTH (16)
+#define DEFAULT_PEAK_THRESHOLD_DB (0.0f)
+
+/// @brief Defining a struct called `peak_config`, that contains the settings for extracting peaks from a spectrum.
+typedef struct peak_config {
+    float threshold_db;   // This field contains a `float` with the minimum power (in dB) a bin must have to be reported as a peak.
+    size_t maximum_peaks; // This field contains a `size_t` with the maximum number of peaks to report (the strongest are kept).
+} peak_config_t;
+
+/// @brief Defining a struct called `fft_peak`, that contains the interpolated properties of a single spectral peak.
+typedef struct fft_peak {
+    float frequency; // This field contains a `float` with the interpolated frequency of the peak (in Hz).
+    float amplitude; // This field contains a `float` with the window-corrected amplitude of the tone that causes the peak.
+    float power_db;  // This field contains a `float` with the interpolated power of the peak (in dB).
+} fft_peak_t;
+
+/// @brief This function searches a power spectrum (in dB) for local maxima, interpolates them to sub-bin accuracy and keeps the strongest ones.
+/// @param power_db An array of `float` values with the power of each frequency bin in dB, as produced by `apply_fft_f32`.
+/// @param bin_count The number of frequency bins in `power_db` (half the FFT length).
+/// @param sample_length The length of the FFT (in samples), used for converting bins to frequencies and for normalizing the amplitudes.
+/// @param sample_frequency The frequency at which the signal is sampled, measured in Hz (Hertz).
+/// @param window_config The window that was applied before the FFT, used to correct the amplitudes for the coherent gain of the window.
+/// @param peak_config The settings (threshold and maximum number of peaks) for the peak extraction.
+/// @param peaks A pointer to an array of at least `MAXIMUM_PEAKS_LENGTH` peaks, where the found peaks are stored from strongest to weakest.
+/// @param number_of_peaks A pointer to a `size_t` where the number of found peaks will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t detect_peaks_f32(const float* power_db, size_t bin_count, size_t sample_length, size_t sample_frequency, window_config_t window_config, peak_config_t peak_config, fft_peak_t* peaks, size_t* number_of_peaks);
+
+#endif
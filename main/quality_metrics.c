@@ -0,0 +1,201 @@
+#include "quality_metrics.h"
+
+/// @brief This is an enumeration called `bin_owner_t` with the part of the spectrum to which a bin belongs.
+typedef enum bin_owner {
+    NOISE_BIN,       // The bin is noise (or a spur that is not a harmonic).
+    DC_BIN,          // The bin is in the main lobe of the DC offset.
+    FUNDAMENTAL_BIN, // The bin is in the main lobe of the fundamental.
+    HARMONIC_BIN     // The bin is in the main lobe of a harmonic.
+} bin_owner_t;
+
+static size_t find_strongest_bin(const float* power, size_t first_bin, size_t last_bin) {
+    size_t strongest_bin = first_bin;
+
+    for (size_t i = first_bin + 1; i <= last_bin; i++) {
+        if (power[i] > power[strongest_bin])
+            strongest_bin = i;
+    }
+
+    return strongest_bin;
+}
+
+static float claim_main_lobe(const float* power, uint8_t* bin_owners, size_t bin_count, size_t center_bin, size_t half_width, bin_owner_t owner, float* weighted_bin) {
+    size_t first_bin = (center_bin > half_width) ? center_bin - half_width : 0;
+    size_t last_bin = (center_bin + half_width < bin_count) ? center_bin + half_width : bin_count - 1;
+
+    float lobe_power = 0.0f;
+    float lobe_moment = 0.0f;
+
+    // Sum the power of the bins that are not claimed by another lobe yet (two lobes that overlap share their bins with the first one):
+    for (size_t i = first_bin; i <= last_bin; i++) {
+        if (bin_owners[i] != NOISE_BIN)
+            continue;
+
+        bin_owners[i] = owner;
+        lobe_power += power[i];
+        lobe_moment += power[i] * i;
+    }
+
+    if (weighted_bin != NULL)
+        *weighted_bin = (lobe_power > 0.0f) ? lobe_moment / lobe_power : center_bin;
+
+    return lobe_power;
+}
+
+static float power_ratio_db(float numerator, float denominator) {
+    return 10.0f * log10f(fmaxf(numerator, QUALITY_MINIMUM_POWER) / fmaxf(denominator, QUALITY_MINIMUM_POWER));
+}
+
+esp_err_t measure_signal_quality_f32(const float* power, size_t bin_count, size_t sample_length, size_t sample_frequency, window_config_t window_config, quality_config_t quality_config, quality_metrics_t* quality_metrics) {
+    // Check if `power` and `quality_metrics` have a valid value:
+    if (power == NULL || quality_metrics == NULL) {
+        ESP_LOGE(QUALITY_METRICS_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "power", "quality_metrics");
+
+        return ESP_FAIL;
+    }
+
+    window_properties_t window_properties = {};
+
+    // Retrieve the width of the main lobe (and the gains, for the amplitude of the fundamental):
+    if (get_window_properties(window_config, &window_properties) != ESP_OK) {
+        ESP_LOGE(QUALITY_METRICS_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
+
+        return ESP_FAIL;
+    }
+
+    size_t half_width = window_properties.main_lobe_half_width;
+
+    // Check if the spectrum has room for the DC lobe, the fundamental and some noise:
+    if (bin_count < 4 * (half_width + 1) || sample_length == 0 || sample_frequency == 0) {
+        ESP_LOGE(QUALITY_METRICS_TAG, "The spectrum of '%d' bins is too short for the main lobes of the window!", (int)bin_count);
+
+        return ESP_FAIL;
+    }
+
+    uint8_t* bin_owners = calloc(bin_count, sizeof(uint8_t)); // The `bin_owner_t` of every bin (all bins start as noise).
+
+    // Check if the memory allocation was successful:
+    if (bin_owners == NULL) {
+        ESP_LOGE(QUALITY_METRICS_TAG, "The value of '%s' could not be 'NULL'!", "bin_owners");
+
+        return ESP_FAIL;
+    }
+
+    float bin_resolution = (float)sample_frequency / (float)sample_length;
+
+    // The DC offset leaks into the first bins, which are neither signal nor noise:
+    claim_main_lobe(power, bin_owners, bin_count, 0, half_width, DC_BIN, NULL);
+
+    // Search the fundamental in the whole spectrum, or around the requested frequency:
+    size_t first_bin = half_width + 1;
+    size_t last_bin = bin_count - 1;
+
+    if (quality_config.fundamental_frequency > 0.0f) {
+        size_t expected_bin = (size_t)lroundf(quality_config.fundamental_frequency / bin_resolution);
+
+        if (expected_bin >= first_bin + half_width)
+            first_bin = expected_bin - half_width;
+
+        if (expected_bin + half_width < last_bin)
+            last_bin = expected_bin + half_width;
+
+        if (first_bin > last_bin) {
+            ESP_LOGE(QUALITY_METRICS_TAG, "The fundamental frequency '%.2f' Hz is outside of the spectrum!", quality_config.fundamental_frequency);
+
+            free(bin_owners);
+
+            return ESP_FAIL;
+        }
+    }
+
+    size_t fundamental_bin = find_strongest_bin(power, first_bin, last_bin);
+    float fundamental_peak = power[fundamental_bin];
+    float fundamental_center = 0.0f;
+    float fundamental_power = claim_main_lobe(power, bin_owners, bin_count, fundamental_bin, half_width, FUNDAMENTAL_BIN, &fundamental_center);
+
+    // Check if there is a tone to measure:
+    if (fundamental_power <= QUALITY_MINIMUM_POWER) {
+        ESP_LOGE(QUALITY_METRICS_TAG, "The spectrum does not contain a fundamental!");
+
+        free(bin_owners);
+
+        return ESP_FAIL;
+    }
+
+    quality_metrics->fundamental_frequency = fundamental_center * bin_resolution;
+
+    // The main lobe holds the power of the tone times the mean square of the window (`A^2 * N * enbw * cg^2`, since `dsps_cplx2reC_fc32` doubles the one-sided bins):
+    quality_metrics->fundamental_amplitude = sqrtf(fundamental_power / (sample_length * window_properties.equivalent_noise_bandwidth * window_properties.coherent_gain * window_properties.coherent_gain));
+
+    size_t number_of_harmonics = (quality_config.number_of_harmonics <= MAXIMUM_QUALITY_HARMONICS) ? quality_config.number_of_harmonics : MAXIMUM_QUALITY_HARMONICS;
+    float harmonics_power = 0.0f;
+
+    // Integrate every harmonic over its main lobe, where a harmonic above the Nyquist frequency is folded back (as it is aliased by the sampling):
+    for (size_t i = 0; i < number_of_harmonics; i++) {
+        float harmonic_frequency = fmodf(quality_metrics->fundamental_frequency * (i + 2), (float)sample_frequency);
+
+        if (harmonic_frequency > 0.5f * sample_frequency)
+            harmonic_frequency = sample_frequency - harmonic_frequency;
+
+        size_t expected_bin = (size_t)lroundf(harmonic_frequency / bin_resolution);
+
+        if (expected_bin > bin_count - 1)
+            expected_bin = bin_count - 1;
+
+        // Allow the harmonic to be a bin off, since its frequency follows from the interpolated fundamental:
+        size_t harmonic_bin = find_strongest_bin(power, (expected_bin > 0) ? expected_bin - 1 : 0, (expected_bin + 1 < bin_count) ? expected_bin + 1 : bin_count - 1);
+
+        quality_metrics->harmonic_frequencies[i] = harmonic_frequency;
+
+        // A harmonic on a lobe that is already claimed is not counted twice:
+        if (bin_owners[harmonic_bin] != NOISE_BIN) {
+            quality_metrics->harmonic_levels_dbc[i] = -INFINITY;
+
+            continue;
+        }
+
+        float harmonic_power = claim_main_lobe(power, bin_owners, bin_count, harmonic_bin, half_width, HARMONIC_BIN, NULL);
+
+        quality_metrics->harmonic_levels_dbc[i] = power_ratio_db(harmonic_power, fundamental_power);
+        harmonics_power += harmonic_power;
+    }
+
+    quality_metrics->number_of_harmonics = number_of_harmonics;
+
+    float noise_power = 0.0f;
+    size_t noise_bins = 0;
+    size_t spur_bin = 0;
+    float spur_peak = 0.0f;
+
+    // Sum the noise, and find the strongest bin outside of the fundamental (a harmonic or any other spur), in a single pass:
+    for (size_t i = 0; i < bin_count; i++) {
+        if (bin_owners[i] == NOISE_BIN) {
+            noise_power += power[i];
+            noise_bins++;
+        }
+
+        if ((bin_owners[i] == NOISE_BIN || bin_owners[i] == HARMONIC_BIN) && power[i] > spur_peak) {
+            spur_peak = power[i];
+            spur_bin = i;
+        }
+    }
+
+    free(bin_owners);
+
+    // Extrapolate the noise over the bins of the fundamental and the harmonics (the DC lobe does not count):
+    size_t signal_bins = bin_count - (half_width + 1);
+    float noise_per_bin = (noise_bins > 0) ? noise_power / noise_bins : 0.0f;
+
+    noise_power = noise_per_bin * signal_bins;
+
+    quality_metrics->thd_db = power_ratio_db(harmonics_power, fundamental_power);
+    quality_metrics->thd_percent = 100.0f * sqrtf(harmonics_power / fundamental_power);
+    quality_metrics->snr_db = power_ratio_db(fundamental_power, noise_power);
+    quality_metrics->sinad_db = power_ratio_db(fundamental_power, noise_power + harmonics_power);
+    quality_metrics->enob = (quality_metrics->sinad_db - QUALITY_SINAD_OFFSET_DB) / QUALITY_DB_PER_BIT;
+    quality_metrics->sfdr_db = power_ratio_db(fundamental_peak, spur_peak);
+    quality_metrics->spur_frequency = spur_bin * bin_resolution;
+    quality_metrics->noise_floor_db = power_ratio_db(noise_per_bin, fundamental_power);
+
+    return ESP_OK;
+}
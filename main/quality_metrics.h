@@ -0,0 +1,59 @@
+#ifndef QUALITY_METRICS_H_
+#define QUALITY_METRICS_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "esp_log.h"
+
+#include "window_transform.h"
+
+#define QUALITY_METRICS_TAG ("QUALITY_METRICS_H_")
+
+#define MAXIMUM_QUALITY_HARMONICS (10)
+#define DEFAULT_QUALITY_HARMONICS (5) // The harmonics 2 up to 6, like most datasheets.
+
+#define QUALITY_MINIMUM_POWER (1e-30f)  // The power below which a ratio is clamped (so an ideal signal gives a large, but finite, figure).
+#define QUALITY_SINAD_OFFSET_DB (1.76f) // The SINAD of an ideal quantizer, apart from the 6.02 dB per bit (for a full-scale sine).
+#define QUALITY_DB_PER_BIT (6.02f)      // The SINAD that every bit of an ideal quantizer adds.
+
+/// @brief Defining a struct called `quality_config`, that contains the settings of a signal quality measurement.
+typedef struct quality_config {
+    size_t number_of_harmonics;  // This field contains a `size_t` with the number of harmonics (from the second one up) that count as distortion (at most `MAXIMUM_QUALITY_HARMONICS`).
+    float fundamental_frequency; // This field contains a `float` with the frequency (in Hz) around which the fundamental is searched, or zero to use the strongest tone.
+} quality_config_t;
+
+/// @brief Defining a struct called `quality_metrics`, that contains the distortion and noise figures of a single tone.
+typedef struct quality_metrics {
+    float fundamental_frequency; // This field contains a `float` with the frequency of the fundamental (in Hz, the power-weighted center of its main lobe).
+    float fundamental_amplitude; // This field contains a `float` with the amplitude of the fundamental (from the power of its main lobe, corrected for the window).
+
+    float harmonic_frequencies[MAXIMUM_QUALITY_HARMONICS]; // This field contains the frequency of every harmonic (in Hz, folded back below the Nyquist frequency).
+    float harmonic_levels_dbc[MAXIMUM_QUALITY_HARMONICS];  // This field contains the power of every harmonic relative to the fundamental (in dBc), or `-INFINITY` for a harmonic that falls on the fundamental, the DC lobe or a previous harmonic.
+    size_t number_of_harmonics;                            // This field contains a `size_t` with the number of harmonics in the arrays above.
+
+    float thd_db;      // This field contains a `float` with the total harmonic distortion (in dBc).
+    float thd_percent; // This field contains a `float` with the total harmonic distortion as a percentage of the amplitude of the fundamental.
+    float snr_db;      // This field contains a `float` with the signal-to-noise ratio, without the harmonics (in dB).
+    float sinad_db;    // This field contains a `float` with the signal-to-noise-and-distortion ratio (in dB).
+    float enob;        // This field contains a `float` with the effective number of bits, that follows from the SINAD.
+    float sfdr_db;     // This field contains a `float` with the spurious-free dynamic range, between the fundamental and the strongest other bin (in dB).
+
+    float spur_frequency; // This field contains a `float` with the frequency of the strongest spur (in Hz).
+    float noise_floor_db; // This field contains a `float` with the average noise power per bin, relative to the fundamental (in dBc).
+} quality_metrics_t;
+
+/// @brief This function measures the distortion and noise of the strongest tone in a power spectrum, in a single pass over the bins. The fundamental and every harmonic are integrated over the main lobe of the window (so the window and a tone between two bins do not change their power), the DC lobe is skipped, and the remaining bins are the noise (extrapolated over the skipped bins).
+/// @param power A pointer to the power of each bin in absolute scale, as produced by `compute_fft_spectrum_f32`.
+/// @param bin_count The number of bins in `power` (half the FFT length).
+/// @param sample_length The length of the FFT (in samples).
+/// @param sample_frequency The frequency at which the signal is sampled, measured in Hz (Hertz).
+/// @param window_config The window that was applied before the FFT, which sets the width of the main lobes.
+/// @param quality_config The settings of the measurement.
+/// @param quality_metrics A pointer to a `quality_metrics_t` structure where the figures will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error (also if the spectrum holds no tone).
+extern esp_err_t measure_signal_quality_f32(const float* power, size_t bin_count, size_t sample_length, size_t sample_frequency, window_config_t window_config, quality_config_t quality_config, quality_metrics_t* quality_metrics);
+
+#endif
@@ -0,0 +1,204 @@
+#include "replay_source.h"
+
+/// @brief Defining a struct called `replay_context`, that contains the private data of the replay source.
+typedef struct replay_context {
+    replay_header_t header;  // This field contains the decoded `replay_header_t` of the recording.
+    const uint8_t* samples;  // This field is a pointer to the first (encoded) sample of the recording.
+    size_t current_index;    // This field contains a `size_t` with the index of the next sample to replay.
+
+    uint8_t* owned_data; // This field is a pointer to the recording if it is owned by the source (and freed on close), or `NULL` otherwise.
+} replay_context_t;
+
+static uint16_t read_little_endian_u16(const uint8_t* data) {
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t read_little_endian_u32(const uint8_t* data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static esp_err_t read_replay_source(void* context, float* samples, size_t sample_length) {
+    replay_context_t* replay_context = context;
+
+    size_t number_of_samples = replay_context->header.number_of_samples;
+    float scale = replay_context->header.scale;
+
+    // Decode the next samples, looping back to the start of the recording after the last sample (the samples are stored in the byte order of the device):
+    for (size_t i = 0; i < sample_length; i++) {
+        size_t current_index = replay_context->current_index;
+
+        if (replay_context->header.format == REPLAY_FORMAT_F32) {
+            float sample = 0.0f;
+
+            memcpy(&sample, &replay_context->samples[current_index * sizeof(float)], sizeof(float));
+
+            samples[i] = sample;
+        }
+        else {
+            int16_t sample = 0;
+
+            memcpy(&sample, &replay_context->samples[current_index * sizeof(int16_t)], sizeof(int16_t));
+
+            samples[i] = sample * scale;
+        }
+
+        replay_context->current_index = (current_index + 1) % number_of_samples;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t close_replay_source(void* context) {
+    replay_context_t* replay_context = context;
+
+    // Free the memory of the recording and the context:
+    free(replay_context->owned_data);
+    free(replay_context);
+
+    return ESP_OK;
+}
+
+esp_err_t parse_replay_header(const uint8_t* data, size_t data_length, replay_header_t* header) {
+    // Check if `data` and `header` have a valid value:
+    if (data == NULL || header == NULL) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "data", "header");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the recording is large enough to contain a header:
+    if (data_length < REPLAY_HEADER_LENGTH) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording is too small to contain a header!");
+
+        return ESP_FAIL;
+    }
+
+    // Decode the fields of the header:
+    header->magic = read_little_endian_u32(&data[0]);
+    header->version = read_little_endian_u16(&data[4]);
+    header->format = read_little_endian_u16(&data[6]);
+    header->sample_frequency = read_little_endian_u32(&data[8]);
+    header->number_of_samples = read_little_endian_u32(&data[12]);
+
+    uint32_t scale_bits = read_little_endian_u32(&data[16]);
+
+    memcpy(&header->scale, &scale_bits, sizeof(float));
+
+    // Check if the header belongs to a supported recording:
+    if (header->magic != REPLAY_MAGIC || header->version != REPLAY_VERSION) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording has an unknown magic value or version!");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the format, sample frequency and number of samples are valid:
+    if ((header->format != REPLAY_FORMAT_F32 && header->format != REPLAY_FORMAT_I16) || header->sample_frequency == 0 || header->number_of_samples == 0) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording has an invalid format, sample frequency or number of samples!");
+
+        return ESP_FAIL;
+    }
+
+    size_t sample_size = (header->format == REPLAY_FORMAT_F32) ? sizeof(float) : sizeof(int16_t);
+
+    // Check if the recording contains all the samples that are announced in the header:
+    if ((data_length - REPLAY_HEADER_LENGTH) / sample_size < header->number_of_samples) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording is truncated, it does not contain '%u' samples!", (unsigned int)header->number_of_samples);
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t open_replay_memory_source(sample_source_t* source, const uint8_t* data, size_t data_length, bool take_ownership) {
+    // Check if `source` has a valid value:
+    if (source == NULL) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The value of '%s' could not be 'NULL'!", "source");
+
+        return ESP_FAIL;
+    }
+
+    replay_context_t* replay_context = calloc(1, sizeof(replay_context_t)); // Allocate memory for the context of the replay source.
+
+    // Check if the memory allocation was successful:
+    if (replay_context == NULL) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The value of '%s' could not be 'NULL'!", "replay_context");
+
+        return ESP_FAIL;
+    }
+
+    // Decode and validate the header of the recording:
+    if (parse_replay_header(data, data_length, &replay_context->header) != ESP_OK) {
+        free(replay_context);
+
+        return ESP_FAIL;
+    }
+
+    replay_context->samples = &data[REPLAY_HEADER_LENGTH];
+    replay_context->current_index = 0;
+    replay_context->owned_data = take_ownership ? (uint8_t*)data : NULL;
+
+    // Fill the interface of the source:
+    source->type = REPLAY_SOURCE;
+    source->sample_frequency = replay_context->header.sample_frequency;
+    source->read = read_replay_source;
+    source->close = close_replay_source;
+    source->context = replay_context;
+
+    return ESP_OK;
+}
+
+esp_err_t open_replay_file_source(sample_source_t* source, const char* file_path) {
+    // Check if `source` and `file_path` have a valid value:
+    if (source == NULL || file_path == NULL) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "source", "file_path");
+
+        return ESP_FAIL;
+    }
+
+    FILE* file = fopen(file_path, "rb");
+
+    // Check if the file could be opened:
+    if (file == NULL) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording '%s' could not be opened!", file_path);
+
+        return ESP_FAIL;
+    }
+
+    // Determine the length of the recording:
+    fseek(file, 0, SEEK_END);
+    long file_length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    // Check if the length of the recording is valid:
+    if (file_length < REPLAY_HEADER_LENGTH || file_length > REPLAY_MAXIMUM_LENGTH) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording '%s' has an invalid length of '%ld' bytes!", file_path, file_length);
+
+        fclose(file);
+
+        return ESP_FAIL;
+    }
+
+    uint8_t* data = malloc(file_length); // Allocate memory for the complete recording.
+
+    // Check if the memory allocation was successful, and read the complete recording:
+    if (data == NULL || fread(data, 1, file_length, file) != (size_t)file_length) {
+        ESP_LOGE(REPLAY_SOURCE_TAG, "The recording '%s' could not be read!", file_path);
+
+        free(data);
+        fclose(file);
+
+        return ESP_FAIL;
+    }
+
+    fclose(file);
+
+    // Replay the recording from memory, where the source becomes the owner of the data:
+    if (open_replay_memory_source(source, data, file_length, true) != ESP_OK) {
+        free(data);
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
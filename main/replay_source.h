@@ -0,0 +1,55 @@
+#ifndef REPLAY_SOURCE_H_
+#define REPLAY_SOURCE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sample_source.h"
+
+#define REPLAY_SOURCE_TAG ("REPLAY_SOURCE_H_")
+
+#define REPLAY_MAGIC (0x52544646) // The characters 'FFTR' (in little-endian byte order).
+#define REPLAY_VERSION (1)
+
+#define REPLAY_HEADER_LENGTH (20)
+#define REPLAY_MAXIMUM_LENGTH (64 * 1024)
+
+/// @brief This is an enumeration called `replay_format_t` with the supported sample formats of a recording.
+typedef enum replay_format {
+    REPLAY_FORMAT_F32 = 0,
+    REPLAY_FORMAT_I16 = 1
+} replay_format_t;
+
+/// @brief Defining a struct called `replay_header`, that contains the decoded header of a recording. In memory (and on disk) the header is `REPLAY_HEADER_LENGTH` bytes, stored in little-endian byte order and directly followed by the samples.
+typedef struct replay_header {
+    uint32_t magic;             // This field contains a `uint32_t` that must be equal to `REPLAY_MAGIC`.
+    uint16_t version;           // This field contains a `uint16_t` that must be equal to `REPLAY_VERSION`.
+    uint16_t format;            // This field contains a `uint16_t` with the `replay_format_t` of the samples.
+    uint32_t sample_frequency;  // This field contains a `uint32_t` with the frequency at which the samples were recorded (in Hz).
+    uint32_t number_of_samples; // This field contains a `uint32_t` with the number of samples that follow the header.
+    float scale;                // This field contains a `float` that every (integer) sample is multiplied with, for example the volts per LSB of the ADC.
+} replay_header_t;
+
+/// @brief This function decodes and validates the header of a recording.
+/// @param data A pointer to the recording (the header followed by the samples).
+/// @param data_length The length of the recording in bytes.
+/// @param header A pointer to a `replay_header_t` structure where the decoded header will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the header is valid and the recording contains all the samples, or `ESP_FAIL` if there is an error.
+extern esp_err_t parse_replay_header(const uint8_t* data, size_t data_length, replay_header_t* header);
+
+/// @brief This function opens a source that replays a recording from memory, looping back to the start after the last sample.
+/// @param source A pointer to the `sample_source_t` structure that will be initialized.
+/// @param data A pointer to the recording (the header followed by the samples), which must stay valid until the source is closed.
+/// @param data_length The length of the recording in bytes.
+/// @param take_ownership If `true`, the recording is freed (with `free`) when the source is closed.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t open_replay_memory_source(sample_source_t* source, const uint8_t* data, size_t data_length, bool take_ownership);
+
+/// @brief This function opens a source that replays a recording from a file (for example on the host, or on a mounted file system), looping back to the start after the last sample.
+/// @param source A pointer to the `sample_source_t` structure that will be initialized.
+/// @param file_path The path of the file with the recording.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t open_replay_file_source(sample_source_t* source, const char* file_path);
+
+#endif
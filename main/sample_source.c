@@ -0,0 +1,34 @@
+#include "sample_source.h"
+
+esp_err_t read_sample_source(sample_source_t* source, float* samples, size_t sample_length) {
+    // Check if `source` and `samples` have a valid value:
+    if (source == NULL || samples == NULL) {
+        ESP_LOGE(SAMPLE_SOURCE_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "source", "samples");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the source is opened:
+    if (source->read == NULL) {
+        ESP_LOGE(SAMPLE_SOURCE_TAG, "The source is not opened yet!");
+
+        return ESP_FAIL;
+    }
+
+    return source->read(source->context, samples, sample_length);
+}
+
+esp_err_t close_sample_source(sample_source_t* source) {
+    // Check if `source` has a valid value:
+    if (source == NULL) {
+        ESP_LOGE(SAMPLE_SOURCE_TAG, "The value of '%s' could not be 'NULL'!", "source");
+
+        return ESP_FAIL;
+    }
+
+    esp_err_t succeeded_close = (source->close != NULL) ? source->close(source->context) : ESP_OK; // Release the resources of the source (if it has any).
+
+    memset(source, 0, sizeof(sample_source_t)); // Reset the interface, so that the source can not be used after closing it.
+
+    return succeeded_close;
+}
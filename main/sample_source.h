@@ -0,0 +1,47 @@
+#ifndef SAMPLE_SOURCE_H_
+#define SAMPLE_SOURCE_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#define SAMPLE_SOURCE_TAG ("SAMPLE_SOURCE_H_")
+
+/// @brief This is an enumeration called `sample_source_type_t` with the different kinds of sources that can feed samples to the FFT pipeline.
+typedef enum sample_source_type {
+    SYNTHESIZER_SOURCE,
+    ADC_SOURCE,
+    REPLAY_SOURCE
+} sample_source_type_t;
+
+/// @brief This is a function pointer, that fills a buffer with the next samples of a source.
+typedef esp_err_t (*sample_source_read_function)(void* context, float* samples, size_t sample_length);
+
+/// @brief This is a function pointer, that releases all the resources of a source.
+typedef esp_err_t (*sample_source_close_function)(void* context);
+
+/// @brief Defining a struct called `sample_source`, that contains the interface of a source of samples (the synthesizer, the ADC or a replayed recording). Every source opens itself in its own module (see 'synthesizer_source.h', 'adc_source.h' and 'replay_source.h'), so this interface does not depend on any of them.
+typedef struct sample_source {
+    sample_source_type_t type; // This field contains a `sample_source_type_t` with the kind of source.
+    size_t sample_frequency;   // This field contains a `size_t` with the frequency at which the source delivers its samples (in Hz).
+
+    sample_source_read_function read;   // This field contains a `sample_source_read_function` that fills a buffer with the next samples.
+    sample_source_close_function close; // This field contains a `sample_source_close_function` that releases the resources of the source (it may be `NULL`).
+
+    void* context; // This field is a pointer to the private data of the source.
+} sample_source_t;
+
+/// @brief This function fills a buffer with the next samples of a source.
+/// @param source A pointer to an opened `sample_source_t` structure.
+/// @param samples A pointer to an array of floats where the samples will be stored.
+/// @param sample_length The number of samples to read.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t read_sample_source(sample_source_t* source, float* samples, size_t sample_length);
+
+/// @brief This function closes a source and releases all its resources. Closing an unopened (zero-initialized) source has no effect.
+/// @param source A pointer to a `sample_source_t` structure.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t close_sample_source(sample_source_t* source);
+
+#endif
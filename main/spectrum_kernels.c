@@ -0,0 +1,387 @@
+#include "spectrum_kernels.h"
+
+float fast_power_db_f32(float x) {
+    // Clamp the value, so that zero (and denormal) values result in a finite floor instead of minus infinity:
+    if (!(x > SPECTRUM_MINIMUM_POWER))
+        x = SPECTRUM_MINIMUM_POWER;
+
+    // Split the value into its exponent and its mantissa (which is in the range [1, 2)):
+    union {
+        float value;
+        uint32_t bits;
+    } split_value = { .value = x };
+
+    float exponent = (float)((int32_t)((split_value.bits >> 23) & 0xFF) - 127);
+
+    split_value.bits = (split_value.bits & 0x007FFFFF) | 0x3F800000;
+
+    float mantissa = split_value.value;
+
+    // Center the mantissa around one (in the range [sqrt(0.5), sqrt(2))), so that the series below converges fast:
+    if (mantissa > (float)M_SQRT2) {
+        mantissa *= 0.5f;
+        exponent += 1.0f;
+    }
+
+    // Approximate the natural logarithm of the mantissa with the series `ln(m) = 2 * (t + t^3 / 3 + t^5 / 5)`, where `t = (m - 1) / (m + 1)`:
+    float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+    float t_squared = t * t;
+
+    float ln_mantissa = 2.0f * t * (1.0f + t_squared * (0.33333333f + t_squared * 0.2f));
+
+    return 4.3429448190f * ln_mantissa + 3.0102999566f * exponent; // Convert into dB, that is `10 * log10(e) * ln(m) + 10 * log10(2) * exponent`.
+}
+
+float fast_atan2_f32(float y, float x) {
+    float absolute_x = fabsf(x);
+    float absolute_y = fabsf(y);
+
+    // Check if both parts are zero, in which case the angle is defined as zero:
+    if (absolute_x == 0.0f && absolute_y == 0.0f)
+        return 0.0f;
+
+    // Reduce the argument to the range [0, 1], so that the polynomial only has to approximate the first octant:
+    bool swapped = absolute_y > absolute_x;
+    float ratio = swapped ? absolute_x / absolute_y : absolute_y / absolute_x;
+    float ratio_squared = ratio * ratio;
+
+    float angle = ratio * (0.99997726f + ratio_squared * (-0.33262347f + ratio_squared * (0.19354346f + ratio_squared * (-0.11643287f + ratio_squared * (0.05265332f + ratio_squared * -0.01172120f)))));
+
+    // Map the angle from the first octant back to the correct quadrant:
+    if (swapped)
+        angle = (float)M_PI_2 - angle;
+
+    if (x < 0.0f)
+        angle = (float)M_PI - angle;
+
+    return (y < 0.0f) ? -angle : angle;
+}
+
+esp_err_t get_psd_scale_f32(window_config_t window_config, size_t sample_length, size_t sample_frequency, float* psd_scale) {
+    // Check if `psd_scale` has a valid value:
+    if (psd_scale == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The value of '%s' could not be 'NULL'!", "psd_scale");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the sample length and sample frequency are valid:
+    if (sample_length == 0 || sample_frequency == 0) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The sample length and sample frequency cannot be equal to zero!");
+
+        return ESP_FAIL;
+    }
+
+    window_properties_t window_properties = {};
+
+    // Retrieve the coherent gain and the equivalent noise bandwidth of the window:
+    if (get_window_properties(window_config, &window_properties) != ESP_OK) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
+
+        return ESP_FAIL;
+    }
+
+    // The sum of the squared window equals `N * CG^2 * ENBW`, and the factor two folds the negative frequencies onto the positive ones:
+    float window_power = sample_length * window_properties.coherent_gain * window_properties.coherent_gain * window_properties.equivalent_noise_bandwidth;
+
+    *psd_scale = 2.0f / (sample_frequency * window_power);
+
+    return ESP_OK;
+}
+
+esp_err_t spectrum_power_f32(const float* fft_cf, float* power, size_t bin_count, float power_scale) {
+    spectrum_outputs_t outputs = {
+        .power = power,
+        .power_scale = power_scale
+    };
+
+    return spectrum_process_f32(fft_cf, bin_count, &outputs);
+}
+
+esp_err_t spectrum_power_db_f32(const float* fft_cf, float* power_db, size_t bin_count, float power_scale) {
+    spectrum_outputs_t outputs = {
+        .power_db = power_db,
+        .power_scale = power_scale
+    };
+
+    return spectrum_process_f32(fft_cf, bin_count, &outputs);
+}
+
+esp_err_t spectrum_phase_f32(const float* fft_cf, float* phase, size_t bin_count) {
+    spectrum_outputs_t outputs = {
+        .phase = phase
+    };
+
+    return spectrum_process_f32(fft_cf, bin_count, &outputs);
+}
+
+esp_err_t spectrum_process_f32(const float* fft_cf, size_t bin_count, const spectrum_outputs_t* outputs) {
+    // Check if `fft_cf` and `outputs` have a valid value:
+    if (fft_cf == NULL || outputs == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "fft_cf", "outputs");
+
+        return ESP_FAIL;
+    }
+
+    float power_scale = outputs->power_scale;
+    float psd_scale = outputs->psd_scale;
+
+    size_t unrolled_count = bin_count - (bin_count % SPECTRUM_KERNELS_UNROLL);
+
+    // Process the bins in blocks, where every block is completely read before it is written (so the outputs may alias the first half of the input):
+    for (size_t i = 0; i < bin_count; i += SPECTRUM_KERNELS_UNROLL) {
+        size_t block_length = (i < unrolled_count) ? SPECTRUM_KERNELS_UNROLL : bin_count - i;
+
+        float real_parts[SPECTRUM_KERNELS_UNROLL] = {};
+        float imaginary_parts[SPECTRUM_KERNELS_UNROLL] = {};
+        float squared_magnitudes[SPECTRUM_KERNELS_UNROLL] = {};
+
+        // Load the block, and calculate the squared magnitude only once per bin:
+        for (size_t j = 0; j < block_length; j++) {
+            real_parts[j] = fft_cf[(i + j) * 2 + 0];
+            imaginary_parts[j] = fft_cf[(i + j) * 2 + 1];
+            squared_magnitudes[j] = real_parts[j] * real_parts[j] + imaginary_parts[j] * imaginary_parts[j];
+        }
+
+        // Store the requested outputs of the block:
+        if (outputs->power != NULL)
+            for (size_t j = 0; j < block_length; j++)
+                outputs->power[i + j] = squared_magnitudes[j] * power_scale;
+
+        if (outputs->magnitude != NULL)
+            for (size_t j = 0; j < block_length; j++)
+                outputs->magnitude[i + j] = sqrtf(squared_magnitudes[j] * power_scale);
+
+        if (outputs->power_db != NULL)
+            for (size_t j = 0; j < block_length; j++)
+                outputs->power_db[i + j] = fast_power_db_f32(squared_magnitudes[j] * power_scale);
+
+        if (outputs->phase != NULL)
+            for (size_t j = 0; j < block_length; j++)
+                outputs->phase[i + j] = fast_atan2_f32(imaginary_parts[j], real_parts[j]);
+
+        if (outputs->psd != NULL)
+            for (size_t j = 0; j < block_length; j++)
+                outputs->psd[i + j] = squared_magnitudes[j] * psd_scale;
+    }
+
+    return ESP_OK;
+}
+
+_Static_assert(SPECTRUM_KERNELS_UNROLL == 4, "The accumulator kernels below are unrolled by hand for blocks of four bins!");
+
+esp_err_t spectrum_average_f32(float* accumulator, const float* power, size_t bin_count, float weight) {
+    // Check if `accumulator` and `power` have a valid value:
+    if (accumulator == NULL || power == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "accumulator", "power");
+
+        return ESP_FAIL;
+    }
+
+    size_t unrolled_count = bin_count - (bin_count % SPECTRUM_KERNELS_UNROLL);
+
+    // Update the bins in blocks, so the independent updates of a block can be pipelined:
+    for (size_t i = 0; i < unrolled_count; i += SPECTRUM_KERNELS_UNROLL) {
+        accumulator[i + 0] += weight * (power[i + 0] - accumulator[i + 0]);
+        accumulator[i + 1] += weight * (power[i + 1] - accumulator[i + 1]);
+        accumulator[i + 2] += weight * (power[i + 2] - accumulator[i + 2]);
+        accumulator[i + 3] += weight * (power[i + 3] - accumulator[i + 3]);
+    }
+
+    for (size_t i = unrolled_count; i < bin_count; i++)
+        accumulator[i] += weight * (power[i] - accumulator[i]);
+
+    return ESP_OK;
+}
+
+esp_err_t spectrum_max_hold_f32(float* accumulator, const float* power, size_t bin_count) {
+    // Check if `accumulator` and `power` have a valid value:
+    if (accumulator == NULL || power == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "accumulator", "power");
+
+        return ESP_FAIL;
+    }
+
+    size_t unrolled_count = bin_count - (bin_count % SPECTRUM_KERNELS_UNROLL);
+
+    // Update the bins in blocks, with `fmaxf` instead of a branch per bin:
+    for (size_t i = 0; i < unrolled_count; i += SPECTRUM_KERNELS_UNROLL) {
+        accumulator[i + 0] = fmaxf(accumulator[i + 0], power[i + 0]);
+        accumulator[i + 1] = fmaxf(accumulator[i + 1], power[i + 1]);
+        accumulator[i + 2] = fmaxf(accumulator[i + 2], power[i + 2]);
+        accumulator[i + 3] = fmaxf(accumulator[i + 3], power[i + 3]);
+    }
+
+    for (size_t i = unrolled_count; i < bin_count; i++)
+        accumulator[i] = fmaxf(accumulator[i], power[i]);
+
+    return ESP_OK;
+}
+
+esp_err_t spectrum_min_hold_f32(float* accumulator, const float* power, size_t bin_count) {
+    // Check if `accumulator` and `power` have a valid value:
+    if (accumulator == NULL || power == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "accumulator", "power");
+
+        return ESP_FAIL;
+    }
+
+    size_t unrolled_count = bin_count - (bin_count % SPECTRUM_KERNELS_UNROLL);
+
+    // Update the bins in blocks, with `fminf` instead of a branch per bin:
+    for (size_t i = 0; i < unrolled_count; i += SPECTRUM_KERNELS_UNROLL) {
+        accumulator[i + 0] = fminf(accumulator[i + 0], power[i + 0]);
+        accumulator[i + 1] = fminf(accumulator[i + 1], power[i + 1]);
+        accumulator[i + 2] = fminf(accumulator[i + 2], power[i + 2]);
+        accumulator[i + 3] = fminf(accumulator[i + 3], power[i + 3]);
+    }
+
+    for (size_t i = unrolled_count; i < bin_count; i++)
+        accumulator[i] = fminf(accumulator[i], power[i]);
+
+    return ESP_OK;
+}
+
+esp_err_t spectrum_power_to_db_f32(const float* power, float* power_db, size_t bin_count) {
+    // Check if `power` and `power_db` have a valid value:
+    if (power == NULL || power_db == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "power", "power_db");
+
+        return ESP_FAIL;
+    }
+
+    for (size_t i = 0; i < bin_count; i++)
+        power_db[i] = fast_power_db_f32(power[i]);
+
+    return ESP_OK;
+}
+
+esp_err_t benchmark_spectrum_kernels_f32(size_t bin_count, size_t iterations, spectrum_benchmark_t* benchmark) {
+    // Check if `benchmark` has a valid value:
+    if (benchmark == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The value of '%s' could not be 'NULL'!", "benchmark");
+
+        return ESP_FAIL;
+    }
+
+    float* fft_cf = malloc(bin_count * 2 * sizeof(float));    // The interleaved complex bins, which are only read.
+    float* scalar_output = malloc(bin_count * 2 * sizeof(float)); // The power (first half) and the power in dB (second half) of the scalar loop.
+    float* fused_output = malloc(bin_count * 2 * sizeof(float));  // The same outputs of the fused kernel.
+
+    // Check if the memory allocation was successful:
+    if (fft_cf == NULL || scalar_output == NULL || fused_output == NULL) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "fft_cf", "scalar_output", "fused_output");
+
+        free(fft_cf);
+        free(scalar_output);
+        free(fused_output);
+
+        return ESP_FAIL;
+    }
+
+    *benchmark = (spectrum_benchmark_t){};
+
+    // Fill the bins with a spectrum that spans a large dynamic range (from about -120 dB up to +60 dB), at every angle:
+    for (size_t i = 0; i < bin_count; i++) {
+        float magnitude = powf(10.0f, -6.0f + 9.0f * (float)((i * 7919) % bin_count) / bin_count);
+        float angle = 2.0f * (float)M_PI * (float)((i * 104729) % bin_count) / bin_count - (float)M_PI;
+
+        fft_cf[i * 2 + 0] = magnitude * cosf(angle);
+        fft_cf[i * 2 + 1] = magnitude * sinf(angle);
+    }
+
+    float power_scale = 1.0f / (bin_count * 2);
+
+    spectrum_outputs_t power_outputs = {
+        .power = fused_output,
+        .power_db = &fused_output[bin_count],
+        .power_scale = power_scale
+    };
+
+    spectrum_outputs_t phase_outputs = {
+        .phase = fused_output
+    };
+
+    // Time the scalar loop that `apply_fft_f32` used before the fused kernel (which calculates the squared magnitude twice, and calls `log10f` per bin):
+    int64_t start_time_us = esp_timer_get_time();
+
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        for (size_t i = 0; i < bin_count; i++) {
+            scalar_output[bin_count + i] = 10 * log10f((fft_cf[i * 2 + 0] * fft_cf[i * 2 + 0] + fft_cf[i * 2 + 1] * fft_cf[i * 2 + 1]) * power_scale);
+            scalar_output[i] = (fft_cf[i * 2 + 0] * fft_cf[i * 2 + 0] + fft_cf[i * 2 + 1] * fft_cf[i * 2 + 1]) * power_scale;
+        }
+    }
+
+    benchmark->scalar_power_duration_us = esp_timer_get_time() - start_time_us;
+
+    // Time the fused kernel with the same outputs:
+    start_time_us = esp_timer_get_time();
+
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+        spectrum_process_f32(fft_cf, bin_count, &power_outputs);
+
+    benchmark->fused_power_duration_us = esp_timer_get_time() - start_time_us;
+
+    // Check the outputs of both loops against each other (which also keeps the compiler from dropping the loops):
+    for (size_t i = 0; i < bin_count; i++) {
+        benchmark->maximum_db_error = fmaxf(benchmark->maximum_db_error, fabsf(fused_output[bin_count + i] - scalar_output[bin_count + i]));
+
+        if (fabsf(fused_output[i] - scalar_output[i]) > FLT_EPSILON * 4.0f * fabsf(scalar_output[i]))
+            benchmark->maximum_db_error = INFINITY; // The power should only differ by the rounding of the scale.
+    }
+
+    // Time a scalar loop with `atan2f` against the fused phase kernel:
+    start_time_us = esp_timer_get_time();
+
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+        for (size_t i = 0; i < bin_count; i++)
+            scalar_output[i] = atan2f(fft_cf[i * 2 + 1], fft_cf[i * 2 + 0]);
+
+    benchmark->scalar_phase_duration_us = esp_timer_get_time() - start_time_us;
+
+    start_time_us = esp_timer_get_time();
+
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+        spectrum_process_f32(fft_cf, bin_count, &phase_outputs);
+
+    benchmark->fused_phase_duration_us = esp_timer_get_time() - start_time_us;
+
+    for (size_t i = 0; i < bin_count; i++)
+        benchmark->maximum_phase_error = fmaxf(benchmark->maximum_phase_error, fabsf(fused_output[i] - scalar_output[i]));
+
+    free(fft_cf);
+    free(scalar_output);
+    free(fused_output);
+
+    // Check the dB approximation against `log10f` over the complete range of powers (from `SPECTRUM_MINIMUM_POWER` up to 1e30), so every exponent and mantissa is covered:
+    for (size_t i = 0; i <= SPECTRUM_ACCURACY_STEPS; i++) {
+        float x = powf(10.0f, -30.0f + 60.0f * (float)i / SPECTRUM_ACCURACY_STEPS);
+
+        benchmark->maximum_db_error = fmaxf(benchmark->maximum_db_error, fabsf(fast_power_db_f32(x) - 10.0f * log10f(x)));
+    }
+
+    // Check the phase approximation against `atan2f` around the complete circle, at a small and a large magnitude:
+    for (size_t i = 0; i < SPECTRUM_ACCURACY_STEPS; i++) {
+        float angle = 2.0f * (float)M_PI * ((float)i + 0.5f) / SPECTRUM_ACCURACY_STEPS - (float)M_PI;
+
+        for (float magnitude = 1e-6f; magnitude < 1e7f; magnitude *= 1e6f) {
+            float y = magnitude * sinf(angle);
+            float x = magnitude * cosf(angle);
+
+            benchmark->maximum_phase_error = fmaxf(benchmark->maximum_phase_error, fabsf(fast_atan2_f32(y, x) - atan2f(y, x)));
+        }
+    }
+
+    ESP_LOGI(SPECTRUM_KERNELS_TAG, "Power and dB of '%u' bins: '%lld' us with 'log10f', '%lld' us fused (over '%u' iterations)", (unsigned int)bin_count, (long long)benchmark->scalar_power_duration_us, (long long)benchmark->fused_power_duration_us, (unsigned int)iterations);
+    ESP_LOGI(SPECTRUM_KERNELS_TAG, "Phase of '%u' bins: '%lld' us with 'atan2f', '%lld' us fused (over '%u' iterations)", (unsigned int)bin_count, (long long)benchmark->scalar_phase_duration_us, (long long)benchmark->fused_phase_duration_us, (unsigned int)iterations);
+    ESP_LOGI(SPECTRUM_KERNELS_TAG, "The largest error is '%g' dB and '%g' radians", benchmark->maximum_db_error, benchmark->maximum_phase_error);
+
+    // Check if both approximations are within their documented tolerance:
+    if (!(benchmark->maximum_db_error <= SPECTRUM_DB_TOLERANCE) || !(benchmark->maximum_phase_error <= SPECTRUM_PHASE_TOLERANCE)) {
+        ESP_LOGE(SPECTRUM_KERNELS_TAG, "The approximations of the spectrum kernels are outside their tolerance!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
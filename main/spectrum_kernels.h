@@ -0,0 +1,135 @@
+#ifndef SPECTRUM_KERNELS_H_
+#define SPECTRUM_KERNELS_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "window_transform.h"
+
+#define SPECTRUM_KERNELS_TAG ("SPECTRUM_KERNELS_H_")
+
+#define SPECTRUM_KERNELS_UNROLL (4)
+
+#define SPECTRUM_MINIMUM_POWER (1e-30f)
+
+#define SPECTRUM_DB_TOLERANCE (1e-4f)    // The largest error of `fast_power_db_f32` against `10 * log10f(x)` (in dB).
+#define SPECTRUM_PHASE_TOLERANCE (1e-5f) // The largest error of `fast_atan2_f32` against `atan2f(y, x)` (in radians).
+
+#define SPECTRUM_BENCHMARK_ITERATIONS (100) // The number of passes over the bins that every loop of the benchmark is timed for.
+#define SPECTRUM_ACCURACY_STEPS (100000)    // The number of values (and angles) at which the accuracy of the approximations is checked.
+
+/// @brief Defining a struct called `spectrum_outputs`, that contains the (optional) output buffers of the fused spectrum kernel. Every buffer that is `NULL` is skipped.
+typedef struct spectrum_outputs {
+    float* power;     // This field is a pointer to an array of `float` values for the power of each bin, scaled by `power_scale`.
+    float* magnitude; // This field is a pointer to an array of `float` values for the magnitude (the square root of the scaled power) of each bin.
+    float* power_db;  // This field is a pointer to an array of `float` values for the scaled power of each bin in dB.
+    float* phase;     // This field is a pointer to an array of `float` values for the phase of each bin (in radians).
+    float* psd;       // This field is a pointer to an array of `float` values for the power spectral density of each bin (in units squared per Hz).
+
+    float power_scale; // This field contains a `float` with the scale that is applied to the power of each bin (for example `1 / N`).
+    float psd_scale;   // This field contains a `float` with the scale that converts the squared magnitude into a density, see `get_psd_scale_f32`.
+} spectrum_outputs_t;
+
+/// @brief Defining a struct called `spectrum_benchmark`, that contains the timings of the fused kernels against the scalar loops they replace, and the accuracy of the approximations.
+typedef struct spectrum_benchmark {
+    int64_t scalar_power_duration_us; // This field contains an `int64_t` with the time of the scalar loop with `log10f` that calculated the power and the power in dB (in microseconds, over all iterations).
+    int64_t fused_power_duration_us;  // This field contains an `int64_t` with the time of `spectrum_process_f32` for the same outputs (in microseconds, over all iterations).
+    int64_t scalar_phase_duration_us; // This field contains an `int64_t` with the time of a scalar loop with `atan2f` (in microseconds, over all iterations).
+    int64_t fused_phase_duration_us;  // This field contains an `int64_t` with the time of `spectrum_process_f32` for the phase (in microseconds, over all iterations).
+
+    float maximum_db_error;    // This field contains a `float` with the largest difference between `fast_power_db_f32` and `10 * log10f(x)` (in dB).
+    float maximum_phase_error; // This field contains a `float` with the largest difference between `fast_atan2_f32` and `atan2f` (in radians).
+} spectrum_benchmark_t;
+
+/// @brief This function approximates `10 * log10(x)` with a short series on the mantissa of `x`. The absolute error is below 0.0001 dB for every positive `x`.
+/// @param x The (positive) value to convert to dB. Values below `SPECTRUM_MINIMUM_POWER` are clamped to it.
+/// @return The value of `x` in dB.
+extern float fast_power_db_f32(float x);
+
+/// @brief This function approximates `atan2f(y, x)` with an octant reduction and a polynomial. The absolute error is below 0.00001 radians.
+/// @param y The imaginary part (the y-coordinate) of the value.
+/// @param x The real part (the x-coordinate) of the value.
+/// @return The angle of the value in radians, in the range [-pi, pi].
+extern float fast_atan2_f32(float y, float x);
+
+/// @brief This function calculates the scale that converts the squared FFT magnitude into a one-sided power spectral density, using the equivalent noise bandwidth of the window.
+/// @param window_config The window that was applied before the FFT.
+/// @param sample_length The length of the FFT (in samples).
+/// @param sample_frequency The frequency at which the signal is sampled, measured in Hz (Hertz).
+/// @param psd_scale A pointer to a `float` where the scale will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t get_psd_scale_f32(window_config_t window_config, size_t sample_length, size_t sample_frequency, float* psd_scale);
+
+/// @brief This function calculates the scaled power of every bin of an interleaved complex FFT output.
+/// @param fft_cf A pointer to the interleaved complex FFT output (real and imaginary part for each bin).
+/// @param power A pointer to an array of `float` values where the power of each bin will be stored (it may alias the first half of `fft_cf`).
+/// @param bin_count The number of bins to process.
+/// @param power_scale The scale that is applied to the power of each bin.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_power_f32(const float* fft_cf, float* power, size_t bin_count, float power_scale);
+
+/// @brief This function calculates the scaled power in dB of every bin of an interleaved complex FFT output, using `fast_power_db_f32`.
+/// @param fft_cf A pointer to the interleaved complex FFT output (real and imaginary part for each bin).
+/// @param power_db A pointer to an array of `float` values where the power of each bin in dB will be stored (it may alias the first half of `fft_cf`).
+/// @param bin_count The number of bins to process.
+/// @param power_scale The scale that is applied to the power of each bin, before converting it to dB.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_power_db_f32(const float* fft_cf, float* power_db, size_t bin_count, float power_scale);
+
+/// @brief This function calculates the phase of every bin of an interleaved complex FFT output, using `fast_atan2_f32`.
+/// @param fft_cf A pointer to the interleaved complex FFT output (real and imaginary part for each bin).
+/// @param phase A pointer to an array of `float` values where the phase of each bin will be stored (it may alias the first half of `fft_cf`).
+/// @param bin_count The number of bins to process.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_phase_f32(const float* fft_cf, float* phase, size_t bin_count);
+
+/// @brief This function calculates all the requested spectrum outputs (power, magnitude, dB, phase and PSD) in a single pass over an interleaved complex FFT output.
+/// @param fft_cf A pointer to the interleaved complex FFT output (real and imaginary part for each bin).
+/// @param bin_count The number of bins to process.
+/// @param outputs A pointer to a `spectrum_outputs_t` structure with the output buffers (which may alias the first half of `fft_cf`) and scales.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_process_f32(const float* fft_cf, size_t bin_count, const spectrum_outputs_t* outputs);
+
+/// @brief This function moves every bin of an accumulator towards a new spectrum in-place, that is `accumulator += weight * (power - accumulator)`. A weight of `1 / n` keeps the mean of `n` spectra, and a constant weight keeps an exponential moving average.
+/// @param accumulator A pointer to an array of `float` values with the accumulated power of each bin, which is updated in-place.
+/// @param power A pointer to an array of `float` values with the power of each bin of the new spectrum.
+/// @param bin_count The number of bins to process.
+/// @param weight The weight of the new spectrum (between 0 and 1, where 1 replaces the accumulator).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_average_f32(float* accumulator, const float* power, size_t bin_count, float weight);
+
+/// @brief This function keeps the highest power of every bin in an accumulator in-place (max-hold).
+/// @param accumulator A pointer to an array of `float` values with the accumulated power of each bin, which is updated in-place.
+/// @param power A pointer to an array of `float` values with the power of each bin of the new spectrum.
+/// @param bin_count The number of bins to process.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_max_hold_f32(float* accumulator, const float* power, size_t bin_count);
+
+/// @brief This function keeps the lowest power of every bin in an accumulator in-place (min-hold).
+/// @param accumulator A pointer to an array of `float` values with the accumulated power of each bin, which is updated in-place.
+/// @param power A pointer to an array of `float` values with the power of each bin of the new spectrum.
+/// @param bin_count The number of bins to process.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_min_hold_f32(float* accumulator, const float* power, size_t bin_count);
+
+/// @brief This function converts the power of every bin into dB, using `fast_power_db_f32`.
+/// @param power A pointer to an array of `float` values with the power of each bin.
+/// @param power_db A pointer to an array of `float` values where the power of each bin in dB will be stored (it may alias `power`).
+/// @param bin_count The number of bins to process.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t spectrum_power_to_db_f32(const float* power, float* power_db, size_t bin_count);
+
+/// @brief This function times the fused kernels against the scalar loops that they replace (on the same bins), and checks the accuracy of `fast_power_db_f32` and `fast_atan2_f32` against `log10f` and `atan2f` over their complete range. It runs at startup when the build defines `SPECTRUM_KERNELS_BENCHMARK`, and on the host in 'test/test_spectrum_kernels.c'.
+/// @param bin_count The number of bins of every pass (half the FFT length).
+/// @param iterations The number of passes that every loop is timed for.
+/// @param benchmark A pointer to a `spectrum_benchmark_t` structure where the timings and errors will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if both approximations are within their tolerance or `ESP_FAIL` if there is an error.
+extern esp_err_t benchmark_spectrum_kernels_f32(size_t bin_count, size_t iterations, spectrum_benchmark_t* benchmark);
+
+#endif
@@ -0,0 +1,392 @@
+#include "spectrum_stream.h"
+
+static void write_little_endian_u32(uint8_t* data, uint32_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = (value >> 24) & 0xFF;
+}
+
+static void write_little_endian_f32(uint8_t* data, float value) {
+    uint32_t bits = 0;
+
+    memcpy(&bits, &value, sizeof(float));
+
+    write_little_endian_u32(data, bits);
+}
+
+static uint8_t quantize_power_db(float power_db) {
+    float step = (power_db - STREAM_DB_OFFSET) / STREAM_DB_STEP + 0.5f;
+
+    // Clamp the step to the range of an `uint8_t`:
+    if (step <= 0.0f)
+        return 0;
+
+    if (step >= 255.0f)
+        return 255;
+
+    return (uint8_t)step;
+}
+
+static void stream_frame_sent(esp_err_t error, int, void* argument) {
+    stream_client_t* client = argument;
+
+    // Release the client, so that it accepts a new frame (and remove it if the frame could not be sent):
+    xSemaphoreTake(client->stream->lock, portMAX_DELAY);
+
+    client->is_sending = false;
+
+    if (error != ESP_OK)
+        client->is_active = false;
+
+    xSemaphoreGive(client->stream->lock);
+}
+
+static void remove_stream_client(stream_client_t* client) {
+    ESP_LOGI(SPECTRUM_STREAM_TAG, "The client on socket '%d' left the stream, after '%u' frames and '%u' dropped frames!", client->socket, (unsigned int)client->sequence, (unsigned int)client->dropped_frames);
+
+    // Keep the frame buffer of a client that is still being sent (it is reused by the next client of the slot):
+    client->is_active = false;
+}
+
+static void spectrum_stream_task(void* argument) {
+    spectrum_stream_t* stream = argument;
+
+    size_t bin_count = stream->sample_length / 2;
+
+    float* power_db = calloc(bin_count, sizeof(float));                 // Allocate memory for the spectrum in log scale.
+    float* samples = malloc(stream->sample_length * sizeof(float)); // Allocate memory for a copy of the samples, so they are not written while the spectrum is computed.
+
+    // Check if the memory allocations were successful:
+    if (power_db == NULL || samples == NULL) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "power_db", "samples");
+
+        free(power_db);
+        free(samples);
+
+        vTaskDelete(NULL);
+
+        return;
+    }
+
+    fft_data_t fft_data = {};
+
+    ESP_ERROR_CHECK(initialize_fft_f32(&fft_data)); // Keep the FFT initialized for as long as the stream runs.
+
+    while (true) {
+        int64_t current_time_us = esp_timer_get_time();
+        bool frame_is_due = false;
+
+        // Check if any of the clients is due for a new frame:
+        xSemaphoreTake(stream->lock, portMAX_DELAY);
+
+        for (int i = 0; i < MAXIMUM_STREAM_CLIENTS; i++)
+            if (stream->clients[i].is_active && stream->clients[i].next_frame_time_us <= current_time_us)
+                frame_is_due = true;
+
+        xSemaphoreGive(stream->lock);
+
+        if (!frame_is_due) {
+            vTaskDelay(pdMS_TO_TICKS(STREAM_IDLE_DELAY_MS));
+
+            continue;
+        }
+
+        // Copy the samples, so a request that reads new samples does not change them halfway through the FFT:
+        xSemaphoreTake(stream->sample_lock, portMAX_DELAY);
+
+        memcpy(samples, stream->samples, stream->sample_length * sizeof(float));
+
+        xSemaphoreGive(stream->sample_lock);
+
+        // Compute the spectrum only once, and share it between all the clients that are due:
+        if (compute_fft_spectrum_f32(&fft_data, samples, *stream->window, stream->sample_length, power_db, NULL) != ESP_OK) {
+            vTaskDelay(pdMS_TO_TICKS(STREAM_IDLE_DELAY_MS));
+
+            continue;
+        }
+
+        xSemaphoreTake(stream->lock, portMAX_DELAY);
+
+        for (int i = 0; i < MAXIMUM_STREAM_CLIENTS; i++) {
+            stream_client_t* client = &stream->clients[i];
+
+            if (!client->is_active || client->next_frame_time_us > current_time_us)
+                continue;
+
+            // Schedule the next frame (without catching up on frames that were missed):
+            client->next_frame_time_us += client->frame_interval_us;
+
+            if (client->next_frame_time_us <= current_time_us)
+                client->next_frame_time_us = current_time_us + client->frame_interval_us;
+
+            // Remove the client if its socket is no longer a WebSocket connection:
+            if (httpd_ws_get_fd_info(stream->server_handle, client->socket) != HTTPD_WS_CLIENT_WEBSOCKET) {
+                remove_stream_client(client);
+
+                continue;
+            }
+
+            // Drop the frame if the previous frame is still being sent (the socket is backed up):
+            if (client->is_sending) {
+                client->dropped_frames++;
+
+                continue;
+            }
+
+            size_t frame_length = encode_stream_frame(client, power_db, bin_count, client->frame);
+
+            httpd_ws_frame_t websocket_frame = {
+                .final = true,
+                .fragmented = false,
+                .type = HTTPD_WS_TYPE_BINARY,
+                .payload = client->frame,
+                .len = frame_length
+            };
+
+            client->is_sending = true;
+
+            // Send the frame asynchronously, the client is released again in `stream_frame_sent`:
+            if (httpd_ws_send_data_async(stream->server_handle, client->socket, &websocket_frame, stream_frame_sent, client) != ESP_OK) {
+                client->is_sending = false;
+
+                remove_stream_client(client);
+            }
+        }
+
+        xSemaphoreGive(stream->lock);
+    }
+}
+
+esp_err_t start_spectrum_stream(spectrum_stream_t* stream, httpd_handle_t server_handle, const float* samples, size_t sample_length, window_config_t* window) {
+    // Check if `stream`, `samples` and `window` have a valid value:
+    if (stream == NULL || samples == NULL || window == NULL) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "stream", "samples", "window");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the spectrum fits into a frame:
+    if (sample_length / 2 > MAXIMUM_STREAM_BIN_COUNT) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The spectrum of '%d' samples does not fit into a frame!", (int)sample_length);
+
+        return ESP_FAIL;
+    }
+
+    stream->server_handle = server_handle;
+    stream->samples = samples;
+    stream->sample_length = sample_length;
+    stream->window = window;
+
+    stream->lock = xSemaphoreCreateMutex();        // Create the mutex that guards the slots of the clients.
+    stream->sample_lock = xSemaphoreCreateMutex(); // Create the mutex that guards the samples.
+
+    // Check if the mutexes could be created:
+    if (stream->lock == NULL || stream->sample_lock == NULL) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "lock", "sample_lock");
+
+        return ESP_FAIL;
+    }
+
+    // Start the task that computes and sends the frames:
+    if (xTaskCreate(spectrum_stream_task, "spectrum_stream", STREAM_TASK_STACK_SIZE, stream, STREAM_TASK_PRIORITY, &stream->task) != pdPASS) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The task for the spectrum stream could not be created!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+void take_stream_sample_lock(spectrum_stream_t* stream) {
+    // Without a started stream, no task reads the samples:
+    if (stream != NULL && stream->sample_lock != NULL)
+        xSemaphoreTake(stream->sample_lock, portMAX_DELAY);
+}
+
+void give_stream_sample_lock(spectrum_stream_t* stream) {
+    if (stream != NULL && stream->sample_lock != NULL)
+        xSemaphoreGive(stream->sample_lock);
+}
+
+esp_err_t add_stream_client(spectrum_stream_t* stream, int socket) {
+    // Check if `stream` has a valid value:
+    if (stream == NULL || stream->lock == NULL) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The stream is not started yet!");
+
+        return ESP_FAIL;
+    }
+
+    esp_err_t succeeded_add = ESP_FAIL;
+
+    xSemaphoreTake(stream->lock, portMAX_DELAY);
+
+    int slot = -1;
+
+    // Reuse the slot of the socket, if it is already in the stream (the descriptor of a closed connection is reused by the next one):
+    for (int i = 0; i < MAXIMUM_STREAM_CLIENTS && slot < 0; i++)
+        if (stream->clients[i].is_active && stream->clients[i].socket == socket)
+            slot = i;
+
+    // Otherwise, find a free slot, whose last frame is not being sent anymore:
+    for (int i = 0; i < MAXIMUM_STREAM_CLIENTS && slot < 0; i++)
+        if (!stream->clients[i].is_active && !stream->clients[i].is_sending)
+            slot = i;
+
+    if (slot >= 0) {
+        stream_client_t* client = &stream->clients[slot];
+
+        // Allocate the frame buffer on first use of the slot:
+        if (client->frame == NULL)
+            client->frame = malloc(STREAM_FRAME_LENGTH);
+
+        if (client->frame == NULL)
+            ESP_LOGE(SPECTRUM_STREAM_TAG, "The value of '%s' could not be 'NULL'!", "frame");
+        else {
+            client->stream = stream;
+            client->is_active = true;
+            client->socket = socket;
+            client->encoding = QUANTIZED_STREAM_ENCODING;
+            client->frame_interval_us = 1000000 / DEFAULT_STREAM_FRAME_RATE;
+            client->next_frame_time_us = esp_timer_get_time();
+            client->sequence = 0;
+            client->dropped_frames = 0;
+            client->has_previous_frame = false;
+
+            succeeded_add = ESP_OK;
+        }
+    }
+
+    xSemaphoreGive(stream->lock);
+
+    if (slot < 0)
+        ESP_LOGW(SPECTRUM_STREAM_TAG, "The client on socket '%d' could not join the stream, all '%d' slots are in use!", socket, MAXIMUM_STREAM_CLIENTS);
+
+    return succeeded_add;
+}
+
+esp_err_t configure_stream_client(spectrum_stream_t* stream, int socket, size_t frame_rate, stream_encoding_t encoding) {
+    // Check if `stream` has a valid value:
+    if (stream == NULL || stream->lock == NULL) {
+        ESP_LOGE(SPECTRUM_STREAM_TAG, "The stream is not started yet!");
+
+        return ESP_FAIL;
+    }
+
+    // Truncate the frame rate to the supported range:
+    if (frame_rate == 0)
+        frame_rate = 1;
+
+    if (frame_rate > MAXIMUM_STREAM_FRAME_RATE) {
+        ESP_LOGW(SPECTRUM_STREAM_TAG, "Requested a frame rate that is not supported. Truncating it to '%d' frames per second!", MAXIMUM_STREAM_FRAME_RATE);
+
+        frame_rate = MAXIMUM_STREAM_FRAME_RATE;
+    }
+
+    esp_err_t succeeded_configure = ESP_FAIL;
+
+    xSemaphoreTake(stream->lock, portMAX_DELAY);
+
+    // Find the slot of the client, and apply the new settings (a new encoding always starts with a keyframe):
+    for (int i = 0; i < MAXIMUM_STREAM_CLIENTS; i++) {
+        stream_client_t* client = &stream->clients[i];
+
+        if (!client->is_active || client->socket != socket)
+            continue;
+
+        client->frame_interval_us = 1000000 / frame_rate;
+        client->next_frame_time_us = esp_timer_get_time();
+        client->encoding = encoding;
+        client->has_previous_frame = false;
+
+        succeeded_configure = ESP_OK;
+
+        break;
+    }
+
+    xSemaphoreGive(stream->lock);
+
+    return succeeded_configure;
+}
+
+size_t encode_stream_frame(stream_client_t* client, const float* power_db, size_t bin_count, uint8_t* frame) {
+    bool is_keyframe = !client->has_previous_frame || client->sequence % STREAM_KEYFRAME_INTERVAL == 0;
+    stream_encoding_t encoding = client->encoding;
+
+    // A delta frame without a valid reference is sent as a quantized keyframe:
+    if (encoding == DELTA_STREAM_ENCODING && is_keyframe)
+        encoding = QUANTIZED_STREAM_ENCODING;
+
+    // Write the header of the frame:
+    frame[0] = encoding;
+    frame[1] = is_keyframe ? STREAM_KEYFRAME_FLAG : 0;
+    frame[2] = bin_count & 0xFF;
+    frame[3] = (bin_count >> 8) & 0xFF;
+
+    write_little_endian_u32(&frame[4], client->sequence++);
+    write_little_endian_f32(&frame[8], STREAM_DB_OFFSET);
+    write_little_endian_f32(&frame[12], STREAM_DB_STEP);
+
+    uint8_t* payload = &frame[STREAM_HEADER_LENGTH];
+    size_t payload_length = 0;
+
+    switch (encoding) {
+        // Send every bin as a `float` in dB:
+        case FULL_STREAM_ENCODING:
+            for (size_t i = 0; i < bin_count; i++)
+                write_little_endian_f32(&payload[i * sizeof(float)], power_db[i]);
+
+            payload_length = bin_count * sizeof(float);
+            client->has_previous_frame = false;
+
+            break;
+
+        // Send every bin as a quantized `uint8_t`, which also becomes the reference for the next delta frame:
+        case QUANTIZED_STREAM_ENCODING:
+            for (size_t i = 0; i < bin_count; i++) {
+                payload[i] = quantize_power_db(power_db[i]);
+                client->previous_frame[i] = payload[i];
+            }
+
+            payload_length = bin_count;
+            client->has_previous_frame = true;
+
+            break;
+
+        // Send the difference with the reference as an `int8_t`, and encode runs of unchanged bins as a zero byte followed by the length of the run:
+        case DELTA_STREAM_ENCODING:
+            for (size_t i = 0; i < bin_count;) {
+                int difference = (int)quantize_power_db(power_db[i]) - (int)client->previous_frame[i];
+
+                if (difference == 0) {
+                    size_t run_length = 0;
+
+                    while (i < bin_count && run_length < UINT8_MAX && quantize_power_db(power_db[i]) == client->previous_frame[i]) {
+                        run_length++;
+                        i++;
+                    }
+
+                    payload[payload_length++] = 0;
+                    payload[payload_length++] = run_length;
+
+                    continue;
+                }
+
+                // Limit the difference to the range of an `int8_t`, and keep the reference equal to what the client reconstructs:
+                if (difference > INT8_MAX)
+                    difference = INT8_MAX;
+
+                if (difference < -INT8_MAX)
+                    difference = -INT8_MAX;
+
+                client->previous_frame[i] += difference;
+                payload[payload_length++] = (uint8_t)(int8_t)difference;
+
+                i++;
+            }
+
+            break;
+    }
+
+    return STREAM_HEADER_LENGTH + payload_length;
+}
@@ -0,0 +1,120 @@
+#ifndef SPECTRUM_STREAM_H_
+#define SPECTRUM_STREAM_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_http_server.h"
+
+#include "fft_transform.h"
+
+#define SPECTRUM_STREAM_TAG ("SPECTRUM_STREAM_H_")
+
+#define MAXIMUM_STREAM_CLIENTS (4)
+#define MAXIMUM_STREAM_BIN_COUNT (1024)
+#define MAXIMUM_STREAM_FRAME_RATE (20)
+#define DEFAULT_STREAM_FRAME_RATE (5)
+
+#define STREAM_HEADER_LENGTH (16)
+#define STREAM_FRAME_LENGTH (STREAM_HEADER_LENGTH + MAXIMUM_STREAM_BIN_COUNT * sizeof(float))
+#define STREAM_KEYFRAME_INTERVAL (32)
+#define STREAM_KEYFRAME_FLAG (0x01)
+
+#define STREAM_DB_OFFSET (-30.0f)
+#define STREAM_DB_STEP (0.5f)
+
+#define STREAM_TASK_STACK_SIZE (4096)
+#define STREAM_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
+#define STREAM_IDLE_DELAY_MS (10)
+
+/// @brief This is an enumeration called `stream_encoding_t` with the different encodings of a streamed spectrum frame.
+typedef enum stream_encoding {
+    FULL_STREAM_ENCODING,      // Every bin is sent as a `float` in dB.
+    QUANTIZED_STREAM_ENCODING, // Every bin is sent as an `uint8_t`, that is `(dB - db_offset) / db_step`.
+    DELTA_STREAM_ENCODING      // Every bin is sent as an `int8_t` difference with the previous quantized frame, where a zero byte is followed by the length of a run of unchanged bins. Every `STREAM_KEYFRAME_INTERVAL` frames a quantized keyframe is sent.
+} stream_encoding_t;
+
+/// @brief Defining a struct called `stream_client`, that contains the state of a single WebSocket client of the spectrum stream.
+typedef struct stream_client {
+    struct spectrum_stream* stream; // This field is a pointer to the `spectrum_stream_t` that owns the client.
+
+    bool is_active;   // This field contains a `bool`, indicating if the slot is used by a connected client.
+    bool is_sending;  // This field contains a `bool`, indicating if the previous frame of the client is still being sent (in which case new frames are dropped).
+    int socket;       // This field contains an `int` with the socket descriptor of the client.
+
+    stream_encoding_t encoding; // This field contains the `stream_encoding_t` that is requested by the client.
+    int64_t frame_interval_us;  // This field contains an `int64_t` with the time between two frames (in microseconds).
+    int64_t next_frame_time_us; // This field contains an `int64_t` with the time at which the next frame is due (in microseconds).
+
+    uint32_t sequence;        // This field contains an `uint32_t` with the sequence number of the next frame.
+    uint32_t dropped_frames;  // This field contains an `uint32_t` with the number of frames that were dropped because the socket was backed up.
+    bool has_previous_frame;  // This field contains a `bool`, indicating if `previous_frame` contains the last frame as reconstructed by the client.
+
+    uint8_t previous_frame[MAXIMUM_STREAM_BIN_COUNT]; // This field contains the last quantized frame, as reconstructed by the client (the reference for delta encoding).
+    uint8_t* frame;                                   // This field is a pointer to a buffer of `STREAM_FRAME_LENGTH` bytes, which holds the frame that is being sent.
+} stream_client_t;
+
+/// @brief Defining a struct called `spectrum_stream`, that contains all the needed data for streaming the spectrum of the samples to WebSocket clients.
+typedef struct spectrum_stream {
+    httpd_handle_t server_handle; // This field contains the `httpd_handle_t` of the HTTP server that owns the WebSocket connections.
+
+    const float* samples;          // This field is a pointer to the samples whose spectrum is streamed.
+    size_t sample_length;          // This field contains a `size_t` with the number of samples.
+    window_config_t* window;       // This field is a pointer to the window that is applied before the FFT.
+
+    stream_client_t clients[MAXIMUM_STREAM_CLIENTS]; // This field contains an array with the slots for the clients.
+
+    SemaphoreHandle_t lock;        // This field contains a `SemaphoreHandle_t` mutex, that guards the slots of the clients.
+    SemaphoreHandle_t sample_lock; // This field contains a `SemaphoreHandle_t` mutex, that guards `samples` while they are written, or copied by the task.
+    TaskHandle_t task;             // This field contains the `TaskHandle_t` of the task that computes and sends the frames.
+} spectrum_stream_t;
+
+/// @brief The declaration of an external variable `spectrum_stream`, which means that this variable is defined in another source file (in this case 'main.c').
+extern spectrum_stream_t spectrum_stream;
+
+/// @brief This function starts the task that streams the spectrum of a set of samples to the connected WebSocket clients.
+/// @param stream A pointer to the `spectrum_stream_t` structure.
+/// @param server_handle The handle of the HTTP server that owns the WebSocket connections.
+/// @param samples A pointer to the samples whose spectrum is streamed.
+/// @param sample_length The number of samples (at most twice `MAXIMUM_STREAM_BIN_COUNT`).
+/// @param window A pointer to the window that is applied before the FFT (read again for every frame).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t start_spectrum_stream(spectrum_stream_t* stream, httpd_handle_t server_handle, const float* samples, size_t sample_length, window_config_t* window);
+
+/// @brief This function takes the lock of the streamed samples, which must be held while they are written (it does nothing while the stream is not started).
+/// @param stream A pointer to the `spectrum_stream_t` structure.
+extern void take_stream_sample_lock(spectrum_stream_t* stream);
+
+/// @brief This function gives back the lock of the streamed samples, that is taken with `take_stream_sample_lock`.
+/// @param stream A pointer to the `spectrum_stream_t` structure.
+extern void give_stream_sample_lock(spectrum_stream_t* stream);
+
+/// @brief This function adds a WebSocket client to the stream, with the default frame rate and the quantized encoding. A socket that is already in the stream (a reused descriptor) keeps its slot, and starts over with the defaults.
+/// @param stream A pointer to the `spectrum_stream_t` structure.
+/// @param socket The socket descriptor of the client.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if all the slots are in use.
+extern esp_err_t add_stream_client(spectrum_stream_t* stream, int socket);
+
+/// @brief This function changes the frame rate and encoding of a WebSocket client of the stream.
+/// @param stream A pointer to the `spectrum_stream_t` structure.
+/// @param socket The socket descriptor of the client.
+/// @param frame_rate The requested number of frames per second (truncated to `MAXIMUM_STREAM_FRAME_RATE`).
+/// @param encoding The requested `stream_encoding_t` of the frames.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if the client is unknown.
+extern esp_err_t configure_stream_client(spectrum_stream_t* stream, int socket, size_t frame_rate, stream_encoding_t encoding);
+
+/// @brief This function encodes a spectrum into a frame for a client, according to the encoding of the client, and updates the delta reference of the client.
+/// @param client A pointer to the `stream_client_t` structure of the client.
+/// @param power_db A pointer to the power of each bin in dB.
+/// @param bin_count The number of bins (at most `MAXIMUM_STREAM_BIN_COUNT`).
+/// @param frame A pointer to a buffer of at least `STREAM_FRAME_LENGTH` bytes, where the encoded frame will be stored.
+/// @return The length of the encoded frame in bytes.
+extern size_t encode_stream_frame(stream_client_t* client, const float* power_db, size_t bin_count, uint8_t* frame);
+
+#endif
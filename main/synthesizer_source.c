@@ -0,0 +1,52 @@
+#include "synthesizer_source.h"
+
+/// @brief Defining a struct called `synthesizer_context`, that contains the private data of the synthesizer source.
+typedef struct synthesizer_context {
+    wave_config_t* wave_configs; // This field is a pointer to the array of waves that are synthesized.
+    size_t* number_of_waves;     // This field is a pointer to the number of waves that are synthesized.
+} synthesizer_context_t;
+
+static esp_err_t read_synthesizer_source(void* context, float* samples, size_t sample_length) {
+    synthesizer_context_t* synthesizer_context = context;
+
+    // Reset the samples, because `generate_waves_f32` adds every wave to the existing samples:
+    memset(samples, 0, sample_length * sizeof(float));
+
+    return generate_waves_f32(synthesizer_context->wave_configs, samples, sample_length, *synthesizer_context->number_of_waves);
+}
+
+static esp_err_t close_synthesizer_source(void* context) {
+    free(context); // Free the memory allocated for the context of the synthesizer.
+
+    return ESP_OK;
+}
+
+esp_err_t open_synthesizer_source(sample_source_t* source, wave_config_t* wave_configs, size_t* number_of_waves, size_t sample_frequency) {
+    // Check if `source`, `wave_configs` and `number_of_waves` have a valid value:
+    if (source == NULL || wave_configs == NULL || number_of_waves == NULL) {
+        ESP_LOGE(SYNTHESIZER_SOURCE_TAG, "The values of '%s', '%s' and '%s' could not be 'NULL'!", "source", "wave_configs", "number_of_waves");
+
+        return ESP_FAIL;
+    }
+
+    synthesizer_context_t* synthesizer_context = calloc(1, sizeof(synthesizer_context_t)); // Allocate memory for the context of the synthesizer.
+
+    // Check if the memory allocation was successful:
+    if (synthesizer_context == NULL) {
+        ESP_LOGE(SYNTHESIZER_SOURCE_TAG, "The value of '%s' could not be 'NULL'!", "synthesizer_context");
+
+        return ESP_FAIL;
+    }
+
+    synthesizer_context->wave_configs = wave_configs;
+    synthesizer_context->number_of_waves = number_of_waves;
+
+    // Fill the interface of the source:
+    source->type = SYNTHESIZER_SOURCE;
+    source->sample_frequency = sample_frequency;
+    source->read = read_synthesizer_source;
+    source->close = close_synthesizer_source;
+    source->context = synthesizer_context;
+
+    return ESP_OK;
+}
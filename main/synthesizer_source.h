@@ -0,0 +1,17 @@
+#ifndef SYNTHESIZER_SOURCE_H_
+#define SYNTHESIZER_SOURCE_H_
+
+#include "sample_source.h"
+#include "wave_transform.h"
+
+#define SYNTHESIZER_SOURCE_TAG ("SYNTHESIZER_SOURCE_H_")
+
+/// @brief This function opens a source that synthesizes its samples from a list of waves, using `generate_waves_f32`.
+/// @param source A pointer to the `sample_source_t` structure that will be initialized.
+/// @param wave_configs A pointer to the array of waves, which is read again on every call to `read_sample_source` (so changes to the waves are picked up).
+/// @param number_of_waves A pointer to the number of waves in `wave_configs`, which is read again on every call to `read_sample_source`.
+/// @param sample_frequency The frequency at which the waves are sampled, measured in Hz (Hertz).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t open_synthesizer_source(sample_source_t* source, wave_config_t* wave_configs, size_t* number_of_waves, size_t sample_frequency);
+
+#endif
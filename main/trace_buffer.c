@@ -0,0 +1,230 @@
+#include "trace_buffer.h"
+
+_Static_assert((TRACE_BUFFER_LENGTH & (TRACE_BUFFER_LENGTH - 1)) == 0, "The length of the trace buffer must be a power of two!");
+_Static_assert(sizeof(trace_event_t) == 40, "A trace event must keep its fixed size!");
+
+static void trace_drain_task(void* argument) {
+    trace_buffer_t* buffer = argument;
+
+    trace_event_t events[TRACE_CONSOLE_EVENTS_PER_DRAIN] = {};
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_DRAIN_PERIOD_MS));
+
+        // Skip the events while the console output is disabled (`/trace` still reads them):
+        if (!atomic_load(&buffer->console_output)) {
+            buffer->console_sequence = get_trace_sequence(buffer);
+
+            continue;
+        }
+
+        size_t number_of_events = 0;
+        uint32_t dropped_events = 0;
+
+        read_trace_events(buffer, &buffer->console_sequence, events, TRACE_CONSOLE_EVENTS_PER_DRAIN, &number_of_events, &dropped_events);
+
+        for (size_t i = 0; i < number_of_events; i++) {
+            const trace_event_t* event = &events[i];
+
+            ESP_LOGI(TRACE_BUFFER_TAG, "#%u at '%lld' us: %s %ld %ld %ld %g %g", (unsigned int)event->sequence, (long long)event->timestamp_us, get_trace_stage_name(event->stage), (long)event->values[0], (long)event->values[1], (long)event->values[2], event->measurements[0], event->measurements[1]);
+        }
+
+        uint32_t skipped_events = dropped_events;
+
+        // Rate-limit the console: the events that did not fit in this period are skipped, instead of being printed later:
+        if (number_of_events == TRACE_CONSOLE_EVENTS_PER_DRAIN) {
+            uint32_t next_sequence = get_trace_sequence(buffer);
+
+            skipped_events += next_sequence - buffer->console_sequence;
+            buffer->console_sequence = next_sequence;
+        }
+
+        if (skipped_events > 0)
+            ESP_LOGW(TRACE_BUFFER_TAG, "Skipped '%u' trace events on the console (they can still be read on '/trace' while they are in the buffer)!", (unsigned int)skipped_events);
+    }
+}
+
+esp_err_t start_trace_buffer(trace_buffer_t* buffer, trace_level_t level) {
+    // Check if `buffer` has a valid value:
+    if (buffer == NULL) {
+        ESP_LOGE(TRACE_BUFFER_TAG, "The value of '%s' could not be 'NULL'!", "buffer");
+
+        return ESP_FAIL;
+    }
+
+    atomic_store(&buffer->level, level);
+    atomic_store(&buffer->console_output, true);
+
+    buffer->console_sequence = get_trace_sequence(buffer);
+
+    // Start the task that drains the events to the console, below every task that records them:
+    if (xTaskCreate(trace_drain_task, "trace_buffer", TRACE_DRAIN_TASK_STACK_SIZE, buffer, TRACE_DRAIN_TASK_PRIORITY, &buffer->task) != pdPASS) {
+        ESP_LOGE(TRACE_BUFFER_TAG, "The drain task of the trace could not be created!");
+
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+void record_trace_event(trace_buffer_t* buffer, trace_stage_t stage, trace_level_t level, const int32_t values[TRACE_EVENT_VALUES], const float measurements[TRACE_EVENT_MEASUREMENTS]) {
+    if (!trace_level_is_enabled(buffer, level))
+        return;
+
+    uint32_t sequence = atomic_fetch_add_explicit(&buffer->next_sequence, 1, memory_order_relaxed); // Claim the slot of the event (every writer gets another sequence number).
+    trace_slot_t* slot = &buffer->slots[sequence & (TRACE_BUFFER_LENGTH - 1)];
+
+    // Mark the slot as incomplete, before the previous event in it is overwritten:
+    atomic_store_explicit(&slot->committed_sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot->event = (trace_event_t){
+        .timestamp_us = esp_timer_get_time(),
+        .sequence = sequence,
+        .stage = stage,
+        .level = level
+    };
+
+    for (size_t i = 0; values != NULL && i < TRACE_EVENT_VALUES; i++)
+        slot->event.values[i] = values[i];
+
+    for (size_t i = 0; measurements != NULL && i < TRACE_EVENT_MEASUREMENTS; i++)
+        slot->event.measurements[i] = measurements[i];
+
+    // Publish the complete event to the readers:
+    atomic_store_explicit(&slot->committed_sequence, sequence + 1, memory_order_release);
+}
+
+bool trace_level_is_enabled(trace_buffer_t* buffer, trace_level_t level) {
+    return buffer != NULL && level != TRACE_LEVEL_OFF && level <= atomic_load_explicit(&buffer->level, memory_order_relaxed);
+}
+
+esp_err_t read_trace_events(trace_buffer_t* buffer, uint32_t* sequence, trace_event_t* events, size_t maximum_events, size_t* number_of_events, uint32_t* dropped_events) {
+    // Check if `buffer`, `sequence`, `events`, `number_of_events` and `dropped_events` have a valid value:
+    if (buffer == NULL || sequence == NULL || events == NULL || number_of_events == NULL || dropped_events == NULL) {
+        ESP_LOGE(TRACE_BUFFER_TAG, "The values of '%s', '%s', '%s', '%s' and '%s' could not be 'NULL'!", "buffer", "sequence", "events", "number_of_events", "dropped_events");
+
+        return ESP_FAIL;
+    }
+
+    uint32_t next_sequence = atomic_load_explicit(&buffer->next_sequence, memory_order_acquire);
+    uint32_t current_sequence = *sequence;
+
+    *number_of_events = 0;
+
+    // Skip the events that are already overwritten (the ring only holds the last `TRACE_BUFFER_LENGTH` events):
+    if (next_sequence - current_sequence > TRACE_BUFFER_LENGTH) {
+        *dropped_events += next_sequence - current_sequence - TRACE_BUFFER_LENGTH;
+
+        current_sequence = next_sequence - TRACE_BUFFER_LENGTH;
+    }
+
+    while (*number_of_events < maximum_events && current_sequence != next_sequence) {
+        const trace_slot_t* slot = &buffer->slots[current_sequence & (TRACE_BUFFER_LENGTH - 1)];
+
+        uint32_t committed_sequence = atomic_load_explicit(&slot->committed_sequence, memory_order_acquire);
+
+        // The event is not complete yet, so it is read on the next call (unless a newer event already took its slot):
+        if (committed_sequence != current_sequence + 1) {
+            if (committed_sequence != 0 && (int32_t)(committed_sequence - (current_sequence + 1)) > 0) {
+                (*dropped_events)++;
+                current_sequence++;
+
+                continue;
+            }
+
+            break;
+        }
+
+        trace_event_t event = slot->event;
+
+        // Check if the event was overwritten while it was copied:
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&slot->committed_sequence, memory_order_relaxed) != current_sequence + 1)
+            (*dropped_events)++;
+        else
+            events[(*number_of_events)++] = event;
+
+        current_sequence++;
+    }
+
+    *sequence = current_sequence;
+
+    return ESP_OK;
+}
+
+uint32_t get_trace_sequence(trace_buffer_t* buffer) {
+    return atomic_load_explicit(&buffer->next_sequence, memory_order_acquire);
+}
+
+const char* get_trace_stage_name(trace_stage_t stage) {
+    switch (stage) {
+        case WAVE_REQUEST_TRACE:
+            return "WAVE_REQUEST";
+
+        case FFT_REQUEST_TRACE:
+            return "FFT_REQUEST";
+
+        case DAC_REQUEST_TRACE:
+            return "DAC_REQUEST";
+
+        case SOURCE_REQUEST_TRACE:
+            return "SOURCE_REQUEST";
+
+        case FILTER_REQUEST_TRACE:
+            return "FILTER_REQUEST";
+
+        case REPLAY_REQUEST_TRACE:
+            return "REPLAY_REQUEST";
+
+        case CORRELATE_REQUEST_TRACE:
+            return "CORRELATE_REQUEST";
+
+        case METRICS_REQUEST_TRACE:
+            return "METRICS_REQUEST";
+
+        case STREAM_REQUEST_TRACE:
+            return "STREAM_REQUEST";
+
+        case TRACE_REQUEST_TRACE:
+            return "TRACE_REQUEST";
+
+        case FFT_JOB_TRACE:
+            return "FFT_JOB";
+
+        case FFT_PEAK_TRACE:
+            return "FFT_PEAK";
+
+        case DAC_STAGE_TRACE:
+            return "DAC_STAGE";
+
+        case CORRELATION_TRACE:
+            return "CORRELATION";
+
+        case METRICS_TRACE:
+            return "METRICS";
+
+        default:
+            return "UNKNOWN";
+    }
+}
+
+const char* get_trace_level_name(trace_level_t level) {
+    switch (level) {
+        case TRACE_LEVEL_OFF:
+            return "OFF";
+
+        case TRACE_LEVEL_INFO:
+            return "INFO";
+
+        case TRACE_LEVEL_VERBOSE:
+            return "VERBOSE";
+
+        case TRACE_LEVEL_PLOT:
+            return "PLOT";
+
+        default:
+            return "UNKNOWN";
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef TRACE_BUFFER_H_
+#define TRACE_BUFFER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TRACE_BUFFER_TAG ("TRACE_BUFFER_H_")
+
+#define TRACE_BUFFER_LENGTH (128)           // The number of events in the ring (a power of two, so the slot of an event follows from its sequence number).
+#define TRACE_EVENT_VALUES (3)              // The number of integer values of an event.
+#define TRACE_EVENT_MEASUREMENTS (2)        // The number of `float` measurements of an event.
+#define TRACE_DRAIN_PERIOD_MS (250)         // The period at which the drain task prints the new events to the console.
+#define TRACE_CONSOLE_EVENTS_PER_DRAIN (16) // The most events that are printed per period (the others are counted as skipped, so the console never falls behind).
+
+#define TRACE_DRAIN_TASK_STACK_SIZE (3072)
+#define TRACE_DRAIN_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+/// @brief This is an enumeration called `trace_level_t` with the levels of detail of the tracing, where every level includes the levels before it.
+typedef enum trace_level {
+    TRACE_LEVEL_OFF,     // No events are recorded.
+    TRACE_LEVEL_INFO,    // The requests, the FFT jobs, the staged DAC values and the measurements are recorded (the default).
+    TRACE_LEVEL_VERBOSE, // The peaks of every FFT are recorded as well, and the content of every request is logged directly (which blocks on the console).
+    TRACE_LEVEL_PLOT     // The spectrum of every FFT is plotted on the console with `dsps_view` as well (which takes many milliseconds per FFT).
+} trace_level_t;
+
+/// @brief This is an enumeration called `trace_stage_t` with the stages that record an event, and the meaning of its values and measurements.
+typedef enum trace_stage {
+    WAVE_REQUEST_TRACE,      // A request to `/wave`, with the content length and whether it is binary.
+    FFT_REQUEST_TRACE,       // A request to `/fft`, with the content length and whether it is binary.
+    DAC_REQUEST_TRACE,       // A request to `/dac`, with the content length and whether it is binary.
+    SOURCE_REQUEST_TRACE,    // A request to `/source`, with the content length.
+    FILTER_REQUEST_TRACE,    // A request to `/filter`, with the content length.
+    REPLAY_REQUEST_TRACE,    // A request to `/replay`, with the content length.
+    CORRELATE_REQUEST_TRACE, // A request to `/correlate`, with the content length.
+    METRICS_REQUEST_TRACE,   // A request to `/metrics`, with the content length.
+    STREAM_REQUEST_TRACE,    // A message on the `/stream` WebSocket, with the content length.
+    TRACE_REQUEST_TRACE,     // A request to `/trace`, with the content length.
+    FFT_JOB_TRACE,           // A finished FFT job, with its ID, its `fft_job_status_t` and the time since it was queued (in microseconds).
+    FFT_PEAK_TRACE,          // A peak of an FFT, with its index and the number of peaks, and its frequency (in Hz) and amplitude as measurements.
+    DAC_STAGE_TRACE,         // Values that are staged for the DAC, with the number of samples, the period of the timer (in microseconds) and the `dac_output_channels_t`.
+    CORRELATION_TRACE,       // A correlation, with its duration (in microseconds) and the lengths of its output and reference, and the peak and its lag (in samples) as measurements.
+    METRICS_TRACE            // A quality measurement, with its duration (in microseconds) and the number of harmonics, and the THD and SINAD (in dB) as measurements.
+} trace_stage_t;
+
+/// @brief Defining a struct called `trace_event`, that contains a single fixed-size event of the trace.
+typedef struct trace_event {
+    int64_t timestamp_us; // This field contains an `int64_t` with the time at which the event is recorded (in microseconds since boot).
+    uint32_t sequence;    // This field contains an `uint32_t` with the sequence number of the event (it counts every recorded event, also the overwritten ones).
+    uint8_t stage;        // This field contains an `uint8_t` with the `trace_stage_t` that recorded the event.
+    uint8_t level;        // This field contains an `uint8_t` with the `trace_level_t` of the event.
+    uint16_t reserved;    // This field is reserved, and keeps the values aligned.
+
+    int32_t values[TRACE_EVENT_VALUES];           // This field contains the integer values of the event (see `trace_stage_t`).
+    float measurements[TRACE_EVENT_MEASUREMENTS]; // This field contains the `float` measurements of the event (see `trace_stage_t`).
+} trace_event_t;
+
+/// @brief Defining a struct called `trace_slot`, that contains an event of the ring together with the sequence number that marks it as complete.
+typedef struct trace_slot {
+    _Atomic uint32_t committed_sequence; // This field contains an atomic `uint32_t` with the sequence number of the event plus one once it is complete, or zero while it is written.
+    trace_event_t event;                 // This field contains the `trace_event_t` of the slot.
+} trace_slot_t;
+
+/// @brief Defining a struct called `trace_buffer`, that contains the lock-free ring of events and the task that drains it to the console. Every task records events without blocking, and every reader keeps its own sequence number, so the console and `/trace` do not take events from each other.
+typedef struct trace_buffer {
+    trace_slot_t slots[TRACE_BUFFER_LENGTH]; // This field contains an array with the slots of the ring.
+    _Atomic uint32_t next_sequence;          // This field contains an atomic `uint32_t` with the sequence number of the next event, which every writer claims with a single atomic increment.
+
+    _Atomic(trace_level_t) level; // This field contains the atomic `trace_level_t`, above which events are not recorded.
+    _Atomic bool console_output;  // This field contains an atomic `bool`, indicating if the drain task prints the events to the console.
+
+    uint32_t console_sequence; // This field contains an `uint32_t` with the sequence number of the next event that the drain task prints.
+    TaskHandle_t task;         // This field contains the `TaskHandle_t` of the drain task.
+} trace_buffer_t;
+
+/// @brief The declaration of an external variable `trace_buffer`, which means that this variable is defined in another source file (in this case 'main.c').
+extern trace_buffer_t trace_buffer;
+
+/// @brief This function sets the level of the trace, and starts the low-priority task that drains the events to the console.
+/// @param buffer A pointer to the `trace_buffer_t` structure.
+/// @param level The `trace_level_t` above which events are not recorded.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t start_trace_buffer(trace_buffer_t* buffer, trace_level_t level);
+
+/// @brief This function records an event in the ring, if its level is enabled. It never blocks: it claims a slot with an atomic increment, and overwrites the oldest event when the ring is full.
+/// @param buffer A pointer to the `trace_buffer_t` structure.
+/// @param stage The `trace_stage_t` that records the event.
+/// @param level The `trace_level_t` of the event.
+/// @param values An array of `TRACE_EVENT_VALUES` integer values (see `trace_stage_t`), or `NULL` if the stage has none.
+/// @param measurements An array of `TRACE_EVENT_MEASUREMENTS` measurements (see `trace_stage_t`), or `NULL` if the stage has none.
+extern void record_trace_event(trace_buffer_t* buffer, trace_stage_t stage, trace_level_t level, const int32_t values[TRACE_EVENT_VALUES], const float measurements[TRACE_EVENT_MEASUREMENTS]);
+
+/// @brief This function checks if events (and the output) of a level are enabled, so a caller can skip the work of an event that is not recorded.
+/// @param buffer A pointer to the `trace_buffer_t` structure.
+/// @param level The `trace_level_t` that is checked.
+/// @return A `bool`, which is `true` if the level is enabled.
+extern bool trace_level_is_enabled(trace_buffer_t* buffer, trace_level_t level);
+
+/// @brief This function copies the complete events from a sequence number on, and advances the sequence number past them. Events that are overwritten before they are read are counted as dropped.
+/// @param buffer A pointer to the `trace_buffer_t` structure.
+/// @param sequence A pointer to the sequence number of the first event to read, which is updated to the sequence number of the next event.
+/// @param events A pointer to an array of `maximum_events` events, where the events will be stored.
+/// @param maximum_events The largest number of events to read.
+/// @param number_of_events A pointer where the number of read events will be stored.
+/// @param dropped_events A pointer where the number of dropped events will be added.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t read_trace_events(trace_buffer_t* buffer, uint32_t* sequence, trace_event_t* events, size_t maximum_events, size_t* number_of_events, uint32_t* dropped_events);
+
+/// @brief This function returns the sequence number of the next event that will be recorded.
+/// @param buffer A pointer to the `trace_buffer_t` structure.
+/// @return The sequence number.
+extern uint32_t get_trace_sequence(trace_buffer_t* buffer);
+
+/// @brief This function converts a trace stage into its name (for example `"FFT_JOB"`).
+/// @param stage The `trace_stage_t` value.
+/// @return A string with the name of the stage.
+extern const char* get_trace_stage_name(trace_stage_t stage);
+
+/// @brief This function converts a trace level into its name (for example `"VERBOSE"`).
+/// @param level The `trace_level_t` value.
+/// @return A string with the name of the level.
+extern const char* get_trace_level_name(trace_level_t level);
+
+#endif
@@ -10,18 +10,25 @@ esp_err_t generate_waves_f32(wave_config_t* wave_configs, float* samples, size_t
 
     // Generate waves based on the provided wave configurations:
     for (int i = 0; i < number_of_waves; i++) {
-        float current_amplitude = wave_configs[i].amplitude;
-        float current_frequency = wave_configs[i].frequency;
-        float current_phase = wave_configs[i].phase;
         float current_offset = wave_configs[i].offset;
 
         float* current_wave = calloc(sample_length, sizeof(float)); // Allocate memory for the current wave.
 
         // Check if the memory allocation was successful:
-        if (current_wave == NULL)
+        if (current_wave == NULL) {
             ESP_LOGE(WAVE_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "current_wave");
 
-        dsps_tone_gen_f32(current_wave, sample_length, current_amplitude, current_frequency, current_phase); // Generate the current wave using the tone generator function.
+            return ESP_FAIL;
+        }
+
+        // Check if the current wave could be generated:
+        if (generate_wave_f32(&wave_configs[i], current_wave, sample_length) != ESP_OK) {
+            ESP_LOGE(WAVE_TRANSFORM_TAG, "Wave '%d' with type '%d' could not be generated!", i, wave_configs[i].type);
+
+            free(current_wave);
+
+            return ESP_FAIL;
+        }
 
         // Add the current wave to the samples array, taking into account the offset:
         for (int j = 0; j < sample_length; j++)
@@ -32,3 +39,63 @@ esp_err_t generate_waves_f32(wave_config_t* wave_configs, float* samples, size_t
 
     return ESP_OK;
 }
+
+esp_err_t generate_wave_f32(const wave_config_t* wave_config, float* wave, size_t sample_length) {
+    // Check if `wave_config` and `wave` pointers are valid:
+    if (wave_config == NULL || wave == NULL) {
+        ESP_LOGE(WAVE_TRANSFORM_TAG, "The values of '%s' and '%s' could not be 'NULL'!", "wave_config", "wave");
+
+        return ESP_FAIL;
+    }
+
+    float amplitude = wave_config->amplitude;
+    float frequency = wave_config->frequency;
+    float phase = wave_config->phase;
+
+    // Generate the wave with the generator of its type:
+    switch (wave_config->type) {
+        case SINE_WAVE:
+            return dsps_tone_gen_f32(wave, sample_length, amplitude, frequency, phase); // Generate the wave using the tone generator function.
+
+        case SQUARE_WAVE:
+            return generate_wavetable_f32(SQUARE_WAVETABLE, wave, sample_length, amplitude, frequency, phase);
+
+        case SAWTOOTH_WAVE:
+            return generate_wavetable_f32(SAWTOOTH_WAVETABLE, wave, sample_length, amplitude, frequency, phase);
+
+        case TRIANGLE_WAVE:
+            return generate_wavetable_f32(TRIANGLE_WAVETABLE, wave, sample_length, amplitude, frequency, phase);
+
+        case PULSE_WAVE:
+            return generate_pulse_f32(wave, sample_length, amplitude, frequency, phase, wave_config->duty_cycle);
+
+        case CHIRP_WAVE:
+            return generate_chirp_f32(wave, sample_length, amplitude, frequency, wave_config->end_frequency, phase);
+
+        case NOISE_WAVE:
+            return generate_noise_f32(wave, sample_length, amplitude);
+
+        default:
+            ESP_LOGE(WAVE_TRANSFORM_TAG, "Unknown type '%d' of the wave!", wave_config->type);
+
+            return ESP_FAIL;
+    }
+}
+
+esp_err_t rescale_wave_configs(wave_config_t* wave_configs, size_t number_of_waves, size_t previous_sample_frequency, size_t sample_frequency) {
+    // Check if `wave_configs` has a valid value, and if both sample frequencies are valid:
+    if (wave_configs == NULL || previous_sample_frequency == 0 || sample_frequency == 0) {
+        ESP_LOGE(WAVE_TRANSFORM_TAG, "The value of '%s' could not be 'NULL', and the sample frequencies could not be zero!", "wave_configs");
+
+        return ESP_FAIL;
+    }
+
+    float ratio = (float)previous_sample_frequency / (float)sample_frequency;
+
+    for (size_t i = 0; i < number_of_waves; i++) {
+        wave_configs[i].frequency *= ratio;
+        wave_configs[i].end_frequency *= ratio;
+    }
+
+    return ESP_OK;
+}
@@ -5,14 +5,31 @@
 
 #include "esp_dsp.h"
 
+#include "wavetable.h"
+
 #define WAVE_TRANSFORM_TAG ("WAVE_TRANSFORM_H_")
 
+/// @brief This is an enumeration called `wave_type_t` with the different shapes of a wave. Except for the sine, the waves are played from band-limited tables (see 'wavetable.h').
+typedef enum wave_type {
+    SINE_WAVE,     // A sine, generated with `dsps_tone_gen_f32` (the default).
+    SQUARE_WAVE,   // A band-limited square wave.
+    SAWTOOTH_WAVE, // A band-limited (rising) sawtooth wave.
+    TRIANGLE_WAVE, // A band-limited triangle wave.
+    PULSE_WAVE,    // A band-limited pulse wave, which is high for `duty_cycle` of the period.
+    CHIRP_WAVE,    // A linear chirp from `frequency` to `end_frequency` over the generated samples.
+    NOISE_WAVE     // Uniform white noise (the frequency and phase are not used).
+} wave_type_t;
+
 /// @brief Defining a struct called `wave_config`, that contains all the needed data for creating a custom wave.
 typedef struct wave_config {
     float amplitude; // This field contains a `float` for the amplitude of a wave.
     float frequency; // This field contains a `float` for the frequency of a wave.
     float phase;     // This field contains a `float` for the phase of a wave.
     float offset;    // This field contains a `float` for the offset of a wave.
+
+    wave_type_t type;    // This field contains the `wave_type_t` shape of a wave.
+    float duty_cycle;    // This field contains a `float` for the duty cycle of a pulse wave (between 0 and 1).
+    float end_frequency; // This field contains a `float` for the end frequency of a chirp (in the same unit as `frequency`).
 } wave_config_t;
 
 /// @brief This function generates multiple waves with specified configurations and adds them together to create a final waveform.
@@ -23,4 +40,19 @@ typedef struct wave_config {
 /// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
 extern esp_err_t generate_waves_f32(wave_config_t* wave_configs, float* samples, size_t sample_length, size_t number_of_waves);
 
+/// @brief This function generates a single wave (without its offset), with the generator that matches the type of the wave.
+/// @param wave_config A pointer to the `wave_config_t` structure of the wave, where the frequencies are relative to the sample frequency.
+/// @param wave A pointer to an array of floats where the generated wave will be stored.
+/// @param sample_length The length of the output array.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t generate_wave_f32(const wave_config_t* wave_config, float* wave, size_t sample_length);
+
+/// @brief This function converts the relative frequencies of waves from one sample frequency to another, so the waves keep their frequencies in Hz.
+/// @param wave_configs An array of `wave_config_t` structures, whose `frequency` and `end_frequency` are converted in-place.
+/// @param number_of_waves The number of waves.
+/// @param previous_sample_frequency The sample frequency to which the frequencies are relative now (in Hz).
+/// @param sample_frequency The sample frequency to which the frequencies will be relative (in Hz).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t rescale_wave_configs(wave_config_t* wave_configs, size_t number_of_waves, size_t previous_sample_frequency, size_t sample_frequency);
+
 #endif
@@ -0,0 +1,280 @@
+#include "wavetable.h"
+
+#define WAVETABLE_INDEX_SHIFT (32 - 10)                          // The number of fractional bits of the phase accumulator (the upper 10 bits index the `WAVETABLE_LENGTH` samples).
+#define WAVETABLE_FRACTION_MASK ((1u << WAVETABLE_INDEX_SHIFT) - 1) // The mask of the fractional bits of the phase accumulator.
+#define WAVETABLE_PHASE_SCALE (4294967296.0)                      // The value of a full period in the phase accumulator (2^32).
+
+_Static_assert(WAVETABLE_LENGTH == (1 << (32 - WAVETABLE_INDEX_SHIFT)), "The phase accumulator must index exactly 'WAVETABLE_LENGTH' samples!");
+
+static portMUX_TYPE wavetable_spinlock = portMUX_INITIALIZER_UNLOCKED;        // A spinlock that guards the creation of `wavetable_lock`.
+static SemaphoreHandle_t wavetable_lock = NULL;                               // A mutex that guards the building of the tables.
+static float* wavetables[WAVETABLE_SHAPES_LENGTH][WAVETABLE_BANDS] = {};      // The built tables per shape and band, or `NULL` if a table is not built yet.
+static uint32_t noise_state = 0x12345678;                                     // The state of the xorshift generator of the noise (never zero).
+
+static SemaphoreHandle_t get_wavetable_lock(void) {
+    // Create the mutex on first use (the waves can be generated from multiple tasks at the same time):
+    if (wavetable_lock == NULL) {
+        SemaphoreHandle_t created_lock = xSemaphoreCreateMutex();
+
+        portENTER_CRITICAL(&wavetable_spinlock);
+
+        if (wavetable_lock == NULL) {
+            wavetable_lock = created_lock;
+            created_lock = NULL;
+        }
+
+        portEXIT_CRITICAL(&wavetable_spinlock);
+
+        if (created_lock != NULL)
+            vSemaphoreDelete(created_lock);
+    }
+
+    return wavetable_lock;
+}
+
+static float get_harmonic_amplitude(wavetable_shape_t shape, size_t harmonic) {
+    bool is_odd = (harmonic % 2) == 1;
+
+    // Return the Fourier series coefficient (of the sine term) of the harmonic, for a wave with a peak of one:
+    switch (shape) {
+        case SINE_WAVETABLE:
+            return harmonic == 1 ? 1.0f : 0.0f;
+
+        case SQUARE_WAVETABLE:
+            return is_odd ? 4.0f / (M_PI * harmonic) : 0.0f;
+
+        case SAWTOOTH_WAVETABLE:
+            return (is_odd ? 2.0f : -2.0f) / (M_PI * harmonic);
+
+        case TRIANGLE_WAVETABLE:
+            return is_odd ? ((harmonic % 4) == 1 ? 8.0f : -8.0f) / (M_PI * M_PI * harmonic * harmonic) : 0.0f;
+
+        default:
+            return 0.0f;
+    }
+}
+
+static esp_err_t build_wavetable(wavetable_shape_t shape, size_t band, float* wavetable) {
+    float* spectrum = calloc(WAVETABLE_LENGTH * 2, sizeof(float)); // Allocate memory for the complex spectrum, that is transformed into the table.
+
+    // Check if the memory allocation was successful:
+    if (spectrum == NULL) {
+        ESP_LOGE(WAVETABLE_TAG, "The value of '%s' could not be 'NULL'!", "spectrum");
+
+        return ESP_FAIL;
+    }
+
+    // Set the (real) coefficient of every harmonic in the band, so the FFT sums all the harmonics in a single pass (instead of summing a sine per harmonic):
+    for (size_t harmonic = 1; harmonic <= (1u << band); harmonic++)
+        spectrum[harmonic * 2] = get_harmonic_amplitude(shape, harmonic);
+
+    fft_data_t fft_data = {};
+
+    // Check if the FFT could be initialized:
+    if (initialize_fft_f32(&fft_data) != ESP_OK) {
+        free(spectrum);
+
+        return ESP_FAIL;
+    }
+
+    esp_err_t succeeded_fft = apply_complex_fft_fc32(spectrum, WAVETABLE_LENGTH);
+
+    ESP_ERROR_CHECK(de_initialize_fft_f32(&fft_data));
+
+    if (succeeded_fft != ESP_OK) {
+        free(spectrum);
+
+        return ESP_FAIL;
+    }
+
+    // The forward FFT of the coefficients sums `c * e^(-j * 2 * pi * k * n / N)`, so the sum of the sines is the negated imaginary part:
+    for (size_t i = 0; i < WAVETABLE_LENGTH; i++)
+        wavetable[i] = -spectrum[i * 2 + 1];
+
+    free(spectrum);
+
+    return ESP_OK;
+}
+
+static inline uint32_t get_phase_increment(float frequency) {
+    return (uint32_t)(int64_t)(frequency * WAVETABLE_PHASE_SCALE); // Convert a frequency (in periods per sample) into a step of the phase accumulator (negative steps wrap around).
+}
+
+static inline uint32_t get_phase_offset(float phase) {
+    return (uint32_t)(int64_t)fmod(phase / 360.0 * WAVETABLE_PHASE_SCALE, WAVETABLE_PHASE_SCALE); // Convert a phase (in degrees) into a value of the phase accumulator.
+}
+
+static inline float read_wavetable(const float* wavetable, uint32_t phase) {
+    uint32_t index = phase >> WAVETABLE_INDEX_SHIFT;
+    float fraction = (phase & WAVETABLE_FRACTION_MASK) * (1.0f / (1u << WAVETABLE_INDEX_SHIFT));
+
+    float current_value = wavetable[index];
+    float next_value = wavetable[(index + 1) & (WAVETABLE_LENGTH - 1)];
+
+    return current_value + (next_value - current_value) * fraction; // Interpolate linearly between the two nearest samples of the table.
+}
+
+esp_err_t get_wavetable(wavetable_shape_t shape, float frequency, const float** wavetable) {
+    // Check if `wavetable` has a valid value, and if the shape is known:
+    if (wavetable == NULL || shape < 0 || shape >= WAVETABLE_SHAPES_LENGTH) {
+        ESP_LOGE(WAVETABLE_TAG, "The value of '%s' could not be 'NULL', and the shape must be known!", "wavetable");
+
+        return ESP_FAIL;
+    }
+
+    frequency = fabsf(frequency);
+
+    // Select the band with the most harmonics, of which the highest harmonic stays below the Nyquist frequency (a sine only needs the first band):
+    size_t band = 0;
+
+    while (shape != SINE_WAVETABLE && band + 1 < WAVETABLE_BANDS && (2u << band) * frequency < 0.5f)
+        band++;
+
+    SemaphoreHandle_t table_lock = get_wavetable_lock();
+
+    xSemaphoreTake(table_lock, portMAX_DELAY);
+
+    // Build the table on first use:
+    if (wavetables[shape][band] == NULL) {
+        float* built_table = malloc(WAVETABLE_LENGTH * sizeof(float));
+
+        if (built_table != NULL && build_wavetable(shape, band, built_table) == ESP_OK)
+            wavetables[shape][band] = built_table;
+        else
+            free(built_table);
+    }
+
+    const float* selected_table = wavetables[shape][band];
+
+    xSemaphoreGive(table_lock);
+
+    // Check if the table is built:
+    if (selected_table == NULL) {
+        ESP_LOGE(WAVETABLE_TAG, "The table for shape '%d' and band '%d' could not be built!", shape, (int)band);
+
+        return ESP_FAIL;
+    }
+
+    *wavetable = selected_table;
+
+    return ESP_OK;
+}
+
+esp_err_t generate_wavetable_f32(wavetable_shape_t shape, float* output, size_t length, float amplitude, float frequency, float phase) {
+    // Check if `output` has a valid value:
+    if (output == NULL) {
+        ESP_LOGE(WAVETABLE_TAG, "The value of '%s' could not be 'NULL'!", "output");
+
+        return ESP_FAIL;
+    }
+
+    const float* wavetable = NULL;
+
+    // Retrieve the table of the band that matches the frequency:
+    if (get_wavetable(shape, frequency, &wavetable) != ESP_OK)
+        return ESP_FAIL;
+
+    uint32_t current_phase = get_phase_offset(phase);
+    uint32_t phase_increment = get_phase_increment(frequency);
+
+    for (size_t i = 0; i < length; i++) {
+        output[i] = amplitude * read_wavetable(wavetable, current_phase);
+
+        current_phase += phase_increment; // The accumulator wraps around at the end of every period.
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t generate_pulse_f32(float* output, size_t length, float amplitude, float frequency, float phase, float duty_cycle) {
+    // Check if `output` has a valid value:
+    if (output == NULL) {
+        ESP_LOGE(WAVETABLE_TAG, "The value of '%s' could not be 'NULL'!", "output");
+
+        return ESP_FAIL;
+    }
+
+    // Check if the duty cycle is valid:
+    if (!(duty_cycle >= 0.0f && duty_cycle <= 1.0f)) {
+        ESP_LOGE(WAVETABLE_TAG, "The duty cycle of '%.2f' is not between 0 and 1!", duty_cycle);
+
+        return ESP_FAIL;
+    }
+
+    const float* wavetable = NULL;
+
+    // Retrieve the sawtooth table of the band that matches the frequency:
+    if (get_wavetable(SAWTOOTH_WAVETABLE, frequency, &wavetable) != ESP_OK)
+        return ESP_FAIL;
+
+    uint32_t current_phase = get_phase_offset(phase);
+    uint32_t phase_increment = get_phase_increment(frequency);
+    uint32_t duty_offset = (uint32_t)(int64_t)(duty_cycle * WAVETABLE_PHASE_SCALE);
+
+    float pulse_offset = 2.0f * duty_cycle - 1.0f; // The offset that centers the difference of the sawtooth waves around zero.
+
+    current_phase += 1u << 31; // Start half a period later in the tables, because the sawtooth jumps in the middle of its period.
+
+    // The difference of a sawtooth and a sawtooth that lags by the duty cycle is high for the duty cycle, and low for the rest of the period:
+    for (size_t i = 0; i < length; i++) {
+        output[i] = amplitude * (read_wavetable(wavetable, current_phase - duty_offset) - read_wavetable(wavetable, current_phase) + pulse_offset);
+
+        current_phase += phase_increment;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t generate_chirp_f32(float* output, size_t length, float amplitude, float start_frequency, float end_frequency, float phase) {
+    // Check if `output` has a valid value:
+    if (output == NULL) {
+        ESP_LOGE(WAVETABLE_TAG, "The value of '%s' could not be 'NULL'!", "output");
+
+        return ESP_FAIL;
+    }
+
+    const float* wavetable = NULL;
+
+    // Retrieve the sine table:
+    if (get_wavetable(SINE_WAVETABLE, 0.0f, &wavetable) != ESP_OK)
+        return ESP_FAIL;
+
+    uint32_t current_phase = get_phase_offset(phase);
+    uint32_t phase_increment = get_phase_increment(start_frequency);
+
+    // The step of the frequency per sample, so the last sample has the end frequency:
+    uint32_t increment_step = length > 1 ? (uint32_t)(int64_t)((end_frequency - start_frequency) / (length - 1) * WAVETABLE_PHASE_SCALE) : 0;
+
+    for (size_t i = 0; i < length; i++) {
+        output[i] = amplitude * read_wavetable(wavetable, current_phase);
+
+        current_phase += phase_increment;
+        phase_increment += increment_step;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t generate_noise_f32(float* output, size_t length, float amplitude) {
+    // Check if `output` has a valid value:
+    if (output == NULL) {
+        ESP_LOGE(WAVETABLE_TAG, "The value of '%s' could not be 'NULL'!", "output");
+
+        return ESP_FAIL;
+    }
+
+    uint32_t state = noise_state;
+
+    // Generate the noise with a xorshift generator, and map its full range onto `-amplitude` to `amplitude`:
+    for (size_t i = 0; i < length; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        output[i] = amplitude * ((int32_t)state * (1.0f / 2147483648.0f));
+    }
+
+    noise_state = state;
+
+    return ESP_OK;
+}
@@ -0,0 +1,75 @@
+#ifndef WAVETABLE_H_
+#define WAVETABLE_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+
+#include "fft_transform.h"
+
+#define WAVETABLE_TAG ("WAVETABLE_H_")
+
+#define WAVETABLE_LENGTH (1024) // The number of samples in a single period of a table (a power of two, because the tables are synthesized with the FFT).
+#define WAVETABLE_BANDS (8)     // The number of bands per shape, where band `b` contains the harmonics up to `2^b` (so the last band contains 128 harmonics).
+#define WAVETABLE_SHAPES_LENGTH (4)
+
+#define DEFAULT_DUTY_CYCLE (0.5f)
+
+/// @brief This is an enumeration called `wavetable_shape_t` with the shapes of which band-limited tables are built.
+typedef enum wavetable_shape {
+    SINE_WAVETABLE,     // A single sine (only the first band is used).
+    SQUARE_WAVETABLE,   // The odd harmonics with an amplitude of `1 / k`.
+    SAWTOOTH_WAVETABLE, // All the harmonics with an amplitude of `1 / k` (a rising ramp).
+    TRIANGLE_WAVETABLE  // The odd harmonics with an alternating amplitude of `1 / k^2`.
+} wavetable_shape_t;
+
+/// @brief This function retrieves the band-limited table of a shape, for a wave of a given frequency. The band with the most harmonics below the Nyquist frequency is selected, and it is built on first use. A built table is never changed or freed, so it can be shared by multiple tasks.
+/// @param shape The `wavetable_shape_t` of the table.
+/// @param frequency The highest frequency at which the table will be played, relative to the sample frequency (so at most 0.5).
+/// @param wavetable A pointer where a pointer to the table of `WAVETABLE_LENGTH` samples will be stored.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t get_wavetable(wavetable_shape_t shape, float frequency, const float** wavetable);
+
+/// @brief This function generates a wave by playing a band-limited table, with a table lookup (and linear interpolation) per sample.
+/// @param shape The `wavetable_shape_t` of the wave.
+/// @param output A pointer to an array of floats where the wave will be stored.
+/// @param length The number of samples to generate.
+/// @param amplitude The amplitude of the wave.
+/// @param frequency The frequency of the wave, relative to the sample frequency.
+/// @param phase The phase of the wave, in degrees (the same unit as `dsps_tone_gen_f32`).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t generate_wavetable_f32(wavetable_shape_t shape, float* output, size_t length, float amplitude, float frequency, float phase);
+
+/// @brief This function generates a band-limited pulse wave, as the difference of two shifted sawtooth tables (so no table per duty cycle is needed).
+/// @param output A pointer to an array of floats where the wave will be stored.
+/// @param length The number of samples to generate.
+/// @param amplitude The amplitude of the wave.
+/// @param frequency The frequency of the wave, relative to the sample frequency.
+/// @param phase The phase of the wave, in degrees.
+/// @param duty_cycle The fraction of the period in which the wave is high (between 0 and 1).
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t generate_pulse_f32(float* output, size_t length, float amplitude, float frequency, float phase, float duty_cycle);
+
+/// @brief This function generates a linear chirp, that sweeps from a start to an end frequency over the generated samples, with a phase accumulator and the sine table.
+/// @param output A pointer to an array of floats where the wave will be stored.
+/// @param length The number of samples to generate.
+/// @param amplitude The amplitude of the wave.
+/// @param start_frequency The frequency of the first sample, relative to the sample frequency.
+/// @param end_frequency The frequency of the last sample, relative to the sample frequency.
+/// @param phase The phase of the first sample, in degrees.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t generate_chirp_f32(float* output, size_t length, float amplitude, float start_frequency, float end_frequency, float phase);
+
+/// @brief This function generates uniform white noise between `-amplitude` and `amplitude`, with a xorshift generator (the state is kept between calls).
+/// @param output A pointer to an array of floats where the noise will be stored.
+/// @param length The number of samples to generate.
+/// @param amplitude The amplitude of the noise.
+/// @return An `esp_err_t` value, which is either `ESP_OK` if the function executes successfully or `ESP_FAIL` if there is an error.
+extern esp_err_t generate_noise_f32(float* output, size_t length, float amplitude);
+
+#endif
@@ -1,4 +1,83 @@
 #include "window_transform.h"
+#include "fft_tables.h"
+
+/// @brief Defining a struct called `window_table`, that contains a cached table of a window function.
+typedef struct window_table {
+    float* table;  // This field is a pointer to the generated window, or `NULL` if it is not generated yet.
+    size_t length; // This field contains a `size_t` with the length of the generated window.
+} window_table_t;
+
+static portMUX_TYPE window_table_spinlock = portMUX_INITIALIZER_UNLOCKED; // A spinlock that guards the creation of `window_table_lock`.
+static SemaphoreHandle_t window_table_lock = NULL;                        // A mutex that guards the creation of the cached tables.
+static window_table_t window_tables[WINDOW_CONFIGS_LENGTH] = {};          // The cached tables, in the same order as the `window_config_t` enum.
+
+static SemaphoreHandle_t get_window_table_lock(void) {
+    // Create the mutex on first use (the windows can be requested from multiple tasks at the same time):
+    if (window_table_lock == NULL) {
+        SemaphoreHandle_t created_lock = xSemaphoreCreateMutex();
+
+        portENTER_CRITICAL(&window_table_spinlock);
+
+        if (window_table_lock == NULL) {
+            window_table_lock = created_lock;
+            created_lock = NULL;
+        }
+
+        portEXIT_CRITICAL(&window_table_spinlock);
+
+        if (created_lock != NULL)
+            vSemaphoreDelete(created_lock);
+    }
+
+    return window_table_lock;
+}
+
+static esp_err_t cache_window_table(window_config_t window_config, size_t window_length, const float** cached_table) {
+    // Check if the `window_config` value is within the valid range:
+    if (window_config < 0 || window_config >= WINDOW_CONFIGS_LENGTH || window_length == 0) {
+        ESP_LOGE(WINDOW_TRANSFORM_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
+
+        return ESP_FAIL;
+    }
+
+#ifdef FFT_STATIC_LENGTH
+    // A window with the length of the generated tables is used directly from flash (so it is never generated or copied):
+    if (window_length == FFT_STATIC_LENGTH) {
+        *cached_table = fft_static_window_tables[window_config];
+
+        return ESP_OK;
+    }
+#endif
+
+    SemaphoreHandle_t table_lock = get_window_table_lock();
+
+    xSemaphoreTake(table_lock, portMAX_DELAY);
+
+    window_table_t* cached_window = &window_tables[window_config];
+
+    // Generate the table on first use:
+    if (cached_window->table == NULL) {
+        float* table = malloc(window_length * sizeof(float));
+
+        if (table != NULL && apply_window_function(table, window_config, window_length) == ESP_OK) {
+            cached_window->table = table;
+            cached_window->length = window_length;
+        }
+        else
+            free(table);
+    }
+
+    bool is_cached = cached_window->table != NULL && cached_window->length == window_length;
+
+    xSemaphoreGive(table_lock);
+
+    if (!is_cached)
+        return ESP_FAIL;
+
+    *cached_table = cached_window->table;
+
+    return ESP_OK;
+}
 
 esp_err_t apply_window_function(float* window, window_config_t window_config, size_t window_length) {
     // Check if the `window` pointer is valid:
@@ -29,3 +108,60 @@ esp_err_t apply_window_function(float* window, window_config_t window_config, si
 
     return ESP_FAIL;
 }
+
+esp_err_t get_window_properties(window_config_t window_config, window_properties_t* window_properties) {
+    // Check if the `window_properties` pointer is valid:
+    if (window_properties == NULL) {
+        ESP_LOGE(WINDOW_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "window_properties");
+
+        return ESP_FAIL;
+    }
+
+    // Define the cosine-sum coefficients of every window, in the same order as the `window_config_t` enum (these match the coefficients used by `esp_dsp`):
+    const float window_coefficients[][WINDOW_COEFFICIENTS_LENGTH] = {
+        {0.5f, 0.5f, 0.0f, 0.0f, 0.0f},
+        {0.42f, 0.5f, 0.08f, 0.0f, 0.0f},
+        {0.35875f, 0.48829f, 0.14128f, 0.01168f, 0.0f},
+        {0.3635819f, 0.4891775f, 0.1365995f, 0.0106411f, 0.0f},
+        {0.355768f, 0.487396f, 0.144232f, 0.012604f, 0.0f},
+        {1.0f, 1.93f, 1.29f, 0.388f, 0.028f}
+    };
+
+    // Check if the `window_config` value is within the valid range:
+    if (window_config < 0 || window_config >= sizeof(window_coefficients) / sizeof(window_coefficients[0])) {
+        ESP_LOGE(WINDOW_TRANSFORM_TAG, "Unknown configuration for the provided window in '%s'!", "window_config");
+
+        return ESP_FAIL;
+    }
+
+    const float* coefficients = window_coefficients[window_config];
+
+    // The mean of a cosine-sum window is its constant term, and its mean square is the constant term squared plus half of every other term squared:
+    float mean_square = coefficients[0] * coefficients[0];
+
+    for (int i = 1; i < WINDOW_COEFFICIENTS_LENGTH; i++)
+        mean_square += 0.5f * coefficients[i] * coefficients[i];
+
+    // Every cosine term beyond the constant one widens the main lobe by a bin on each side:
+    size_t main_lobe_half_width = 1;
+
+    for (int i = 1; i < WINDOW_COEFFICIENTS_LENGTH; i++)
+        main_lobe_half_width += (coefficients[i] != 0.0f) ? 1 : 0;
+
+    window_properties->coherent_gain = coefficients[0];
+    window_properties->equivalent_noise_bandwidth = mean_square / (coefficients[0] * coefficients[0]);
+    window_properties->main_lobe_half_width = main_lobe_half_width;
+
+    return ESP_OK;
+}
+
+esp_err_t get_window_table(window_config_t window_config, size_t window_length, const float** window_table) {
+    // Check if the `window_table` pointer is valid:
+    if (window_table == NULL) {
+        ESP_LOGE(WINDOW_TRANSFORM_TAG, "The value of '%s' could not be 'NULL'!", "window_table");
+
+        return ESP_FAIL;
+    }
+
+    return cache_window_table(window_config, window_length, window_table);
+}
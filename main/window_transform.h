@@ -2,11 +2,18 @@
 #define WINDOW_TRANSFORM_H_
 
 #include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 #include "esp_dsp.h"
 
 #define WINDOW_TRANSFORM_TAG ("WINDOW_TRANSFORM_H_")
 
+#define WINDOW_COEFFICIENTS_LENGTH (5)
+#define WINDOW_CONFIGS_LENGTH (6)
+
 /// @brief This is a function pointer, that takes a pointer to a window together with the length.
 typedef void (*window_function)(float* window, int length);
 
@@ -20,6 +27,13 @@ typedef enum window_config {
     FLAT_TOP_WINDOW_F32
 } window_config_t;
 
+/// @brief Defining a struct called `window_properties`, that contains the spectral properties of a window function.
+typedef struct window_properties {
+    float coherent_gain;              // This field contains a `float` with the coherent gain (the mean value) of the window.
+    float equivalent_noise_bandwidth; // This field contains a `float` with the equivalent noise bandwidth of the window, expressed in bins.
+    size_t main_lobe_half_width;      // This field contains a `size_t` with the distance from the center of the main lobe to its first zero, expressed in bins.
+} window_properties_t;
+
 /// @brief This function applies a selected window function to a given window array.
 /// @param window A pointer to an array of floats that represents the window function to be applied.
 /// @param window_config An enum value representing the type of window function to be applied. The possible values are defined in the `window_config_t` enum.
@@ -27,4 +41,17 @@ typedef enum window_config {
 /// @return An `esp_err_t` type, which is either `ESP_OK` or `ESP_FAIL`.
 extern esp_err_t apply_window_function(float* window, window_config_t window_config, size_t window_length);
 
+/// @brief This function retrieves the spectral properties (coherent gain, noise bandwidth and main lobe width) of a selected window function.
+/// @param window_config An enum value representing the type of window function. The possible values are defined in the `window_config_t` enum.
+/// @param window_properties A pointer to a `window_properties_t` structure where the properties of the window will be stored.
+/// @return An `esp_err_t` type, which is either `ESP_OK` or `ESP_FAIL`.
+extern esp_err_t get_window_properties(window_config_t window_config, window_properties_t* window_properties);
+
+/// @brief This function retrieves a cached table of a window function, which is generated on first use (a table with the length of the generated tables in 'fft_tables.h' is used directly from flash). A cached table is never changed or freed, so it can be shared by multiple tasks.
+/// @param window_config An enum value representing the type of window function. The possible values are defined in the `window_config_t` enum.
+/// @param window_length The length of the window. Only a single length is cached per window function (the first one that is requested).
+/// @param window_table A pointer where a pointer to the cached table will be stored.
+/// @return An `esp_err_t` type, which is either `ESP_OK` or `ESP_FAIL` (also if a table with another length is cached, in which case the caller should generate the window itself).
+extern esp_err_t get_window_table(window_config_t window_config, size_t window_length, const float** window_table);
+
 #endif
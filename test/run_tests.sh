@@ -0,0 +1,61 @@
+#!/bin/sh
+# Builds and runs the host tests of the sources in 'main', against the replacements of ESP-IDF and `esp_dsp` in 'test/stubs'.
+# Usage: sh test/run_tests.sh [output directory]
+
+set -e
+
+TEST_DIRECTORY=$(cd "$(dirname "$0")" && pwd)
+MAIN_DIRECTORY="$TEST_DIRECTORY/../main"
+OUTPUT_DIRECTORY=${1:-"$TEST_DIRECTORY/../_host_tests"}
+
+CC=${CC:-gcc}
+CFLAGS="-std=gnu11 -O2 -Wall -Wno-unused-function -I$TEST_DIRECTORY -I$TEST_DIRECTORY/stubs -I$MAIN_DIRECTORY"
+STUBS="$TEST_DIRECTORY/stubs/esp_idf_host.c $TEST_DIRECTORY/stubs/esp_dsp_host.c"
+
+mkdir -p "$OUTPUT_DIRECTORY"
+
+FAILED_TESTS=""
+
+# Build and run a single test, with the sources of 'main' that it needs:
+run_test() {
+    NAME=$1
+    shift
+
+    echo "=== $NAME"
+
+    if $CC $CFLAGS "$@" $STUBS -lm -o "$OUTPUT_DIRECTORY/$NAME" && "$OUTPUT_DIRECTORY/$NAME"; then
+        :
+    else
+        FAILED_TESTS="$FAILED_TESTS $NAME"
+    fi
+}
+
+run_test test_spectrum_kernels "$TEST_DIRECTORY/test_spectrum_kernels.c" "$MAIN_DIRECTORY/spectrum_kernels.c" "$MAIN_DIRECTORY/window_transform.c"
+run_test test_replay_source "$TEST_DIRECTORY/test_replay_source.c" "$MAIN_DIRECTORY/replay_source.c" "$MAIN_DIRECTORY/sample_source.c"
+run_test test_replay_pipeline "$TEST_DIRECTORY/test_replay_pipeline.c" "$MAIN_DIRECTORY/replay_source.c" "$MAIN_DIRECTORY/sample_source.c" "$MAIN_DIRECTORY/fft_transform.c" "$MAIN_DIRECTORY/peak_detector.c" "$MAIN_DIRECTORY/spectrum_kernels.c" "$MAIN_DIRECTORY/window_transform.c" "$MAIN_DIRECTORY/trace_buffer.c"
+run_test test_display_communicator "$TEST_DIRECTORY/test_display_communicator.c" "$MAIN_DIRECTORY/display_communicator.c"
+run_test test_config_storage "$TEST_DIRECTORY/test_config_storage.c" "$MAIN_DIRECTORY/config_storage.c" "$TEST_DIRECTORY/stubs/nvs_host.c"
+run_test test_dac_communicator "$TEST_DIRECTORY/test_dac_communicator.c" "$MAIN_DIRECTORY/dac_communicator.c" "$MAIN_DIRECTORY/filter_transform.c" "$MAIN_DIRECTORY/window_transform.c" "$MAIN_DIRECTORY/trace_buffer.c"
+run_test test_fft_averaging "$TEST_DIRECTORY/test_fft_averaging.c" "$MAIN_DIRECTORY/fft_transform.c" "$MAIN_DIRECTORY/peak_detector.c" "$MAIN_DIRECTORY/spectrum_kernels.c" "$MAIN_DIRECTORY/window_transform.c" "$MAIN_DIRECTORY/trace_buffer.c"
+run_test test_peak_detector "$TEST_DIRECTORY/test_peak_detector.c" "$MAIN_DIRECTORY/fft_transform.c" "$MAIN_DIRECTORY/peak_detector.c" "$MAIN_DIRECTORY/spectrum_kernels.c" "$MAIN_DIRECTORY/window_transform.c" "$MAIN_DIRECTORY/trace_buffer.c"
+run_test test_correlation_transform "$TEST_DIRECTORY/test_correlation_transform.c" "$MAIN_DIRECTORY/correlation_transform.c" "$MAIN_DIRECTORY/fft_transform.c" "$MAIN_DIRECTORY/peak_detector.c" "$MAIN_DIRECTORY/spectrum_kernels.c" "$MAIN_DIRECTORY/window_transform.c" "$MAIN_DIRECTORY/trace_buffer.c"
+run_test test_quality_metrics "$TEST_DIRECTORY/test_quality_metrics.c" "$MAIN_DIRECTORY/quality_metrics.c" "$MAIN_DIRECTORY/fft_transform.c" "$MAIN_DIRECTORY/peak_detector.c" "$MAIN_DIRECTORY/spectrum_kernels.c" "$MAIN_DIRECTORY/window_transform.c" "$MAIN_DIRECTORY/trace_buffer.c"
+run_test test_filter_transform "$TEST_DIRECTORY/test_filter_transform.c" "$MAIN_DIRECTORY/filter_transform.c" "$MAIN_DIRECTORY/window_transform.c"
+run_test test_spectrum_stream "$TEST_DIRECTORY/test_spectrum_stream.c" "$MAIN_DIRECTORY/spectrum_stream.c"
+run_test test_trace_buffer "$TEST_DIRECTORY/test_trace_buffer.c" "$MAIN_DIRECTORY/trace_buffer.c"
+
+# Generate the FFT tables for `NUMBER_OF_SAMPLES`, like the build does (see 'main/CMakeLists.txt'), and check them against `esp_dsp`:
+FFT_STATIC_LENGTH=$(sed -n 's/^#define NUMBER_OF_SAMPLES (\([0-9]*\)).*$/\1/p' "$MAIN_DIRECTORY/http_server.h")
+
+if ${PYTHON:-python3} "$TEST_DIRECTORY/../tools/fft_tables/generate_fft_tables.py" --length "$FFT_STATIC_LENGTH" --output "$OUTPUT_DIRECTORY/fft_static_tables.c"; then
+    run_test test_fft_tables "-DFFT_STATIC_LENGTH=$FFT_STATIC_LENGTH" "$TEST_DIRECTORY/test_fft_tables.c" "$MAIN_DIRECTORY/fft_tables.c" "$OUTPUT_DIRECTORY/fft_static_tables.c" "$MAIN_DIRECTORY/window_transform.c"
+else
+    FAILED_TESTS="$FAILED_TESTS test_fft_tables"
+fi
+
+if [ -n "$FAILED_TESTS" ]; then
+    echo "Failed tests:$FAILED_TESTS"
+    exit 1
+fi
+
+echo "All host tests passed."
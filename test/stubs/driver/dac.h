@@ -0,0 +1,15 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use.
+
+#include "esp_err.h"
+
+typedef enum {
+    DAC_CHANNEL_1 = 0,
+    DAC_CHANNEL_2 = 1,
+    DAC_CHANNEL_MAX
+} dac_channel_t;
+
+esp_err_t dac_output_enable(dac_channel_t channel);
+esp_err_t dac_output_disable(dac_channel_t channel);
+esp_err_t dac_output_voltage(dac_channel_t channel, uint8_t dac_value);
@@ -0,0 +1,41 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use.
+
+#include "esp_log.h"
+#include <stdint.h>
+#define CONFIG_DSP_MAX_FFT_SIZE 4096
+esp_err_t dsps_fft2r_init_fc32(float* table, int size);
+void dsps_fft2r_deinit_fc32(void);
+esp_err_t dsps_fft2r_fc32(float* data, int N);
+esp_err_t dsps_bit_rev_fc32(float* data, int N);
+esp_err_t dsps_cplx2reC_fc32(float* data, int N);
+esp_err_t dsps_fft2r_fc32_ansi_(float *data, int N, float *w);
+#define dsps_fft2r_fc32_ansi(data, N) dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32)
+extern float* dsps_fft_w_table_fc32;
+esp_err_t dsps_bit_rev_lookup_fc32(float *data, int reverse_size, uint16_t *reverse_tab);
+esp_err_t dsps_gen_bitrev2r_table(int N, int step, char *name_ext);
+void dsps_view(const float* data, int32_t len, int width, int height, float min, float max, char view_char);
+void dsps_wind_hann_f32(float* window, int len);
+void dsps_wind_blackman_f32(float* window, int len);
+void dsps_wind_blackman_harris_f32(float* window, int len);
+void dsps_wind_blackman_nuttall_f32(float* window, int len);
+void dsps_wind_nuttall_f32(float* window, int len);
+void dsps_wind_flat_top_f32(float* window, int len);
+esp_err_t dsps_tone_gen_f32(float* output, int len, float Ampl, float freq, float phase);
+esp_err_t dsps_biquad_f32(const float* input, float* output, int len, float* coef, float* w);
+esp_err_t dsps_biquad_gen_lpf_f32(float* coeffs, float f, float qFactor);
+esp_err_t dsps_biquad_gen_hpf_f32(float* coeffs, float f, float qFactor);
+esp_err_t dsps_biquad_gen_bpf_f32(float* coeffs, float f, float qFactor);
+esp_err_t dsps_biquad_gen_notch_f32(float* coeffs, float f, float gain, float qFactor);
+esp_err_t dsps_mul_f32(const float* input1, const float* input2, float* output, int len, int step1, int step2, int step_out);
+esp_err_t dsps_mulc_f32(const float* input, float* output, int len, float C, int step_in, int step_out);
+esp_err_t dsps_add_f32(const float* input1, const float* input2, float* output, int len, int step1, int step2, int step_out);
+esp_err_t dsps_addc_f32(const float* input, float* output, int len, float C, int step_in, int step_out);
+esp_err_t dsps_sub_f32(const float* input1, const float* input2, float* output, int len, int step1, int step2, int step_out);
+esp_err_t dsps_dotprod_f32(const float* src1, const float* src2, float* dest, int len);
+typedef struct fir_f32_s { float* coeffs; float* delay; int N; int pos; int decim; int d_pos; int16_t use_delay; } fir_f32_t;
+esp_err_t dsps_fir_init_f32(fir_f32_t* fir, float* coeffs, float* delay, int N);
+esp_err_t dsps_fir_f32(fir_f32_t* fir, const float* input, float* output, int len);
+esp_err_t dsps_corr_f32(const float* Signal, const int siglen, const float* Pattern, const int patlen, float* dest);
+esp_err_t dsps_conv_f32(const float* Signal, const int siglen, const float* Kernel, const int kernlen, float* convout);
@@ -0,0 +1,292 @@
+// Host replacements of the `esp_dsp` functions that the sources in 'main' use. They follow the ANSI implementations of `esp_dsp` 1.4, so the tables and the outputs match those of the device (within the rounding of the host).
+
+#include <math.h>
+#include <string.h>
+
+#include "esp_dsp.h"
+
+#define HOST_DSP_MAXIMUM_FFT_SIZE (CONFIG_DSP_MAX_FFT_SIZE)
+
+static float host_fft_table[HOST_DSP_MAXIMUM_FFT_SIZE]; // The twiddles of `dsps_fft2r_init_fc32` (bit-reversed, like on the device).
+float* dsps_fft_w_table_fc32 = NULL;
+
+static void generate_cosine_sum_window(float* window, int len, const float* coefficients, int number_of_coefficients) {
+    float len_mult = 1.0f / (float)(len - 1);
+
+    for (int i = 0; i < len; i++) {
+        float value = 0.0f;
+
+        for (int k = 0; k < number_of_coefficients; k++)
+            value += ((k % 2 == 0) ? 1.0f : -1.0f) * coefficients[k] * cosf(i * 2 * k * M_PI * len_mult);
+
+        window[i] = value;
+    }
+}
+
+void dsps_wind_hann_f32(float* window, int len) {
+    generate_cosine_sum_window(window, len, (const float[]){0.5f, 0.5f}, 2);
+}
+
+void dsps_wind_blackman_f32(float* window, int len) {
+    generate_cosine_sum_window(window, len, (const float[]){0.42f, 0.5f, 0.08f}, 3);
+}
+
+void dsps_wind_blackman_harris_f32(float* window, int len) {
+    generate_cosine_sum_window(window, len, (const float[]){0.35875f, 0.48829f, 0.14128f, 0.01168f}, 4);
+}
+
+void dsps_wind_blackman_nuttall_f32(float* window, int len) {
+    generate_cosine_sum_window(window, len, (const float[]){0.3635819f, 0.4891775f, 0.1365995f, 0.0106411f}, 4);
+}
+
+void dsps_wind_nuttall_f32(float* window, int len) {
+    generate_cosine_sum_window(window, len, (const float[]){0.355768f, 0.487396f, 0.144232f, 0.012604f}, 4);
+}
+
+void dsps_wind_flat_top_f32(float* window, int len) {
+    generate_cosine_sum_window(window, len, (const float[]){1.0f, 1.93f, 1.29f, 0.388f, 0.028f}, 5);
+}
+
+esp_err_t dsps_bit_rev_fc32(float* data, int N) {
+    int j = 0;
+
+    for (int i = 1; i < (N - 1); i++) {
+        int k = N >> 1;
+
+        while (k <= j) {
+            j -= k;
+            k >>= 1;
+        }
+
+        j += k;
+
+        if (i < j) {
+            float temp = data[j * 2 + 0];
+
+            data[j * 2 + 0] = data[i * 2 + 0];
+            data[i * 2 + 0] = temp;
+
+            temp = data[j * 2 + 1];
+            data[j * 2 + 1] = data[i * 2 + 1];
+            data[i * 2 + 1] = temp;
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_init_fc32(float* table, int size) {
+    if (size > HOST_DSP_MAXIMUM_FFT_SIZE || (size & (size - 1)) != 0)
+        return ESP_ERR_INVALID_ARG;
+
+    dsps_fft_w_table_fc32 = (table != NULL) ? table : host_fft_table;
+
+    // Generate the factors of the first half of the circle, and put them in bit-reversed order (like `dsps_gen_w_r2_fc32` and the initialization of `esp_dsp`):
+    float e = M_PI * 2.0 / size;
+
+    for (int i = 0; i < (size >> 1); i++) {
+        dsps_fft_w_table_fc32[2 * i + 0] = cosf(i * e);
+        dsps_fft_w_table_fc32[2 * i + 1] = sinf(i * e);
+    }
+
+    return dsps_bit_rev_fc32(dsps_fft_w_table_fc32, size >> 1);
+}
+
+void dsps_fft2r_deinit_fc32(void) {
+    dsps_fft_w_table_fc32 = NULL;
+}
+
+esp_err_t dsps_fft2r_fc32_ansi_(float* data, int N, float* w) {
+    if (w == NULL)
+        return ESP_ERR_INVALID_STATE;
+
+    int ie = 1;
+
+    for (int N2 = N / 2; N2 > 0; N2 >>= 1) {
+        int ia = 0;
+
+        for (int j = 0; j < ie; j++) {
+            float c = w[2 * j + 0];
+            float s = w[2 * j + 1];
+
+            for (int i = 0; i < N2; i++) {
+                int m = ia + N2;
+
+                float re_temp = c * data[2 * m + 0] + s * data[2 * m + 1];
+                float im_temp = c * data[2 * m + 1] - s * data[2 * m + 0];
+
+                data[2 * m + 0] = data[2 * ia + 0] - re_temp;
+                data[2 * m + 1] = data[2 * ia + 1] - im_temp;
+                data[2 * ia + 0] = data[2 * ia + 0] + re_temp;
+                data[2 * ia + 1] = data[2 * ia + 1] + im_temp;
+
+                ia++;
+            }
+
+            ia += N2;
+        }
+
+        ie <<= 1;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_fft2r_fc32(float* data, int N) {
+    return dsps_fft2r_fc32_ansi_(data, N, dsps_fft_w_table_fc32);
+}
+
+esp_err_t dsps_cplx2reC_fc32(float* data, int N) {
+    int n2 = N << 1;
+
+    // Split the spectra of the real and the imaginary input, without the factor 1/2 (so the bins above DC are doubled, like on the device):
+    for (int i = 0; i < N / 4; i++) {
+        float rkl = data[i * 2 + 0 + 2];
+        float ikl = data[i * 2 + 1 + 2];
+        float rnl = data[n2 - i * 2 - 2];
+        float inl = data[n2 - i * 2 - 1];
+
+        float rkh = data[i * 2 + 0 + 2 + N];
+        float ikh = data[i * 2 + 1 + 2 + N];
+        float rnh = data[n2 - i * 2 - 2 - N];
+        float inh = data[n2 - i * 2 - 1 - N];
+
+        data[i * 2 + 0 + 2] = rkl + rnl;
+        data[i * 2 + 1 + 2] = ikl - inl;
+
+        data[n2 - i * 2 - 1 - N] = inh - ikh;
+        data[n2 - i * 2 - 2 - N] = rkh + rnh;
+
+        data[i * 2 + 0 + 2 + N] = ikl + inl;
+        data[i * 2 + 1 + 2 + N] = rnl - rkl;
+
+        data[n2 - i * 2 - 1] = rkh - rnh;
+        data[n2 - i * 2 - 2] = ikh + inh;
+    }
+
+    data[N] = data[1];
+    data[1] = 0;
+    data[N + 1] = 0;
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_biquad_f32(const float* input, float* output, int len, float* coef, float* w) {
+    for (int i = 0; i < len; i++) {
+        float d0 = input[i] - coef[3] * w[0] - coef[4] * w[1];
+
+        output[i] = coef[0] * d0 + coef[1] * w[0] + coef[2] * w[1];
+        w[1] = w[0];
+        w[0] = d0;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_biquad_gen_lpf_f32(float* coeffs, float f, float qFactor) {
+    if (qFactor <= 0.0001f)
+        qFactor = 0.0001f;
+
+    float w0 = 2 * M_PI * f;
+    float c = cosf(w0);
+    float s = sinf(w0);
+    float alpha = s / (2 * qFactor);
+
+    float b0 = (1 - c) / 2;
+    float b1 = 1 - c;
+    float b2 = b0;
+    float a0 = 1 + alpha;
+    float a1 = -2 * c;
+    float a2 = 1 - alpha;
+
+    coeffs[0] = b0 / a0;
+    coeffs[1] = b1 / a0;
+    coeffs[2] = b2 / a0;
+    coeffs[3] = a1 / a0;
+    coeffs[4] = a2 / a0;
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_biquad_gen_hpf_f32(float* coeffs, float f, float qFactor) {
+    if (qFactor <= 0.0001f)
+        qFactor = 0.0001f;
+
+    float w0 = 2 * M_PI * f;
+    float c = cosf(w0);
+    float s = sinf(w0);
+    float alpha = s / (2 * qFactor);
+
+    float b0 = (1 + c) / 2;
+    float b1 = -(1 + c);
+    float b2 = b0;
+    float a0 = 1 + alpha;
+    float a1 = -2 * c;
+    float a2 = 1 - alpha;
+
+    coeffs[0] = b0 / a0;
+    coeffs[1] = b1 / a0;
+    coeffs[2] = b2 / a0;
+    coeffs[3] = a1 / a0;
+    coeffs[4] = a2 / a0;
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_fir_init_f32(fir_f32_t* fir, float* coeffs, float* delay, int N) {
+    fir->coeffs = coeffs;
+    fir->delay = delay;
+    fir->N = N;
+    fir->pos = 0;
+
+    memset(delay, 0, N * sizeof(float));
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_fir_f32(fir_f32_t* fir, const float* input, float* output, int len) {
+    for (int i = 0; i < len; i++) {
+        float acc = 0;
+        int coeff_pos = fir->N - 1;
+
+        fir->delay[fir->pos] = input[i];
+        fir->pos++;
+
+        if (fir->pos >= fir->N)
+            fir->pos = 0;
+
+        for (int n = fir->pos; n < fir->N; n++)
+            acc += fir->coeffs[coeff_pos--] * fir->delay[n];
+
+        for (int n = 0; n < fir->pos; n++)
+            acc += fir->coeffs[coeff_pos--] * fir->delay[n];
+
+        output[i] = acc;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dsps_tone_gen_f32(float* output, int len, float Ampl, float freq, float phase) {
+    if (freq >= 1.0f || freq <= -1.0f)
+        return ESP_ERR_INVALID_ARG;
+
+    float ph = phase / 180.0f;
+    float fr = 2 * freq;
+
+    for (int i = 0; i < len; i++) {
+        output[i] = Ampl * sinf(ph * M_PI);
+        ph += fr;
+
+        if (ph > 2)
+            ph -= 2;
+
+        if (ph < -2)
+            ph += 2;
+    }
+
+    return ESP_OK;
+}
+
+void dsps_view(const float* data, int32_t len, int width, int height, float min, float max, char view_char) {
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK (0)
+#define ESP_FAIL (-1)
+#define ESP_ERR_NO_MEM (0x101)
+#define ESP_ERR_INVALID_ARG (0x102)
+#define ESP_ERR_INVALID_STATE (0x103)
+#define ESP_ERR_INVALID_SIZE (0x104)
+#define ESP_ERR_NOT_FOUND (0x105)
+#define ESP_ERR_NOT_SUPPORTED (0x106)
+#define ESP_ERR_TIMEOUT (0x107)
+
+const char* esp_err_to_name(esp_err_t code);
+
+// Abort like on the device, so a failing check fails the test:
+#define ESP_ERROR_CHECK(x) do {                                                                        \
+        esp_err_t error_code = (x);                                                                    \
+                                                                                                       \
+        if (error_code != ESP_OK) {                                                                    \
+            fprintf(stderr, "ESP_ERROR_CHECK failed: '%s' at %s:%d\n", #x, __FILE__, __LINE__);        \
+            abort();                                                                                   \
+        }                                                                                              \
+    } while (0)
+
+#define ESP_ERROR_CHECK_WITHOUT_ABORT(x) (x)
@@ -0,0 +1,12 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use.
+
+#include "esp_err.h"
+typedef void* httpd_handle_t;
+typedef enum { HTTPD_WS_TYPE_CONTINUE = 0, HTTPD_WS_TYPE_TEXT = 1, HTTPD_WS_TYPE_BINARY = 2, HTTPD_WS_TYPE_CLOSE = 8, HTTPD_WS_TYPE_PING = 9, HTTPD_WS_TYPE_PONG = 10 } httpd_ws_type_t;
+typedef struct { bool final; bool fragmented; httpd_ws_type_t type; uint8_t* payload; size_t len; } httpd_ws_frame_t;
+typedef void (*transfer_complete_cb)(esp_err_t, int, void*);
+esp_err_t httpd_ws_send_data_async(httpd_handle_t, int, httpd_ws_frame_t*, transfer_complete_cb, void*);
+typedef enum { HTTPD_WS_CLIENT_INVALID = 0, HTTPD_WS_CLIENT_HTTP = 1, HTTPD_WS_CLIENT_WEBSOCKET = 2 } httpd_ws_client_info_t;
+httpd_ws_client_info_t httpd_ws_get_fd_info(httpd_handle_t, int);
@@ -0,0 +1,60 @@
+// Host replacements of the ESP-IDF and FreeRTOS functions that the sources in 'main' use. The tests run in a single thread, so the locks only count their use.
+
+#include <time.h>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+static int host_mutex = 0; // Every mutex handle points here (a handle only has to be non-`NULL`).
+
+const char* esp_err_to_name(esp_err_t code) {
+    return (code == ESP_OK) ? "ESP_OK" : "ESP_FAIL";
+}
+
+int64_t esp_timer_get_time(void) {
+    struct timespec now = {};
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return &host_mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+}
+
+void portENTER_CRITICAL(portMUX_TYPE* mux) {
+}
+
+void portEXIT_CRITICAL(portMUX_TYPE* mux) {
+}
+
+void portENTER_CRITICAL_ISR(portMUX_TYPE* mux) {
+}
+
+void portEXIT_CRITICAL_ISR(portMUX_TYPE* mux) {
+}
+
+void vTaskDelay(TickType_t ticks) {
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_depth, void* parameters, UBaseType_t priority, TaskHandle_t* created_task) {
+    return pdPASS; // The tasks are not started on the host, the tests call the code of a task directly.
+}
+
+void vTaskDelete(TaskHandle_t task) {
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use.
+
+#include <stdint.h>
+#include <stddef.h>
+typedef uint32_t TickType_t; typedef int BaseType_t; typedef unsigned UBaseType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xffffffff
+#define pdMS_TO_TICKS(x) (x)
+#define tskNO_AFFINITY 0x7fffffff
+typedef struct { int x; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+void portENTER_CRITICAL(portMUX_TYPE*); void portEXIT_CRITICAL(portMUX_TYPE*);
+void portENTER_CRITICAL_ISR(portMUX_TYPE*); void portEXIT_CRITICAL_ISR(portMUX_TYPE*);
+#define IRAM_ATTR
@@ -0,0 +1,10 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use.
+
+#include "FreeRTOS.h"
+typedef void* TaskHandle_t; typedef void (*TaskFunction_t)(void*);
+BaseType_t xTaskCreate(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t, TaskHandle_t*);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t, TaskHandle_t*, BaseType_t);
+void vTaskDelay(TickType_t); void vTaskDelete(TaskHandle_t);
+#define tskIDLE_PRIORITY 0
@@ -0,0 +1,26 @@
+#pragma once
+
+// A host replacement of the ESP-IDF header, with only what the sources in 'main' use. The blobs are kept in memory by 'nvs_host.c', which counts the writes for the tests.
+
+#include "esp_err.h"
+
+#define ESP_ERR_NVS_NOT_FOUND (0x1102)
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE
+} nvs_open_mode_t;
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t* out_handle);
+void nvs_close(nvs_handle_t handle);
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length);
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length);
+esp_err_t nvs_commit(nvs_handle_t handle);
+
+extern size_t nvs_host_write_count;  // The number of blobs that were written since the start (or the last `nvs_host_erase`).
+extern size_t nvs_host_commit_count; // The number of commits since the start (or the last `nvs_host_erase`).
+
+/// @brief This function erases all the blobs of the host NVS, and resets its counters.
+void nvs_host_erase(void);
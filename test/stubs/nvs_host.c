@@ -0,0 +1,106 @@
+// A host replacement of NVS, that keeps a few blobs in memory (in a single namespace).
+
+#include <string.h>
+
+#include "nvs.h"
+
+#define NVS_HOST_MAXIMUM_BLOBS (8)
+#define NVS_HOST_MAXIMUM_KEY_LENGTH (16)
+
+typedef struct nvs_host_blob {
+    char key[NVS_HOST_MAXIMUM_KEY_LENGTH];
+    void* value;
+    size_t length;
+} nvs_host_blob_t;
+
+static nvs_host_blob_t nvs_host_blobs[NVS_HOST_MAXIMUM_BLOBS] = {};
+static size_t nvs_host_blob_count = 0;
+
+size_t nvs_host_write_count = 0;
+size_t nvs_host_commit_count = 0;
+
+static nvs_host_blob_t* find_blob(const char* key) {
+    for (size_t i = 0; i < nvs_host_blob_count; i++) {
+        if (strcmp(nvs_host_blobs[i].key, key) == 0)
+            return &nvs_host_blobs[i];
+    }
+
+    return NULL;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t* out_handle) {
+    // Like on the device, a namespace can only be opened for reading after something was written to it:
+    if (open_mode == NVS_READONLY && nvs_host_blob_count == 0)
+        return ESP_ERR_NVS_NOT_FOUND;
+
+    *out_handle = 1;
+
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    nvs_host_blob_t* blob = find_blob(key);
+
+    if (blob == NULL) {
+        if (nvs_host_blob_count == NVS_HOST_MAXIMUM_BLOBS || strlen(key) >= NVS_HOST_MAXIMUM_KEY_LENGTH)
+            return ESP_ERR_NO_MEM;
+
+        blob = &nvs_host_blobs[nvs_host_blob_count++];
+
+        strcpy(blob->key, key);
+    }
+
+    free(blob->value);
+
+    blob->value = malloc(length);
+    blob->length = length;
+
+    memcpy(blob->value, value, length);
+
+    nvs_host_write_count++;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length) {
+    nvs_host_blob_t* blob = find_blob(key);
+
+    if (blob == NULL)
+        return ESP_ERR_NVS_NOT_FOUND;
+
+    // Without a buffer, only the length of the blob is returned:
+    if (out_value == NULL) {
+        *length = blob->length;
+
+        return ESP_OK;
+    }
+
+    if (*length < blob->length)
+        return ESP_ERR_INVALID_SIZE;
+
+    memcpy(out_value, blob->value, blob->length);
+
+    *length = blob->length;
+
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    nvs_host_commit_count++;
+
+    return ESP_OK;
+}
+
+void nvs_host_erase(void) {
+    for (size_t i = 0; i < nvs_host_blob_count; i++)
+        free(nvs_host_blobs[i].value);
+
+    memset(nvs_host_blobs, 0, sizeof(nvs_host_blobs));
+
+    nvs_host_blob_count = 0;
+    nvs_host_write_count = 0;
+    nvs_host_commit_count = 0;
+}
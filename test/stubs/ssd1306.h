@@ -0,0 +1,30 @@
+#pragma once
+
+// A host replacement of the SSD1306 component header, with only what the sources in 'main' use. The tests implement the functions, so they can inspect what is drawn.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define CONFIG_SDA_GPIO (1)
+#define CONFIG_SCL_GPIO (2)
+#define CONFIG_RESET_GPIO (3)
+
+typedef struct {
+    int _width;
+    int _height;
+} SSD1306_t;
+
+void i2c_master_init(SSD1306_t* dev, int16_t sda, int16_t scl, int16_t reset);
+void ssd1306_init(SSD1306_t* dev, int width, int height);
+void ssd1306_clear_screen(SSD1306_t* dev, bool invert);
+void ssd1306_contrast(SSD1306_t* dev, int contrast);
+void ssd1306_display_text(SSD1306_t* dev, int page, char* text, int text_len, bool invert);
+void ssd1306_display_text_x3(SSD1306_t* dev, int page, char* text, int text_len, bool invert);
+void ssd1306_display_text_cursor(SSD1306_t* dev, int y, int x, char* text, int text_len, bool invert);
+void ssd1306_line(SSD1306_t* dev, int x1, int y1, int x2, int y2, bool invert);
+void ssd1306_pixel(SSD1306_t* dev, int xpos, int ypos, bool invert);
+int ssd1306_get_width(SSD1306_t* dev);
+int ssd1306_get_height(SSD1306_t* dev);
+
+char* itoa(int value, char* buffer, int base); // Part of the C library of the ESP-IDF (newlib), but not of glibc.
@@ -0,0 +1,179 @@
+// Checks that the configuration is only written to NVS when it, or its DAC values, changed.
+
+#include "config_storage.h"
+#include "test_utilities.h"
+
+#define TEST_DAC_VALUES_LENGTH (16)
+
+static uint8_t test_dac_values[TEST_DAC_VALUES_LENGTH] = {};
+
+static stored_config_t create_config(void) {
+    stored_config_t stored_config;
+
+    memset(&stored_config, 0, sizeof(stored_config)); // Clear the padding, like `save_program_data`.
+
+    stored_config.sample_frequency = 1000;
+    stored_config.number_of_waves = 1;
+    stored_config.waves[0].amplitude = 1.0f;
+    stored_config.waves[0].frequency = 50.0f;
+    stored_config.window = BLACKMAN_WINDOW_F32;
+    stored_config.dac_is_enabled = true;
+    stored_config.dac_interpolation_factor = 1;
+    stored_config.dac_channels = DAC_OUTPUT_CHANNEL_1;
+
+    return stored_config;
+}
+
+static void test_unchanged_config_is_not_written(void) {
+    nvs_host_erase();
+
+    stored_config_t stored_config = create_config();
+
+    TEST_CHECK(save_stored_config(&stored_config, NULL) == ESP_OK);
+    TEST_CHECK(nvs_host_commit_count == 1);
+
+    // Save the same configuration again, as every request does:
+    TEST_CHECK(save_stored_config(&stored_config, NULL) == ESP_OK);
+    TEST_CHECK(nvs_host_commit_count == 1);
+
+    // A changed setting is written:
+    stored_config.waves[0].frequency = 60.0f;
+
+    TEST_CHECK(save_stored_config(&stored_config, NULL) == ESP_OK);
+    TEST_CHECK(nvs_host_commit_count == 2);
+}
+
+static void test_changed_dac_values_are_written(void) {
+    nvs_host_erase();
+
+    stored_config_t stored_config = create_config();
+
+    stored_config.dac_values_length = TEST_DAC_VALUES_LENGTH;
+
+    for (size_t i = 0; i < TEST_DAC_VALUES_LENGTH; i++)
+        test_dac_values[i] = (uint8_t)(i * 16);
+
+    TEST_CHECK(save_stored_config(&stored_config, test_dac_values) == ESP_OK);
+    TEST_CHECK(nvs_host_write_count == 2); // The DAC values and the configuration.
+
+    TEST_CHECK(save_stored_config(&stored_config, test_dac_values) == ESP_OK);
+    TEST_CHECK(nvs_host_write_count == 2);
+
+    // Without DAC values, the stored DAC values are kept, so nothing changed:
+    stored_config.dac_values_length = 0;
+
+    TEST_CHECK(save_stored_config(&stored_config, NULL) == ESP_OK);
+    TEST_CHECK(nvs_host_write_count == 2);
+
+    // Other DAC values with the same settings (for example after a change of the filter) are written:
+    stored_config.dac_values_length = TEST_DAC_VALUES_LENGTH;
+    test_dac_values[3] ^= 0xFF;
+
+    TEST_CHECK(save_stored_config(&stored_config, test_dac_values) == ESP_OK);
+    TEST_CHECK(nvs_host_write_count == 4); // The DAC values and the configuration.
+}
+
+static void test_restored_config_is_not_written(void) {
+    nvs_host_erase();
+
+    stored_config_t stored_config = create_config();
+
+    stored_config.sample_frequency = 2000; // Differs from the configuration of the previous test, which the storage still remembers as stored.
+    stored_config.dac_values_length = TEST_DAC_VALUES_LENGTH;
+
+    TEST_CHECK(save_stored_config(&stored_config, test_dac_values) == ESP_OK);
+
+    // Load the configuration, like after a reboot:
+    stored_config_t loaded_config = {};
+    uint8_t loaded_dac_values[TEST_DAC_VALUES_LENGTH] = {};
+
+    TEST_CHECK(load_stored_config(&loaded_config, loaded_dac_values, TEST_DAC_VALUES_LENGTH) == ESP_OK);
+    TEST_CHECK(loaded_config.dac_values_length == TEST_DAC_VALUES_LENGTH);
+    TEST_CHECK(memcmp(loaded_dac_values, test_dac_values, TEST_DAC_VALUES_LENGTH) == 0);
+
+    size_t write_count = nvs_host_write_count;
+
+    // Saving the restored configuration does not write it again:
+    TEST_CHECK(save_stored_config(&stored_config, loaded_dac_values) == ESP_OK);
+    TEST_CHECK(nvs_host_write_count == write_count);
+
+    // An empty NVS has no configuration:
+    nvs_host_erase();
+
+    TEST_CHECK(load_stored_config(&loaded_config, loaded_dac_values, TEST_DAC_VALUES_LENGTH) == ESP_ERR_NOT_FOUND);
+}
+
+/// @brief Stores a configuration with a changed setting, and returns what loading it again returns.
+static esp_err_t load_changed_config(void (*change_setting)(stored_config_t*)) {
+    nvs_host_erase();
+
+    stored_config_t stored_config = create_config();
+
+    stored_config.sample_frequency = 3000; // Differs from the configuration that the storage remembers, so it is written.
+
+    change_setting(&stored_config);
+
+    TEST_CHECK(save_stored_config(&stored_config, NULL) == ESP_OK);
+
+    stored_config_t loaded_config = {};
+
+    return load_stored_config(&loaded_config, NULL, 0);
+}
+
+static void keep_settings(stored_config_t* stored_config) {
+}
+
+static void set_too_many_waves(stored_config_t* stored_config) {
+    stored_config->number_of_waves = MAXIMUM_STORED_WAVES + 1;
+}
+
+static void set_too_many_second_channel_waves(stored_config_t* stored_config) {
+    stored_config->number_of_second_channel_waves = 0x10000;
+}
+
+static void set_unknown_window(stored_config_t* stored_config) {
+    stored_config->window = WINDOW_CONFIGS_LENGTH;
+}
+
+static void set_zero_interpolation_factor(stored_config_t* stored_config) {
+    stored_config->dac_interpolation_factor = 0;
+}
+
+static void set_too_high_interpolation_factor(stored_config_t* stored_config) {
+    stored_config->dac_interpolation_factor = DAC_MAXIMUM_INTERPOLATION_FACTOR + 1;
+}
+
+static void set_no_channels(stored_config_t* stored_config) {
+    stored_config->dac_channels = 0;
+}
+
+static void set_unknown_channels(stored_config_t* stored_config) {
+    stored_config->dac_channels = 0x04;
+}
+
+static void set_unknown_swap_mode(stored_config_t* stored_config) {
+    stored_config->dac_swap_mode = DAC_SWAP_AT_PERIOD + 1;
+}
+
+static void test_invalid_config_is_ignored(void) {
+    TEST_CHECK(load_changed_config(keep_settings) == ESP_OK);
+
+    // A corrupt or foreign configuration is ignored as a whole, instead of overflowing the waves or stopping the DAC from starting:
+    TEST_CHECK(load_changed_config(set_too_many_waves) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_too_many_second_channel_waves) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_unknown_window) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_zero_interpolation_factor) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_too_high_interpolation_factor) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_no_channels) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_unknown_channels) == ESP_ERR_NOT_FOUND);
+    TEST_CHECK(load_changed_config(set_unknown_swap_mode) == ESP_ERR_NOT_FOUND);
+}
+
+int main(void) {
+    test_unchanged_config_is_not_written();
+    test_changed_dac_values_are_written();
+    test_restored_config_is_not_written();
+    test_invalid_config_is_ignored();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,157 @@
+// Checks the correlation and convolution with a reference against a direct sum, in a single block and streamed in chunks with overlap-add and overlap-save.
+
+#include "correlation_transform.h"
+#include "test_utilities.h"
+
+#define TEST_SIGNAL_LENGTH (700)
+#define TEST_REFERENCE_LENGTH (50)
+#define TEST_OUTPUT_LENGTH (TEST_SIGNAL_LENGTH + TEST_REFERENCE_LENGTH - 1)
+#define TEST_MAXIMUM_RELATIVE_ERROR (5e-7)
+
+trace_buffer_t trace_buffer = {};
+
+// The spectrum is not shown, so the display is not needed on the host:
+esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t sample_data_length, size_t sample_frequency, float y_min_magnitude_scale, float y_max_magnitude_scale) {
+    return ESP_FAIL;
+}
+
+static float test_signal[TEST_SIGNAL_LENGTH] = {};
+static float test_reference[TEST_REFERENCE_LENGTH] = {};
+static float test_output[TEST_OUTPUT_LENGTH] = {};
+static double test_expected_output[TEST_OUTPUT_LENGTH] = {};
+
+/// @brief Fills an array with uniform noise between -1 and 1, from a fixed seed.
+static void generate_noise(float* samples, size_t sample_length, uint32_t seed) {
+    for (size_t i = 0; i < sample_length; i++) {
+        seed = seed * 1664525u + 1013904223u;
+
+        samples[i] = (float)(seed >> 8) / (float)(1 << 23) - 1.0f;
+    }
+}
+
+/// @brief Computes the full linear result with a direct sum, where output `i` is the lag `i - (reference_length - 1)` of a cross-correlation (or the sample `i` of a convolution).
+static void compute_direct_output(correlation_mode_t mode) {
+    for (int i = 0; i < TEST_OUTPUT_LENGTH; i++) {
+        double sum = 0.0;
+
+        for (int k = 0; k < TEST_REFERENCE_LENGTH; k++) {
+            // A cross-correlation `sum(x[n + l] * r[n])` at lag `l = i - (R - 1)`, or a convolution `sum(x[i - k] * r[k])`:
+            int n = (mode == CROSS_CORRELATION) ? i - (TEST_REFERENCE_LENGTH - 1) + k : i - k;
+
+            if (n >= 0 && n < TEST_SIGNAL_LENGTH)
+                sum += (double)test_signal[n] * test_reference[k];
+        }
+
+        test_expected_output[i] = sum;
+    }
+}
+
+/// @brief Returns the error of the output relative to the direct sum (in the root-mean-square sense over the whole result).
+static double get_relative_error(void) {
+    double error_energy = 0.0;
+    double energy = 0.0;
+
+    for (size_t i = 0; i < TEST_OUTPUT_LENGTH; i++) {
+        error_energy += (test_output[i] - test_expected_output[i]) * (test_output[i] - test_expected_output[i]);
+        energy += test_expected_output[i] * test_expected_output[i];
+    }
+
+    return sqrt(error_energy / energy);
+}
+
+static void test_single_block(void) {
+    const correlation_mode_t modes[] = {CROSS_CORRELATION, CONVOLUTION};
+
+    for (size_t i = 0; i < 2; i++) {
+        correlation_kernel_t kernel = {};
+
+        compute_direct_output(modes[i]);
+
+        TEST_CHECK(prepare_correlation_kernel(&kernel, test_reference, TEST_REFERENCE_LENGTH, modes[i], get_correlation_fft_length(TEST_OUTPUT_LENGTH)) == ESP_OK);
+        TEST_CHECK(apply_correlation_f32(&kernel, test_signal, TEST_SIGNAL_LENGTH, test_output) == ESP_OK);
+        TEST_CHECK_NEAR(get_relative_error(), 0.0, TEST_MAXIMUM_RELATIVE_ERROR);
+
+        // A signal whose result does not fit in the FFT has to be streamed instead:
+        TEST_CHECK(apply_correlation_f32(&kernel, test_signal, kernel.fft_length, test_output) == ESP_FAIL);
+        TEST_CHECK(free_correlation_kernel(&kernel) == ESP_OK);
+    }
+}
+
+static void test_streamed_chunks(void) {
+    const correlation_mode_t modes[] = {CROSS_CORRELATION, CONVOLUTION};
+    const correlation_method_t methods[] = {OVERLAP_ADD_CORRELATION, OVERLAP_SAVE_CORRELATION};
+    const size_t chunk_lengths[] = {1, 37, TEST_SIGNAL_LENGTH}; // A single sample, a length that splits the blocks unevenly, and the whole signal (several blocks in one call).
+
+    float zeros[TEST_REFERENCE_LENGTH - 1] = {};
+
+    for (size_t i = 0; i < 2; i++) {
+        correlation_kernel_t kernel = {};
+
+        compute_direct_output(modes[i]);
+
+        // A streaming FFT (of 4 times the reference), which is much shorter than the signal:
+        TEST_CHECK(prepare_correlation_kernel(&kernel, test_reference, TEST_REFERENCE_LENGTH, modes[i], 0) == ESP_OK);
+        TEST_CHECK(kernel.block_length < TEST_SIGNAL_LENGTH);
+
+        for (size_t j = 0; j < 2; j++) {
+            for (size_t k = 0; k < sizeof(chunk_lengths) / sizeof(chunk_lengths[0]); k++) {
+                TEST_CHECK(reset_correlation_stream(&kernel) == ESP_OK);
+
+                memset(test_output, 0, sizeof(test_output));
+
+                for (size_t offset = 0; offset < TEST_SIGNAL_LENGTH; offset += chunk_lengths[k]) {
+                    size_t chunk_length = (offset + chunk_lengths[k] <= TEST_SIGNAL_LENGTH) ? chunk_lengths[k] : TEST_SIGNAL_LENGTH - offset;
+
+                    TEST_CHECK(stream_correlation_f32(&kernel, methods[j], &test_signal[offset], chunk_length, &test_output[offset]) == ESP_OK);
+                }
+
+                // Feeding zeros flushes the last lags:
+                TEST_CHECK(stream_correlation_f32(&kernel, methods[j], zeros, TEST_REFERENCE_LENGTH - 1, &test_output[TEST_SIGNAL_LENGTH]) == ESP_OK);
+                TEST_CHECK_NEAR(get_relative_error(), 0.0, TEST_MAXIMUM_RELATIVE_ERROR);
+            }
+        }
+
+        TEST_CHECK(stream_correlation_f32(&kernel, SINGLE_BLOCK_CORRELATION, test_signal, TEST_SIGNAL_LENGTH, test_output) == ESP_FAIL);
+        TEST_CHECK(free_correlation_kernel(&kernel) == ESP_OK);
+    }
+}
+
+static void test_peak_of_a_fractional_delay(void) {
+    const double delay = 123.3;
+    const double center = TEST_REFERENCE_LENGTH / 2.0;
+    const double width = 8.0;
+
+    // A smooth pulse as reference, and the same pulse delayed by a fractional number of samples as signal:
+    for (size_t i = 0; i < TEST_REFERENCE_LENGTH; i++)
+        test_reference[i] = (float)exp(-pow((i - center) / width, 2.0));
+
+    for (size_t i = 0; i < TEST_SIGNAL_LENGTH; i++)
+        test_signal[i] = (float)exp(-pow((i - center - delay) / width, 2.0));
+
+    correlation_kernel_t kernel = {};
+    correlation_peak_t peak = {};
+
+    TEST_CHECK(prepare_correlation_kernel(&kernel, test_reference, TEST_REFERENCE_LENGTH, CROSS_CORRELATION, get_correlation_fft_length(TEST_OUTPUT_LENGTH)) == ESP_OK);
+    TEST_CHECK(apply_correlation_f32(&kernel, test_signal, TEST_SIGNAL_LENGTH, test_output) == ESP_OK);
+    TEST_CHECK(find_correlation_peak_f32(test_output, TEST_OUTPUT_LENGTH, -(TEST_REFERENCE_LENGTH - 1), &peak) == ESP_OK);
+
+    TEST_CHECK(peak.index == 123 + TEST_REFERENCE_LENGTH - 1);
+    TEST_CHECK_NEAR(peak.lag, delay, 0.02);
+
+    // A perfect (delayed) match has a normalized peak of one:
+    TEST_CHECK(normalize_correlation_peak_f32(&peak, test_signal, TEST_SIGNAL_LENGTH, test_reference, TEST_REFERENCE_LENGTH) == ESP_OK);
+    TEST_CHECK_NEAR(peak.normalized_value, 1.0, 0.01);
+
+    TEST_CHECK(free_correlation_kernel(&kernel) == ESP_OK);
+}
+
+int main(void) {
+    generate_noise(test_signal, TEST_SIGNAL_LENGTH, 1);
+    generate_noise(test_reference, TEST_REFERENCE_LENGTH, 2);
+
+    test_single_block();
+    test_streamed_chunks();
+    test_peak_of_a_fractional_delay();
+
+    TEST_FINISH();
+}
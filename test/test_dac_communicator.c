@@ -0,0 +1,147 @@
+// Checks the spectrum of what the DAC timer outputs against the spectrum of the ideal (continuous) wave, with and without the interpolator.
+
+#include "dac_communicator.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (256)
+#define TEST_SAMPLE_FREQUENCY (2000) // Low enough for the timer at the highest interpolation factor.
+#define TEST_TONE_BIN (32) // The tone completes 32 periods in the samples, that is 250 Hz.
+#define TEST_AMPLITUDE (1.0f)
+#define TEST_OFFSET (1.65f)
+#define TEST_MAXIMUM_OUTPUT_LENGTH (TEST_NUMBER_OF_SAMPLES * DAC_MAXIMUM_INTERPOLATION_FACTOR)
+
+dac_data_t dac_data = {};
+trace_buffer_t trace_buffer = {};
+
+static uint8_t test_output[DAC_NUMBER_OF_CHANNELS][TEST_MAXIMUM_OUTPUT_LENGTH] = {}; // The values that the timer wrote to every channel.
+static size_t test_output_length[DAC_NUMBER_OF_CHANNELS] = {};
+
+esp_err_t dac_output_enable(dac_channel_t channel) {
+    return ESP_OK;
+}
+
+esp_err_t dac_output_disable(dac_channel_t channel) {
+    return ESP_OK;
+}
+
+esp_err_t dac_output_voltage(dac_channel_t channel, uint8_t dac_value) {
+    if (test_output_length[channel] < TEST_MAXIMUM_OUTPUT_LENGTH)
+        test_output[channel][test_output_length[channel]++] = dac_value;
+
+    return ESP_OK;
+}
+
+// The timer is driven by the test, by calling `dac_timer_handler` for every tick:
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle) {
+    *out_handle = (esp_timer_handle_t)&dac_data;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_restart(esp_timer_handle_t timer, uint64_t timeout_us) {
+    return ESP_OK;
+}
+
+/// @brief Calculates the amplitude of every bin of a periodic signal (its mean removed), with a plain DFT (the length is a whole number of periods, so no window is needed).
+static void calculate_amplitudes(const double* signal, size_t length, double* amplitudes) {
+    double mean = 0.0;
+
+    for (size_t i = 0; i < length; i++)
+        mean += signal[i] / length;
+
+    for (size_t bin = 0; bin <= length / 2; bin++) {
+        double real = 0.0;
+        double imaginary = 0.0;
+
+        for (size_t i = 0; i < length; i++) {
+            double angle = 2.0 * M_PI * bin * i / length;
+
+            real += (signal[i] - mean) * cos(angle);
+            imaginary -= (signal[i] - mean) * sin(angle);
+        }
+
+        amplitudes[bin] = 2.0 * sqrt(real * real + imaginary * imaginary) / length;
+    }
+}
+
+static double to_db(double amplitude, double reference) {
+    return 20.0 * log10(fmax(amplitude, 1e-12) / reference);
+}
+
+/// @brief Outputs one period of the tone at an interpolation factor, and returns the level of the tone, of its first image and of the strongest other bin (relative to the ideal tone, in dB).
+static void measure_output(size_t interpolation_factor, double* tone_db, double* spurious_db, double* image_db) {
+    float samples[TEST_NUMBER_OF_SAMPLES] = {};
+    uint8_t dac_values[TEST_NUMBER_OF_SAMPLES * DAC_NUMBER_OF_CHANNELS] = {};
+
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES; i++)
+        samples[i] = TEST_OFFSET + TEST_AMPLITUDE * sinf(2.0f * (float)M_PI * TEST_TONE_BIN * i / TEST_NUMBER_OF_SAMPLES);
+
+    TEST_CHECK(quantize_dac_values(samples, dac_values, TEST_NUMBER_OF_SAMPLES, 0, true) == ESP_OK);
+
+    // Start the output from the first sample, like after a reboot:
+    memset(&dac_data, 0, sizeof(dac_data));
+    memset(test_output_length, 0, sizeof(test_output_length));
+
+    TEST_CHECK(dac_output_values(dac_values, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, interpolation_factor, DAC_OUTPUT_CHANNEL_1) == ESP_OK);
+
+    size_t output_length = TEST_NUMBER_OF_SAMPLES * interpolation_factor;
+
+    for (size_t i = 0; i < output_length; i++)
+        dac_timer_handler(NULL);
+
+    TEST_CHECK(test_output_length[0] == output_length);
+    TEST_CHECK(test_output_length[1] == 0); // The second channel is not output.
+
+    static double output[TEST_MAXIMUM_OUTPUT_LENGTH] = {};
+    static double amplitudes[TEST_MAXIMUM_OUTPUT_LENGTH / 2 + 1] = {};
+
+    for (size_t i = 0; i < output_length; i++)
+        output[i] = test_output[0][i];
+
+    calculate_amplitudes(output, output_length, amplitudes);
+
+    // The ideal output is the continuous tone, sampled at the rate of the timer, which only has the tone in its spectrum:
+    double ideal_amplitude = TEST_AMPLITUDE * 255.0 / ESP_VCC_MAX;
+
+    *tone_db = to_db(amplitudes[TEST_TONE_BIN], ideal_amplitude);
+    *spurious_db = -INFINITY;
+    *image_db = (interpolation_factor > 1) ? to_db(amplitudes[TEST_NUMBER_OF_SAMPLES - TEST_TONE_BIN], ideal_amplitude) : -INFINITY; // The first image, at the sample frequency minus the tone.
+
+    for (size_t bin = 1; bin <= output_length / 2; bin++) {
+        if (bin != TEST_TONE_BIN)
+            *spurious_db = fmax(*spurious_db, to_db(amplitudes[bin], ideal_amplitude));
+    }
+
+    fprintf(stderr, "Interpolation factor '%zu': the tone is at %.2f dB, the first image at %.1f dB and the strongest other bin at %.1f dB of the ideal tone.\n", interpolation_factor, *tone_db, *image_db, *spurious_db);
+}
+
+static void test_output_spectrum(void) {
+    double tone_db = 0.0;
+    double spurious_db = 0.0;
+    double image_db = 0.0;
+
+    // Without the interpolator, the output is the quantized samples, so only the quantization of 8 bits (harmonics of about -46 dB for this coherent tone) differs from the ideal tone:
+    measure_output(1, &tone_db, &spurious_db, &image_db);
+
+    TEST_CHECK_NEAR(tone_db, 0.0, 0.1);
+    TEST_CHECK(spurious_db < -40.0);
+
+    // With the interpolator, the images of the samples around multiples of the sample frequency must be removed (a hold of the samples leaves the first image at about -17 dB):
+    for (size_t interpolation_factor = 2; interpolation_factor <= DAC_MAXIMUM_INTERPOLATION_FACTOR; interpolation_factor *= 2) {
+        measure_output(interpolation_factor, &tone_db, &spurious_db, &image_db);
+
+        TEST_CHECK_NEAR(tone_db, 0.0, 0.5);
+        TEST_CHECK(image_db < -45.0);
+        TEST_CHECK(spurious_db < -40.0);
+    }
+}
+
+int main(void) {
+    test_output_spectrum();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,130 @@
+// Checks that the spectrum view draws within the OLED display for the sample frequencies that the load generator and the ADC use.
+
+#include "display_communicator.h"
+#include "test_utilities.h"
+
+#include "../tools/load_generator/load_generator.h"
+
+#define TEST_SCREEN_WIDTH (128)
+#define TEST_SCREEN_HEIGHT (64)
+
+#define TEST_NUMBER_OF_SAMPLES (2048)
+#define TEST_MAXIMUM_LABELS (8)
+
+SSD1306_t oled_display = {};
+
+static char test_labels[TEST_MAXIMUM_LABELS][UNIT_BUFFER_LENGTH + 1] = {}; // The texts that were drawn since the screen was cleared.
+static size_t test_label_count = 0;
+static size_t test_pixels_outside = 0; // The number of pixels that were drawn outside of the screen.
+
+void i2c_master_init(SSD1306_t* dev, int16_t sda, int16_t scl, int16_t reset) {
+}
+
+void ssd1306_init(SSD1306_t* dev, int width, int height) {
+    dev->_width = width;
+    dev->_height = height;
+}
+
+void ssd1306_clear_screen(SSD1306_t* dev, bool invert) {
+    test_label_count = 0;
+}
+
+void ssd1306_contrast(SSD1306_t* dev, int contrast) {
+}
+
+void ssd1306_display_text(SSD1306_t* dev, int page, char* text, int text_len, bool invert) {
+}
+
+void ssd1306_display_text_x3(SSD1306_t* dev, int page, char* text, int text_len, bool invert) {
+}
+
+void ssd1306_display_text_cursor(SSD1306_t* dev, int y, int x, char* text, int text_len, bool invert) {
+    if (test_label_count < TEST_MAXIMUM_LABELS)
+        snprintf(test_labels[test_label_count++], UNIT_BUFFER_LENGTH + 1, "%.*s", text_len, text);
+}
+
+void ssd1306_line(SSD1306_t* dev, int x1, int y1, int x2, int y2, bool invert) {
+}
+
+void ssd1306_pixel(SSD1306_t* dev, int xpos, int ypos, bool invert) {
+    if (xpos < 0 || xpos >= dev->_width || ypos < 0 || ypos >= dev->_height)
+        test_pixels_outside++;
+}
+
+int ssd1306_get_width(SSD1306_t* dev) {
+    return dev->_width;
+}
+
+int ssd1306_get_height(SSD1306_t* dev) {
+    return dev->_height;
+}
+
+char* itoa(int value, char* buffer, int base) {
+    sprintf(buffer, "%d", value);
+
+    return buffer;
+}
+
+static void draw_spectrum(size_t sample_frequency) {
+    static float fft_data[TEST_NUMBER_OF_SAMPLES / 2] = {};
+
+    // A tone at a quarter of the sample frequency, above a noise floor:
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES / 2; i++)
+        fft_data[i] = (i == TEST_NUMBER_OF_SAMPLES / 8) ? 40.0f : -80.0f;
+
+    test_pixels_outside = 0;
+
+    TEST_CHECK(oled_view_fft(fft_data, TEST_NUMBER_OF_SAMPLES / 2, TEST_NUMBER_OF_SAMPLES, sample_frequency, -100.0f, 50.0f) == ESP_OK);
+    TEST_CHECK(test_pixels_outside == 0);
+}
+
+static void test_frequency_labels(void) {
+    // The load generator uses a sample frequency above 1 kHz by default, which used to overflow the labels and abort the FFT worker:
+    draw_spectrum(LOAD_GENERATOR_DEFAULT_SAMPLE_FREQUENCY);
+
+    TEST_CHECK(test_label_count == 5);
+    TEST_CHECK(strcmp(test_labels[0], "500") == 0);  // The middle of the frequency axis.
+    TEST_CHECK(strcmp(test_labels[1], "1.0k") == 0); // The Nyquist frequency.
+
+    draw_spectrum(200);
+
+    TEST_CHECK(strcmp(test_labels[0], "50") == 0);
+    TEST_CHECK(strcmp(test_labels[1], "100") == 0);
+
+    draw_spectrum(44100);
+
+    TEST_CHECK(strcmp(test_labels[0], "11k") == 0);
+    TEST_CHECK(strcmp(test_labels[1], "22k") == 0);
+
+    draw_spectrum(83333); // The highest sample frequency of the ADC.
+
+    TEST_CHECK(strcmp(test_labels[0], "20k") == 0);
+    TEST_CHECK(strcmp(test_labels[1], "41k") == 0);
+}
+
+static void test_empty_spectrum_is_rejected(void) {
+    float fft_data[1] = {};
+
+    TEST_CHECK(oled_view_fft(NULL, 1, TEST_NUMBER_OF_SAMPLES, 1000, -100.0f, 50.0f) == ESP_FAIL);
+    TEST_CHECK(oled_view_fft(fft_data, 0, TEST_NUMBER_OF_SAMPLES, 1000, -100.0f, 50.0f) == ESP_FAIL);
+}
+
+static void test_uninitialized_display_is_rejected(void) {
+    // Without `initialize_oled`, there is no lock to draw a view with:
+    TEST_CHECK(oled_view_info("Info") == ESP_FAIL);
+    TEST_CHECK(oled_view_error("Error") == ESP_FAIL);
+    TEST_CHECK(oled_view_startup("Header", "Version") == ESP_FAIL);
+}
+
+int main(void) {
+    test_uninitialized_display_is_rejected();
+
+    initialize_oled(TEST_SCREEN_WIDTH, TEST_SCREEN_HEIGHT);
+
+    test_frequency_labels();
+    test_empty_spectrum_is_rejected();
+
+    TEST_CHECK(oled_view_info("Info") == ESP_OK);
+
+    TEST_FINISH();
+}
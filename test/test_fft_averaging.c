@@ -0,0 +1,94 @@
+// Checks how consecutive spectra are accumulated by the averaging modes of the FFT.
+
+#include "fft_transform.h"
+#include "test_utilities.h"
+
+#define TEST_BIN_COUNT (4)
+
+trace_buffer_t trace_buffer = {};
+
+// The accumulation does not show a spectrum, so the display is not needed on the host:
+esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t sample_data_length, size_t sample_frequency, float y_min_magnitude_scale, float y_max_magnitude_scale) {
+    return ESP_FAIL;
+}
+
+/// @brief Accumulates a spectrum with the same power in every bin, and returns the accumulated power of the first bin.
+static float accumulate_power(fft_data_t* fft_data, float frame_power) {
+    float power[TEST_BIN_COUNT] = {};
+    float power_db[TEST_BIN_COUNT] = {};
+
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++)
+        power[i] = frame_power;
+
+    TEST_CHECK(accumulate_spectrum_f32(fft_data, HANN_WINDOW_F32, power, power_db, TEST_BIN_COUNT) == ESP_OK);
+    TEST_CHECK_NEAR(power[TEST_BIN_COUNT - 1], power[0], 0.0);
+
+    return power[0];
+}
+
+static void test_linear_average_of_a_block(void) {
+    fft_data_t fft_data = {
+        .averaging_config = {.mode = LINEAR_AVERAGING, .frames = 4}
+    };
+
+    TEST_CHECK(reset_spectrum_average() == ESP_OK);
+
+    // Within a block, the result is the mean of all its spectra (also of the first one, which an exponential average would forget):
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 8.0f), 8.0, 1e-6);
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 4.0f), 6.0, 1e-6);
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 0.0f), 4.0, 1e-6);
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 4.0f), 4.0, 1e-6);
+    TEST_CHECK(fft_data.averaged_frames == 4);
+
+    // The next spectrum starts a new block:
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 1.0f), 1.0, 1e-6);
+    TEST_CHECK(fft_data.averaged_frames == 1);
+
+    for (size_t i = 0; i < 3; i++)
+        accumulate_power(&fft_data, 3.0f);
+
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 10.0f), 10.0, 1e-6); // The block of (1, 3, 3, 3) is full, so a new one starts.
+
+    // A block with every spectrum the same weight: the mean of (10, 2, 2, 2) is 4, where an exponential average with a weight of 1/4 ends at 5.375:
+    for (size_t i = 0; i < 2; i++)
+        accumulate_power(&fft_data, 2.0f);
+
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 2.0f), 4.0, 1e-6);
+}
+
+static void test_exponential_average(void) {
+    fft_data_t fft_data = {
+        .averaging_config = {.mode = EXPONENTIAL_AVERAGING, .alpha = 0.5f}
+    };
+
+    TEST_CHECK(reset_spectrum_average() == ESP_OK);
+
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 8.0f), 8.0, 1e-6);
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 0.0f), 4.0, 1e-6);
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 0.0f), 2.0, 1e-6);
+    TEST_CHECK(fft_data.averaged_frames == 3);
+}
+
+static void test_changed_settings_start_over(void) {
+    fft_data_t fft_data = {
+        .averaging_config = {.mode = MAX_HOLD_AVERAGING}
+    };
+
+    accumulate_power(&fft_data, 8.0f);
+
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 2.0f), 8.0, 1e-6);
+
+    fft_data.averaging_config.mode = MIN_HOLD_AVERAGING;
+
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 2.0f), 2.0, 1e-6);
+    TEST_CHECK_NEAR(accumulate_power(&fft_data, 5.0f), 2.0, 1e-6);
+    TEST_CHECK(fft_data.averaged_frames == 2);
+}
+
+int main(void) {
+    test_linear_average_of_a_block();
+    test_exponential_average();
+    test_changed_settings_start_over();
+
+    TEST_FINISH();
+}
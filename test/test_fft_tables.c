@@ -0,0 +1,46 @@
+// Checks the tables of 'tools/fft_tables/generate_fft_tables.py' against the ones that `esp_dsp` computes at runtime. The test is built with the source that the generator wrote for `FFT_STATIC_LENGTH` (see 'run_tests.sh').
+
+#include "fft_tables.h"
+#include "test_utilities.h"
+
+static float test_dsp_table[FFT_STATIC_LENGTH] = {}; // The twiddles of `dsps_fft2r_init_fc32` (half a circle of complex pairs).
+
+static size_t reverse_test_bits(size_t value, size_t bits) {
+    size_t reversed_value = 0;
+
+    for (size_t i = 0; i < bits; i++, value >>= 1)
+        reversed_value = (reversed_value << 1) | (value & 1);
+
+    return reversed_value;
+}
+
+static void test_twiddles_match_esp_dsp(void) {
+    TEST_CHECK(dsps_fft2r_init_fc32(test_dsp_table, FFT_STATIC_LENGTH) == ESP_OK);
+
+    // The generated twiddles are in natural order, and the ones of `esp_dsp` are bit-reversed over the `FFT_STATIC_LENGTH / 2` pairs:
+    size_t bits = __builtin_ctz(FFT_STATIC_LENGTH / 2);
+    float largest_difference = 0.0f;
+
+    for (size_t k = 0; k < FFT_STATIC_LENGTH / 2; k++) {
+        size_t dsp_index = reverse_test_bits(k, bits);
+
+        largest_difference = fmaxf(largest_difference, fabsf(fft_static_twiddles[k * 2 + 0] - test_dsp_table[dsp_index * 2 + 0]));
+        largest_difference = fmaxf(largest_difference, fabsf(fft_static_twiddles[k * 2 + 1] - test_dsp_table[dsp_index * 2 + 1]));
+    }
+
+    TEST_CHECK_NEAR(largest_difference, 0.0, FFT_TWIDDLE_TOLERANCE);
+
+    dsps_fft2r_deinit_fc32();
+}
+
+static void test_tables_and_output_match(void) {
+    // The bit-reversal pairs, the windows and the output of the static FFT, like the check at startup of `FFT_VERIFY_STATIC_TABLES`:
+    TEST_CHECK(verify_static_fft_tables() == ESP_OK);
+}
+
+int main(void) {
+    test_twiddles_match_esp_dsp();
+    test_tables_and_output_match();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,104 @@
+// Checks that a periodic frame is filtered into the steady state of the filter, without a transient or a step where the frame wraps around.
+
+#include "filter_transform.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (512)
+#define TEST_SAMPLE_FREQUENCY (1000)
+#define TEST_REPEATS (8) // The number of repeats of the frame, after which the continuous filter is settled.
+
+static void generate_frame(float* samples) {
+    // A step in the frame (a square wave of a single period) and a tone, with a large offset, so a filter from rest has a clear transient:
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES; i++)
+        samples[i] = 1.5f + ((i < TEST_NUMBER_OF_SAMPLES / 2) ? 0.5f : -0.5f) + 0.25f * sinf(2.0f * (float)M_PI * 8 * i / TEST_NUMBER_OF_SAMPLES);
+}
+
+static void check_periodic_filter(const filter_config_t* filter_config, double tolerance) {
+    static float periodic_samples[TEST_NUMBER_OF_SAMPLES] = {};
+    static float continuous_samples[TEST_NUMBER_OF_SAMPLES] = {};
+    static float first_pass_samples[TEST_NUMBER_OF_SAMPLES] = {};
+
+    filter_stage_t periodic_stage = {};
+    filter_stage_t continuous_stage = {};
+
+    TEST_CHECK(configure_filter_stage(&periodic_stage, filter_config) == ESP_OK);
+    TEST_CHECK(configure_filter_stage(&continuous_stage, filter_config) == ESP_OK);
+
+    generate_frame(periodic_samples);
+
+    TEST_CHECK(apply_periodic_filter_stage(&periodic_stage, periodic_samples, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY) == ESP_OK);
+
+    // The reference is the frame repeated through the continuous filter, until the filter is settled:
+    for (size_t repeat = 0; repeat < TEST_REPEATS; repeat++) {
+        generate_frame(continuous_samples);
+
+        TEST_CHECK(apply_filter_stage(&continuous_stage, continuous_samples, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY) == ESP_OK);
+
+        if (repeat == 0)
+            memcpy(first_pass_samples, continuous_samples, sizeof(first_pass_samples));
+    }
+
+    double largest_difference = 0.0;
+    double largest_transient = 0.0;
+
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES; i++) {
+        largest_difference = fmax(largest_difference, fabs(periodic_samples[i] - continuous_samples[i]));
+        largest_transient = fmax(largest_transient, fabs(first_pass_samples[i] - continuous_samples[i]));
+    }
+
+    TEST_CHECK_NEAR(largest_difference, 0.0, tolerance);
+    TEST_CHECK(largest_transient > 0.5); // A single pass from rest has the transient that the periodic filter removes.
+
+    // The same frame is always filtered into the same output (the state of an earlier frame does not leak into it):
+    static float repeated_samples[TEST_NUMBER_OF_SAMPLES] = {};
+
+    generate_frame(repeated_samples);
+
+    TEST_CHECK(apply_periodic_filter_stage(&periodic_stage, repeated_samples, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY) == ESP_OK);
+    TEST_CHECK(memcmp(repeated_samples, periodic_samples, sizeof(repeated_samples)) == 0);
+}
+
+static void test_periodic_biquad_filter(void) {
+    filter_config_t filter_config = {
+        .structure = BIQUAD_FILTER,
+        .response = LOW_PASS_FILTER,
+        .high_frequency = 50.0f,
+        .order = 4
+    };
+
+    check_periodic_filter(&filter_config, 1e-4);
+}
+
+static void test_periodic_fir_filter(void) {
+    filter_config_t filter_config = {
+        .structure = FIR_FILTER,
+        .response = BAND_PASS_FILTER,
+        .low_frequency = 10.0f,
+        .high_frequency = 40.0f,
+        .order = 64
+    };
+
+    check_periodic_filter(&filter_config, 1e-5);
+}
+
+static void test_no_filter_passes_samples(void) {
+    float samples[TEST_NUMBER_OF_SAMPLES] = {};
+    float expected_samples[TEST_NUMBER_OF_SAMPLES] = {};
+
+    generate_frame(samples);
+    generate_frame(expected_samples);
+
+    filter_stage_t filter_stage = {};
+
+    TEST_CHECK(apply_periodic_filter_stage(&filter_stage, samples, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY) == ESP_OK);
+    TEST_CHECK(memcmp(samples, expected_samples, sizeof(samples)) == 0);
+    TEST_CHECK(apply_periodic_filter_stage(NULL, samples, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY) == ESP_FAIL);
+}
+
+int main(void) {
+    test_periodic_biquad_filter();
+    test_periodic_fir_filter();
+    test_no_filter_passes_samples();
+
+    TEST_FINISH();
+}
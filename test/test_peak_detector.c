@@ -0,0 +1,149 @@
+// Checks the frequency and the amplitude of the peaks that are found in the spectrum of off-bin tones, for every window.
+
+#include "fft_transform.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (1024)
+#define TEST_SAMPLE_FREQUENCY (8000)
+#define TEST_BIN_COUNT (TEST_NUMBER_OF_SAMPLES / 2)
+
+trace_buffer_t trace_buffer = {};
+
+// The spectrum is not shown, so the display is not needed on the host:
+esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t sample_data_length, size_t sample_frequency, float y_min_magnitude_scale, float y_max_magnitude_scale) {
+    return ESP_FAIL;
+}
+
+static const window_config_t test_windows[] = {HANN_WINDOW_F32, BLACKMAN_WINDOW_F32, BLACKMAN_HARRIS_WINDOW_F32, BLACKMAN_NUTTALL_WINDOW_F32, NUTTALL_WINDOW_F32, FLAT_TOP_WINDOW_F32};
+
+// The error of the parabolic fit on the main lobe (relative for the amplitude, in bins for the frequency), which is largest halfway between two bins for the narrow lobe of the Hann window, and for the flat lobe of the flat top window:
+static const double test_amplitude_tolerances[] = {0.04, 0.01, 0.005, 0.005, 0.005, 0.02};
+static const double test_frequency_tolerances[] = {0.02, 0.01, 0.005, 0.005, 0.005, 0.15};
+
+static float test_samples[TEST_NUMBER_OF_SAMPLES] = {};
+static float test_power_db[TEST_BIN_COUNT] = {};
+
+/// @brief Fills the samples with the sum of sine waves, at frequencies in bins (which may be between two bins).
+static void generate_tones(const float* bins, const float* amplitudes, size_t number_of_tones) {
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES; i++) {
+        double sample = 0.0;
+
+        for (size_t j = 0; j < number_of_tones; j++)
+            sample += amplitudes[j] * sin(2.0 * M_PI * bins[j] * i / TEST_NUMBER_OF_SAMPLES + 0.3 * j);
+
+        test_samples[i] = (float)sample;
+    }
+}
+
+/// @brief Computes the spectrum of the samples with a window, and returns what the peak detection returns.
+static esp_err_t detect_test_peaks(window_config_t window_config, peak_config_t peak_config, fft_peak_t* peaks, size_t* number_of_peaks) {
+    fft_data_t fft_data = {};
+
+    TEST_CHECK(initialize_fft_f32(&fft_data) == ESP_OK);
+    TEST_CHECK(compute_fft_spectrum_f32(&fft_data, test_samples, window_config, TEST_NUMBER_OF_SAMPLES, test_power_db, NULL) == ESP_OK);
+    TEST_CHECK(de_initialize_fft_f32(&fft_data) == ESP_OK);
+
+    return detect_peaks_f32(test_power_db, TEST_BIN_COUNT, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, window_config, peak_config, peaks, number_of_peaks);
+}
+
+static void test_off_bin_tone_for_every_window(void) {
+    float bin_resolution = (float)TEST_SAMPLE_FREQUENCY / TEST_NUMBER_OF_SAMPLES;
+    peak_config_t peak_config = {.threshold_db = -20.0f, .maximum_peaks = 1};
+
+    for (size_t i = 0; i < sizeof(test_windows) / sizeof(test_windows[0]); i++) {
+        // On a bin, a quarter bin and halfway between two bins, so the sub-bin interpolation and the coherent gain are both needed:
+        const float offsets[] = {0.0f, 0.25f, 0.5f};
+
+        for (size_t j = 0; j < sizeof(offsets) / sizeof(offsets[0]); j++) {
+            float bin = 100.0f + offsets[j];
+            float amplitude = 0.8f;
+
+            generate_tones(&bin, &amplitude, 1);
+
+            fft_peak_t peaks[MAXIMUM_PEAKS_LENGTH] = {};
+            size_t number_of_peaks = 0;
+
+            TEST_CHECK(detect_test_peaks(test_windows[i], peak_config, peaks, &number_of_peaks) == ESP_OK);
+            TEST_CHECK(number_of_peaks == 1);
+            TEST_CHECK_NEAR(peaks[0].frequency, bin * bin_resolution, test_frequency_tolerances[i] * bin_resolution);
+            TEST_CHECK_NEAR(peaks[0].amplitude, amplitude, test_amplitude_tolerances[i] * amplitude);
+        }
+    }
+}
+
+static void test_interpolation_is_better_than_a_bin(void) {
+    float bin_resolution = (float)TEST_SAMPLE_FREQUENCY / TEST_NUMBER_OF_SAMPLES;
+    peak_config_t peak_config = {.threshold_db = -20.0f, .maximum_peaks = 1};
+
+    // A tone at a third of a bin is found within a small part of a bin, where the center of the bin is a third of a bin off:
+    float bin = 60.33f;
+    float amplitude = 1.0f;
+
+    generate_tones(&bin, &amplitude, 1);
+
+    fft_peak_t peaks[MAXIMUM_PEAKS_LENGTH] = {};
+    size_t number_of_peaks = 0;
+
+    TEST_CHECK(detect_test_peaks(HANN_WINDOW_F32, peak_config, peaks, &number_of_peaks) == ESP_OK);
+    TEST_CHECK(number_of_peaks == 1);
+    TEST_CHECK_NEAR(peaks[0].frequency, bin * bin_resolution, 0.05 * bin_resolution);
+}
+
+static void test_threshold_and_ordering(void) {
+    float bin_resolution = (float)TEST_SAMPLE_FREQUENCY / TEST_NUMBER_OF_SAMPLES;
+
+    // Four tones of different amplitudes, far enough apart that their main lobes do not overlap (the weakest comes first, so the list has to be sorted):
+    const float bins[] = {40.3f, 90.7f, 150.5f, 210.2f};
+    const float amplitudes[] = {0.01f, 0.1f, 1.0f, 0.5f};
+
+    generate_tones(bins, amplitudes, 4);
+
+    fft_peak_t peaks[MAXIMUM_PEAKS_LENGTH] = {};
+    size_t number_of_peaks = 0;
+
+    // Without a threshold on the tones, the strongest three are kept from strongest to weakest:
+    peak_config_t peak_config = {.threshold_db = -60.0f, .maximum_peaks = 3};
+
+    TEST_CHECK(detect_test_peaks(BLACKMAN_HARRIS_WINDOW_F32, peak_config, peaks, &number_of_peaks) == ESP_OK);
+    TEST_CHECK(number_of_peaks == 3);
+    TEST_CHECK_NEAR(peaks[0].frequency, bins[2] * bin_resolution, 0.1 * bin_resolution);
+    TEST_CHECK_NEAR(peaks[1].frequency, bins[3] * bin_resolution, 0.1 * bin_resolution);
+    TEST_CHECK_NEAR(peaks[2].frequency, bins[1] * bin_resolution, 0.1 * bin_resolution);
+    TEST_CHECK_NEAR(peaks[0].amplitude, amplitudes[2], 0.01 * amplitudes[2]);
+    TEST_CHECK_NEAR(peaks[1].amplitude, amplitudes[3], 0.01 * amplitudes[3]);
+    TEST_CHECK_NEAR(peaks[2].amplitude, amplitudes[1], 0.01 * amplitudes[1]);
+
+    // The power of a tone with an amplitude of 0.1 is below a threshold just above it (the power of a bin is |X|² / N), so only the two strongest tones are left:
+    float weak_tone_power_db = test_power_db[91];
+
+    peak_config.threshold_db = weak_tone_power_db + 3.0f;
+    peak_config.maximum_peaks = MAXIMUM_PEAKS_LENGTH;
+
+    TEST_CHECK(detect_test_peaks(BLACKMAN_HARRIS_WINDOW_F32, peak_config, peaks, &number_of_peaks) == ESP_OK);
+    TEST_CHECK(number_of_peaks == 2);
+    TEST_CHECK(peaks[0].power_db > peaks[1].power_db);
+
+    // No peaks are requested:
+    peak_config.maximum_peaks = 0;
+
+    TEST_CHECK(detect_test_peaks(BLACKMAN_HARRIS_WINDOW_F32, peak_config, peaks, &number_of_peaks) == ESP_OK);
+    TEST_CHECK(number_of_peaks == 0);
+}
+
+static void test_invalid_arguments_are_rejected(void) {
+    fft_peak_t peaks[MAXIMUM_PEAKS_LENGTH] = {};
+    size_t number_of_peaks = 0;
+    peak_config_t peak_config = {.threshold_db = 0.0f, .maximum_peaks = 1};
+
+    TEST_CHECK(detect_peaks_f32(NULL, TEST_BIN_COUNT, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, HANN_WINDOW_F32, peak_config, peaks, &number_of_peaks) == ESP_FAIL);
+    TEST_CHECK(detect_peaks_f32(test_power_db, TEST_BIN_COUNT, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, FLAT_TOP_WINDOW_F32 + 1, peak_config, peaks, &number_of_peaks) == ESP_FAIL);
+}
+
+int main(void) {
+    test_off_bin_tone_for_every_window();
+    test_interpolation_is_better_than_a_bin();
+    test_threshold_and_ordering();
+    test_invalid_arguments_are_rejected();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,128 @@
+// Checks the distortion and amplitude that are measured from the spectrum of a tone with known harmonics, on and off the bins, and with harmonics that are folded back.
+
+#include "fft_transform.h"
+#include "quality_metrics.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (2048)
+#define TEST_SAMPLE_FREQUENCY (20480) // A resolution of 10 Hz per bin.
+#define TEST_BIN_COUNT (TEST_NUMBER_OF_SAMPLES / 2)
+#define TEST_WINDOW (BLACKMAN_HARRIS_WINDOW_F32)
+
+trace_buffer_t trace_buffer = {};
+
+// The spectrum is not shown, so the display is not needed on the host:
+esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t sample_data_length, size_t sample_frequency, float y_min_magnitude_scale, float y_max_magnitude_scale) {
+    return ESP_FAIL;
+}
+
+static float test_samples[TEST_NUMBER_OF_SAMPLES] = {};
+static float test_power[TEST_BIN_COUNT] = {};
+static float test_power_db[TEST_BIN_COUNT] = {};
+
+/// @brief Generates a tone with the amplitudes of its harmonics (from the second one up), and measures its quality with the default settings.
+static void measure_tone(float frequency, float amplitude, const float* harmonic_amplitudes, size_t number_of_harmonics, quality_metrics_t* quality_metrics) {
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES; i++) {
+        double time = (double)i / TEST_SAMPLE_FREQUENCY;
+        double sample = amplitude * sin(2.0 * M_PI * frequency * time);
+
+        // A harmonic above the Nyquist frequency is aliased by the sampling itself:
+        for (size_t j = 0; j < number_of_harmonics; j++)
+            sample += harmonic_amplitudes[j] * sin(2.0 * M_PI * frequency * (j + 2) * time + 0.7 * j);
+
+        test_samples[i] = (float)sample;
+    }
+
+    fft_data_t fft_data = {};
+    quality_config_t quality_config = {.number_of_harmonics = DEFAULT_QUALITY_HARMONICS};
+
+    TEST_CHECK(initialize_fft_f32(&fft_data) == ESP_OK);
+    TEST_CHECK(compute_fft_spectrum_f32(&fft_data, test_samples, TEST_WINDOW, TEST_NUMBER_OF_SAMPLES, test_power_db, test_power) == ESP_OK);
+    TEST_CHECK(de_initialize_fft_f32(&fft_data) == ESP_OK);
+    TEST_CHECK(measure_signal_quality_f32(test_power, TEST_BIN_COUNT, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, TEST_WINDOW, quality_config, quality_metrics) == ESP_OK);
+}
+
+/// @brief Returns the THD (in dBc) of a tone with an amplitude and the amplitudes of its harmonics.
+static double get_expected_thd_db(float amplitude, const float* harmonic_amplitudes, size_t number_of_harmonics) {
+    double harmonics_power = 0.0;
+
+    for (size_t i = 0; i < number_of_harmonics; i++)
+        harmonics_power += harmonic_amplitudes[i] * harmonic_amplitudes[i];
+
+    return 10.0 * log10(harmonics_power / (amplitude * amplitude));
+}
+
+static void test_tone_on_and_off_the_bins(void) {
+    const float frequencies[] = {1000.0f, 1003.7f}; // On bin 100, and a third of a bin next to it.
+    const float harmonic_amplitudes[] = {0.01f, 0.001f, 0.0f, 0.003f};
+    const float amplitude = 0.8f;
+
+    for (size_t i = 0; i < 2; i++) {
+        quality_metrics_t quality_metrics = {};
+
+        measure_tone(frequencies[i], amplitude, harmonic_amplitudes, 4, &quality_metrics);
+
+        TEST_CHECK_NEAR(quality_metrics.fundamental_frequency, frequencies[i], 0.05);
+        TEST_CHECK_NEAR(quality_metrics.fundamental_amplitude, amplitude, 0.0005 * amplitude);
+        TEST_CHECK_NEAR(quality_metrics.thd_db, get_expected_thd_db(amplitude, harmonic_amplitudes, 4), 0.05);
+        TEST_CHECK(quality_metrics.number_of_harmonics == DEFAULT_QUALITY_HARMONICS);
+
+        // The levels of the single harmonics:
+        TEST_CHECK_NEAR(quality_metrics.harmonic_levels_dbc[0], 20.0 * log10(0.01 / amplitude), 0.05);
+        TEST_CHECK_NEAR(quality_metrics.harmonic_levels_dbc[1], 20.0 * log10(0.001 / amplitude), 0.05);
+        TEST_CHECK_NEAR(quality_metrics.harmonic_levels_dbc[3], 20.0 * log10(0.003 / amplitude), 0.05);
+
+        // The strongest spur is the second harmonic:
+        TEST_CHECK_NEAR(quality_metrics.spur_frequency, 2.0f * frequencies[i], 10.0);
+    }
+}
+
+static void test_harmonic_above_nyquist_is_folded(void) {
+    const float harmonic_amplitudes[] = {0.0f, 0.0f, 0.01f}; // Only the fourth harmonic, at 12000 Hz, which is aliased to 8480 Hz.
+    const float amplitude = 1.0f;
+
+    quality_metrics_t quality_metrics = {};
+
+    measure_tone(3000.0f, amplitude, harmonic_amplitudes, 3, &quality_metrics);
+
+    TEST_CHECK_NEAR(quality_metrics.harmonic_frequencies[2], TEST_SAMPLE_FREQUENCY - 12000.0f, 1.0);
+    TEST_CHECK_NEAR(quality_metrics.harmonic_levels_dbc[2], -40.0, 0.05);
+    TEST_CHECK_NEAR(quality_metrics.thd_db, -40.0, 0.05);
+    TEST_CHECK_NEAR(quality_metrics.fundamental_amplitude, amplitude, 0.0005 * amplitude);
+}
+
+static void test_harmonic_on_the_fundamental_is_not_counted(void) {
+    // At a third of the sample frequency, the second harmonic is aliased onto the fundamental itself:
+    const float frequency = TEST_SAMPLE_FREQUENCY / 3.0f;
+    const float harmonic_amplitudes[] = {0.0f, 0.01f}; // The third harmonic is aliased onto DC.
+
+    quality_metrics_t quality_metrics = {};
+
+    measure_tone(frequency, 1.0f, harmonic_amplitudes, 2, &quality_metrics);
+
+    TEST_CHECK(isinf(quality_metrics.harmonic_levels_dbc[0]) && quality_metrics.harmonic_levels_dbc[0] < 0.0f);
+    TEST_CHECK(isinf(quality_metrics.harmonic_levels_dbc[1]) && quality_metrics.harmonic_levels_dbc[1] < 0.0f);
+    TEST_CHECK_NEAR(quality_metrics.fundamental_frequency, frequency, 0.05);
+}
+
+static void test_invalid_arguments_are_rejected(void) {
+    quality_metrics_t quality_metrics = {};
+    quality_config_t quality_config = {.number_of_harmonics = DEFAULT_QUALITY_HARMONICS};
+
+    TEST_CHECK(measure_signal_quality_f32(NULL, TEST_BIN_COUNT, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, TEST_WINDOW, quality_config, &quality_metrics) == ESP_FAIL);
+    TEST_CHECK(measure_signal_quality_f32(test_power, 8, 16, TEST_SAMPLE_FREQUENCY, TEST_WINDOW, quality_config, &quality_metrics) == ESP_FAIL); // Too short for the main lobes.
+
+    // A silent spectrum has no fundamental:
+    memset(test_power, 0, sizeof(test_power));
+
+    TEST_CHECK(measure_signal_quality_f32(test_power, TEST_BIN_COUNT, TEST_NUMBER_OF_SAMPLES, TEST_SAMPLE_FREQUENCY, TEST_WINDOW, quality_config, &quality_metrics) == ESP_FAIL);
+}
+
+int main(void) {
+    test_tone_on_and_off_the_bins();
+    test_harmonic_above_nyquist_is_folded();
+    test_harmonic_on_the_fundamental_is_not_counted();
+    test_invalid_arguments_are_rejected();
+
+    TEST_FINISH();
+}
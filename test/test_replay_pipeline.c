@@ -0,0 +1,96 @@
+// Checks that the tones of a replayed recording are found by the FFT and the peak detection, like a live capture that `/fft` analyzes.
+
+#include "fft_transform.h"
+#include "replay_source.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (1024)
+#define TEST_RECORDING_LENGTH (1600) // Not a multiple of the FFT length, so the second capture wraps around within the recording.
+#define TEST_SAMPLE_FREQUENCY (16000)
+#define TEST_SCALE (1.0f / 32768.0f)
+
+trace_buffer_t trace_buffer = {};
+
+// The spectrum is not shown, so the display is not needed on the host:
+esp_err_t oled_view_fft(float* fft_data, uint32_t fft_data_length, uint32_t sample_data_length, size_t sample_frequency, float y_min_magnitude_scale, float y_max_magnitude_scale) {
+    return ESP_FAIL;
+}
+
+// Two tones that fit a whole number of periods in the recording (so it loops without a step), between the bins of the FFT:
+static const float test_frequencies[] = {1010.0f, 2560.0f};
+static const float test_amplitudes[] = {0.5f, 0.125f};
+
+static uint8_t test_recording[REPLAY_HEADER_LENGTH + TEST_RECORDING_LENGTH * sizeof(int16_t)] = {};
+
+static void write_recording(void) {
+    uint32_t magic = REPLAY_MAGIC;
+    uint16_t version = REPLAY_VERSION;
+    uint16_t format = REPLAY_FORMAT_I16;
+    uint32_t sample_frequency = TEST_SAMPLE_FREQUENCY;
+    uint32_t number_of_samples = TEST_RECORDING_LENGTH;
+    float scale = TEST_SCALE;
+
+    // Write the header in little-endian byte order (the byte order of the host and the device):
+    memcpy(&test_recording[0], &magic, sizeof(magic));
+    memcpy(&test_recording[4], &version, sizeof(version));
+    memcpy(&test_recording[6], &format, sizeof(format));
+    memcpy(&test_recording[8], &sample_frequency, sizeof(sample_frequency));
+    memcpy(&test_recording[12], &number_of_samples, sizeof(number_of_samples));
+    memcpy(&test_recording[16], &scale, sizeof(scale));
+
+    for (size_t i = 0; i < TEST_RECORDING_LENGTH; i++) {
+        double sample = 0.0;
+
+        for (size_t j = 0; j < 2; j++)
+            sample += test_amplitudes[j] * sin(2.0 * M_PI * test_frequencies[j] * i / TEST_SAMPLE_FREQUENCY);
+
+        int16_t quantized_sample = (int16_t)lround(sample / TEST_SCALE);
+
+        memcpy(&test_recording[REPLAY_HEADER_LENGTH + i * sizeof(int16_t)], &quantized_sample, sizeof(int16_t));
+    }
+}
+
+static void test_replayed_tones_are_found(void) {
+    write_recording();
+
+    sample_source_t source = {};
+    float samples[TEST_NUMBER_OF_SAMPLES] = {};
+    float power_db[TEST_NUMBER_OF_SAMPLES / 2] = {};
+
+    TEST_CHECK(open_replay_memory_source(&source, test_recording, sizeof(test_recording), false) == ESP_OK);
+
+    fft_data_t fft_data = {};
+
+    TEST_CHECK(initialize_fft_f32(&fft_data) == ESP_OK);
+
+    float bin_resolution = (float)source.sample_frequency / TEST_NUMBER_OF_SAMPLES;
+    peak_config_t peak_config = {.threshold_db = -20.0f, .maximum_peaks = 4};
+
+    // Analyze two consecutive captures, where the second one starts within the recording and wraps around to its start:
+    for (size_t capture = 0; capture < 2; capture++) {
+        TEST_CHECK(read_sample_source(&source, samples, TEST_NUMBER_OF_SAMPLES) == ESP_OK);
+        TEST_CHECK(compute_fft_spectrum_f32(&fft_data, samples, BLACKMAN_HARRIS_WINDOW_F32, TEST_NUMBER_OF_SAMPLES, power_db, NULL) == ESP_OK);
+
+        fft_peak_t peaks[MAXIMUM_PEAKS_LENGTH] = {};
+        size_t number_of_peaks = 0;
+
+        TEST_CHECK(detect_peaks_f32(power_db, TEST_NUMBER_OF_SAMPLES / 2, TEST_NUMBER_OF_SAMPLES, source.sample_frequency, BLACKMAN_HARRIS_WINDOW_F32, peak_config, peaks, &number_of_peaks) == ESP_OK);
+
+        // Only the two tones are found, from the strongest to the weakest (the side lobes and the noise of the quantization are far below the threshold):
+        TEST_CHECK(number_of_peaks == 2);
+
+        for (size_t i = 0; i < 2 && i < number_of_peaks; i++) {
+            TEST_CHECK_NEAR(peaks[i].frequency, test_frequencies[i], 0.02 * bin_resolution);
+            TEST_CHECK_NEAR(peaks[i].amplitude, test_amplitudes[i], 0.005 * test_amplitudes[i]);
+        }
+    }
+
+    TEST_CHECK(de_initialize_fft_f32(&fft_data) == ESP_OK);
+    TEST_CHECK(close_sample_source(&source) == ESP_OK);
+}
+
+int main(void) {
+    test_replayed_tones_are_found();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,154 @@
+// Checks the decoding, validation and looping of recordings by the replay source, from memory and from a file.
+
+#include <unistd.h>
+
+#include "replay_source.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (5)
+
+static size_t write_recording(uint8_t* data, uint16_t format, uint32_t sample_frequency, uint32_t number_of_samples, float scale) {
+    uint32_t magic = REPLAY_MAGIC;
+    uint16_t version = REPLAY_VERSION;
+
+    // Write the header in little-endian byte order (the byte order of the host and the device):
+    memcpy(&data[0], &magic, sizeof(magic));
+    memcpy(&data[4], &version, sizeof(version));
+    memcpy(&data[6], &format, sizeof(format));
+    memcpy(&data[8], &sample_frequency, sizeof(sample_frequency));
+    memcpy(&data[12], &number_of_samples, sizeof(number_of_samples));
+    memcpy(&data[16], &scale, sizeof(scale));
+
+    size_t sample_size = (format == REPLAY_FORMAT_F32) ? sizeof(float) : sizeof(int16_t);
+
+    for (uint32_t i = 0; i < number_of_samples; i++) {
+        if (format == REPLAY_FORMAT_F32) {
+            float sample = 0.5f * i - 1.0f;
+
+            memcpy(&data[REPLAY_HEADER_LENGTH + i * sample_size], &sample, sample_size);
+        }
+        else {
+            int16_t sample = (int16_t)(1000 * i - 2000);
+
+            memcpy(&data[REPLAY_HEADER_LENGTH + i * sample_size], &sample, sample_size);
+        }
+    }
+
+    return REPLAY_HEADER_LENGTH + number_of_samples * sample_size;
+}
+
+static void test_f32_recording_loops(void) {
+    uint8_t data[REPLAY_HEADER_LENGTH + TEST_NUMBER_OF_SAMPLES * sizeof(float)] = {};
+    size_t data_length = write_recording(data, REPLAY_FORMAT_F32, 8000, TEST_NUMBER_OF_SAMPLES, 1.0f);
+
+    sample_source_t source = {};
+    float samples[12] = {};
+
+    TEST_CHECK(open_replay_memory_source(&source, data, data_length, false) == ESP_OK);
+    TEST_CHECK(source.type == REPLAY_SOURCE);
+    TEST_CHECK(source.sample_frequency == 8000);
+
+    // Read more samples than the recording holds, in two parts, so the replay wraps around within and between reads:
+    TEST_CHECK(read_sample_source(&source, samples, 7) == ESP_OK);
+    TEST_CHECK(read_sample_source(&source, &samples[7], 5) == ESP_OK);
+
+    for (size_t i = 0; i < 12; i++)
+        TEST_CHECK_NEAR(samples[i], 0.5f * (i % TEST_NUMBER_OF_SAMPLES) - 1.0f, 0.0);
+
+    TEST_CHECK(close_sample_source(&source) == ESP_OK);
+    TEST_CHECK(source.read == NULL);
+    TEST_CHECK(read_sample_source(&source, samples, 1) == ESP_FAIL); // A closed source can not be read.
+}
+
+static void test_i16_recording_is_scaled(void) {
+    uint8_t data[REPLAY_HEADER_LENGTH + TEST_NUMBER_OF_SAMPLES * sizeof(int16_t)] = {};
+    size_t data_length = write_recording(data, REPLAY_FORMAT_I16, 20000, TEST_NUMBER_OF_SAMPLES, 0.001f);
+
+    sample_source_t source = {};
+    float samples[TEST_NUMBER_OF_SAMPLES] = {};
+
+    TEST_CHECK(open_replay_memory_source(&source, data, data_length, false) == ESP_OK);
+    TEST_CHECK(read_sample_source(&source, samples, TEST_NUMBER_OF_SAMPLES) == ESP_OK);
+
+    for (size_t i = 0; i < TEST_NUMBER_OF_SAMPLES; i++)
+        TEST_CHECK_NEAR(samples[i], (1000.0 * i - 2000.0) * 0.001, 1e-6);
+
+    TEST_CHECK(close_sample_source(&source) == ESP_OK);
+}
+
+static void test_invalid_recordings_are_rejected(void) {
+    uint8_t data[REPLAY_HEADER_LENGTH + TEST_NUMBER_OF_SAMPLES * sizeof(float)] = {};
+    size_t data_length = write_recording(data, REPLAY_FORMAT_F32, 8000, TEST_NUMBER_OF_SAMPLES, 1.0f);
+
+    replay_header_t header = {};
+
+    TEST_CHECK(parse_replay_header(data, data_length, &header) == ESP_OK);
+    TEST_CHECK(header.number_of_samples == TEST_NUMBER_OF_SAMPLES);
+
+    TEST_CHECK(parse_replay_header(data, REPLAY_HEADER_LENGTH - 1, &header) == ESP_FAIL); // Too short for a header.
+    TEST_CHECK(parse_replay_header(data, data_length - 1, &header) == ESP_FAIL);          // Truncated samples.
+    TEST_CHECK(parse_replay_header(NULL, data_length, &header) == ESP_FAIL);
+
+    uint8_t invalid_data[sizeof(data)] = {};
+
+    memcpy(invalid_data, data, sizeof(data));
+    invalid_data[0] ^= 0xFF; // Another magic value.
+    TEST_CHECK(parse_replay_header(invalid_data, data_length, &header) == ESP_FAIL);
+
+    memcpy(invalid_data, data, sizeof(data));
+    invalid_data[4] = REPLAY_VERSION + 1; // Another version.
+    TEST_CHECK(parse_replay_header(invalid_data, data_length, &header) == ESP_FAIL);
+
+    memcpy(invalid_data, data, sizeof(data));
+    invalid_data[6] = 7; // An unknown format.
+    TEST_CHECK(parse_replay_header(invalid_data, data_length, &header) == ESP_FAIL);
+
+    memcpy(invalid_data, data, sizeof(data));
+    memset(&invalid_data[8], 0, sizeof(uint32_t)); // No sample frequency.
+    TEST_CHECK(parse_replay_header(invalid_data, data_length, &header) == ESP_FAIL);
+
+    memcpy(invalid_data, data, sizeof(data));
+    memset(&invalid_data[12], 0, sizeof(uint32_t)); // No samples.
+    TEST_CHECK(parse_replay_header(invalid_data, data_length, &header) == ESP_FAIL);
+
+    // A source is not opened from an invalid recording:
+    sample_source_t source = {};
+
+    TEST_CHECK(open_replay_memory_source(&source, data, data_length - 1, false) == ESP_FAIL);
+    TEST_CHECK(source.read == NULL);
+}
+
+static void test_file_recording_is_owned(void) {
+    uint8_t data[REPLAY_HEADER_LENGTH + TEST_NUMBER_OF_SAMPLES * sizeof(float)] = {};
+    size_t data_length = write_recording(data, REPLAY_FORMAT_F32, 44100, TEST_NUMBER_OF_SAMPLES, 1.0f);
+
+    char file_path[] = "/tmp/test_replay_source_XXXXXX";
+    int file_descriptor = mkstemp(file_path);
+
+    TEST_CHECK(file_descriptor >= 0);
+    TEST_CHECK(write(file_descriptor, data, data_length) == (ssize_t)data_length);
+
+    close(file_descriptor);
+
+    sample_source_t source = {};
+    float samples[TEST_NUMBER_OF_SAMPLES] = {};
+
+    TEST_CHECK(open_replay_file_source(&source, file_path) == ESP_OK);
+    TEST_CHECK(source.sample_frequency == 44100);
+    TEST_CHECK(read_sample_source(&source, samples, TEST_NUMBER_OF_SAMPLES) == ESP_OK);
+    TEST_CHECK_NEAR(samples[TEST_NUMBER_OF_SAMPLES - 1], 0.5f * (TEST_NUMBER_OF_SAMPLES - 1) - 1.0f, 0.0);
+    TEST_CHECK(close_sample_source(&source) == ESP_OK); // Frees the recording that was read from the file.
+
+    unlink(file_path);
+
+    TEST_CHECK(open_replay_file_source(&source, file_path) == ESP_FAIL); // The file is gone.
+}
+
+int main(void) {
+    test_f32_recording_loops();
+    test_i16_recording_is_scaled();
+    test_invalid_recordings_are_rejected();
+    test_file_recording_is_owned();
+
+    TEST_FINISH();
+}
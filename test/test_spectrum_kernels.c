@@ -0,0 +1,78 @@
+// Checks the fused spectrum kernels against the scalar loops they replace, and times them (the same benchmark runs on the device with `idf.py -DSPECTRUM_KERNELS_BENCHMARK=ON build`).
+
+#include "spectrum_kernels.h"
+#include "test_utilities.h"
+
+#define TEST_BIN_COUNT (1024)
+
+static void test_power_and_db_match_the_scalar_loop(void) {
+    float fft_cf[TEST_BIN_COUNT * 2] = {};
+    float power[TEST_BIN_COUNT] = {};
+    float power_db[TEST_BIN_COUNT] = {};
+    float phase[TEST_BIN_COUNT] = {};
+    float magnitude[TEST_BIN_COUNT] = {};
+
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++) {
+        fft_cf[i * 2 + 0] = 100.0f * cosf(0.37f * i) / (1.0f + i);
+        fft_cf[i * 2 + 1] = 100.0f * sinf(0.11f * i * i) / (1.0f + i);
+    }
+
+    fft_cf[10] = fft_cf[11] = 0.0f; // A bin without power is clamped to the floor, instead of minus infinity.
+
+    spectrum_outputs_t outputs = {
+        .power = power,
+        .magnitude = magnitude,
+        .power_db = power_db,
+        .phase = phase,
+        .power_scale = 1.0f / (TEST_BIN_COUNT * 2)
+    };
+
+    TEST_CHECK(spectrum_process_f32(fft_cf, TEST_BIN_COUNT - 3, &outputs) == ESP_OK); // A length that is not a multiple of the unroll.
+
+    for (size_t i = 0; i < TEST_BIN_COUNT - 3; i++) {
+        float squared_magnitude = (fft_cf[i * 2 + 0] * fft_cf[i * 2 + 0] + fft_cf[i * 2 + 1] * fft_cf[i * 2 + 1]) * outputs.power_scale;
+
+        TEST_CHECK_NEAR(power[i], squared_magnitude, 1e-6 * squared_magnitude);
+        TEST_CHECK_NEAR(magnitude[i], sqrtf(squared_magnitude), 1e-6 * sqrtf(squared_magnitude));
+        TEST_CHECK_NEAR(power_db[i], 10.0f * log10f(fmaxf(squared_magnitude, SPECTRUM_MINIMUM_POWER)), SPECTRUM_DB_TOLERANCE);
+        TEST_CHECK_NEAR(phase[i], atan2f(fft_cf[i * 2 + 1], fft_cf[i * 2 + 0]), SPECTRUM_PHASE_TOLERANCE);
+    }
+
+    TEST_CHECK(power[TEST_BIN_COUNT - 3] == 0.0f); // The bins after `bin_count` are not written.
+}
+
+static void test_power_db_aliases_the_input(void) {
+    float fft_cf[TEST_BIN_COUNT * 2] = {};
+    float expected_db[TEST_BIN_COUNT] = {};
+
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++) {
+        fft_cf[i * 2 + 0] = 1.0f + i;
+        fft_cf[i * 2 + 1] = -0.5f * i;
+
+        expected_db[i] = 10.0f * log10f(fft_cf[i * 2 + 0] * fft_cf[i * 2 + 0] + fft_cf[i * 2 + 1] * fft_cf[i * 2 + 1]);
+    }
+
+    // Write the dB over the first half of the complex input, like `apply_fft_f32` does:
+    TEST_CHECK(spectrum_power_db_f32(fft_cf, fft_cf, TEST_BIN_COUNT, 1.0f) == ESP_OK);
+
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++)
+        TEST_CHECK_NEAR(fft_cf[i], expected_db[i], SPECTRUM_DB_TOLERANCE);
+}
+
+static void test_benchmark_against_log10f_and_atan2f(void) {
+    spectrum_benchmark_t benchmark = {};
+
+    TEST_CHECK(benchmark_spectrum_kernels_f32(TEST_BIN_COUNT, SPECTRUM_BENCHMARK_ITERATIONS * 10, &benchmark) == ESP_OK);
+
+    TEST_CHECK(benchmark.maximum_db_error <= SPECTRUM_DB_TOLERANCE);
+    TEST_CHECK(benchmark.maximum_phase_error <= SPECTRUM_PHASE_TOLERANCE);
+    TEST_CHECK(benchmark.scalar_power_duration_us > 0 && benchmark.fused_power_duration_us > 0);
+}
+
+int main(void) {
+    test_power_and_db_match_the_scalar_loop();
+    test_power_db_aliases_the_input();
+    test_benchmark_against_log10f_and_atan2f();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,274 @@
+// Checks that the clients of the spectrum stream get a single slot per socket, also when a socket joins again, and that a client decodes the frames into the spectrum that was encoded.
+
+#include "spectrum_stream.h"
+#include "test_utilities.h"
+
+#define TEST_NUMBER_OF_SAMPLES (256)
+#define TEST_BIN_COUNT (600) // More than two runs of unchanged bins of the longest length (255).
+
+// The task of the stream is not started on the host, so its FFT and sockets are not needed:
+esp_err_t initialize_fft_f32(fft_data_t* fft_data) {
+    return ESP_FAIL;
+}
+
+esp_err_t compute_fft_spectrum_f32(fft_data_t* fft_data, const float* samples, window_config_t window, size_t sample_length, float* power_db, float* power) {
+    return ESP_FAIL;
+}
+
+esp_err_t httpd_ws_send_data_async(httpd_handle_t handle, int socket, httpd_ws_frame_t* frame, transfer_complete_cb callback, void* argument) {
+    return ESP_FAIL;
+}
+
+httpd_ws_client_info_t httpd_ws_get_fd_info(httpd_handle_t handle, int socket) {
+    return HTTPD_WS_CLIENT_WEBSOCKET;
+}
+
+static float test_samples[TEST_NUMBER_OF_SAMPLES] = {};
+static window_config_t test_window = HANN_WINDOW_F32;
+
+/// @brief Returns the number of slots that are used by a socket.
+static size_t count_socket_slots(const spectrum_stream_t* stream, int socket) {
+    size_t slots = 0;
+
+    for (size_t i = 0; i < MAXIMUM_STREAM_CLIENTS; i++)
+        if (stream->clients[i].is_active && stream->clients[i].socket == socket)
+            slots++;
+
+    return slots;
+}
+
+static void test_socket_joins_again(void) {
+    spectrum_stream_t stream = {};
+
+    TEST_CHECK(start_spectrum_stream(&stream, NULL, test_samples, TEST_NUMBER_OF_SAMPLES, &test_window) == ESP_OK);
+
+    // A socket that joins again (a reused descriptor) keeps its slot, and starts over with the defaults:
+    TEST_CHECK(add_stream_client(&stream, 7) == ESP_OK);
+    TEST_CHECK(configure_stream_client(&stream, 7, 20, DELTA_STREAM_ENCODING) == ESP_OK);
+
+    stream.clients[0].sequence = 42;
+
+    TEST_CHECK(add_stream_client(&stream, 7) == ESP_OK);
+    TEST_CHECK(count_socket_slots(&stream, 7) == 1);
+    TEST_CHECK(stream.clients[0].encoding == QUANTIZED_STREAM_ENCODING);
+    TEST_CHECK(stream.clients[0].sequence == 0);
+
+    // So the other slots are still free for new sockets, until all of them are in use:
+    for (int socket = 8; socket < 8 + MAXIMUM_STREAM_CLIENTS - 1; socket++)
+        TEST_CHECK(add_stream_client(&stream, socket) == ESP_OK);
+
+    TEST_CHECK(add_stream_client(&stream, 100) == ESP_FAIL);
+    TEST_CHECK(add_stream_client(&stream, 7) == ESP_OK); // A full stream still accepts a socket that is already in it.
+    TEST_CHECK(count_socket_slots(&stream, 7) == 1);
+}
+
+static void test_sample_lock_without_stream(void) {
+    spectrum_stream_t stream = {};
+
+    // The samples are read before the stream is started, which must not block:
+    take_stream_sample_lock(&stream);
+    give_stream_sample_lock(&stream);
+
+    TEST_CHECK(stream.sample_lock == NULL);
+
+    TEST_CHECK(start_spectrum_stream(&stream, NULL, test_samples, TEST_NUMBER_OF_SAMPLES, &test_window) == ESP_OK);
+    TEST_CHECK(stream.sample_lock != NULL);
+}
+
+static uint8_t test_frame[STREAM_FRAME_LENGTH] = {};
+static float test_power_db[TEST_BIN_COUNT] = {};
+
+/// @brief Defining a struct called `test_decoder`, that contains the state of a client that decodes the frames.
+typedef struct test_decoder {
+    uint32_t sequence;                           // The expected sequence number of the next frame.
+    bool has_reference;                          // Whether `reference` contains the last quantized frame.
+    uint8_t reference[MAXIMUM_STREAM_BIN_COUNT]; // The last quantized frame, that the next delta frame is applied to.
+    float power_db[MAXIMUM_STREAM_BIN_COUNT];    // The decoded power of each bin in dB.
+} test_decoder_t;
+
+static uint32_t read_u32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static float read_f32(const uint8_t* data) {
+    uint32_t bits = read_u32(data);
+    float value = 0.0f;
+
+    memcpy(&value, &bits, sizeof(float));
+
+    return value;
+}
+
+/// @brief Decodes a frame like a client of the stream does, and returns its encoding.
+static stream_encoding_t decode_frame(test_decoder_t* decoder, const uint8_t* frame, size_t frame_length) {
+    stream_encoding_t encoding = frame[0];
+    bool is_keyframe = frame[1] & STREAM_KEYFRAME_FLAG;
+    size_t bin_count = frame[2] | (frame[3] << 8);
+    float db_offset = read_f32(&frame[8]);
+    float db_step = read_f32(&frame[12]);
+
+    TEST_CHECK(bin_count == TEST_BIN_COUNT);
+    TEST_CHECK(read_u32(&frame[4]) == decoder->sequence++);
+
+    const uint8_t* payload = &frame[STREAM_HEADER_LENGTH];
+    size_t payload_length = frame_length - STREAM_HEADER_LENGTH;
+
+    switch (encoding) {
+        case FULL_STREAM_ENCODING:
+            TEST_CHECK(payload_length == bin_count * sizeof(float));
+
+            for (size_t i = 0; i < bin_count; i++)
+                decoder->power_db[i] = read_f32(&payload[i * sizeof(float)]);
+
+            decoder->has_reference = false; // A full frame is no reference for a delta frame.
+
+            return encoding;
+
+        case QUANTIZED_STREAM_ENCODING:
+            TEST_CHECK(payload_length == bin_count);
+
+            memcpy(decoder->reference, payload, bin_count);
+            decoder->has_reference = true;
+
+            break;
+
+        case DELTA_STREAM_ENCODING: {
+            // A delta frame is never a keyframe, and needs the previous quantized frame:
+            TEST_CHECK(!is_keyframe && decoder->has_reference);
+
+            size_t bin = 0;
+            size_t position = 0;
+
+            while (position < payload_length && bin < bin_count) {
+                int8_t difference = (int8_t)payload[position++];
+
+                // A zero byte is followed by the length of a run of unchanged bins:
+                if (difference == 0) {
+                    TEST_CHECK(position < payload_length && payload[position] > 0);
+
+                    bin += payload[position++];
+                }
+                else
+                    decoder->reference[bin++] += difference;
+            }
+
+            // The payload ends exactly with the last bin:
+            TEST_CHECK(bin == bin_count && position == payload_length);
+
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < bin_count; i++)
+        decoder->power_db[i] = db_offset + decoder->reference[i] * db_step;
+
+    return encoding;
+}
+
+/// @brief Encodes the test spectrum for a client, decodes it again, and checks that the client and the decoder share the same reference.
+static stream_encoding_t encode_and_decode(stream_client_t* client, test_decoder_t* decoder) {
+    size_t frame_length = encode_stream_frame(client, test_power_db, TEST_BIN_COUNT, test_frame);
+    stream_encoding_t encoding = decode_frame(decoder, test_frame, frame_length);
+
+    if (client->has_previous_frame)
+        TEST_CHECK(memcmp(decoder->reference, client->previous_frame, TEST_BIN_COUNT) == 0);
+
+    return encoding;
+}
+
+/// @brief Returns the number of bins that differ more than one quantization step from the test spectrum.
+static size_t count_inexact_bins(const test_decoder_t* decoder) {
+    size_t inexact_bins = 0;
+
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++)
+        if (fabsf(decoder->power_db[i] - test_power_db[i]) > STREAM_DB_STEP)
+            inexact_bins++;
+
+    return inexact_bins;
+}
+
+static void test_frames_decode_to_the_spectrum(void) {
+    stream_client_t client = {.encoding = DELTA_STREAM_ENCODING};
+    test_decoder_t decoder = {};
+
+    // A spectrum within the quantized range (-30 dB up to 97.5 dB):
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++)
+        test_power_db[i] = 30.0f + 20.0f * sinf(0.05f * i);
+
+    // The first frame has no reference, so it is a quantized keyframe:
+    TEST_CHECK(encode_and_decode(&client, &decoder) == QUANTIZED_STREAM_ENCODING);
+    TEST_CHECK(test_frame[1] & STREAM_KEYFRAME_FLAG);
+    TEST_CHECK(count_inexact_bins(&decoder) == 0);
+
+    // An unchanged spectrum is sent as runs of at most 255 bins (255, 255 and 90):
+    size_t frame_length = encode_stream_frame(&client, test_power_db, TEST_BIN_COUNT, test_frame);
+
+    TEST_CHECK(frame_length == STREAM_HEADER_LENGTH + 6);
+    TEST_CHECK(test_frame[STREAM_HEADER_LENGTH + 1] == 255 && test_frame[STREAM_HEADER_LENGTH + 5] == 90);
+    TEST_CHECK(decode_frame(&decoder, test_frame, frame_length) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(memcmp(decoder.reference, client.previous_frame, TEST_BIN_COUNT) == 0);
+
+    // Small changes of a few bins are sent as differences:
+    for (size_t i = 300; i < 310; i++)
+        test_power_db[i] += 3.0f;
+
+    TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(count_inexact_bins(&decoder) == 0);
+
+    // A jump of 80 dB (160 steps) is clamped to 127 steps, so the client lags behind for a frame, but keeps the same reference:
+    for (size_t i = 100; i < 105; i++)
+        test_power_db[i] += 80.0f;
+
+    TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(count_inexact_bins(&decoder) == 5);
+    TEST_CHECK_NEAR(decoder.power_db[100], test_power_db[100] - 80.0f + INT8_MAX * STREAM_DB_STEP, STREAM_DB_STEP);
+
+    // And catches up with the next frame:
+    TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(count_inexact_bins(&decoder) == 0);
+
+    // A falling jump of the same size is clamped to -127 steps:
+    for (size_t i = 100; i < 105; i++)
+        test_power_db[i] -= 80.0f;
+
+    TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(count_inexact_bins(&decoder) == 5);
+    TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(count_inexact_bins(&decoder) == 0);
+
+    // Every `STREAM_KEYFRAME_INTERVAL` frames, a quantized keyframe is sent:
+    while (client.sequence % STREAM_KEYFRAME_INTERVAL != 0) {
+        test_power_db[client.sequence] += 1.0f;
+
+        TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+        TEST_CHECK(count_inexact_bins(&decoder) == 0);
+    }
+
+    TEST_CHECK(encode_and_decode(&client, &decoder) == QUANTIZED_STREAM_ENCODING);
+    TEST_CHECK(test_frame[1] & STREAM_KEYFRAME_FLAG);
+    TEST_CHECK(count_inexact_bins(&decoder) == 0);
+
+    // A full frame is exact, and clears the reference, so the next delta frame is a keyframe again:
+    client.encoding = FULL_STREAM_ENCODING;
+
+    TEST_CHECK(encode_and_decode(&client, &decoder) == FULL_STREAM_ENCODING);
+    TEST_CHECK(!client.has_previous_frame);
+
+    for (size_t i = 0; i < TEST_BIN_COUNT; i++)
+        TEST_CHECK_NEAR(decoder.power_db[i], test_power_db[i], 0.0);
+
+    client.encoding = DELTA_STREAM_ENCODING;
+
+    TEST_CHECK(encode_and_decode(&client, &decoder) == QUANTIZED_STREAM_ENCODING);
+    TEST_CHECK(test_frame[1] & STREAM_KEYFRAME_FLAG);
+    TEST_CHECK(encode_and_decode(&client, &decoder) == DELTA_STREAM_ENCODING);
+    TEST_CHECK(count_inexact_bins(&decoder) == 0);
+}
+
+int main(void) {
+    test_socket_joins_again();
+    test_sample_lock_without_stream();
+    test_frames_decode_to_the_spectrum();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,222 @@
+// Checks that the readers of the trace get every event once and in order, also when the sequence numbers wrap around, and that events they miss are counted as dropped.
+
+#include <string.h>
+
+#include "trace_buffer.h"
+#include "test_utilities.h"
+
+static trace_buffer_t test_buffer = {};
+
+/// @brief Clears the ring, and lets the next event start at a sequence number.
+static void reset_buffer(trace_level_t level, uint32_t next_sequence) {
+    memset(&test_buffer, 0, sizeof(test_buffer));
+
+    atomic_store(&test_buffer.level, level);
+    atomic_store(&test_buffer.next_sequence, next_sequence);
+}
+
+/// @brief Records a number of events, with the index of every event as its first value.
+static void record_events(size_t number_of_events) {
+    for (size_t i = 0; i < number_of_events; i++) {
+        int32_t values[TRACE_EVENT_VALUES] = {(int32_t)i, 0, 0};
+
+        record_trace_event(&test_buffer, FFT_JOB_TRACE, TRACE_LEVEL_INFO, values, NULL);
+    }
+}
+
+static void test_events_are_read_in_order(void) {
+    reset_buffer(TRACE_LEVEL_INFO, 0);
+
+    int32_t values[TRACE_EVENT_VALUES] = {7, -8, 9};
+    float measurements[TRACE_EVENT_MEASUREMENTS] = {1.5f, -2.5f};
+
+    record_trace_event(&test_buffer, CORRELATION_TRACE, TRACE_LEVEL_INFO, values, measurements);
+    record_events(4);
+
+    trace_event_t events[3] = {};
+    uint32_t sequence = 0;
+    size_t number_of_events = 0;
+    uint32_t dropped_events = 0;
+
+    // The first call is limited by the length of the array:
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, 3, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 3);
+    TEST_CHECK(sequence == 3);
+    TEST_CHECK(dropped_events == 0);
+
+    TEST_CHECK(events[0].sequence == 0);
+    TEST_CHECK(events[0].stage == CORRELATION_TRACE);
+    TEST_CHECK(events[0].level == TRACE_LEVEL_INFO);
+    TEST_CHECK(events[0].values[1] == -8);
+    TEST_CHECK(events[0].measurements[1] == -2.5f);
+    TEST_CHECK(events[1].sequence == 1 && events[1].values[0] == 0);
+    TEST_CHECK(events[2].sequence == 2 && events[2].values[0] == 1);
+
+    // The next call continues where the first one stopped:
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, 3, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 2);
+    TEST_CHECK(sequence == 5);
+    TEST_CHECK(events[0].sequence == 3 && events[1].sequence == 4);
+
+    // Nothing is left:
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, 3, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 0);
+    TEST_CHECK(sequence == 5);
+    TEST_CHECK(dropped_events == 0);
+}
+
+static void test_sequence_wraps_around(void) {
+    uint32_t first_sequence = UINT32_MAX - 9;
+
+    reset_buffer(TRACE_LEVEL_INFO, first_sequence);
+    record_events(20);
+
+    TEST_CHECK(get_trace_sequence(&test_buffer) == 10);
+
+    trace_event_t events[TRACE_BUFFER_LENGTH] = {};
+    uint32_t sequence = first_sequence;
+    size_t number_of_events = 0;
+    uint32_t dropped_events = 0;
+
+    // The events before and after the wrap (including the one with the largest sequence number) are read in order:
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, TRACE_BUFFER_LENGTH, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 20);
+    TEST_CHECK(sequence == 10);
+    TEST_CHECK(dropped_events == 0);
+
+    for (size_t i = 0; i < number_of_events; i++) {
+        TEST_CHECK(events[i].sequence == (uint32_t)(first_sequence + i));
+        TEST_CHECK(events[i].values[0] == (int32_t)i);
+    }
+}
+
+static void test_overwritten_events_are_dropped(void) {
+    uint32_t first_sequence = UINT32_MAX - 99;
+
+    reset_buffer(TRACE_LEVEL_INFO, first_sequence);
+    record_events(TRACE_BUFFER_LENGTH + 172); // The ring is lapped while the sequence numbers wrap around.
+
+    trace_event_t events[TRACE_BUFFER_LENGTH] = {};
+    uint32_t sequence = first_sequence;
+    size_t number_of_events = 0;
+    uint32_t dropped_events = 5; // The dropped events are added to the count of the caller.
+
+    // The reader fell behind, so it skips to the oldest event in the ring, and counts the others as dropped:
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, TRACE_BUFFER_LENGTH, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == TRACE_BUFFER_LENGTH);
+    TEST_CHECK(dropped_events == 5 + 172);
+    TEST_CHECK(sequence == get_trace_sequence(&test_buffer));
+
+    for (size_t i = 0; i < number_of_events; i++) {
+        TEST_CHECK(events[i].sequence == (uint32_t)(first_sequence + 172 + i));
+        TEST_CHECK(events[i].values[0] == (int32_t)(172 + i));
+    }
+
+    // A reader that is up to date drops nothing, when it is lapped exactly once:
+    record_events(TRACE_BUFFER_LENGTH);
+
+    dropped_events = 0;
+
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, TRACE_BUFFER_LENGTH, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == TRACE_BUFFER_LENGTH);
+    TEST_CHECK(dropped_events == 0);
+}
+
+static void test_reclaimed_slot_is_skipped(void) {
+    reset_buffer(TRACE_LEVEL_INFO, 0);
+    record_events(10);
+
+    // A writer that lapped the reader already claimed the slot of the fourth event (its sequence number is not visible to the reader yet):
+    atomic_store(&test_buffer.slots[3].committed_sequence, 3 + TRACE_BUFFER_LENGTH + 1);
+
+    // The slot of the sixth event is being written:
+    atomic_store(&test_buffer.slots[5].committed_sequence, 0);
+
+    trace_event_t events[TRACE_BUFFER_LENGTH] = {};
+    uint32_t sequence = 0;
+    size_t number_of_events = 0;
+    uint32_t dropped_events = 0;
+
+    // The reclaimed event is dropped, and the read stops before the incomplete one:
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, TRACE_BUFFER_LENGTH, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 4);
+    TEST_CHECK(dropped_events == 1);
+    TEST_CHECK(sequence == 5);
+    TEST_CHECK(events[0].sequence == 0 && events[1].sequence == 1 && events[2].sequence == 2 && events[3].sequence == 4);
+
+    // Once the event is complete, it is read on the next call:
+    atomic_store(&test_buffer.slots[5].committed_sequence, 5 + 1);
+
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, TRACE_BUFFER_LENGTH, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 5);
+    TEST_CHECK(dropped_events == 1);
+    TEST_CHECK(sequence == 10);
+    TEST_CHECK(events[0].sequence == 5 && events[4].sequence == 9);
+}
+
+static void test_levels_are_gated(void) {
+    reset_buffer(TRACE_LEVEL_INFO, 0);
+
+    // Only the levels up to the level of the buffer are recorded (and `TRACE_LEVEL_OFF` never is):
+    record_trace_event(&test_buffer, FFT_JOB_TRACE, TRACE_LEVEL_OFF, NULL, NULL);
+    record_trace_event(&test_buffer, FFT_JOB_TRACE, TRACE_LEVEL_INFO, NULL, NULL);
+    record_trace_event(&test_buffer, FFT_PEAK_TRACE, TRACE_LEVEL_VERBOSE, NULL, NULL);
+    record_trace_event(&test_buffer, FFT_PEAK_TRACE, TRACE_LEVEL_PLOT, NULL, NULL);
+
+    TEST_CHECK(get_trace_sequence(&test_buffer) == 1);
+    TEST_CHECK(trace_level_is_enabled(&test_buffer, TRACE_LEVEL_INFO));
+    TEST_CHECK(!trace_level_is_enabled(&test_buffer, TRACE_LEVEL_VERBOSE));
+    TEST_CHECK(!trace_level_is_enabled(&test_buffer, TRACE_LEVEL_OFF));
+    TEST_CHECK(!trace_level_is_enabled(NULL, TRACE_LEVEL_INFO));
+
+    atomic_store(&test_buffer.level, TRACE_LEVEL_VERBOSE);
+
+    record_trace_event(&test_buffer, FFT_PEAK_TRACE, TRACE_LEVEL_VERBOSE, NULL, NULL);
+    record_trace_event(&test_buffer, FFT_PEAK_TRACE, TRACE_LEVEL_PLOT, NULL, NULL);
+
+    TEST_CHECK(get_trace_sequence(&test_buffer) == 2);
+
+    // A disabled trace records nothing:
+    atomic_store(&test_buffer.level, TRACE_LEVEL_OFF);
+
+    record_trace_event(&test_buffer, FFT_JOB_TRACE, TRACE_LEVEL_INFO, NULL, NULL);
+    record_trace_event(NULL, FFT_JOB_TRACE, TRACE_LEVEL_INFO, NULL, NULL);
+
+    TEST_CHECK(get_trace_sequence(&test_buffer) == 2);
+
+    trace_event_t events[4] = {};
+    uint32_t sequence = 0;
+    size_t number_of_events = 0;
+    uint32_t dropped_events = 0;
+
+    // The recorded events carry their stage and level (without values, they are zero):
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, 4, &number_of_events, &dropped_events) == ESP_OK);
+    TEST_CHECK(number_of_events == 2);
+    TEST_CHECK(events[0].stage == FFT_JOB_TRACE && events[0].level == TRACE_LEVEL_INFO);
+    TEST_CHECK(events[1].stage == FFT_PEAK_TRACE && events[1].level == TRACE_LEVEL_VERBOSE);
+    TEST_CHECK(events[1].values[0] == 0 && events[1].measurements[0] == 0.0f);
+}
+
+static void test_invalid_arguments(void) {
+    trace_event_t events[1] = {};
+    uint32_t sequence = 0;
+    size_t number_of_events = 0;
+    uint32_t dropped_events = 0;
+
+    TEST_CHECK(read_trace_events(NULL, &sequence, events, 1, &number_of_events, &dropped_events) == ESP_FAIL);
+    TEST_CHECK(read_trace_events(&test_buffer, NULL, events, 1, &number_of_events, &dropped_events) == ESP_FAIL);
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, NULL, 1, &number_of_events, &dropped_events) == ESP_FAIL);
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, 1, NULL, &dropped_events) == ESP_FAIL);
+    TEST_CHECK(read_trace_events(&test_buffer, &sequence, events, 1, &number_of_events, NULL) == ESP_FAIL);
+}
+
+int main(void) {
+    test_events_are_read_in_order();
+    test_sequence_wraps_around();
+    test_overwritten_events_are_dropped();
+    test_reclaimed_slot_is_skipped();
+    test_levels_are_gated();
+    test_invalid_arguments();
+
+    TEST_FINISH();
+}
@@ -0,0 +1,35 @@
+#ifndef TEST_UTILITIES_H_
+#define TEST_UTILITIES_H_
+
+#include <stdio.h>
+#include <math.h>
+
+static int test_failures = 0; // The number of failed checks of the test program.
+
+/// @brief This macro checks a condition, and reports it (without stopping the test) when it is false.
+#define TEST_CHECK(condition) do {                                                        \
+        if (!(condition)) {                                                               \
+            fprintf(stderr, "FAILED: '%s' at %s:%d\n", #condition, __FILE__, __LINE__);  \
+            test_failures++;                                                              \
+        }                                                                                 \
+    } while (0)
+
+/// @brief This macro checks if two values are within a tolerance of each other.
+#define TEST_CHECK_NEAR(value, expected, tolerance) do {                                                                                            \
+        double test_value = (value);                                                                                                              \
+        double test_expected = (expected);                                                                                                        \
+                                                                                                                                                  \
+        if (!(fabs(test_value - test_expected) <= (tolerance))) {                                                                                 \
+            fprintf(stderr, "FAILED: '%s' is '%g', expected '%g' (within '%g') at %s:%d\n", #value, test_value, test_expected, (double)(tolerance), __FILE__, __LINE__); \
+            test_failures++;                                                                                                                      \
+        }                                                                                                                                         \
+    } while (0)
+
+/// @brief This macro ends a test program, with a non-zero exit code if a check failed.
+#define TEST_FINISH() do {                                                                  \
+        fprintf(stderr, "%s: %s\n", __FILE__, (test_failures == 0) ? "passed" : "FAILED"); \
+                                                                                            \
+        return (test_failures == 0) ? 0 : 1;                                                \
+    } while (0)
+
+#endif
@@ -0,0 +1,87 @@
+#include "binary_encoder.h"
+
+size_t encode_wave_message(uint8_t* message, size_t message_length, uint32_t sample_frequency, const binary_wave_t* waves, size_t number_of_waves) {
+    size_t payload_length = BINARY_WAVE_PAYLOAD_HEADER_LENGTH + number_of_waves * BINARY_WAVE_RECORD_LENGTH;
+
+    // Check if the number of waves fits in the message, and if the message fits in the buffer:
+    if (message == NULL || (waves == NULL && number_of_waves > 0) || number_of_waves > UINT8_MAX || BINARY_HEADER_LENGTH + payload_length > message_length)
+        return 0;
+
+    binary_write_header(message, BINARY_WAVE_MESSAGE, (uint16_t)payload_length);
+
+    uint8_t* payload = &message[BINARY_HEADER_LENGTH];
+
+    binary_write_u32(&payload[0], sample_frequency);
+    payload[4] = (uint8_t)number_of_waves;
+    payload[5] = payload[6] = payload[7] = 0;
+
+    // Write a record for every wave:
+    for (size_t i = 0; i < number_of_waves; i++) {
+        uint8_t* record = &payload[BINARY_WAVE_PAYLOAD_HEADER_LENGTH + i * BINARY_WAVE_RECORD_LENGTH];
+
+        binary_write_f32(&record[0], waves[i].amplitude);
+        binary_write_f32(&record[4], waves[i].frequency);
+        binary_write_f32(&record[8], waves[i].phase);
+        binary_write_f32(&record[12], waves[i].offset);
+    }
+
+    return BINARY_HEADER_LENGTH + payload_length;
+}
+
+size_t encode_fft_message(uint8_t* message, size_t message_length, binary_window_id_t window_id, bool has_peak_config, uint8_t maximum_peaks, float peak_threshold) {
+    // Check if the message fits in the buffer:
+    if (message == NULL || BINARY_HEADER_LENGTH + BINARY_FFT_PAYLOAD_LENGTH > message_length)
+        return 0;
+
+    binary_write_header(message, BINARY_FFT_MESSAGE, BINARY_FFT_PAYLOAD_LENGTH);
+
+    uint8_t* payload = &message[BINARY_HEADER_LENGTH];
+
+    payload[0] = (uint8_t)window_id;
+    payload[1] = has_peak_config ? BINARY_FFT_FLAG_PEAK_CONFIG : 0;
+    payload[2] = maximum_peaks;
+    payload[3] = 0;
+    binary_write_f32(&payload[4], peak_threshold);
+
+    return BINARY_HEADER_LENGTH + BINARY_FFT_PAYLOAD_LENGTH;
+}
+
+size_t encode_dac_message(uint8_t* message, size_t message_length, bool prevent_overflow, bool keep_phase, bool swap_at_period) {
+    // Check if the message fits in the buffer:
+    if (message == NULL || BINARY_HEADER_LENGTH + BINARY_DAC_PAYLOAD_LENGTH > message_length)
+        return 0;
+
+    binary_write_header(message, BINARY_DAC_MESSAGE, BINARY_DAC_PAYLOAD_LENGTH);
+
+    uint8_t* payload = &message[BINARY_HEADER_LENGTH];
+
+    payload[0] = (prevent_overflow ? BINARY_DAC_FLAG_PREVENT_OVERFLOW : 0) | (keep_phase ? BINARY_DAC_FLAG_KEEP_PHASE : 0) | (swap_at_period ? BINARY_DAC_FLAG_SWAP_AT_PERIOD : 0);
+    payload[1] = payload[2] = payload[3] = 0;
+
+    return BINARY_HEADER_LENGTH + BINARY_DAC_PAYLOAD_LENGTH;
+}
+
+int decode_peak_message(const uint8_t* message, size_t message_length, binary_peak_t* peaks, size_t maximum_peaks, size_t* number_of_peaks) {
+    const uint8_t* payload = NULL;
+    size_t payload_length = 0;
+
+    // Check if the header is valid:
+    if (peaks == NULL || number_of_peaks == NULL || binary_read_header(message, message_length, BINARY_PEAK_MESSAGE, &payload, &payload_length) != 0)
+        return -1;
+
+    // Check if the payload contains the announced number of records:
+    if (payload_length < BINARY_PEAK_PAYLOAD_HEADER_LENGTH || payload_length < BINARY_PEAK_PAYLOAD_HEADER_LENGTH + (size_t)payload[0] * BINARY_PEAK_RECORD_LENGTH)
+        return -1;
+
+    *number_of_peaks = payload[0] < maximum_peaks ? payload[0] : maximum_peaks;
+
+    // Read the record of every peak that fits in the array:
+    for (size_t i = 0; i < *number_of_peaks; i++) {
+        const uint8_t* record = &payload[BINARY_PEAK_PAYLOAD_HEADER_LENGTH + i * BINARY_PEAK_RECORD_LENGTH];
+
+        peaks[i].frequency = binary_read_f32(&record[0]);
+        peaks[i].amplitude = binary_read_f32(&record[4]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#ifndef BINARY_ENCODER_H_
+#define BINARY_ENCODER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "../../main/binary_protocol.h"
+
+/// @brief Defining a struct called `binary_wave`, that contains the configuration of a single wave in a binary wave message.
+typedef struct binary_wave {
+    float amplitude; // This field contains a `float` with the amplitude of the wave.
+    float frequency; // This field contains a `float` with the frequency of the wave (in Hz).
+    float phase;     // This field contains a `float` with the phase of the wave.
+    float offset;    // This field contains a `float` with the offset of the wave.
+} binary_wave_t;
+
+/// @brief Defining a struct called `binary_peak`, that contains a single peak of a binary peak message.
+typedef struct binary_peak {
+    float frequency; // This field contains a `float` with the frequency of the peak (in Hz).
+    float amplitude; // This field contains a `float` with the amplitude of the peak.
+} binary_peak_t;
+
+/// @brief This function encodes a binary wave message.
+/// @param message A pointer to the buffer where the message will be stored.
+/// @param message_length The length of the buffer (in bytes).
+/// @param sample_frequency The sample frequency of the waves (in Hz).
+/// @param waves A pointer to the configurations of the waves.
+/// @param number_of_waves The number of waves (at most 255).
+/// @return The length of the encoded message in bytes, or zero if the buffer is too small.
+extern size_t encode_wave_message(uint8_t* message, size_t message_length, uint32_t sample_frequency, const binary_wave_t* waves, size_t number_of_waves);
+
+/// @brief This function encodes a binary FFT message.
+/// @param message A pointer to the buffer where the message will be stored.
+/// @param message_length The length of the buffer (in bytes).
+/// @param window_id The `binary_window_id_t` of the window that is applied before the FFT.
+/// @param has_peak_config A `bool` indicating if the peak configuration below should be used by the server.
+/// @param maximum_peaks The maximum number of peaks that will be reported.
+/// @param peak_threshold The minimum power of a reported peak (in dB).
+/// @return The length of the encoded message in bytes, or zero if the buffer is too small.
+extern size_t encode_fft_message(uint8_t* message, size_t message_length, binary_window_id_t window_id, bool has_peak_config, uint8_t maximum_peaks, float peak_threshold);
+
+/// @brief This function encodes a binary DAC message.
+/// @param message A pointer to the buffer where the message will be stored.
+/// @param message_length The length of the buffer (in bytes).
+/// @param prevent_overflow A `bool` indicating if the DAC output should be scaled to prevent overflow.
+/// @param keep_phase A `bool` indicating if new values continue at the same position in their period.
+/// @param swap_at_period A `bool` indicating if new values are swapped in at the end of the period (instead of at a crossing).
+/// @return The length of the encoded message in bytes, or zero if the buffer is too small.
+extern size_t encode_dac_message(uint8_t* message, size_t message_length, bool prevent_overflow, bool keep_phase, bool swap_at_period);
+
+/// @brief This function decodes a binary peak message (the response to a binary FFT message).
+/// @param message A pointer to the received message.
+/// @param message_length The length of the received message (in bytes).
+/// @param peaks A pointer to the array where the peaks will be stored.
+/// @param maximum_peaks The length of the `peaks` array.
+/// @param number_of_peaks A pointer where the number of stored peaks will be stored.
+/// @return Zero if the message is valid, or a negative value if it is not.
+extern int decode_peak_message(const uint8_t* message, size_t message_length, binary_peak_t* peaks, size_t maximum_peaks, size_t* number_of_peaks);
+
+#endif
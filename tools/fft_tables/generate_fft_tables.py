@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Generates the constant FFT tables of 'main/fft_tables.h' for a fixed FFT length.
+
+The build runs this script (see 'main/CMakeLists.txt'), so the twiddles, the bit-reversal
+pairs and the windows are placed in flash, instead of being computed in RAM at startup.
+"""
+
+import argparse
+import math
+import struct
+
+# The cosine-sum coefficients of every window, in the same order as the `window_config_t` enum (these match `get_window_properties` and the windows of `esp_dsp`):
+WINDOW_COEFFICIENTS = [
+    ("HANN_WINDOW_F32", [0.5, 0.5]),
+    ("BLACKMAN_WINDOW_F32", [0.42, 0.5, 0.08]),
+    ("BLACKMAN_HARRIS_WINDOW_F32", [0.35875, 0.48829, 0.14128, 0.01168]),
+    ("BLACKMAN_NUTTALL_WINDOW_F32", [0.3635819, 0.4891775, 0.1365995, 0.0106411]),
+    ("NUTTALL_WINDOW_F32", [0.355768, 0.487396, 0.144232, 0.012604]),
+    ("FLAT_TOP_WINDOW_F32", [1.0, 1.93, 1.29, 0.388, 0.028]),
+]
+
+VALUES_PER_LINE = 8
+
+
+def to_float32(value):
+    # Round the value to the nearest `float`, so the table holds exactly what the device would store:
+    return struct.unpack("<f", struct.pack("<f", value))[0]
+
+
+def format_float(value):
+    # Nine significant digits are enough to read back the exact `float` (and a literal needs a point or an exponent for the suffix):
+    text = "{:.9g}".format(to_float32(value))
+
+    return (text if "." in text or "e" in text else text + ".0") + "f"
+
+
+def format_values(values, indent):
+    lines = []
+
+    for i in range(0, len(values), VALUES_PER_LINE):
+        lines.append(indent + ", ".join(values[i:i + VALUES_PER_LINE]) + ",")
+
+    return "\n".join(lines)
+
+
+def reverse_bits(value, bits):
+    return int(format(value, "0{}b".format(bits))[::-1], 2)
+
+
+def generate_twiddles(length):
+    # The factors `cos(2 * pi * k / N)` and `sin(2 * pi * k / N)` of the first half of the circle, as complex pairs in natural order:
+    values = []
+
+    for k in range(length // 2):
+        angle = 2.0 * math.pi * k / length
+
+        values.append(format_float(math.cos(angle)))
+        values.append(format_float(math.sin(angle)))
+
+    return values
+
+
+def generate_bit_reversal_pairs(length):
+    # Only the pairs that have to be swapped (an index that is its own reverse stays in place):
+    bits = length.bit_length() - 1
+
+    return [(i, reverse_bits(i, bits)) for i in range(length) if i < reverse_bits(i, bits)]
+
+
+def generate_window(coefficients, length):
+    # A symmetric cosine-sum window, with alternating signs (like the windows of `esp_dsp`):
+    values = []
+
+    for i in range(length):
+        value = 0.0
+
+        for k, coefficient in enumerate(coefficients):
+            value += (-1.0) ** k * coefficient * math.cos(2.0 * math.pi * k * i / (length - 1))
+
+        values.append(format_float(value))
+
+    return values
+
+
+def generate_source(length):
+    bit_reversal_pairs = generate_bit_reversal_pairs(length)
+
+    lines = [
+        "// This file is generated by 'tools/fft_tables/generate_fft_tables.py', do not edit it.",
+        "",
+        "#include \"fft_tables.h\"",
+        "",
+        "#if FFT_STATIC_LENGTH != {}".format(length),
+        "#error \"The generated FFT tables do not match 'FFT_STATIC_LENGTH'!\"",
+        "#endif",
+        "",
+        "const float fft_static_twiddles[FFT_STATIC_LENGTH] = {",
+        format_values(generate_twiddles(length), "    "),
+        "};",
+        "",
+        "const size_t fft_static_bit_reversal_pair_count = {};".format(len(bit_reversal_pairs)),
+        "",
+        "const uint16_t fft_static_bit_reversal_pairs[][2] = {",
+        format_values(["{{{}, {}}}".format(first, second) for first, second in bit_reversal_pairs], "    "),
+        "};",
+        "",
+        "const float fft_static_window_tables[WINDOW_CONFIGS_LENGTH][FFT_STATIC_LENGTH] = {",
+    ]
+
+    for name, coefficients in WINDOW_COEFFICIENTS:
+        lines.append("    [{}] = {{".format(name))
+        lines.append(format_values(generate_window(coefficients, length), "        "))
+        lines.append("    },")
+
+    lines.append("};")
+    lines.append("")
+
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--length", type=int, required=True, help="the length of the FFT (a power of two)")
+    parser.add_argument("--output", required=True, help="the path of the generated C source")
+
+    arguments = parser.parse_args()
+
+    # Check if the length is a power of two, that fits the `uint16_t` bit-reversal pairs:
+    if arguments.length < 4 or arguments.length > 65536 or arguments.length & (arguments.length - 1) != 0:
+        parser.error("The length '{}' must be a power of two between 4 and 65536!".format(arguments.length))
+
+    with open(arguments.output, "w", encoding="utf-8") as output:
+        output.write(generate_source(arguments.length))
+
+
+if __name__ == "__main__":
+    main()
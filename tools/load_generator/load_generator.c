@@ -0,0 +1,647 @@
+#include "load_generator.h"
+
+#include <errno.h>
+#include <getopt.h>
+#include <math.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#define SERVER_MAXIMUM_CONTENT_LENGTH (250) // The length of the content that the server receives of a request (see `MAXIMUM_CONTENT_LENGTH` in 'main/http_server.h').
+
+/// @brief Defining a struct called `load_endpoint_name`, that maps the name of an endpoint in a request mix to its `load_endpoint_t`.
+typedef struct load_endpoint_name {
+    const char* name;
+    load_endpoint_t endpoint;
+} load_endpoint_name_t;
+
+static const load_endpoint_name_t load_endpoint_names[] = {
+    {"wave", WAVE_ENDPOINT},
+    {"fft", FFT_ENDPOINT},
+    {"fft_result", FFT_RESULT_ENDPOINT},
+    {"fft_job", FFT_JOB_ENDPOINT},
+    {"dac", DAC_ENDPOINT}
+};
+
+static double get_time_ms(void) {
+    struct timespec time = {};
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+static void sleep_ms(unsigned int duration_ms) {
+    struct timespec duration = {
+        .tv_sec = duration_ms / 1000,
+        .tv_nsec = (long)(duration_ms % 1000) * 1000000
+    };
+
+    nanosleep(&duration, NULL);
+}
+
+static void record_request(load_run_t* load_run, load_endpoint_t endpoint, double latency_ms, int status, int expected_status) {
+    pthread_mutex_lock(&load_run->lock);
+
+    endpoint_statistics_t* statistics = &load_run->statistics[endpoint];
+
+    // A busy board is counted apart from the errors, because it is the expected answer to an overload:
+    if (status == 503)
+        statistics->number_of_rejected++;
+    else if (status != expected_status)
+        statistics->number_of_errors++;
+    else {
+        // Grow the array of the latencies when it is full:
+        if (statistics->latency_count == statistics->latency_capacity) {
+            size_t latency_capacity = (statistics->latency_capacity == 0) ? 256 : statistics->latency_capacity * 2;
+            double* latencies_ms = realloc(statistics->latencies_ms, latency_capacity * sizeof(double));
+
+            if (latencies_ms == NULL) {
+                statistics->number_of_errors++;
+
+                pthread_mutex_unlock(&load_run->lock);
+
+                return;
+            }
+
+            statistics->latencies_ms = latencies_ms;
+            statistics->latency_capacity = latency_capacity;
+        }
+
+        statistics->latencies_ms[statistics->latency_count++] = latency_ms;
+    }
+
+    pthread_mutex_unlock(&load_run->lock);
+}
+
+static size_t format_wave_request(const load_config_t* config, uint8_t* body, size_t body_length) {
+    binary_wave_t waves[MAXIMUM_LOAD_WAVES] = {};
+
+    // Spread the waves below a quarter of the sample frequency, with a total amplitude that fits the DAC:
+    for (size_t i = 0; i < config->number_of_waves; i++) {
+        waves[i].amplitude = 1.0f / config->number_of_waves;
+        waves[i].frequency = (float)config->sample_frequency * (i + 1) / (4.0f * config->number_of_waves);
+        waves[i].offset = (i == 0) ? 1.65f : 0.0f;
+    }
+
+    if (config->use_binary_format)
+        return encode_wave_message(body, body_length, config->sample_frequency, waves, config->number_of_waves);
+
+    int length = snprintf((char*)body, body_length, "{\"sample_frequency\":%u,\"waves\":[", (unsigned int)config->sample_frequency);
+
+    for (size_t i = 0; i < config->number_of_waves && length > 0 && (size_t)length < body_length; i++)
+        length += snprintf((char*)&body[length], body_length - length, "%s{\"amplitude\":%.3f,\"frequency\":%.1f,\"phase\":0,\"offset\":%.2f}", (i == 0) ? "" : ",", waves[i].amplitude, waves[i].frequency, waves[i].offset);
+
+    if (length > 0 && (size_t)length < body_length)
+        length += snprintf((char*)&body[length], body_length - length, "]}");
+
+    return (length > 0 && (size_t)length < body_length) ? (size_t)length : 0;
+}
+
+static size_t format_fft_request(const load_config_t* config, uint8_t* body, size_t body_length) {
+    if (config->use_binary_format)
+        return encode_fft_message(body, body_length, BINARY_HANN_WINDOW, false, 0, 0.0f);
+
+    int length = snprintf((char*)body, body_length, "{\"window\":\"HANN_F32\"}");
+
+    return (length > 0 && (size_t)length < body_length) ? (size_t)length : 0;
+}
+
+static size_t format_dac_request(const load_config_t* config, uint8_t* body, size_t body_length) {
+    if (config->use_binary_format)
+        return encode_dac_message(body, body_length, true, false, false);
+
+    int length = snprintf((char*)body, body_length, "{\"prevent_overflow_value\":true}");
+
+    return (length > 0 && (size_t)length < body_length) ? (size_t)length : 0;
+}
+
+static const char* get_content_type(const load_config_t* config) {
+    return config->use_binary_format ? BINARY_PROTOCOL_CONTENT_TYPE : "application/json";
+}
+
+static void poll_fft_job(load_run_t* load_run, const char* response, double queued_time_ms) {
+    const load_config_t* config = load_run->config;
+    const char* job_id_field = strstr(response, "\"job_id\":");
+
+    // Check if the response contains the ID of the job:
+    if (job_id_field == NULL) {
+        record_request(load_run, FFT_JOB_ENDPOINT, 0.0, 0, 200);
+
+        return;
+    }
+
+    char path[64] = {};
+
+    snprintf(path, sizeof(path), "/fft/result?id=%lu", strtoul(job_id_field + strlen("\"job_id\":"), NULL, 10));
+
+    // Poll the result of the job, until it is finished (or the timeout is passed):
+    while (true) {
+        char result[MAXIMUM_HTTP_RESPONSE_LENGTH] = {};
+        int status = 0;
+
+        double start_time_ms = get_time_ms();
+        int succeeded_request = send_http_request(config, "GET", path, NULL, NULL, 0, result, sizeof(result), &status);
+        double end_time_ms = get_time_ms();
+
+        record_request(load_run, FFT_RESULT_ENDPOINT, end_time_ms - start_time_ms, succeeded_request == 0 ? status : 0, (status == 202) ? 202 : 200);
+
+        // A finished job is answered with status 200, and a failed job is an error of the job:
+        if (succeeded_request == 0 && status == 200) {
+            record_request(load_run, FFT_JOB_ENDPOINT, end_time_ms - queued_time_ms, strstr(result, "\"DONE\"") != NULL ? 200 : 0, 200);
+
+            return;
+        }
+
+        if (succeeded_request != 0 || status != 202 || end_time_ms - queued_time_ms > config->timeout_ms) {
+            record_request(load_run, FFT_JOB_ENDPOINT, 0.0, 0, 200);
+
+            return;
+        }
+
+        sleep_ms(config->poll_interval_ms);
+    }
+}
+
+static load_endpoint_t select_endpoint(const load_config_t* config, unsigned int* seed) {
+    unsigned int total_weight = 0;
+
+    for (size_t i = 0; i < NUMBER_OF_ENDPOINTS; i++)
+        total_weight += config->mix_weights[i];
+
+    unsigned int selection = rand_r(seed) % total_weight;
+
+    // Select the endpoint, in which weight the random selection falls:
+    for (size_t i = 0; i < NUMBER_OF_ENDPOINTS; i++) {
+        if (selection < config->mix_weights[i])
+            return (load_endpoint_t)i;
+
+        selection -= config->mix_weights[i];
+    }
+
+    return WAVE_ENDPOINT;
+}
+
+static void* load_worker(void* argument) {
+    load_run_t* load_run = argument;
+    const load_config_t* config = load_run->config;
+
+    unsigned int seed = (unsigned int)(uintptr_t)pthread_self() ^ (unsigned int)time(NULL); // Every worker draws its own sequence from the mix.
+
+    while (true) {
+        // Claim the next request of the run:
+        pthread_mutex_lock(&load_run->lock);
+
+        bool has_request = load_run->next_request < config->number_of_requests;
+
+        if (has_request)
+            load_run->next_request++;
+
+        pthread_mutex_unlock(&load_run->lock);
+
+        if (!has_request)
+            return NULL;
+
+        load_endpoint_t endpoint = select_endpoint(config, &seed);
+
+        uint8_t body[MAXIMUM_HTTP_REQUEST_LENGTH] = {};
+        size_t body_length = 0;
+        const char* path = NULL;
+        int expected_status = 200;
+
+        switch (endpoint) {
+            case WAVE_ENDPOINT:
+                body_length = format_wave_request(config, body, sizeof(body));
+                path = "/wave";
+                break;
+
+            case FFT_ENDPOINT:
+                body_length = format_fft_request(config, body, sizeof(body));
+                path = "/fft";
+                expected_status = config->use_binary_format ? 200 : 202; // A binary FFT request waits for its job.
+                break;
+
+            case DAC_ENDPOINT:
+                body_length = format_dac_request(config, body, sizeof(body));
+                path = "/dac";
+                break;
+
+            default:
+                continue;
+        }
+
+        char response[MAXIMUM_HTTP_RESPONSE_LENGTH] = {};
+        int status = 0;
+
+        double start_time_ms = get_time_ms();
+        int succeeded_request = send_http_request(config, "POST", path, get_content_type(config), body, body_length, response, sizeof(response), &status);
+        double end_time_ms = get_time_ms();
+
+        record_request(load_run, endpoint, end_time_ms - start_time_ms, succeeded_request == 0 ? status : 0, expected_status);
+
+        // Follow a queued job until it is done, so the latency of the complete job is known as well:
+        if (endpoint == FFT_ENDPOINT && !config->use_binary_format && config->poll_fft_jobs && succeeded_request == 0 && status == 202)
+            poll_fft_job(load_run, response, start_time_ms);
+    }
+}
+
+static int compare_latencies(const void* first, const void* second) {
+    double first_latency = *(const double*)first;
+    double second_latency = *(const double*)second;
+
+    return (first_latency > second_latency) - (first_latency < second_latency);
+}
+
+int parse_request_mix(const char* mix, unsigned int* mix_weights) {
+    // Check if `mix` and `mix_weights` have a valid value:
+    if (mix == NULL || mix_weights == NULL)
+        return -1;
+
+    memset(mix_weights, 0, NUMBER_OF_ENDPOINTS * sizeof(unsigned int));
+
+    char copy[256] = {};
+
+    if (strlen(mix) >= sizeof(copy))
+        return -1;
+
+    strcpy(copy, mix);
+
+    unsigned int total_weight = 0;
+    char* saved_position = NULL;
+
+    // Parse every `name=weight` pair of the mix:
+    for (char* pair = strtok_r(copy, ",", &saved_position); pair != NULL; pair = strtok_r(NULL, ",", &saved_position)) {
+        char* separator = strchr(pair, '=');
+
+        if (separator == NULL)
+            return -1;
+
+        *separator = '\0';
+
+        char* end = NULL;
+        unsigned long weight = strtoul(separator + 1, &end, 10);
+
+        if (*end != '\0' || end == separator + 1 || weight > 1000)
+            return -1;
+
+        bool is_known_endpoint = false;
+
+        // Only the endpoints that send their own requests can be selected (the polls follow the FFT requests):
+        for (size_t i = 0; i < sizeof(load_endpoint_names) / sizeof(load_endpoint_names[0]); i++) {
+            load_endpoint_t endpoint = load_endpoint_names[i].endpoint;
+
+            if (strcmp(pair, load_endpoint_names[i].name) == 0 && (endpoint == WAVE_ENDPOINT || endpoint == FFT_ENDPOINT || endpoint == DAC_ENDPOINT)) {
+                mix_weights[endpoint] = (unsigned int)weight;
+                is_known_endpoint = true;
+            }
+        }
+
+        if (!is_known_endpoint)
+            return -1;
+
+        total_weight += (unsigned int)weight;
+    }
+
+    return (total_weight > 0) ? 0 : -1;
+}
+
+int send_http_request(const load_config_t* config, const char* method, const char* path, const char* content_type, const uint8_t* body, size_t body_length, char* response, size_t response_length, int* status) {
+    // Check if the arguments have a valid value:
+    if (config == NULL || method == NULL || path == NULL || (body == NULL && body_length > 0) || response == NULL || response_length == 0 || status == NULL)
+        return -1;
+
+    response[0] = '\0';
+    *status = 0;
+
+    struct addrinfo hints = {
+        .ai_family = AF_UNSPEC,
+        .ai_socktype = SOCK_STREAM
+    };
+
+    struct addrinfo* addresses = NULL;
+
+    if (getaddrinfo(config->host, config->port, &hints, &addresses) != 0)
+        return -1;
+
+    int socket_descriptor = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+
+    if (socket_descriptor < 0) {
+        freeaddrinfo(addresses);
+
+        return -1;
+    }
+
+    // Let a request fail after the timeout, instead of blocking the worker:
+    struct timeval timeout = {
+        .tv_sec = config->timeout_ms / 1000,
+        .tv_usec = (config->timeout_ms % 1000) * 1000
+    };
+
+    setsockopt(socket_descriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(socket_descriptor, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    int connected = connect(socket_descriptor, addresses->ai_addr, addresses->ai_addrlen);
+
+    freeaddrinfo(addresses);
+
+    if (connected != 0) {
+        close(socket_descriptor);
+
+        return -1;
+    }
+
+    char header[512] = {};
+    int header_length = 0;
+
+    // Close the connection after the response, so the end of the response is the end of the stream:
+    if (content_type != NULL)
+        header_length = snprintf(header, sizeof(header), "%s %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\nContent-Type: %s\r\nContent-Length: %zu\r\n\r\n", method, path, config->host, content_type, body_length);
+    else
+        header_length = snprintf(header, sizeof(header), "%s %s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\n\r\n", method, path, config->host);
+
+    bool is_sent = header_length > 0 && (size_t)header_length < sizeof(header) && send(socket_descriptor, header, header_length, MSG_NOSIGNAL) == header_length;
+
+    if (is_sent && body_length > 0)
+        is_sent = send(socket_descriptor, body, body_length, MSG_NOSIGNAL) == (ssize_t)body_length;
+
+    if (!is_sent) {
+        close(socket_descriptor);
+
+        return -1;
+    }
+
+    char received[MAXIMUM_HTTP_RESPONSE_LENGTH + 512] = {};
+    size_t received_length = 0;
+
+    // Read the response until the server closes the connection (a response that does not fit is truncated):
+    while (true) {
+        char chunk[512];
+        ssize_t chunk_length = recv(socket_descriptor, chunk, sizeof(chunk), 0);
+
+        if (chunk_length == 0)
+            break;
+
+        if (chunk_length < 0) {
+            close(socket_descriptor);
+
+            return -1;
+        }
+
+        size_t copy_length = ((size_t)chunk_length < sizeof(received) - 1 - received_length) ? (size_t)chunk_length : sizeof(received) - 1 - received_length;
+
+        memcpy(&received[received_length], chunk, copy_length);
+        received_length += copy_length;
+    }
+
+    close(socket_descriptor);
+
+    // Parse the status code of the status line:
+    if (sscanf(received, "HTTP/%*d.%*d %d", status) != 1)
+        return -1;
+
+    const char* response_body = strstr(received, "\r\n\r\n");
+
+    if (response_body != NULL)
+        snprintf(response, response_length, "%s", response_body + 4);
+
+    return 0;
+}
+
+int run_load(load_run_t* load_run, double* duration_s) {
+    // Check if `load_run` and `duration_s` have a valid value:
+    if (load_run == NULL || load_run->config == NULL || duration_s == NULL)
+        return -1;
+
+    pthread_t workers[MAXIMUM_LOAD_CONCURRENCY];
+    size_t number_of_workers = 0;
+
+    double start_time_ms = get_time_ms();
+
+    for (; number_of_workers < load_run->config->concurrency; number_of_workers++) {
+        if (pthread_create(&workers[number_of_workers], NULL, load_worker, load_run) != 0)
+            break;
+    }
+
+    for (size_t i = 0; i < number_of_workers; i++)
+        pthread_join(workers[i], NULL);
+
+    *duration_s = (get_time_ms() - start_time_ms) / 1000.0;
+
+    return (number_of_workers == load_run->config->concurrency) ? 0 : -1;
+}
+
+double calculate_latency_percentile(const endpoint_statistics_t* statistics, double percentile) {
+    if (statistics == NULL || statistics->latency_count == 0)
+        return 0.0;
+
+    size_t rank = (size_t)ceil(percentile / 100.0 * statistics->latency_count); // The nearest rank, starting at one.
+
+    return statistics->latencies_ms[(rank == 0) ? 0 : rank - 1];
+}
+
+int report_load(load_run_t* load_run, double duration_s) {
+    const load_config_t* config = load_run->config;
+
+    bool is_within_limits = true;
+
+    printf("%-10s %8s %8s %8s %10s %9s %9s %9s %9s\n", "endpoint", "ok", "errors", "busy", "req/s", "p50 ms", "p95 ms", "p99 ms", "max ms");
+
+    for (size_t i = 0; i < NUMBER_OF_ENDPOINTS; i++) {
+        endpoint_statistics_t* statistics = &load_run->statistics[i];
+
+        size_t number_of_requests = statistics->latency_count + statistics->number_of_errors + statistics->number_of_rejected;
+
+        if (number_of_requests == 0)
+            continue;
+
+        qsort(statistics->latencies_ms, statistics->latency_count, sizeof(double), compare_latencies);
+
+        double p99_ms = calculate_latency_percentile(statistics, 99.0);
+
+        printf("%-10s %8zu %8zu %8zu %10.2f %9.1f %9.1f %9.1f %9.1f\n", get_load_endpoint_name((load_endpoint_t)i), statistics->latency_count, statistics->number_of_errors, statistics->number_of_rejected, statistics->latency_count / duration_s, calculate_latency_percentile(statistics, 50.0), calculate_latency_percentile(statistics, 95.0), p99_ms, calculate_latency_percentile(statistics, 100.0));
+
+        // A run fails on any error, or on a p99 latency above the limit (a busy board is not an error):
+        if (statistics->number_of_errors > 0 || (config->maximum_p99_ms > 0.0 && p99_ms > config->maximum_p99_ms))
+            is_within_limits = false;
+    }
+
+    printf("%zu requests from the mix in %.2f s, with %zu concurrent connections\n", config->number_of_requests, duration_s, config->concurrency);
+
+    return is_within_limits ? 0 : -1;
+}
+
+const char* get_load_endpoint_name(load_endpoint_t endpoint) {
+    for (size_t i = 0; i < sizeof(load_endpoint_names) / sizeof(load_endpoint_names[0]); i++) {
+        if (load_endpoint_names[i].endpoint == endpoint)
+            return load_endpoint_names[i].name;
+    }
+
+    return "unknown";
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [options] <host>\n"
+        "  -p, --port <port>              the port of the HTTP server (default %s)\n"
+        "  -n, --requests <count>         the number of requests from the mix (default %d)\n"
+        "  -c, --concurrency <count>      the number of concurrent connections (default %d, at most %d)\n"
+        "  -m, --mix <mix>                the weights of the endpoints, like 'wave=1,fft=4,dac=1' (the default)\n"
+        "  -w, --waves <count>            the number of waves per /wave request (default %d, at most %d)\n"
+        "  -f, --sample-frequency <hz>    the sample frequency of the waves (default %d)\n"
+        "  -b, --binary                   send the requests in the binary format\n"
+        "  -P, --no-poll                  do not poll the queued FFT jobs\n"
+        "  -i, --poll-interval <ms>       the time between two polls of a job (default %d)\n"
+        "  -t, --timeout <ms>             the timeout of a request or a job (default %d)\n"
+        "  -l, --max-p99 <ms>             fail when the p99 latency of an endpoint is higher\n",
+        program, LOAD_GENERATOR_DEFAULT_PORT, LOAD_GENERATOR_DEFAULT_REQUESTS, LOAD_GENERATOR_DEFAULT_CONCURRENCY, MAXIMUM_LOAD_CONCURRENCY, LOAD_GENERATOR_DEFAULT_WAVES, MAXIMUM_LOAD_WAVES, LOAD_GENERATOR_DEFAULT_SAMPLE_FREQUENCY, LOAD_GENERATOR_DEFAULT_POLL_INTERVAL_MS, LOAD_GENERATOR_DEFAULT_TIMEOUT_MS);
+}
+
+int main(int argc, char** argv) {
+    load_config_t config = {
+        .port = LOAD_GENERATOR_DEFAULT_PORT,
+        .number_of_requests = LOAD_GENERATOR_DEFAULT_REQUESTS,
+        .concurrency = LOAD_GENERATOR_DEFAULT_CONCURRENCY,
+        .number_of_waves = LOAD_GENERATOR_DEFAULT_WAVES,
+        .sample_frequency = LOAD_GENERATOR_DEFAULT_SAMPLE_FREQUENCY,
+        .poll_fft_jobs = true,
+        .poll_interval_ms = LOAD_GENERATOR_DEFAULT_POLL_INTERVAL_MS,
+        .timeout_ms = LOAD_GENERATOR_DEFAULT_TIMEOUT_MS
+    };
+
+    parse_request_mix("wave=1,fft=4,dac=1", config.mix_weights);
+
+    const struct option options[] = {
+        {"port", required_argument, NULL, 'p'},
+        {"requests", required_argument, NULL, 'n'},
+        {"concurrency", required_argument, NULL, 'c'},
+        {"mix", required_argument, NULL, 'm'},
+        {"waves", required_argument, NULL, 'w'},
+        {"sample-frequency", required_argument, NULL, 'f'},
+        {"binary", no_argument, NULL, 'b'},
+        {"no-poll", no_argument, NULL, 'P'},
+        {"poll-interval", required_argument, NULL, 'i'},
+        {"timeout", required_argument, NULL, 't'},
+        {"max-p99", required_argument, NULL, 'l'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int option = 0;
+
+    while ((option = getopt_long(argc, argv, "p:n:c:m:w:f:bPi:t:l:", options, NULL)) != -1) {
+        switch (option) {
+            case 'p':
+                config.port = optarg;
+                break;
+
+            case 'n':
+                config.number_of_requests = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'c':
+                config.concurrency = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'm':
+                if (parse_request_mix(optarg, config.mix_weights) != 0) {
+                    fprintf(stderr, "The request mix '%s' is not valid!\n", optarg);
+
+                    return EXIT_FAILURE;
+                }
+                break;
+
+            case 'w':
+                config.number_of_waves = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'f':
+                config.sample_frequency = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'b':
+                config.use_binary_format = true;
+                break;
+
+            case 'P':
+                config.poll_fft_jobs = false;
+                break;
+
+            case 'i':
+                config.poll_interval_ms = strtoul(optarg, NULL, 10);
+                break;
+
+            case 't':
+                config.timeout_ms = strtoul(optarg, NULL, 10);
+                break;
+
+            case 'l':
+                config.maximum_p99_ms = strtod(optarg, NULL);
+                break;
+
+            default:
+                print_usage(argv[0]);
+
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc - 1) {
+        print_usage(argv[0]);
+
+        return EXIT_FAILURE;
+    }
+
+    config.host = argv[optind];
+
+    // Check if the settings are within the limits of the generator and the server:
+    if (config.number_of_requests == 0 || config.concurrency == 0 || config.concurrency > MAXIMUM_LOAD_CONCURRENCY || config.number_of_waves == 0 || config.number_of_waves > MAXIMUM_LOAD_WAVES || config.sample_frequency == 0 || config.timeout_ms == 0) {
+        fprintf(stderr, "The number of requests, the concurrency, the number of waves, the sample frequency or the timeout is not valid!\n");
+
+        return EXIT_FAILURE;
+    }
+
+    uint8_t body[MAXIMUM_HTTP_REQUEST_LENGTH] = {};
+    size_t body_length = format_wave_request(&config, body, sizeof(body));
+
+    // Check if the waves fit in the content that the server receives:
+    if (body_length == 0 || body_length >= SERVER_MAXIMUM_CONTENT_LENGTH) {
+        fprintf(stderr, "The /wave request of '%zu' bytes does not fit in the '%d' bytes that the server receives, use fewer waves or the binary format!\n", body_length, SERVER_MAXIMUM_CONTENT_LENGTH);
+
+        return EXIT_FAILURE;
+    }
+
+    char response[MAXIMUM_HTTP_RESPONSE_LENGTH] = {};
+    int status = 0;
+
+    // Send the waves once before the run, so `/fft` and `/dac` have samples to work on:
+    if (send_http_request(&config, "POST", "/wave", get_content_type(&config), body, body_length, response, sizeof(response), &status) != 0 || status != 200) {
+        fprintf(stderr, "The board at '%s:%s' did not accept the waves (status %d)!\n", config.host, config.port, status);
+
+        return EXIT_FAILURE;
+    }
+
+    load_run_t load_run = {
+        .config = &config,
+        .lock = PTHREAD_MUTEX_INITIALIZER
+    };
+
+    double duration_s = 0.0;
+
+    if (run_load(&load_run, &duration_s) != 0) {
+        fprintf(stderr, "The workers of the run could not be started!\n");
+
+        return EXIT_FAILURE;
+    }
+
+    int within_limits = report_load(&load_run, duration_s);
+
+    for (size_t i = 0; i < NUMBER_OF_ENDPOINTS; i++)
+        free(load_run.statistics[i].latencies_ms);
+
+    return (within_limits == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
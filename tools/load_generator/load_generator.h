@@ -0,0 +1,116 @@
+#ifndef LOAD_GENERATOR_H_
+#define LOAD_GENERATOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <pthread.h>
+
+#include "../binary_encoder/binary_encoder.h"
+
+#define LOAD_GENERATOR_DEFAULT_PORT ("80")
+#define LOAD_GENERATOR_DEFAULT_REQUESTS (200)
+#define LOAD_GENERATOR_DEFAULT_CONCURRENCY (4)
+#define LOAD_GENERATOR_DEFAULT_WAVES (2)
+#define LOAD_GENERATOR_DEFAULT_SAMPLE_FREQUENCY (2000) // Above 1 kHz on purpose, so the FFT jobs of a run also draw the kHz labels of the OLED spectrum view.
+#define LOAD_GENERATOR_DEFAULT_POLL_INTERVAL_MS (20)
+#define LOAD_GENERATOR_DEFAULT_TIMEOUT_MS (10000)
+
+#define MAXIMUM_LOAD_CONCURRENCY (64)
+#define MAXIMUM_LOAD_WAVES (10) // The number of waves that the server accepts in a single request.
+#define MAXIMUM_HTTP_REQUEST_LENGTH (4096)
+#define MAXIMUM_HTTP_RESPONSE_LENGTH (4096)
+
+/// @brief This is an enumeration called `load_endpoint_t` with the endpoints of which the latency is reported.
+typedef enum load_endpoint {
+    WAVE_ENDPOINT,       // A `POST /wave` with `waves` waves.
+    FFT_ENDPOINT,        // A `POST /fft`, which queues a job (or waits for it, with the binary format).
+    FFT_RESULT_ENDPOINT, // A single `GET /fft/result` while a job is polled.
+    FFT_JOB_ENDPOINT,    // From queueing a job until its result is done (only reported, it can not be selected in the mix).
+    DAC_ENDPOINT,        // A `POST /dac`.
+    NUMBER_OF_ENDPOINTS
+} load_endpoint_t;
+
+/// @brief Defining a struct called `load_config`, that contains the settings of a load run.
+typedef struct load_config {
+    const char* host; // This field contains the host name or address of the board.
+    const char* port; // This field contains the port of the HTTP server.
+
+    size_t number_of_requests;                     // This field contains a `size_t` with the number of requests that are selected from the mix (the polls of the FFT jobs come on top).
+    size_t concurrency;                            // This field contains a `size_t` with the number of connections that send requests at the same time.
+    unsigned int mix_weights[NUMBER_OF_ENDPOINTS]; // This field contains the relative weight of every endpoint in the mix.
+
+    size_t number_of_waves;    // This field contains a `size_t` with the number of waves in every `/wave` request (which sets its payload size).
+    uint32_t sample_frequency; // This field contains an `uint32_t` with the sample frequency of the waves (in Hz).
+
+    bool use_binary_format; // This field contains a `bool`, indicating if the requests use the binary format instead of JSON.
+    bool poll_fft_jobs;     // This field contains a `bool`, indicating if every queued FFT job is polled until it is done.
+
+    unsigned int poll_interval_ms; // This field contains the time between two polls of a job (in milliseconds).
+    unsigned int timeout_ms;       // This field contains the time after which a request (or a polled job) fails (in milliseconds).
+    double maximum_p99_ms;         // This field contains the p99 latency above which the run fails (in milliseconds), or zero to only report it.
+} load_config_t;
+
+/// @brief Defining a struct called `endpoint_statistics`, that contains the latencies and outcomes of the requests to a single endpoint.
+typedef struct endpoint_statistics {
+    double* latencies_ms;    // This field is a pointer to the latencies of the successful requests (in milliseconds).
+    size_t latency_count;    // This field contains a `size_t` with the number of stored latencies.
+    size_t latency_capacity; // This field contains a `size_t` with the length of the `latencies_ms` array.
+
+    size_t number_of_errors;   // This field contains a `size_t` with the number of failed requests (connection errors, timeouts and unexpected statuses).
+    size_t number_of_rejected; // This field contains a `size_t` with the number of requests that were rejected because the board was busy (status 503).
+} endpoint_statistics_t;
+
+/// @brief Defining a struct called `load_run`, that contains the state that is shared between the workers of a load run.
+typedef struct load_run {
+    const load_config_t* config; // This field is a pointer to the settings of the run.
+
+    size_t next_request;                                   // This field contains a `size_t` with the number of requests that are already claimed by the workers.
+    endpoint_statistics_t statistics[NUMBER_OF_ENDPOINTS]; // This field contains the statistics of every endpoint.
+    pthread_mutex_t lock;                                  // This field contains a `pthread_mutex_t`, that guards the fields above.
+} load_run_t;
+
+/// @brief This function parses a request mix, like `"wave=1,fft=4,dac=1"`, into the weights of the endpoints (endpoints that are not named get a weight of zero).
+/// @param mix The request mix.
+/// @param mix_weights A pointer to the array where the weight of every endpoint will be stored.
+/// @return Zero if the mix is valid, or a negative value if it is not.
+extern int parse_request_mix(const char* mix, unsigned int* mix_weights);
+
+/// @brief This function sends a single HTTP/1.1 request over a new connection, and reads the complete response.
+/// @param config A pointer to the settings of the run (for the host, port and timeout).
+/// @param method The method of the request (for example `"POST"`).
+/// @param path The path of the request (for example `"/wave"`).
+/// @param content_type The content type of the body, or `NULL` if there is no body.
+/// @param body A pointer to the body of the request (it may be `NULL` when `body_length` is zero).
+/// @param body_length The length of the body (in bytes).
+/// @param response A pointer to a buffer where the body of the response will be stored (it is always zero-terminated).
+/// @param response_length The length of the `response` buffer.
+/// @param status A pointer where the status code of the response will be stored.
+/// @return Zero if a response was received, or a negative value if the connection failed or timed out.
+extern int send_http_request(const load_config_t* config, const char* method, const char* path, const char* content_type, const uint8_t* body, size_t body_length, char* response, size_t response_length, int* status);
+
+/// @brief This function runs the load: the workers send requests from the mix until `number_of_requests` requests are sent.
+/// @param load_run A pointer to the `load_run_t` structure, whose statistics are filled.
+/// @param duration_s A pointer where the duration of the run will be stored (in seconds).
+/// @return Zero if the run finished, or a negative value if the workers could not be started.
+extern int run_load(load_run_t* load_run, double* duration_s);
+
+/// @brief This function calculates a percentile of the latencies of an endpoint, with the nearest-rank method.
+/// @param statistics A pointer to the statistics of the endpoint (its latencies must be sorted).
+/// @param percentile The percentile (between 0 and 100).
+/// @return The latency at the percentile (in milliseconds), or zero if there are no latencies.
+extern double calculate_latency_percentile(const endpoint_statistics_t* statistics, double percentile);
+
+/// @brief This function prints the throughput and the p50/p95/p99 latencies of every endpoint.
+/// @param load_run A pointer to the finished `load_run_t` structure (the latencies are sorted in-place).
+/// @param duration_s The duration of the run (in seconds).
+/// @return Zero if every endpoint is within the limits of the run, or a negative value if a request failed or a p99 latency is too high.
+extern int report_load(load_run_t* load_run, double duration_s);
+
+/// @brief This function converts an endpoint into its name (for example `"wave"`).
+/// @param endpoint The `load_endpoint_t` of the endpoint.
+/// @return A string with the name of the endpoint.
+extern const char* get_load_endpoint_name(load_endpoint_t endpoint);
+
+#endif